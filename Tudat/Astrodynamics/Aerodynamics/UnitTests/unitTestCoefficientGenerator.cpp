@@ -32,6 +32,14 @@
  *                                  Extended spherical test to check for correct settings.
  *      121108    A. Ronse          Updated unit test to new generator architecture, corrected
  *                                  Apollo expected values and tolerances.
+ *      261016    agent             Updated Apollo expected axial force coefficient, after fixing
+ *                                  inclinations of capsule parts other than the heat shield.
+ *                                  Added test of multi-threaded database generation.
+ *      261016    agent             Added tests of coefficient generation along trajectory and of
+ *                                  concurrent on-demand coefficient generation.
+ *      261016    agent             Added test of cache file of coefficients.
+ *      261016    agent             Factored out creation of capsule analysis.
+ *      261016    agent             Added checks of cache file for different grid and geometry.
  *
  *    References
  *      Gentry, A., Smyth, D., and Oliver, W. . The Mark IV Supersonic-Hypersonic Arbitrary Body
@@ -43,17 +51,26 @@
 
 #define BOOST_TEST_MAIN
 
+#include <limits>
+#include <stdexcept>
+#include <string>
+
 #include <boost/array.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/ref.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 
 #include <Eigen/Core>
 
 #include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
 
 #include "Tudat/Astrodynamics/Aerodynamics/hypersonicLocalInclinationAnalysis.h"
+#include "Tudat/InputOutput/basicInputOutput.h"
 #include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
 #include "Tudat/Mathematics/GeometricShapes/capsule.h"
 #include "Tudat/Mathematics/GeometricShapes/sphereSegment.h"
@@ -65,6 +82,122 @@ namespace unit_tests
 
 using basic_mathematics::Vector6d;
 
+//! Get analysis methods of the parts of the test capsule.
+/*!
+ * Returns the compression (first vector) and expansion (second vector) methods used for the four
+ * parts of the test capsule.
+ * \return Selected methods per part of the test capsule.
+ */
+std::vector< std::vector< int > > getCapsuleSelectedMethods( )
+{
+    std::vector< std::vector< int > > selectedMethods;
+    selectedMethods.resize( 2 );
+    selectedMethods[ 0 ].resize( 4 );
+    selectedMethods[ 1 ].resize( 4 );
+
+    selectedMethods[ 0 ][ 0 ] = 1;
+    selectedMethods[ 0 ][ 1 ] = 5;
+    selectedMethods[ 0 ][ 2 ] = 5;
+    selectedMethods[ 0 ][ 3 ] = 1;
+    selectedMethods[ 1 ][ 0 ] = 6;
+    selectedMethods[ 1 ][ 1 ] = 3;
+    selectedMethods[ 1 ][ 2 ] = 3;
+    selectedMethods[ 1 ][ 3 ] = 3;
+
+    return selectedMethods;
+}
+
+//! Get angle of attack points of the test capsule, from -30 to 0 degrees in steps of 5 degrees.
+std::vector< double > getCapsuleAngleOfAttackPoints( )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    std::vector< double > angleOfAttackPoints;
+    angleOfAttackPoints.resize( 7 );
+
+    for ( int i = 0; i < 7; i++ )
+    {
+        angleOfAttackPoints[ i ] = static_cast< double >( i - 6 ) * 5.0 * PI / 180.0;
+    }
+
+    return angleOfAttackPoints;
+}
+
+//! Create analysis of the (Apollo) test capsule.
+/*!
+ * Creates a hypersonic local inclination analysis of the test capsule, which consists of four
+ * parts, at the default Mach and angle of sideslip points.
+ * \param angleOfAttackPoints Angle of attack points of the analysis.
+ * \param numberOfLines Number of lines per part of the capsule.
+ * \param numberOfPoints Number of points per line per part of the capsule.
+ * \param referenceLength Reference length of the analysis.
+ * \param selectedMethods Compression and expansion methods per part of the capsule.
+ * \return Analysis of the test capsule.
+ */
+boost::shared_ptr< aerodynamics::HypersonicLocalInclinationAnalysis > createCapsuleAnalysis(
+        const std::vector< double >& angleOfAttackPoints = getCapsuleAngleOfAttackPoints( ),
+        const std::vector< int >& numberOfLines = std::vector< int >( 4, 11 ),
+        const std::vector< int >& numberOfPoints = std::vector< int >( 4, 11 ),
+        const double referenceLength = 3.9116,
+        const std::vector< std::vector< int > >& selectedMethods = getCapsuleSelectedMethods( ) )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+    using namespace aerodynamics;
+
+    // Create test capsule, consisting of multiple parts.
+    boost::shared_ptr< geometric_shapes::Capsule > capsule
+            = boost::make_shared< geometric_shapes::Capsule >(
+                    4.694, 1.956, 2.662, -1.0 * 33.0 * PI / 180.0, 0.196 );
+
+    std::vector< std::vector< double > > independentVariableDataPoints;
+    independentVariableDataPoints.resize( 3 );
+    independentVariableDataPoints[ 0 ] = getDefaultHypersonicLocalInclinationMachPoints( "Full" );
+    independentVariableDataPoints[ 1 ] = angleOfAttackPoints;
+    independentVariableDataPoints[ 2 ] =
+            getDefaultHypersonicLocalInclinationAngleOfSideslipPoints( );
+
+    return boost::make_shared< HypersonicLocalInclinationAnalysis >(
+                independentVariableDataPoints, capsule, numberOfLines, numberOfPoints,
+                std::vector< bool >( 4, 0 ), selectedMethods,
+                PI * pow( capsule->getMiddleRadius( ), 2.0 ), referenceLength,
+                Eigen::Vector3d( -0.6624, 0.0, -0.1369 ) );
+}
+
+//! Retrieve all aerodynamic coefficients of analysis.
+/*!
+ * Retrieves the aerodynamic coefficients at all data points of the analysis, generating them if
+ * required. Used to request coefficients concurrently from multiple threads.
+ * \param analysis Analysis from which coefficients are retrieved.
+ * \param coefficients Matrix in which coefficients are stored as rows, with the index of the
+ *          angle of sideslip running fastest (returned by reference).
+ */
+void retrieveAllAerodynamicCoefficients(
+        aerodynamics::HypersonicLocalInclinationAnalysis& analysis,
+        Eigen::MatrixXd& coefficients )
+{
+    coefficients.resize( analysis.getNumberOfValuesOfIndependentVariable( 0 )
+                         * analysis.getNumberOfValuesOfIndependentVariable( 1 )
+                         * analysis.getNumberOfValuesOfIndependentVariable( 2 ), 6 );
+
+    boost::array< int, 3 > independentVariables;
+    int row = 0;
+    for ( int i = 0; i < analysis.getNumberOfValuesOfIndependentVariable( 0 ); i++ )
+    {
+        independentVariables[ 0 ] = i;
+        for ( int j = 0; j < analysis.getNumberOfValuesOfIndependentVariable( 1 ); j++ )
+        {
+            independentVariables[ 1 ] = j;
+            for ( int k = 0; k < analysis.getNumberOfValuesOfIndependentVariable( 2 ); k++ )
+            {
+                independentVariables[ 2 ] = k;
+                coefficients.row( row ) = analysis.getAerodynamicCoefficients(
+                            independentVariables ).transpose( );
+                row++;
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE( test_aerodynamic_coefficient_generator )
 
 //! Test coefficient generator.
@@ -176,12 +309,11 @@ BOOST_AUTO_TEST_CASE( testAerodynamicCoefficientGenerator )
 //! Apollo capsule test case.
 BOOST_AUTO_TEST_CASE( testApolloCapsule )
 {
-    using tudat::basic_mathematics::mathematical_constants::PI;
     using std::vector;
     using namespace aerodynamics;
 
     // Set units of coefficients.
-    const double expectedValueOfAerodynamicCoefficients0 = -1.51;
+    const double expectedValueOfAerodynamicCoefficients0 = -1.58;
     const double expectedValueOfAerodynamicCoefficients4 = -0.052;
 
     // Tolerance in absolute units.
@@ -192,84 +324,30 @@ BOOST_AUTO_TEST_CASE( testApolloCapsule )
     const double toleranceAerodynamicCoefficients4 = 0.975;
     const double toleranceAerodynamicCoefficients5 = std::numeric_limits< double >::epsilon( );
 
-    // Create test capsule.
-    boost::shared_ptr< geometric_shapes::Capsule > capsule
-            = boost::make_shared< geometric_shapes::Capsule >(
-                    4.694, 1.956, 2.662, -1.0 * 33.0 * PI / 180.0, 0.196 );
-
-    vector< int > numberOfLines;
-    vector< int > numberOfPoints;
-    vector< bool > invertOrders;
-    numberOfLines.resize( 4 );
-    numberOfPoints.resize( 4 );
-    invertOrders.resize( 4 );
-
     // Set number of analysis points.
-    numberOfLines[ 0 ] = 31;
-    numberOfPoints[ 0 ] = 31;
-    numberOfLines[ 1 ] = 31;
-    numberOfPoints[ 1 ] = 31;
-    numberOfLines[ 2 ] = 31;
+    vector< int > numberOfLines( 4, 31 );
+    vector< int > numberOfPoints( 4, 31 );
     numberOfPoints[ 2 ] = 10;
     numberOfLines[ 3 ] = 11;
     numberOfPoints[ 3 ] = 11;
-    invertOrders[ 0 ] = 0;
-    invertOrders[ 1 ] = 0;
-    invertOrders[ 2 ] = 0;
-    invertOrders[ 3 ] = 0;
-
-    Eigen::Vector3d momentReference;
-    momentReference( 0 ) = -0.6624;
-    momentReference( 1 ) = 0.0;
-    momentReference( 2 ) = -0.1369;
-
-    std::vector< std::vector< double > > independentVariableDataPoints;
-    independentVariableDataPoints.resize( 3 );
-    independentVariableDataPoints[ 0 ] = getDefaultHypersonicLocalInclinationMachPoints( "Full" );
-    std::vector< double > angleOfAttackPoints;
-    angleOfAttackPoints.resize( 7 );
-
-    for ( int i = 0; i < 7; i++ )
-    {
-        angleOfAttackPoints[ i ] = static_cast< double >( i - 6 ) * 5.0 * PI / 180.0;
-    }
-
-    independentVariableDataPoints[ 1 ] = angleOfAttackPoints;
-    independentVariableDataPoints[ 2 ] =
-            getDefaultHypersonicLocalInclinationAngleOfSideslipPoints( );
-    std::vector< std::vector< int > > selectedMethods;
-    selectedMethods.resize( 2 );
-    selectedMethods[ 0 ].resize( 4 );
-    selectedMethods[ 1 ].resize( 4 );
-
-    selectedMethods[ 0 ][ 0 ] = 1;
-    selectedMethods[ 0 ][ 1 ] = 5;
-    selectedMethods[ 0 ][ 2 ] = 5;
-    selectedMethods[ 0 ][ 3 ] = 1;
-    selectedMethods[ 1 ][ 0 ] = 6;
-    selectedMethods[ 1 ][ 1 ] = 3;
-    selectedMethods[ 1 ][ 2 ] = 3;
-    selectedMethods[ 1 ][ 3 ] = 3;
 
     // Create analysis object.
-    HypersonicLocalInclinationAnalysis analysis = HypersonicLocalInclinationAnalysis(
-                independentVariableDataPoints, capsule, numberOfLines, numberOfPoints,
-                invertOrders, selectedMethods, PI * pow( capsule->getMiddleRadius( ), 2.0 ),
-                3.9116, momentReference );
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > analysis = createCapsuleAnalysis(
+                getCapsuleAngleOfAttackPoints( ), numberOfLines, numberOfPoints );
 
     // Generate capsule database.
-    analysis.generateCoefficients( );
+    analysis->generateCoefficients( );
 
     // Retrieve coefficients at zero angle of attack for comparison.
     boost::array< int, 3 > independentVariables;
 
-    independentVariables[ 0 ] = analysis.getNumberOfValuesOfIndependentVariable( 0 ) - 1;
+    independentVariables[ 0 ] = analysis->getNumberOfValuesOfIndependentVariable( 0 ) - 1;
     independentVariables[ 1 ] = 6;
     independentVariables[ 2 ] = 0;
 
     // Declare local test variables.
     Eigen::VectorXd aerodynamicCoefficients_;
-    aerodynamicCoefficients_ = analysis.getAerodynamicCoefficients( independentVariables );
+    aerodynamicCoefficients_ = analysis->getAerodynamicCoefficients( independentVariables );
 
     // Compare values to database values.
     BOOST_CHECK_SMALL(
@@ -293,6 +371,221 @@ BOOST_AUTO_TEST_CASE( testApolloCapsule )
                        toleranceAerodynamicCoefficients5 );
 }
 
+//! Test multi-threaded generation of database against on-demand generation of coefficients.
+BOOST_AUTO_TEST_CASE( testMultiThreadedCoefficientGeneration )
+{
+    using namespace aerodynamics;
+
+    // Create analysis objects, of which the first generates the complete database using
+    // multiple threads, and the second generates coefficients as they are requested.
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > multiThreadedAnalysis
+            = createCapsuleAnalysis( );
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > onDemandAnalysis
+            = createCapsuleAnalysis( );
+
+    // Use a number of threads that does not divide the number of angle of attack and sideslip
+    // pairs.
+    multiThreadedAnalysis->setNumberOfThreads( 4 );
+    BOOST_CHECK_EQUAL( multiThreadedAnalysis->getNumberOfThreads( ), 4 );
+    multiThreadedAnalysis->generateCoefficients( );
+
+    // Compare coefficients of both analyses, with the Mach number running slowest, such that the
+    // on-demand analysis reuses stored inclinations of all parts.
+    boost::array< int, 3 > independentVariables;
+    for ( int i = 0; i < onDemandAnalysis->getNumberOfValuesOfIndependentVariable( 0 ); i++ )
+    {
+        independentVariables[ 0 ] = i;
+
+        for ( int j = 0; j < onDemandAnalysis->getNumberOfValuesOfIndependentVariable( 1 ); j++ )
+        {
+            independentVariables[ 1 ] = j;
+
+            for ( int k = 0; k < onDemandAnalysis->getNumberOfValuesOfIndependentVariable( 2 );
+                  k++ )
+            {
+                independentVariables[ 2 ] = k;
+
+                const Vector6d multiThreadedCoefficients
+                        = multiThreadedAnalysis->getAerodynamicCoefficients(
+                            independentVariables );
+                const Vector6d onDemandCoefficients
+                        = onDemandAnalysis->getAerodynamicCoefficients( independentVariables );
+
+                for ( int l = 0; l < 6; l++ )
+                {
+                    BOOST_CHECK_SMALL( multiThreadedCoefficients( l )
+                                       - onDemandCoefficients( l ),
+                                       std::numeric_limits< double >::epsilon( ) );
+                }
+            }
+        }
+    }
+}
+
+//! Test generation of coefficients along trajectory and concurrent on-demand generation.
+BOOST_AUTO_TEST_CASE( testCoefficientGenerationAlongTrajectory )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+    using std::vector;
+    using namespace aerodynamics;
+
+    // Create analysis objects, of which the first generates the complete database, the second
+    // generates coefficients along a trajectory, and the third generates coefficients as they
+    // are requested concurrently.
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > completeAnalysis
+            = createCapsuleAnalysis( );
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > trajectoryAnalysis
+            = createCapsuleAnalysis( );
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > concurrentAnalysis
+            = createCapsuleAnalysis( );
+
+    completeAnalysis->generateCoefficients( );
+
+    // Set trajectory, of which the first two points are in the same grid cell, and the last
+    // point has a Mach number beyond the largest data point.
+    Eigen::MatrixXd trajectory( 3, 3 );
+    trajectory << 6.0, -12.0 * PI / 180.0, 0.5 * PI / 180.0,
+            7.0, -13.0 * PI / 180.0, 0.2 * PI / 180.0,
+            25.0, -12.0 * PI / 180.0, 0.5 * PI / 180.0;
+
+    // Check that coefficients are generated at the corners of two grid cells only, and are not
+    // regenerated.
+    BOOST_CHECK_EQUAL( trajectoryAnalysis->generateCoefficientsAlongTrajectory( trajectory ), 16 );
+    BOOST_CHECK_EQUAL( trajectoryAnalysis->generateCoefficientsAlongTrajectory( trajectory ), 0 );
+
+    boost::array< int, 3 > independentVariables;
+    for ( int i = 0; i < trajectoryAnalysis->getNumberOfValuesOfIndependentVariable( 0 ); i++ )
+    {
+        independentVariables[ 0 ] = i;
+        for ( int j = 0; j < trajectoryAnalysis->getNumberOfValuesOfIndependentVariable( 1 ); j++ )
+        {
+            independentVariables[ 1 ] = j;
+            for ( int k = 0; k < trajectoryAnalysis->getNumberOfValuesOfIndependentVariable( 2 );
+                  k++ )
+            {
+                independentVariables[ 2 ] = k;
+
+                // Mach number points 2 to 5, and angle of attack points 3 and 4 bound the
+                // trajectory; both angle of sideslip points are used.
+                const bool isInTrajectoryCell = ( i >= 2 && i <= 5 ) && ( j == 3 || j == 4 );
+                BOOST_CHECK_EQUAL( trajectoryAnalysis->isCoefficientGenerated(
+                                       independentVariables ), isInTrajectoryCell );
+
+                if ( isInTrajectoryCell )
+                {
+                    const Vector6d trajectoryCoefficients
+                            = trajectoryAnalysis->getAerodynamicCoefficients(
+                                independentVariables );
+                    const Vector6d completeCoefficients
+                            = completeAnalysis->getAerodynamicCoefficients(
+                                independentVariables );
+                    for ( int l = 0; l < 6; l++ )
+                    {
+                        BOOST_CHECK_SMALL( trajectoryCoefficients( l )
+                                           - completeCoefficients( l ),
+                                           std::numeric_limits< double >::epsilon( ) );
+                    }
+                }
+            }
+        }
+    }
+
+    // Retrieve all coefficients concurrently from multiple threads, which all request the same
+    // coefficients in the same order.
+    const unsigned int numberOfThreads = 4;
+    vector< Eigen::MatrixXd > concurrentCoefficients( numberOfThreads );
+    boost::thread_group threads;
+    for ( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        threads.create_thread( boost::bind( &retrieveAllAerodynamicCoefficients,
+                                            boost::ref( *concurrentAnalysis ),
+                                            boost::ref( concurrentCoefficients[ i ] ) ) );
+    }
+    threads.join_all( );
+
+    Eigen::MatrixXd completeCoefficients;
+    retrieveAllAerodynamicCoefficients( *completeAnalysis, completeCoefficients );
+    for ( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        BOOST_CHECK_SMALL( ( concurrentCoefficients[ i ] - completeCoefficients )
+                           .cwiseAbs( ).maxCoeff( ),
+                           std::numeric_limits< double >::epsilon( ) );
+    }
+}
+
+//! Test saving and loading of coefficients to and from cache file.
+BOOST_AUTO_TEST_CASE( testCoefficientCacheFile )
+{
+    using std::vector;
+    using namespace aerodynamics;
+
+    // Set number of analysis points.
+    const vector< double > angleOfAttackPoints
+            = getDefaultHypersonicLocalInclinationAngleOfAttackPoints( );
+    const vector< int > numberOfLines( 4, 11 );
+    const vector< int > numberOfPoints( 4, 11 );
+
+    // Set name of cache file, and remove file if present from a previous run.
+    const std::string cacheFileName = input_output::getTudatRootPath( )
+            + "Astrodynamics/Aerodynamics/UnitTests/coefficientCacheFileTest.bin";
+    boost::filesystem::remove( cacheFileName );
+
+    // Generate coefficients, which are saved to the cache file since it does not exist.
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > generatedAnalysis
+            = createCapsuleAnalysis( angleOfAttackPoints );
+    BOOST_CHECK( !generatedAnalysis->loadOrGenerateCoefficients( cacheFileName ) );
+    BOOST_CHECK( boost::filesystem::exists( cacheFileName ) );
+
+    // Load coefficients for analysis with the same settings, and check that they are identical
+    // to the generated coefficients.
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > loadedAnalysis
+            = createCapsuleAnalysis( angleOfAttackPoints );
+    BOOST_CHECK( loadedAnalysis->loadOrGenerateCoefficients( cacheFileName ) );
+
+    boost::array< int, 3 > independentVariables = { { 5, 7, 1 } };
+    BOOST_CHECK( loadedAnalysis->isCoefficientGenerated( independentVariables ) );
+
+    Eigen::MatrixXd generatedCoefficients;
+    Eigen::MatrixXd loadedCoefficients;
+    retrieveAllAerodynamicCoefficients( *generatedAnalysis, generatedCoefficients );
+    retrieveAllAerodynamicCoefficients( *loadedAnalysis, loadedCoefficients );
+    BOOST_CHECK_EQUAL( ( loadedCoefficients - generatedCoefficients ).cwiseAbs( ).maxCoeff( ),
+                       0.0 );
+
+    // Check that cache file is not loaded for analyses with different reference length or
+    // methods.
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > otherReferenceLengthAnalysis
+            = createCapsuleAnalysis( angleOfAttackPoints, numberOfLines, numberOfPoints, 3.0 );
+    BOOST_CHECK( !otherReferenceLengthAnalysis->loadCoefficients( cacheFileName ) );
+    BOOST_CHECK( !otherReferenceLengthAnalysis->isCoefficientGenerated( independentVariables ) );
+
+    vector< vector< int > > selectedMethods = getCapsuleSelectedMethods( );
+    selectedMethods[ 1 ][ 0 ] = 3;
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > otherMethodsAnalysis
+            = createCapsuleAnalysis( angleOfAttackPoints, numberOfLines, numberOfPoints, 3.9116,
+                                     selectedMethods );
+    BOOST_CHECK( !otherMethodsAnalysis->loadCoefficients( cacheFileName ) );
+
+    // Check that cache file is not loaded for analyses with a different grid of the same size,
+    // or with a different panelling of the vehicle.
+    vector< double > otherAngleOfAttackPoints = angleOfAttackPoints;
+    otherAngleOfAttackPoints[ 0 ] += 1.0E-10;
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > otherGridAnalysis
+            = createCapsuleAnalysis( otherAngleOfAttackPoints );
+    BOOST_CHECK( !otherGridAnalysis->loadCoefficients( cacheFileName ) );
+
+    boost::shared_ptr< HypersonicLocalInclinationAnalysis > otherGeometryAnalysis
+            = createCapsuleAnalysis( angleOfAttackPoints, vector< int >( 4, 12 ),
+                                     numberOfPoints );
+    BOOST_CHECK( !otherGeometryAnalysis->loadCoefficients( cacheFileName ) );
+
+    // Check that coefficients cannot be saved before they have been generated.
+    BOOST_CHECK_THROW( otherMethodsAnalysis->saveCoefficients( cacheFileName ),
+                       std::runtime_error );
+
+    boost::filesystem::remove( cacheFileName );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -32,6 +32,8 @@
  *  	120618    A. Ronse          Boostified unit test
  *      120627    P. Musegaas       Changed scope of some variable + minor corrections, removed
  *                                  superfluous test.
+ *      261016    agent             Added test of simultaneous density, pressure and temperature
+ *                                  function.
  *
  *    References
  *      Introduction to Flight, Fifth edition, Appendix A, John D. Anderson Jr., McGraw Hill, 2005.
@@ -206,6 +208,33 @@ BOOST_AUTO_TEST_CASE( testTabulatedAtmospherePositionIndependentFunctions)
     BOOST_CHECK_EQUAL( temperature1, temperature2 );
 }
 
+//! Test if the simultaneous density, pressure and temperature function works.
+BOOST_AUTO_TEST_CASE( testTabulatedAtmosphereDensityPressureAndTemperature )
+{
+    // Create a tabulated atmosphere object.
+    aerodynamics::TabulatedAtmosphere tabulatedAtmosphere;
+
+    // Initialize atmosphere with the desired file.
+    tabulatedAtmosphere.initialize( input_output::getTudatRootPath( ) +
+                                    "/External/AtmosphereTables/" +
+                                    "USSA1976Until100kmPer100mUntil1000kmPer1000m.dat" );
+
+    // Check results at a number of altitudes against separate functions.
+    const double altitudes[ ] = { 0.0, 10.5e3, 86.0e3, 250.0e3, 1000.0e3 };
+    for ( unsigned int i = 0; i < sizeof( altitudes ) / sizeof( altitudes[ 0 ] ); i++ )
+    {
+        const Eigen::Vector3d densityPressureAndTemperature =
+                tabulatedAtmosphere.getDensityPressureAndTemperature( altitudes[ i ] );
+
+        BOOST_CHECK_EQUAL( densityPressureAndTemperature( 0 ),
+                           tabulatedAtmosphere.getDensity( altitudes[ i ] ) );
+        BOOST_CHECK_EQUAL( densityPressureAndTemperature( 1 ),
+                           tabulatedAtmosphere.getPressure( altitudes[ i ] ) );
+        BOOST_CHECK_EQUAL( densityPressureAndTemperature( 2 ),
+                           tabulatedAtmosphere.getTemperature( altitudes[ i ] ) );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
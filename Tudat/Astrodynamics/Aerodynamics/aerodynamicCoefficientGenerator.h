@@ -34,11 +34,18 @@
  *      120825    A. Ronse          Changed dataPointsOfIndependentVariables_ to array of doubles.
  *                                  Fixed bug in setMachPoint function.
  *      120912    D. Dirkx          Templatized class, adjusted to meet RAII idiom.
+ *      261016    agent             Added saving and loading of coefficients to and from binary
+ *                                  cache file.
+ *      261016    agent             Replaced hash key of cache file by FNV-1a digest of serialized
+ *                                  analysis settings, which are stored in and compared to the
+ *                                  cache file.
  *
  *    References
  *      Gentry, A., Smyth, D., and Oliver, W. The Mark IV Supersonic-Hypersonic
  *        Arbitrary Body Program, Volume II - Program Formulation, Douglas
  *        Aircraft Company, 1973.
+ *      Fowler, G., Noll, L.C., Vo, K.-P., Eastlake, D. The FNV Non-Cryptographic Hash Algorithm,
+ *        IETF Internet-Draft draft-eastlake-fnv, 2012.
  *
  *    Notes
  *
@@ -47,8 +54,18 @@
 #ifndef TUDAT_AERODYNAMIC_COEFFICIENT_GENERATOR_H
 #define TUDAT_AERODYNAMIC_COEFFICIENT_GENERATOR_H
 
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/multi_array.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -65,6 +82,9 @@ namespace aerodynamics
 /*!
  * Abstract base class for aerodynamic analysis method. Stores independent variable values
  * and data points of independent variables. Coefficients are stored in a multi_array of pointers.
+ * The generated coefficients can be saved to a binary cache file, together with the settings of
+ * the analysis (see serializeAnalysisSettings( )), and loaded in subsequent runs with identical
+ * settings instead of regenerating the coefficients.
  */
 template< int NumberOfIndependentVariables, int NumberOfCoefficients = 6 >
 class AerodynamicCoefficientGenerator
@@ -148,8 +168,233 @@ public:
      */
     virtual void generateCoefficients( ) = 0;
 
+    //! Save aerodynamic coefficients to binary cache file.
+    /*!
+     * Saves the aerodynamic coefficients at all data points to a binary cache file, together with
+     * the file format version, the serialized analysis settings (see serializeAnalysisSettings( ))
+     * and their FNV-1a digest. The coefficients at all data points must have been generated.
+     * Values are written in the native byte order.
+     * \param fileName Name of cache file.
+     * \throws std::runtime_error If the file cannot be written.
+     */
+    virtual void saveCoefficients( const std::string& fileName )
+    {
+        std::vector< char > analysisSettings;
+        serializeAnalysisSettings( analysisSettings );
+
+        std::ofstream cacheFile( fileName.c_str( ), std::ios::binary );
+
+        // Write header, consisting of file identifier, file format version, dimensions of the
+        // database, and digest and size of analysis settings.
+        cacheFile.write( cacheFileIdentifier_, sizeof( cacheFileIdentifier_ ) );
+        const boost::uint32_t header[ 3 ]
+                = { cacheFileVersion_, NumberOfIndependentVariables, NumberOfCoefficients };
+        cacheFile.write( reinterpret_cast< const char* >( header ), sizeof( header ) );
+        const boost::uint64_t settingsHeader[ 2 ]
+                = { computeFnv1aDigest( analysisSettings ), analysisSettings.size( ) };
+        cacheFile.write( reinterpret_cast< const char* >( settingsHeader ),
+                         sizeof( settingsHeader ) );
+
+        // Write analysis settings, followed by coefficients in storage order of the multi_array.
+        cacheFile.write( &analysisSettings[ 0 ], analysisSettings.size( ) );
+        for ( std::size_t i = 0; i < aerodynamicCoefficients_.num_elements( ); i++ )
+        {
+            cacheFile.write( reinterpret_cast< const char* >(
+                                 aerodynamicCoefficients_.data( )[ i ].data( ) ),
+                             NumberOfCoefficients * sizeof( double ) );
+        }
+
+        if ( !cacheFile )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Could not write aerodynamic coefficients to "
+                                                "cache file " + fileName + "." ) ) );
+        }
+    }
+
+    //! Load aerodynamic coefficients from binary cache file.
+    /*!
+     * Loads the aerodynamic coefficients at all data points from a binary cache file written by
+     * saveCoefficients( ), which is memory-mapped for reading. The coefficients are only loaded
+     * if the file exists, its version matches, and the analysis settings stored in the file are
+     * identical to those of this analysis; otherwise, the coefficients are left unchanged. The
+     * digest of the settings is compared first, to reject non-matching files quickly, after which
+     * the complete settings are compared, such that digest collisions cannot cause coefficients
+     * of a different analysis to be loaded.
+     * \param fileName Name of cache file.
+     * \return True if coefficients have been loaded, false otherwise.
+     */
+    virtual bool loadCoefficients( const std::string& fileName )
+    {
+        using namespace boost::interprocess;
+
+        // Map cache file into memory, which fails if the file does not exist or is empty.
+        mapped_region mappedFile;
+        try
+        {
+            file_mapping cacheFile( fileName.c_str( ), read_only );
+            mapped_region( cacheFile, read_only ).swap( mappedFile );
+        }
+        catch ( interprocess_exception& )
+        {
+            return false;
+        }
+
+        const char* fileData = static_cast< const char* >( mappedFile.get_address( ) );
+        const std::size_t fileSize = mappedFile.get_size( );
+
+        // Check header of cache file.
+        const std::size_t headerSize = sizeof( cacheFileIdentifier_ )
+                + 3 * sizeof( boost::uint32_t ) + 2 * sizeof( boost::uint64_t );
+        if ( fileSize < headerSize
+             || std::memcmp( fileData, cacheFileIdentifier_, sizeof( cacheFileIdentifier_ ) ) )
+        {
+            return false;
+        }
+        std::size_t offset = sizeof( cacheFileIdentifier_ );
+
+        boost::uint32_t header[ 3 ];
+        std::memcpy( header, fileData + offset, sizeof( header ) );
+        offset += sizeof( header );
+        boost::uint64_t settingsHeader[ 2 ];
+        std::memcpy( settingsHeader, fileData + offset, sizeof( settingsHeader ) );
+        offset += sizeof( settingsHeader );
+        if ( header[ 0 ] != cacheFileVersion_
+             || header[ 1 ] != static_cast< boost::uint32_t >( NumberOfIndependentVariables )
+             || header[ 2 ] != static_cast< boost::uint32_t >( NumberOfCoefficients ) )
+        {
+            return false;
+        }
+
+        // Check digest and size of analysis settings, and size of cache file.
+        std::vector< char > analysisSettings;
+        serializeAnalysisSettings( analysisSettings );
+        if ( settingsHeader[ 0 ] != computeFnv1aDigest( analysisSettings )
+             || settingsHeader[ 1 ] != analysisSettings.size( )
+             || fileSize != headerSize + analysisSettings.size( )
+             + aerodynamicCoefficients_.num_elements( ) * NumberOfCoefficients
+             * sizeof( double ) )
+        {
+            return false;
+        }
+
+        // Check complete analysis settings, including data points of independent variables.
+        if ( std::memcmp( fileData + offset, &analysisSettings[ 0 ], analysisSettings.size( ) ) )
+        {
+            return false;
+        }
+        offset += analysisSettings.size( );
+
+        // Copy coefficients from mapped file.
+        for ( std::size_t i = 0; i < aerodynamicCoefficients_.num_elements( ); i++ )
+        {
+            std::memcpy( aerodynamicCoefficients_.data( )[ i ].data( ), fileData + offset,
+                         NumberOfCoefficients * sizeof( double ) );
+            offset += NumberOfCoefficients * sizeof( double );
+        }
+
+        return true;
+    }
+
+    //! Load aerodynamic coefficients from cache file, or generate and save them.
+    /*!
+     * Loads the aerodynamic coefficients from a binary cache file (see loadCoefficients( )). If
+     * the file does not exist or does not match this analysis, the coefficients are generated
+     * and saved to the cache file, overwriting any existing file.
+     * \param fileName Name of cache file.
+     * \return True if coefficients have been loaded, false if they have been generated.
+     */
+    bool loadOrGenerateCoefficients( const std::string& fileName )
+    {
+        if ( loadCoefficients( fileName ) )
+        {
+            return true;
+        }
+
+        generateCoefficients( );
+        saveCoefficients( fileName );
+        return false;
+    }
+
 protected:
 
+    //! Serialize analysis settings.
+    /*!
+     * Appends the settings of the analysis that determine the coefficients to a byte sequence,
+     * which is stored in and compared to cache files of the aerodynamic coefficients. The base
+     * class serializes the data points of the independent variables and the reference
+     * quantities. Derived classes should call this function, and append the vehicle geometry and
+     * any other settings that influence the coefficients. All values are written as fixed-width
+     * types in the native byte order (see appendToAnalysisSettings( )).
+     * \param analysisSettings Serialized analysis settings (returned by reference).
+     */
+    virtual void serializeAnalysisSettings( std::vector< char >& analysisSettings ) const
+    {
+        for ( int i = 0; i < NumberOfIndependentVariables; i++ )
+        {
+            appendToAnalysisSettings( analysisSettings, static_cast< boost::uint64_t >(
+                                          dataPointsOfIndependentVariables_[ i ].size( ) ) );
+            appendToAnalysisSettings( analysisSettings,
+                                      &dataPointsOfIndependentVariables_[ i ][ 0 ],
+                                      dataPointsOfIndependentVariables_[ i ].size( ) );
+        }
+        appendToAnalysisSettings( analysisSettings, referenceArea_ );
+        appendToAnalysisSettings( analysisSettings, referenceLength_ );
+        appendToAnalysisSettings( analysisSettings, momentReferencePoint_.data( ), 3 );
+    }
+
+    //! Append values to serialized analysis settings.
+    /*!
+     * Appends the bytes of an array of values to serialized analysis settings.
+     * \tparam ValueType Type of values, which should be a fixed-width integer type or double.
+     * \param analysisSettings Serialized analysis settings (returned by reference).
+     * \param values Pointer to first value.
+     * \param numberOfValues Number of values to append.
+     */
+    template< typename ValueType >
+    static void appendToAnalysisSettings( std::vector< char >& analysisSettings,
+                                          const ValueType* values,
+                                          const std::size_t numberOfValues )
+    {
+        const char* bytes = reinterpret_cast< const char* >( values );
+        analysisSettings.insert( analysisSettings.end( ), bytes,
+                                 bytes + numberOfValues * sizeof( ValueType ) );
+    }
+
+    //! Append value to serialized analysis settings.
+    /*!
+     * Appends the bytes of a single value to serialized analysis settings.
+     * \tparam ValueType Type of value, which should be a fixed-width integer type or double.
+     * \param analysisSettings Serialized analysis settings (returned by reference).
+     * \param value Value to append.
+     */
+    template< typename ValueType >
+    static void appendToAnalysisSettings( std::vector< char >& analysisSettings,
+                                          const ValueType value )
+    {
+        appendToAnalysisSettings( analysisSettings, &value, 1 );
+    }
+
+    //! Compute FNV-1a digest of byte sequence.
+    /*!
+     * Computes the 64-bit FNV-1a digest of a byte sequence (Fowler et al., 2012). Unlike
+     * boost::hash, the digest is defined by the algorithm only, and is therefore equal for all
+     * compilers and library versions.
+     * \param bytes Byte sequence.
+     * \return FNV-1a digest of byte sequence.
+     */
+    static boost::uint64_t computeFnv1aDigest( const std::vector< char >& bytes )
+    {
+        boost::uint64_t digest = UINT64_C( 14695981039346656037 );
+        for ( std::size_t i = 0; i < bytes.size( ); i++ )
+        {
+            digest ^= static_cast< unsigned char >( bytes[ i ] );
+            digest *= UINT64_C( 1099511628211 );
+        }
+        return digest;
+    }
+
     //! List of pointers to VectorXds containing coefficients.
     /*!
      * List of pointers to VectorXds containing coefficients.
@@ -180,8 +425,26 @@ protected:
      * Point w.r.t. which the arm of the moment on a vehicle panel is determined.
      */
     Eigen::Vector3d momentReferencePoint_;
+
+private:
+
+    //! Identifier at start of cache file.
+    static const char cacheFileIdentifier_[ 8 ];
+
+    //! Version of format of cache file.
+    static const boost::uint32_t cacheFileVersion_ = 1;
 };
 
+//! Identifier at start of cache file.
+template< int NumberOfIndependentVariables, int NumberOfCoefficients >
+const char AerodynamicCoefficientGenerator< NumberOfIndependentVariables, NumberOfCoefficients >::
+cacheFileIdentifier_[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'A', 'C', 'D' };
+
+//! Version of format of cache file.
+template< int NumberOfIndependentVariables, int NumberOfCoefficients >
+const boost::uint32_t AerodynamicCoefficientGenerator< NumberOfIndependentVariables,
+NumberOfCoefficients >::cacheFileVersion_;
+
 } // namespace aerodynamics
 } // namespace tudat
 
@@ -34,6 +34,17 @@
  *      121009    A. Ronse          Adjusted inclination-determination to surface-outward normals.
  *                                  Limited inclination computations to 1 per aoa and aos pair.
  *                                  Streamlined initialization of isCoefficientGenerated_.
+ *      261016    agent             Parallelized coefficient generation over angle of attack and
+ *                                  sideslip pairs, using per-thread panel inclinations and
+ *                                  pressure coefficients. Fixed reuse of stored inclinations for
+ *                                  vehicles with multiple parts.
+ *      261016    agent             Changed panel loops to array operations on flat panel
+ *                                  properties, with vectorized (modified) Newtonian methods.
+ *      261016    agent             Made on-demand coefficient generation thread-safe, and added
+ *                                  generation of coefficients along a nominal trajectory.
+ *      261016    agent             Added saving and loading of coefficients to and from binary
+ *                                  cache file.
+ *      261016    agent             Replaced key of cache files by serialized analysis settings.
  *
  *    References
  *      Gentry, A., Smyth, D., and Oliver, W. . The Mark IV Supersonic-Hypersonic Arbitrary Body
@@ -43,14 +54,20 @@
  *
  */
 
+#include <algorithm>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
 #include <boost/function.hpp>
-#include <boost/lambda/lambda.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/pointer_cast.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/locks.hpp>
 
 #include <Eigen/Geometry>
 
@@ -58,6 +75,7 @@
 
 #include "Tudat/Astrodynamics/Aerodynamics/aerodynamics.h"
 #include "Tudat/Astrodynamics/Aerodynamics/hypersonicLocalInclinationAnalysis.h"
+#include "Tudat/Mathematics/BasicMathematics/nearestNeighbourSearch.h"
 #include "Tudat/Mathematics/GeometricShapes/compositeSurfaceGeometry.h"
 #include "Tudat/Mathematics/GeometricShapes/surfaceGeometry.h"
 
@@ -161,10 +179,11 @@ HypersonicLocalInclinationAnalysis::HypersonicLocalInclinationAnalysis(
         const std::string& machRegime )
     : AerodynamicCoefficientGenerator< 3, 6 >(
           dataPointsOfIndependentVariables, referenceArea, referenceLength, momentReferencePoint ),
-      stagnationPressureCoefficient( 2.0 ),
       ratioOfSpecificHeats( 1.4 ),      // Refer to a constant in "constants file" in the future!
       selectedMethods_( selectedMethods ),
-      machRegime_( machRegime )
+      machRegime_( machRegime ),
+      numberOfThreads_( 1 ),
+      coefficientsMutex_( boost::make_shared< boost::shared_mutex >( ) )
 {
     // Set geometry if it is a single surface.
     if ( boost::dynamic_pointer_cast< SingleSurfaceGeometry > ( inputVehicleSurface ) !=
@@ -234,17 +253,30 @@ HypersonicLocalInclinationAnalysis::HypersonicLocalInclinationAnalysis(
         }
     }
 
-    // Allocate memory for panel inclinations and pressureCoefficient_.
+    // Allocate memory for panel inclinations and pressureCoefficient_, and determine cross
+    // products of moment arms and surface normals of all panels.
     inclination_.resize( vehicleParts_.size( ) );
     pressureCoefficient_.resize( vehicleParts_.size( ) );
+    panelMomentDirections_.resize( vehicleParts_.size( ) );
     for ( unsigned int i = 0 ; i < vehicleParts_.size( ); i++ )
     {
-        inclination_[ i ].resize( vehicleParts_[ i ]->getNumberOfLines( ) );
-        pressureCoefficient_[ i ].resize( vehicleParts_[ i ]->getNumberOfLines( ) );
-        for ( int j = 0 ; j < vehicleParts_[ i ]->getNumberOfLines( ) ; j++ )
+        const int numberOfPanels = vehicleParts_[ i ]->getNumberOfPanels( );
+        inclination_[ i ] = Eigen::VectorXd::Zero( numberOfPanels );
+        pressureCoefficient_[ i ] = Eigen::VectorXd::Zero( numberOfPanels );
+
+        const Eigen::Matrix< double, Eigen::Dynamic, 3 > momentArms
+                = vehicleParts_[ i ]->getPanelCentroids( ).rowwise( )
+                - momentReferencePoint_.transpose( );
+        const Eigen::Matrix< double, Eigen::Dynamic, 3 >& panelSurfaceNormals
+                = vehicleParts_[ i ]->getPanelSurfaceNormals( );
+        panelMomentDirections_[ i ].resize( numberOfPanels, 3 );
+        for ( int j = 0; j < 3; j++ )
         {
-            inclination_[ i ][ j ].resize( vehicleParts_[ i ]->getNumberOfPoints( ) );
-            pressureCoefficient_[ i ][ j ].resize( vehicleParts_[ i ]->getNumberOfPoints( ) );
+            panelMomentDirections_[ i ].col( j )
+                    = momentArms.col( ( j + 1 ) % 3 ).cwiseProduct(
+                        panelSurfaceNormals.col( ( j + 2 ) % 3 ) )
+                    - momentArms.col( ( j + 2 ) % 3 ).cwiseProduct(
+                        panelSurfaceNormals.col( ( j + 1 ) % 3 ) );
         }
     }
 
@@ -264,62 +296,226 @@ HypersonicLocalInclinationAnalysis::HypersonicLocalInclinationAnalysis(
 Vector6d HypersonicLocalInclinationAnalysis::getAerodynamicCoefficients(
         const boost::array< int, 3 > independentVariables )
 {
+    // Retrieve coefficients if they have been generated, which requires shared access only.
+    {
+        boost::shared_lock< boost::shared_mutex > sharedLock( *coefficientsMutex_ );
+        if ( isCoefficientGenerated_( independentVariables ) != 0 )
+        {
+            return aerodynamicCoefficients_( independentVariables );
+        }
+    }
+
+    // Otherwise, generate coefficients with exclusive access, unless another thread has
+    // generated them in the meantime.
+    boost::unique_lock< boost::shared_mutex > exclusiveLock( *coefficientsMutex_ );
     if( isCoefficientGenerated_( independentVariables ) == 0 )
     {
         determineVehicleCoefficients( independentVariables );
     }
+
     // Return requested coefficients.
     return aerodynamicCoefficients_( independentVariables );
+}
 
+//! Check whether aerodynamic coefficients have been generated.
+bool HypersonicLocalInclinationAnalysis::isCoefficientGenerated(
+        const boost::array< int, 3 > independentVariables )
+{
+    boost::shared_lock< boost::shared_mutex > sharedLock( *coefficientsMutex_ );
+    return isCoefficientGenerated_( independentVariables ) != 0;
 }
 
-//! Generate aerodynamic database.
-void HypersonicLocalInclinationAnalysis::generateCoefficients( )
+//! Save aerodynamic coefficients to binary cache file.
+void HypersonicLocalInclinationAnalysis::saveCoefficients( const std::string& fileName )
 {
-    // Allocate variable to pass to coefficient determination for independent
-    // variable indices.
-    boost::array< int, 3 > independentVariableIndices;
+    boost::shared_lock< boost::shared_mutex > sharedLock( *coefficientsMutex_ );
+
+    if ( std::find( isCoefficientGenerated_.data( ),
+                    isCoefficientGenerated_.data( ) + isCoefficientGenerated_.num_elements( ),
+                    false )
+         != isCoefficientGenerated_.data( ) + isCoefficientGenerated_.num_elements( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Aerodynamic coefficients must be generated at all "
+                                            "data points before saving them." ) ) );
+    }
+
+    AerodynamicCoefficientGenerator< 3, 6 >::saveCoefficients( fileName );
+}
+
+//! Load aerodynamic coefficients from binary cache file.
+bool HypersonicLocalInclinationAnalysis::loadCoefficients( const std::string& fileName )
+{
+    boost::unique_lock< boost::shared_mutex > exclusiveLock( *coefficientsMutex_ );
+
+    if ( !AerodynamicCoefficientGenerator< 3, 6 >::loadCoefficients( fileName ) )
+    {
+        return false;
+    }
+
+    std::fill( isCoefficientGenerated_.data( ),
+               isCoefficientGenerated_.data( ) + isCoefficientGenerated_.num_elements( ), true );
+    return true;
+}
 
-    // Iterate over all combinations of independent variables.
-    for ( unsigned int i = 0 ; i < dataPointsOfIndependentVariables_[ mach_index ].size( ) ; i++ )
+//! Generate aerodynamic coefficients along trajectory.
+int HypersonicLocalInclinationAnalysis::generateCoefficientsAlongTrajectory(
+        const Eigen::MatrixXd& independentVariableValues )
+{
+    if ( independentVariableValues.cols( ) != 3 )
     {
-        independentVariableIndices[ mach_index ] = i;
-        for ( unsigned  int j = 0 ; j < dataPointsOfIndependentVariables_[
-              angle_of_attack_index ].size( ) ; j++ )
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Values of independent variables must be given as matrix with "
+                            "three columns." ) ) );
+    }
+
+    boost::unique_lock< boost::shared_mutex > exclusiveLock( *coefficientsMutex_ );
+
+    int numberOfGeneratedCoefficients = 0;
+    boost::array< int, 3 > lowerIndices;
+    boost::array< int, 3 > upperIndices;
+    boost::array< int, 3 > independentVariableIndices;
+    for ( int i = 0; i < independentVariableValues.rows( ); i++ )
+    {
+        // Determine indices of data points bounding the values of the independent variables.
+        for ( int j = 0; j < 3; j++ )
         {
-            independentVariableIndices[ angle_of_attack_index ] = j;
-            for ( unsigned  int k = 0 ; k < dataPointsOfIndependentVariables_[
-                  angle_of_sideslip_index ].size( ) ; k++ )
+            lowerIndices[ j ] = basic_mathematics::computeNearestLeftNeighborUsingBinarySearch(
+                        dataPointsOfIndependentVariables_[ j ], independentVariableValues( i, j ) );
+            upperIndices[ j ] = std::min(
+                        lowerIndices[ j ] + 1,
+                        static_cast< int >( dataPointsOfIndependentVariables_[ j ].size( ) ) - 1 );
+        }
+
+        // Generate coefficients at all corners of the cell, if not generated yet.
+        for ( int corner = 0; corner < 8; corner++ )
+        {
+            for ( int j = 0; j < 3; j++ )
             {
-                independentVariableIndices[ angle_of_sideslip_index ] = k;
+                independentVariableIndices[ j ]
+                        = ( corner & ( 1 << j ) ) ? upperIndices[ j ] : lowerIndices[ j ];
+            }
 
+            if ( isCoefficientGenerated_( independentVariableIndices ) == 0 )
+            {
                 determineVehicleCoefficients( independentVariableIndices );
+                numberOfGeneratedCoefficients++;
             }
         }
     }
+
+    return numberOfGeneratedCoefficients;
 }
 
-//! Generate aerodynamic coefficients at a single set of independent variables.
-void HypersonicLocalInclinationAnalysis::determineVehicleCoefficients(
-        const boost::array< int, 3 > independentVariableIndices )
+//! Generate aerodynamic database.
+void HypersonicLocalInclinationAnalysis::generateCoefficients( )
 {
-    // Declare coefficients vector and initialize to zeros.
-    Vector6d coefficients = Vector6d::Zero( );
+    // Lock coefficients for exclusive access; the threads started below do not lock.
+    boost::unique_lock< boost::shared_mutex > exclusiveLock( *coefficientsMutex_ );
 
-    // Loop over all vehicle parts, calculate aerodynamic coefficients and add
-    // to aerodynamicCoefficients_.
-    for ( unsigned int i = 0 ; i < vehicleParts_.size( ) ; i++ )
+    // Determine the number of pairs of angle of attack and angle of sideslip, and the number of
+    // blocks of pairs, such that each thread handles at least one pair.
+    const int numberOfPairs = dataPointsOfIndependentVariables_[ angle_of_attack_index ].size( )
+            * dataPointsOfIndependentVariables_[ angle_of_sideslip_index ].size( );
+    const int numberOfBlocks = std::max(
+                1, std::min( numberOfPairs, static_cast< int >( numberOfThreads_ ) ) );
+
+    std::vector< boost::exception_ptr > exceptionPointers( numberOfBlocks );
+
+    if ( numberOfBlocks == 1 )
     {
-        coefficients += determinePartCoefficients( i, independentVariableIndices );
+        generateCoefficientsOfBlock( 0, numberOfPairs, exceptionPointers[ 0 ] );
     }
 
-    aerodynamicCoefficients_( independentVariableIndices ) = coefficients;
-    isCoefficientGenerated_( independentVariableIndices ) = 1;
+    else
+    {
+        // Distribute the pairs over the blocks as evenly as possible.
+        boost::thread_group threads;
+        int firstPair = 0;
+        for ( int block = 0; block < numberOfBlocks; block++ )
+        {
+            const int numberOfPairsInBlock = numberOfPairs / numberOfBlocks
+                    + ( block < numberOfPairs % numberOfBlocks ? 1 : 0 );
+
+            threads.create_thread( boost::bind(
+                    &HypersonicLocalInclinationAnalysis::generateCoefficientsOfBlock, this,
+                    firstPair, numberOfPairsInBlock, boost::ref( exceptionPointers[ block ] ) ) );
+
+            firstPair += numberOfPairsInBlock;
+        }
+
+        threads.join_all( );
+    }
+
+    // Rethrow the first exception encountered by any of the blocks.
+    for ( int block = 0; block < numberOfBlocks; block++ )
+    {
+        if ( exceptionPointers[ block ] )
+        {
+            boost::rethrow_exception( exceptionPointers[ block ] );
+        }
+    }
 }
 
-//! Determine aerodynamic coefficients of a single vehicle part.
-Vector6d HypersonicLocalInclinationAnalysis::determinePartCoefficients(
-        const int partNumber, const boost::array< int, 3 > independentVariableIndices )
+//! Generate aerodynamic coefficients for a block of angle of attack and sideslip pairs.
+void HypersonicLocalInclinationAnalysis::generateCoefficientsOfBlock(
+        const int firstPair, const int numberOfPairs, boost::exception_ptr& exceptionPointer )
+{
+    try
+    {
+        // Allocate panel inclinations and pressure coefficients of this block.
+        PanelValues inclinations = inclination_;
+        PanelValues pressureCoefficients = pressureCoefficient_;
+
+        const int numberOfAnglesOfSideslip
+                = dataPointsOfIndependentVariables_[ angle_of_sideslip_index ].size( );
+        boost::array< int, 3 > independentVariableIndices;
+
+        for ( int pair = firstPair; pair < firstPair + numberOfPairs; pair++ )
+        {
+            independentVariableIndices[ angle_of_attack_index ] = pair / numberOfAnglesOfSideslip;
+            independentVariableIndices[ angle_of_sideslip_index ]
+                    = pair % numberOfAnglesOfSideslip;
+
+            const double angleOfAttack = dataPointsOfIndependentVariables_[
+                    angle_of_attack_index ][ independentVariableIndices[ angle_of_attack_index ] ];
+            const double angleOfSideslip = dataPointsOfIndependentVariables_[
+                    angle_of_sideslip_index ][
+                    independentVariableIndices[ angle_of_sideslip_index ] ];
+
+            // Determine panel inclinations of all parts once, as they are independent of the
+            // Mach number.
+            for ( unsigned int i = 0 ; i < vehicleParts_.size( ) ; i++ )
+            {
+                determineInclination( i, angleOfAttack, angleOfSideslip, inclinations );
+            }
+
+            // Determine coefficients at all Mach numbers. Each block sets distinct entries.
+            for ( unsigned int i = 0 ; i < dataPointsOfIndependentVariables_[ mach_index ].size( ) ;
+                  i++ )
+            {
+                independentVariableIndices[ mach_index ] = i;
+
+                aerodynamicCoefficients_( independentVariableIndices )
+                        = determineVehicleCoefficients(
+                            dataPointsOfIndependentVariables_[ mach_index ][ i ], inclinations,
+                            pressureCoefficients );
+                isCoefficientGenerated_( independentVariableIndices ) = 1;
+            }
+        }
+    }
+    catch ( ... )
+    {
+        exceptionPointer = boost::current_exception( );
+    }
+}
+
+//! Generate aerodynamic coefficients at a single set of independent variables.
+void HypersonicLocalInclinationAnalysis::determineVehicleCoefficients(
+        const boost::array< int, 3 > independentVariableIndices )
 {
     // Declare and determine angles of attack and sideslip for analysis.
     double angleOfAttack =  dataPointsOfIndependentVariables_[ angle_of_attack_index ]
@@ -328,15 +524,15 @@ Vector6d HypersonicLocalInclinationAnalysis::determinePartCoefficients(
     double angleOfSideslip =  dataPointsOfIndependentVariables_[ angle_of_sideslip_index ]
             [ independentVariableIndices[ angle_of_sideslip_index ] ];
 
-    // Declare partCoefficient vector.
-    Vector6d partCoefficients = Vector6d::Zero( );
-
-    // Check whether the inclinations of the vehicle part have already been computed.
+    // Check whether the inclinations of the vehicle parts have already been computed.
     if ( previouslyComputedInclinations_.count(  std::pair< double, double >(
             angleOfAttack, angleOfSideslip ) ) == 0 )
     {
-        // Determine panel inclinations for part.
-        determineInclination( partNumber, angleOfAttack, angleOfSideslip );
+        // Determine panel inclinations for all parts.
+        for ( unsigned int i = 0 ; i < vehicleParts_.size( ) ; i++ )
+        {
+            determineInclination( i, angleOfAttack, angleOfSideslip, inclination_ );
+        }
 
         // Add panel inclinations to container
         previouslyComputedInclinations_[ std::pair< double, double >(
@@ -350,98 +546,105 @@ Vector6d HypersonicLocalInclinationAnalysis::determinePartCoefficients(
                 angleOfAttack, angleOfSideslip ) ];
     }
 
-    // Set pressureCoefficient_ array for given independent variables.
-    determinePressureCoefficients( partNumber, independentVariableIndices );
+    aerodynamicCoefficients_( independentVariableIndices ) = determineVehicleCoefficients(
+                dataPointsOfIndependentVariables_[ mach_index ]
+                [ independentVariableIndices[ mach_index ] ],
+                inclination_, pressureCoefficient_ );
+    isCoefficientGenerated_( independentVariableIndices ) = 1;
+}
+
+//! Determine aerodynamic coefficients of the vehicle.
+Vector6d HypersonicLocalInclinationAnalysis::determineVehicleCoefficients(
+        const double machNumber, const PanelValues& inclinations,
+        PanelValues& pressureCoefficients )
+{
+    // Declare coefficients vector and initialize to zeros.
+    Vector6d coefficients = Vector6d::Zero( );
+
+    // Loop over all vehicle parts, calculate aerodynamic coefficients and add
+    // to aerodynamicCoefficients_.
+    for ( unsigned int i = 0 ; i < vehicleParts_.size( ) ; i++ )
+    {
+        coefficients += determinePartCoefficients(
+                    i, machNumber, inclinations, pressureCoefficients );
+    }
+
+    return coefficients;
+}
+
+//! Determine aerodynamic coefficients of a single vehicle part.
+Vector6d HypersonicLocalInclinationAnalysis::determinePartCoefficients(
+        const int partNumber, const double machNumber, const PanelValues& inclinations,
+        PanelValues& pressureCoefficients )
+{
+    // Declare partCoefficient vector.
+    Vector6d partCoefficients = Vector6d::Zero( );
+
+    // Set pressure coefficients for given independent variables.
+    determinePressureCoefficients( partNumber, machNumber, inclinations, pressureCoefficients );
 
     // Calculate force coefficients from pressure coefficients.
-    partCoefficients.segment( 0, 3 ) = calculateForceCoefficients( partNumber );
+    partCoefficients.segment( 0, 3 )
+            = calculateForceCoefficients( partNumber, pressureCoefficients );
 
     // Calculate moment coefficients from pressure coefficients.
-    partCoefficients.segment( 3, 3 ) = calculateMomentCoefficients( partNumber );
+    partCoefficients.segment( 3, 3 )
+            = calculateMomentCoefficients( partNumber, pressureCoefficients );
 
     return partCoefficients;
 }
 
 //! Determine the pressure coefficients on a single vehicle part.
 void HypersonicLocalInclinationAnalysis::determinePressureCoefficients(
-        const int partNumber, const boost::array< int, 3 > independentVariableIndices )
+        const int partNumber, const double machNumber, const PanelValues& inclinations,
+        PanelValues& pressureCoefficients )
 {
-    // Retrieve Mach number.
-    double machNumber = dataPointsOfIndependentVariables_[ mach_index ]
-            [ independentVariableIndices[ mach_index ] ];
-
     // Determine stagnation point pressure coefficients. Value is computed once
     // here to prevent its calculation in inner loop.
-    stagnationPressureCoefficient = computeStagnationPressure(
+    const double stagnationPressureCoefficient = computeStagnationPressure(
                 machNumber, ratioOfSpecificHeats );
 
-    updateCompressionPressures( machNumber, partNumber );
-    updateExpansionPressures( machNumber, partNumber );
+    updateCompressionPressures( machNumber, stagnationPressureCoefficient, partNumber,
+                                inclinations, pressureCoefficients );
+    updateExpansionPressures( machNumber, partNumber, inclinations, pressureCoefficients );
 }
 
 //! Determine force coefficients from pressure coefficients.
 Eigen::Vector3d HypersonicLocalInclinationAnalysis::calculateForceCoefficients(
-        const int partNumber )
+        const int partNumber, const PanelValues& pressureCoefficients )
 {
-    // Declare force coefficient vector and intialize to zeros.
-    Eigen::Vector3d forceCoefficients = Eigen::Vector3d::Zero( );
-    
-    // Loop over all panels and add pressures, scaled by panel area, to force
-    // coefficients.
-    for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
-    {
-        for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++)
-        {
-            forceCoefficients -=
-                    pressureCoefficient_[ partNumber ][ i ][ j ] *
-                    vehicleParts_[ partNumber ]->getPanelArea( i, j ) *
-                    vehicleParts_[ partNumber ]->getPanelSurfaceNormal( i, j );
-        }
-    }
-
-    // Normalize result by reference area.
-    forceCoefficients /= referenceArea_;
-
-    return forceCoefficients;
+    // Sum pressures, scaled by panel area, along outward surface normals of all panels, and
+    // normalize result by reference area.
+    return -( vehicleParts_[ partNumber ]->getPanelSurfaceNormals( ).transpose( )
+              * pressureCoefficients[ partNumber ].cwiseProduct(
+                  vehicleParts_[ partNumber ]->getPanelAreas( ) ) ) / referenceArea_;
 }
 
 //! Determine moment coefficients from pressure coefficients.
 Eigen::Vector3d HypersonicLocalInclinationAnalysis::calculateMomentCoefficients(
-        const int partNumber )
+        const int partNumber, const PanelValues& pressureCoefficients )
 {
-    // Declare moment coefficient vector and intialize to zeros.
-    Eigen::Vector3d momentCoefficients = Eigen::Vector3d::Zero( );
-
-    // Declare moment arm for panel moment determination.
-    Eigen::Vector3d referenceDistance ;
-
-    // Loop over all panels and add moments due pressures.
-    for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
-    {
-        for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
-        {
-            // Determine moment arm for given panel centroid.
-            referenceDistance = ( vehicleParts_[ partNumber ]->
-                                  getPanelCentroid( i, j ) -  momentReferencePoint_ );
-
-            momentCoefficients -=
-                    pressureCoefficient_[ partNumber ][ i ][ j ] *
-                    vehicleParts_[ partNumber ]->getPanelArea( i, j ) *
-                    ( referenceDistance.cross( vehicleParts_[ partNumber ]->
-                                               getPanelSurfaceNormal( i, j ) ) );
-        }
-    }
-
-    // Scale result by reference length and area.
-    momentCoefficients /= ( referenceLength_ * referenceArea_ );
-
-    return momentCoefficients;
+    // Sum moments due to pressures, scaled by panel area, of all panels, and scale result by
+    // reference length and area.
+    return -( panelMomentDirections_[ partNumber ].transpose( )
+              * pressureCoefficients[ partNumber ].cwiseProduct(
+                  vehicleParts_[ partNumber ]->getPanelAreas( ) ) )
+            / ( referenceLength_ * referenceArea_ );
 }
 
 //! Determines the inclination angle of panels on a single part.
 void HypersonicLocalInclinationAnalysis::determineInclination( const int partNumber,
                                                                const double angleOfAttack,
                                                                const double angleOfSideslip )
+{
+    determineInclination( partNumber, angleOfAttack, angleOfSideslip, inclination_ );
+}
+
+//! Determines the inclination angle of panels on a single part, and stores them in container.
+void HypersonicLocalInclinationAnalysis::determineInclination( const int partNumber,
+                                                               const double angleOfAttack,
+                                                               const double angleOfSideslip,
+                                                               PanelValues& inclinations )
 {
     // Declare free-stream velocity vector.
     Eigen::Vector3d freestreamVelocityDirection;
@@ -454,49 +657,38 @@ void HypersonicLocalInclinationAnalysis::determineInclination( const int partNum
     freestreamVelocityDirection( 1 ) = freestreamVelocityDirectionY;
     freestreamVelocityDirection( 2 ) = freestreamVelocityDirectionZ;
 
-    // Declare cosine of inclination angle.
-    double cosineOfInclination;
-
-    // Loop over all panels of given vehicle part and set inclination angles.
-    for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
-    {
-        for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
-        {
-
-            // Determine cosine of inclination angle from inner product between
-            // surface normal and free-stream direction.
-            cosineOfInclination = vehicleParts_[ partNumber ]->
-                    getPanelSurfaceNormal( i, j ).
-                    dot( freestreamVelocityDirection );
-
-            // Set inclination angle.
-            inclination_[ partNumber ][ i ][ j ] = PI / 2.0 - acos( cosineOfInclination );
-        }
-    }
+    // Determine cosines of inclination angles from inner products between surface normals and
+    // free-stream direction, and set inclination angles of all panels of given vehicle part.
+    inclinations[ partNumber ] = ( PI / 2.0 - ( vehicleParts_[ partNumber ]->
+            getPanelSurfaceNormals( ) * freestreamVelocityDirection ).array( ).acos( ) ).matrix( );
 }
 
 //! Determine compression pressure coefficients on all parts.
-void HypersonicLocalInclinationAnalysis::updateCompressionPressures( const double machNumber,
-                                                                     const int partNumber )
-{ 
+void HypersonicLocalInclinationAnalysis::updateCompressionPressures(
+        const double machNumber, const double stagnationPressureCoefficient,
+        const int partNumber, const PanelValues& inclinations, PanelValues& pressureCoefficients )
+{
     int method = selectedMethods_[ 0 ][ partNumber ];
 
+    // For the Newtonian and modified Newtonian methods, the pressure coefficient is
+    // proportional to the squared sine of the inclination, which is evaluated for all panels
+    // at once.
+    if ( method == 0 || method == 1 )
+    {
+        const double maximumPressureCoefficient
+                = ( method == 0 ) ? 2.0 : stagnationPressureCoefficient;
+        pressureCoefficients[ partNumber ] = ( inclinations[ partNumber ].array( ) > 0.0 ).select(
+                    maximumPressureCoefficient
+                    * inclinations[ partNumber ].array( ).sin( ).square( ),
+                    pressureCoefficients[ partNumber ].array( ) ).matrix( );
+        return;
+    }
+
     boost::function< double( double ) > pressureFunction;
 
     // Switch to analyze part using correct method.
     switch( method )
     {
-    case 0:
-        pressureFunction =
-                boost::bind( aerodynamics::computeNewtonianPressureCoefficient, _1 );
-        break;
-
-    case 1:
-        pressureFunction =
-                boost::bind( aerodynamics::computeModifiedNewtonianPressureCoefficient, _1,
-                                        stagnationPressureCoefficient );
-        break;
-
     case 2:
         // Method currently disabled.
         break;
@@ -545,62 +737,49 @@ void HypersonicLocalInclinationAnalysis::updateCompressionPressures( const doubl
         break;
     }
 
-    for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1; i++ )
+    for ( int i = 0 ; i < inclinations[ partNumber ].rows( ) ; i++ )
     {
-        for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
+        if ( inclinations[ partNumber ]( i ) > 0 )
         {
-            if ( inclination_[ partNumber ][ i ][ j ] > 0 )
-            {
-                // If panel inclination is positive, calculate pressure coefficient.
-                pressureCoefficient_[ partNumber ][ i ][ j ] =
-                        pressureFunction( inclination_[ partNumber ][ i ][ j ] );
-            }
+            // If panel inclination is positive, calculate pressure coefficient.
+            pressureCoefficients[ partNumber ]( i ) =
+                    pressureFunction( inclinations[ partNumber ]( i ) );
         }
     }
 }
 
 //! Determines expansion pressure coefficients on all parts.
-void HypersonicLocalInclinationAnalysis::updateExpansionPressures( const double machNumber,
-                                                                   const int partNumber )
+void HypersonicLocalInclinationAnalysis::updateExpansionPressures(
+        const double machNumber, const int partNumber, const PanelValues& inclinations,
+        PanelValues& pressureCoefficients )
 {
     // Get analysis method of part to analyze.
     int method = selectedMethods_[ 1 ][ partNumber ];
 
     if ( method == 0 || method == 1 || method == 4 )
     {
-        boost::function< double( ) > pressureFunction;
+        // Determine pressure coefficient, which is independent of the panel inclination.
+        double pressureCoefficient = 0.0;
         switch( method )
         {
         case 0:
-            pressureFunction = boost::bind( &aerodynamics::computeVacuumPressureCoefficient,
-                                            machNumber, ratioOfSpecificHeats );
+            pressureCoefficient = aerodynamics::computeVacuumPressureCoefficient(
+                        machNumber, ratioOfSpecificHeats );
             break;
 
         case 1:
-            pressureFunction = boost::lambda::constant( 0.0 );
+            pressureCoefficient = 0.0;
             break;
 
         case 4:
-            pressureFunction = boost::bind( &aerodynamics::computeHighMachBasePressure,
-                                            machNumber );
+            pressureCoefficient = aerodynamics::computeHighMachBasePressure( machNumber );
             break;
 
         }
 
-        // Iterate over all panels on part.
-        for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
-        {
-            for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
-            {
-                if ( inclination_[ partNumber ][ i ][ j ] <= 0 )
-                {
-                    // If panel inclination is negative, calculate pressure using
-                    // Van Dyke unified method.
-                    pressureCoefficient_[ partNumber ][ i ][ j ] =
-                            pressureFunction( );
-                }
-            }
-        }
+        // Set pressure coefficient of all panels on part with negative inclination.
+        pressureCoefficients[ partNumber ] = ( inclinations[ partNumber ].array( ) <= 0.0 ).select(
+                    pressureCoefficient, pressureCoefficients[ partNumber ].array( ) ).matrix( );
     }
 
     else if( method == 3 || method == 5 || method == 6 )
@@ -637,17 +816,14 @@ void HypersonicLocalInclinationAnalysis::updateExpansionPressures( const double
         }
 
         // Iterate over all panels on part.
-        for ( int i = 0 ; i < vehicleParts_[ partNumber ]->getNumberOfLines( ) - 1 ; i++ )
+        for ( int i = 0 ; i < inclinations[ partNumber ].rows( ) ; i++ )
         {
-            for ( int j = 0 ; j < vehicleParts_[ partNumber ]->getNumberOfPoints( ) - 1 ; j++ )
+            if ( inclinations[ partNumber ]( i ) <= 0 )
             {
-                if ( inclination_[ partNumber ][ i ][ j ] <= 0 )
-                {
-                    // If panel inclination is negative, calculate pressure using
-                    // Van Dyke unified method.
-                    pressureCoefficient_[ partNumber ][ i ][ j ] =
-                            pressureFunction( inclination_[ partNumber ][ i ][ j ] );
-                }
+                // If panel inclination is negative, calculate pressure using
+                // Van Dyke unified method.
+                pressureCoefficients[ partNumber ]( i ) =
+                        pressureFunction( inclinations[ partNumber ]( i ) );
             }
         }
     }
@@ -659,6 +835,50 @@ void HypersonicLocalInclinationAnalysis::updateExpansionPressures( const double
     }
 }
 
+//! Serialize analysis settings.
+void HypersonicLocalInclinationAnalysis::serializeAnalysisSettings(
+        std::vector< char >& analysisSettings ) const
+{
+    AerodynamicCoefficientGenerator< 3, 6 >::serializeAnalysisSettings( analysisSettings );
+
+    // Append panels of all parts, which also captures the numbers of lines and points and the
+    // ordering of the meshes.
+    appendToAnalysisSettings( analysisSettings,
+                              static_cast< boost::uint64_t >( vehicleParts_.size( ) ) );
+    for ( unsigned int i = 0; i < vehicleParts_.size( ); i++ )
+    {
+        const Eigen::VectorXd& panelAreas = vehicleParts_[ i ]->getPanelAreas( );
+        const Eigen::Matrix< double, Eigen::Dynamic, 3 >& panelCentroids
+                = vehicleParts_[ i ]->getPanelCentroids( );
+        const Eigen::Matrix< double, Eigen::Dynamic, 3 >& panelSurfaceNormals
+                = vehicleParts_[ i ]->getPanelSurfaceNormals( );
+
+        appendToAnalysisSettings( analysisSettings,
+                                  static_cast< boost::uint64_t >( panelAreas.rows( ) ) );
+        appendToAnalysisSettings( analysisSettings, panelAreas.data( ), panelAreas.size( ) );
+        appendToAnalysisSettings( analysisSettings, panelCentroids.data( ),
+                                  panelCentroids.size( ) );
+        appendToAnalysisSettings( analysisSettings, panelSurfaceNormals.data( ),
+                                  panelSurfaceNormals.size( ) );
+    }
+
+    // Append settings of analysis methods.
+    for ( unsigned int i = 0; i < selectedMethods_.size( ); i++ )
+    {
+        appendToAnalysisSettings( analysisSettings,
+                                  static_cast< boost::uint64_t >( selectedMethods_[ i ].size( ) ) );
+        for ( unsigned int j = 0; j < selectedMethods_[ i ].size( ); j++ )
+        {
+            appendToAnalysisSettings( analysisSettings,
+                                      static_cast< boost::int32_t >( selectedMethods_[ i ][ j ] ) );
+        }
+    }
+    appendToAnalysisSettings( analysisSettings,
+                              static_cast< boost::uint64_t >( machRegime_.size( ) ) );
+    appendToAnalysisSettings( analysisSettings, machRegime_.data( ), machRegime_.size( ) );
+    appendToAnalysisSettings( analysisSettings, ratioOfSpecificHeats );
+}
+
 //! Overload ostream to print class information.
 std::ostream& operator<<( std::ostream& stream,
                           HypersonicLocalInclinationAnalysis& hypersonicLocalInclinationAnalysis )
@@ -36,6 +36,15 @@
  *                                  Streamlined initialization of isCoefficientGenerated_.
  *      130120    K. Kumar          Added shared pointer to HypersonicLocalInclinationAnalysis
  *                                  object.
+ *      261016    agent             Parallelized coefficient generation over angle of attack and
+ *                                  sideslip pairs, using per-thread panel inclinations and
+ *                                  pressure coefficients.
+ *      261016    agent             Changed panel inclinations and pressure coefficients to flat
+ *                                  arrays per part, for vectorized pressure integration.
+ *      261016    agent             Made on-demand coefficient generation thread-safe, and added
+ *                                  generation of coefficients along a nominal trajectory.
+ *      261016    agent             Added key of vehicle geometry and methods for cache files.
+ *      261016    agent             Replaced key of cache files by serialized analysis settings.
  *
  *    References
  *      Gentry, A., Smyth, D., and Oliver, W. The Mark IV Supersonic-Hypersonic Arbitrary Body
@@ -56,8 +65,10 @@
 #include <vector>
 
 #include <boost/array.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/multi_array.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/shared_mutex.hpp>
 
 #include <Eigen/Core>
 
@@ -99,7 +110,10 @@ std::vector< double > getDefaultHypersonicLocalInclinationAngleOfSideslipPoints(
  * as needed basis by using the getAerodynamicCoefficients function. Note that during the
  * panel inclination determination process, a geometry with outward surface-normals is assumed.
  * The resulting coefficients are expressed in the same reference frame as that of the input
- * geometry.
+ * geometry. When generating the complete database, the pairs of angle of attack and angle of
+ * sideslip can be distributed over multiple threads (see setNumberOfThreads( )). Alternatively,
+ * coefficients are generated and stored as they are requested, in which case only the part of
+ * the database visited by a trajectory is generated. Requesting coefficients is thread-safe.
  */
 class HypersonicLocalInclinationAnalysis: public AerodynamicCoefficientGenerator< 3, 6 >
 {
@@ -136,7 +150,10 @@ public:
 
     //! Get aerodynamic coefficients.
     /*!
-     * Returns aerodynamic coefficients.
+     * Returns aerodynamic coefficients. If the coefficients at the requested indices have not
+     * been generated yet, they are generated and stored for subsequent requests. This function
+     * may be called concurrently from multiple threads: coefficients that have been generated
+     * are retrieved concurrently, whereas coefficients are generated by one thread at a time.
      * \param independentVariables Array of values of independent variable
      *          indices in dataPointsOfIndependentVariables_.
      * \return vector of coefficients at specified independent variable indices.
@@ -144,14 +161,85 @@ public:
     basic_mathematics::Vector6d getAerodynamicCoefficients(
             const boost::array< int, 3 > independentVariables );
 
+    //! Check whether aerodynamic coefficients have been generated.
+    /*!
+     * Checks whether the aerodynamic coefficients at the given indices have been generated, either
+     * by generateCoefficients( ), generateCoefficientsAlongTrajectory( ) or
+     * getAerodynamicCoefficients( ).
+     * \param independentVariables Array of values of independent variable
+     *          indices in dataPointsOfIndependentVariables_.
+     * \return True if coefficients have been generated, false otherwise.
+     */
+    bool isCoefficientGenerated( const boost::array< int, 3 > independentVariables );
+
+    //! Generate aerodynamic coefficients along trajectory.
+    /*!
+     * Generates aerodynamic coefficients at all data points that are required to interpolate the
+     * coefficients at the given values of the independent variables, typically taken from a
+     * nominal trajectory. For each set of values, these are the data points of the grid cell
+     * containing the values (up to eight data points). Values outside the range of data points
+     * are assigned to the nearest cell. Coefficients that have been generated already are not
+     * regenerated.
+     * \param independentVariableValues Matrix with values of Mach number, angle of attack and
+     *          angle of sideslip as rows (N x 3).
+     * \return Number of data points at which coefficients have been generated.
+     * \throws std::runtime_error If the matrix of values does not have three columns.
+     */
+    int generateCoefficientsAlongTrajectory( const Eigen::MatrixXd& independentVariableValues );
+
     //! Generate aerodynamic database.
     /*!
      * Generates aerodynamic database. Settings of geometry,
      * reference quantities, database point settings and analysis methods
-     *  should have been set previously.
+     *  should have been set previously. The pairs of angle of attack and angle of sideslip are
+     * independent, and are distributed over the number of threads set by setNumberOfThreads( ).
+     * For each pair, the panel inclinations are determined once, after which the coefficients are
+     * determined at all Mach numbers.
      */
     void generateCoefficients( );
 
+    //! Save aerodynamic coefficients to binary cache file.
+    /*!
+     * Saves the aerodynamic coefficients to a binary cache file, see
+     * AerodynamicCoefficientGenerator::saveCoefficients( ).
+     * \param fileName Name of cache file.
+     * \throws std::runtime_error If the coefficients have not been generated at all data points,
+     *          or if the file cannot be written.
+     */
+    void saveCoefficients( const std::string& fileName );
+
+    //! Load aerodynamic coefficients from binary cache file.
+    /*!
+     * Loads the aerodynamic coefficients from a binary cache file, see
+     * AerodynamicCoefficientGenerator::loadCoefficients( ). If loaded, the coefficients at all
+     * data points are marked as generated.
+     * \param fileName Name of cache file.
+     * \return True if coefficients have been loaded, false otherwise.
+     */
+    bool loadCoefficients( const std::string& fileName );
+
+    //! Set number of threads.
+    /*!
+     * Sets the number of threads over which the pairs of angle of attack and angle of sideslip
+     * are distributed when generating the database. The default number of threads is one, in
+     * which case the database is generated in the calling thread.
+     * \param numberOfThreads Number of threads.
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        numberOfThreads_ = numberOfThreads;
+    }
+
+    //! Get number of threads.
+    /*!
+     * Returns the number of threads over which the database generation is distributed.
+     * \return Number of threads.
+     */
+    unsigned int getNumberOfThreads( ) const
+    {
+        return numberOfThreads_;
+    }
+
     //! Determine inclination angles of panels on a given part.
     /*!
      * Determines panel inclinations for all panels on a given part for given attitude.
@@ -208,6 +296,23 @@ public:
 
 private:
 
+    //! Typedef for values of all panels of all parts, with indices indicating part and panel.
+    /*!
+     * Typedef for values of all panels of all parts, stored as one vector per part. The panels
+     * are ordered as in QuadrilateralMeshedSurfaceGeometry::getPanelIndex( ).
+     */
+    typedef std::vector< Eigen::VectorXd > PanelValues;
+
+    //! Serialize analysis settings.
+    /*!
+     * Appends the settings of the analysis that determine the coefficients to a byte sequence,
+     * which is stored in and compared to cache files of the aerodynamic coefficients. Extends
+     * the data points and reference quantities serialized by the base class with the panels of
+     * all vehicle parts, the selected methods, the Mach regime and the ratio of specific heats.
+     * \param analysisSettings Serialized analysis settings (returned by reference).
+     */
+    void serializeAnalysisSettings( std::vector< char >& analysisSettings ) const;
+
     //! Generate aerodynamic coefficients at a single set of independent variables.
     /*!
      * Generates aerodynamic coefficients at a single set of independent variables.
@@ -217,33 +322,83 @@ private:
      */
     void determineVehicleCoefficients( const boost::array< int, 3 > independentVariableIndices );
 
+    //! Generate aerodynamic coefficients for a block of angle of attack and sideslip pairs.
+    /*!
+     * Generates aerodynamic coefficients at all Mach numbers for a contiguous block of pairs of
+     * angle of attack and angle of sideslip, and sets the corresponding entries in
+     * aerodynamicCoefficients_. The pairs are numbered with the angle of sideslip index running
+     * fastest. Panel inclinations and pressure coefficients are stored in variables local to
+     * this function, such that blocks can be generated concurrently. Any exception is caught and
+     * stored, such that it can be rethrown by the calling thread.
+     * \param firstPair Index of first pair of block.
+     * \param numberOfPairs Number of pairs in block.
+     * \param exceptionPointer Pointer to exception thrown while generating the block (returned
+     *          by reference).
+     */
+    void generateCoefficientsOfBlock( const int firstPair, const int numberOfPairs,
+                                      boost::exception_ptr& exceptionPointer );
+
+    //! Determine inclination angles of panels on a given part.
+    /*!
+     * Determines panel inclinations for all panels on a given part for given attitude, and
+     * stores them in the given container. Outward pointing surface-normals are assumed!
+     * \param partNumber Index from vehicleParts_ array for which to determine coefficients.
+     * \param angleOfAttack Angle of attack at which to determine inclination angles.
+     * \param angleOfSideslip Angle of sideslip at which to determine inclination angles.
+     * \param inclinations Panel inclination angles of all parts (returned by reference).
+     */
+    void determineInclination( const int partNumber, const double angleOfAttack,
+                               const double angleOfSideslip, PanelValues& inclinations );
+
+    //! Determine aerodynamic coefficients of the vehicle.
+    /*!
+     * Determines aerodynamic coefficients of the vehicle by summing the coefficients of all
+     * parts, at given Mach number and panel inclinations.
+     * \param machNumber Mach number at which to perform analysis.
+     * \param inclinations Panel inclination angles of all parts.
+     * \param pressureCoefficients Pressure coefficients of all parts, used as work space.
+     * \return Aerodynamic coefficients of the vehicle.
+     */
+    basic_mathematics::Vector6d determineVehicleCoefficients(
+            const double machNumber, const PanelValues& inclinations,
+            PanelValues& pressureCoefficients );
+
     //! Determine aerodynamic coefficients for a single LaWGS part.
     /*!
      * Determines aerodynamic coefficients for a single LaWGS part,
-     * calls determinepressureCoefficient_ function for given vehicle part.
+     * calls determinePressureCoefficients function for given vehicle part.
      * \param partNumber Index from vehicleParts_ array for which to determine coefficients.
-     * \param independentVariableIndices Array of indices of independent variables.
+     * \param machNumber Mach number at which to perform analysis.
+     * \param inclinations Panel inclination angles of all parts.
+     * \param pressureCoefficients Pressure coefficients of all parts, used as work space.
+     * \return Aerodynamic coefficients of part.
      */
     basic_mathematics::Vector6d determinePartCoefficients(
-            const int partNumber, const boost::array< int, 3 > independentVariableIndices );
+            const int partNumber, const double machNumber, const PanelValues& inclinations,
+            PanelValues& pressureCoefficients );
 
     //! Determine pressure coefficients on a given part.
     /*!
      * Determines pressure coefficients on a single vehicle part.
      * Calls the updateExpansionPressures and updateCompressionPressures for given vehicle part.
      * \param partNumber Index from vehicleParts_ array for which to determine coefficients.
-     * \param independentVariableIndices Array of indices of independent variables.
+     * \param machNumber Mach number at which to perform analysis.
+     * \param inclinations Panel inclination angles of all parts.
+     * \param pressureCoefficients Pressure coefficients of all parts (returned by reference).
      */
-    void determinePressureCoefficients( const int partNumber,
-                                        const boost::array< int, 3 > independentVariableIndices );
+    void determinePressureCoefficients( const int partNumber, const double machNumber,
+                                        const PanelValues& inclinations,
+                                        PanelValues& pressureCoefficients );
 
     //! Determine force coefficients of a part.
     /*!
      * Sums the pressure coefficients of given part and determines force coefficients from it by
      * non-dimensionalization with reference area.
      * \param partNumber Index from vehicleParts_ array for which determine coefficients.
+     * \param pressureCoefficients Pressure coefficients of all parts.
      */
-    Eigen::Vector3d calculateForceCoefficients( const int partNumber );
+    Eigen::Vector3d calculateForceCoefficients( const int partNumber,
+                                                const PanelValues& pressureCoefficients );
 
     //! Determine moment coefficients of a part.
     /*!
@@ -251,26 +406,39 @@ private:
      * panels on the part. Moment arms are taken from panel centroid to momentReferencePoint. Non-
      * dimensionalization is performed by product of referenceLength and referenceArea.
      * \param partNumber Index from vehicleParts_ array for which to determine coefficients.
+     * \param pressureCoefficients Pressure coefficients of all parts.
      */
-    Eigen::Vector3d calculateMomentCoefficients( const int partNumber );
+    Eigen::Vector3d calculateMomentCoefficients( const int partNumber,
+                                                 const PanelValues& pressureCoefficients );
 
     //! Determine the compression pressure coefficients of a given part.
     /*!
-     * Sets the values of pressureCoefficient_ on given part and at given Mach number for which
-     * inclination > 0.
+     * Sets the values of the pressure coefficients on given part and at given Mach number for
+     * which inclination > 0.
      * \param machNumber Mach number at which to perform analysis.
+     * \param stagnationPressureCoefficient Stagnation pressure coefficient for flow which has
+     *          passed through a normal shock wave at given Mach number.
      * \param partNumber of part from vehicleParts_ which is to be analyzed.
+     * \param inclinations Panel inclination angles of all parts.
+     * \param pressureCoefficients Pressure coefficients of all parts (returned by reference).
      */
-    void updateCompressionPressures( const double machNumber, const int partNumber );
+    void updateCompressionPressures( const double machNumber,
+                                     const double stagnationPressureCoefficient,
+                                     const int partNumber, const PanelValues& inclinations,
+                                     PanelValues& pressureCoefficients );
 
     //! Determine the expansion pressure coefficients of a given part.
     /*!
-     * Determine the values of pressureCoefficient_ on given part and at given Mach number for
-     * which inclination <= 0.
+     * Determine the values of the pressure coefficients on given part and at given Mach number
+     * for which inclination <= 0.
      * \param machNumber Mach number at which to perform analysis.
      * \param partNumber of part from vehicleParts_ which is to be analyzed.
+     * \param inclinations Panel inclination angles of all parts.
+     * \param pressureCoefficients Pressure coefficients of all parts (returned by reference).
      */
-    void updateExpansionPressures( const double machNumber, const int partNumber );
+    void updateExpansionPressures( const double machNumber, const int partNumber,
+                                   const PanelValues& inclinations,
+                                   PanelValues& pressureCoefficients );
 
     //! Array of vehicle parts.
     /*!
@@ -288,30 +456,32 @@ private:
     //! Three-dimensional array of panel inclination angles.
     /*!
      * Three-dimensional array of panel inclination angles at current values of
-     * independent variables. Indices indicate part-line-point.
+     * independent variables, as used by getAerodynamicCoefficients( ) and determineInclination( ).
+     * Indices indicate part and panel.
      */
-    std::vector< std::vector< std::vector< double > > > inclination_;
+    PanelValues inclination_;
 
     //! Map of angle of attack and -sideslip pair and associated panel inclinations.
     /*!
-     * Map of angle of attack and -sideslip pair and associated panel inclinations.
+     * Map of angle of attack and -sideslip pair and associated panel inclinations of all parts.
      */
-    std::map< std::pair< double, double >, std::vector< std::vector< std::vector< double > > > >
-            previouslyComputedInclinations_;
+    std::map< std::pair< double, double >, PanelValues > previouslyComputedInclinations_;
 
     //! Three-dimensional array of panel pressure coefficients.
     /*!
      * Three-dimensional array of panel pressure coefficients at current values
-     * of independent variables. Indices indicate part-line-point.
+     * of independent variables, as used by getAerodynamicCoefficients( ). Indices indicate
+     * part and panel.
      */
-    std::vector< std::vector< std::vector< double > > > pressureCoefficient_;
+    PanelValues pressureCoefficient_;
 
-    //! Stagnation pressure coefficient.
+    //! Cross products of panel moment arms and outward surface normals.
     /*!
-     * Stagnation pressure coefficient for flow which has passed through a
-     * normal shock wave at current Mach number.
+     * Cross products of the moment arms (from momentReferencePoint_ to the panel centroids) and
+     * the outward surface normals of all panels, as rows, for each part. Multiplied by the panel
+     * pressure force, they give the panel moment contributions.
      */
-    double stagnationPressureCoefficient;
+    std::vector< Eigen::Matrix< double, Eigen::Dynamic, 3 > > panelMomentDirections_;
 
     //! Ratio of specific heats.
     /*!
@@ -331,6 +501,17 @@ private:
      * Mach regime, permissible values are "Full", "High" or "Low", default is "Full".
      */
     std::string machRegime_;
+
+    //! Number of threads over which the database generation is distributed.
+    unsigned int numberOfThreads_;
+
+    //! Mutex for access to generated coefficients.
+    /*!
+     * Mutex for access to generated coefficients, which is locked in shared mode to retrieve
+     * coefficients, and in exclusive mode to generate them. Held by shared pointer, such that
+     * the analysis remains copyable.
+     */
+    boost::shared_ptr< boost::shared_mutex > coefficientsMutex_;
 };
 
 //! Typedef for shared-pointer to HypersonicLocalInclinationAnalysis object.
@@ -27,6 +27,8 @@
  *      110620    F.M. Engelen      File created.
  *      110721    J. Melman         Comments, variable names, and consistency modified.
  *      110722    F.M. Engelen      Removed setRelativePath function.
+ *      261016    agent             Replaced separate cubic spline interpolators by single
+ *                                  multi-channel interpolator.
  *
  *    References
  *
@@ -64,31 +66,22 @@ void TabulatedAtmosphere::initialize( std::string atmosphereTableFile )
         std::cerr << atmosphereTableFile_ << std::endl;
     }
 
-    // Initialize vectors.
+    // Initialize vector.
     altitudeData_.resize( containerOfAtmosphereTableFileData.rows( ) );
-    densityData_.resize( containerOfAtmosphereTableFileData.rows( ) );
-    pressureData_.resize( containerOfAtmosphereTableFileData.rows( ) );
-    temperatureData_.resize( containerOfAtmosphereTableFileData.rows( ) );
 
-    // Loop through all the strings stored in the container and store the data
-    // in the right Eigen::VectorXd.
+    // Loop through all the strings stored in the container and store the altitude data.
     for ( int i = 0; i < containerOfAtmosphereTableFileData.rows( ); i++  )
     {
         altitudeData_[ i ] = containerOfAtmosphereTableFileData( i, 0 );
-        densityData_[ i ] = containerOfAtmosphereTableFileData( i, 1 );
-        pressureData_[ i ] = containerOfAtmosphereTableFileData( i, 2 );
-        temperatureData_[ i ] = containerOfAtmosphereTableFileData( i, 3 );
     }
 
     using namespace interpolators;
 
-    cubicSplineInterpolationForDensity_
-            = boost::make_shared< CubicSplineInterpolatorDouble >( altitudeData_, densityData_ );
-    cubicSplineInterpolationForPressure_
-            = boost::make_shared< CubicSplineInterpolatorDouble >( altitudeData_, pressureData_ );
-    cubicSplineInterpolationForTemperature_
-            = boost::make_shared< CubicSplineInterpolatorDouble >(
-                altitudeData_, temperatureData_ );
+    // Create single interpolator for density, pressure and temperature (columns 1 to 3).
+    cubicSplineInterpolationForAtmosphereProperties_
+            = boost::make_shared< MultiChannelCubicSplineInterpolatorDouble >(
+                altitudeData_, containerOfAtmosphereTableFileData.block(
+                    0, 1, containerOfAtmosphereTableFileData.rows( ), 3 ) );
 }
 
 } // namespace aerodynamics
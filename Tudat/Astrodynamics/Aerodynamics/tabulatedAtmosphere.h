@@ -28,6 +28,9 @@
  *      110721    J. Melman         Comments, file names, and consistency modified.
  *      130120    K. Kumar          Made function calls const-correct; added shared-pointer
  *                                  typedef.
+ *      261016    agent             Replaced separate cubic spline interpolators by single
+ *                                  multi-channel interpolator; added function to get density,
+ *                                  pressure and temperature simultaneously.
  *
  *    References
  *
@@ -50,7 +53,7 @@
 #include <TudatCore/Basics/utilityMacros.h>
 
 #include "Tudat/Astrodynamics/Aerodynamics/atmosphereModel.h"
-#include "Tudat/Mathematics/Interpolators/cubicSplineInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/multiChannelCubicSplineInterpolator.h"
 
 namespace tudat
 {
@@ -113,7 +116,8 @@ public:
         TUDAT_UNUSED_PARAMETER( longitude );
         TUDAT_UNUSED_PARAMETER( latitude );
         TUDAT_UNUSED_PARAMETER( time );
-        return cubicSplineInterpolationForDensity_->interpolate( altitude );
+        return cubicSplineInterpolationForAtmosphereProperties_->interpolateChannel(
+                    altitude, densityChannel );
     }
 
     //! Get local pressure.
@@ -131,7 +135,8 @@ public:
         TUDAT_UNUSED_PARAMETER( longitude );
         TUDAT_UNUSED_PARAMETER( latitude );
         TUDAT_UNUSED_PARAMETER( time );
-        return cubicSplineInterpolationForPressure_->interpolate( altitude );
+        return cubicSplineInterpolationForAtmosphereProperties_->interpolateChannel(
+                    altitude, pressureChannel );
     }
 
     //! Get local temperature.
@@ -149,13 +154,49 @@ public:
         TUDAT_UNUSED_PARAMETER( longitude );
         TUDAT_UNUSED_PARAMETER( latitude );
         TUDAT_UNUSED_PARAMETER( time );
-        return cubicSplineInterpolationForTemperature_->interpolate( altitude );
+        return cubicSplineInterpolationForAtmosphereProperties_->interpolateChannel(
+                    altitude, temperatureChannel );
+    }
+
+    //! Get local density, pressure and temperature.
+    /*!
+     * Returns the local density, pressure and temperature of the atmosphere, in kg per meter^3,
+     * Newton per meter^2 and Kelvin, respectively. The interval in the atmosphere table is looked
+     * up only once, so this function is more efficient than calling the separate functions.
+     * \param altitude Altitude.
+     * \param longitude Longitude.
+     * \param latitude Latitude.
+     * \param time Time.
+     * \return Vector with atmospheric density, pressure and temperature.
+     */
+    Eigen::Vector3d getDensityPressureAndTemperature(
+            const double altitude, const double longitude = 0.0,
+            const double latitude = 0.0, const double time = 0.0 )
+    {
+        TUDAT_UNUSED_PARAMETER( longitude );
+        TUDAT_UNUSED_PARAMETER( latitude );
+        TUDAT_UNUSED_PARAMETER( time );
+        Eigen::Vector3d densityPressureAndTemperature;
+        cubicSplineInterpolationForAtmosphereProperties_->interpolate(
+                    altitude, densityPressureAndTemperature.data( ) );
+        return densityPressureAndTemperature;
     }
 
 protected:
 
 private:
 
+    //! Indices of atmosphere properties in multi-channel interpolator.
+    /*!
+     *  Indices of atmosphere properties in multi-channel interpolator.
+     */
+    enum AtmospherePropertyChannels
+    {
+        densityChannel = 0,
+        pressureChannel = 1,
+        temperatureChannel = 2
+    };
+
     //! The relative directory path.
     /*!
      *  The relative path directory path.
@@ -174,41 +215,13 @@ private:
      */
     std::vector< double > altitudeData_;
 
-    //! Vector containing the density data as a function of the altitude.
-    /*!
-     *  Vector containing the density data as a function of the altitude.
-     */
-    std::vector< double > densityData_;
-
-    //! Vector containing the pressure data as a function of the altitude.
-    /*!
-     *  Vector containing the pressure data as a function of the altitude.
-     */
-    std::vector< double > pressureData_;
-
-    //! Vector containing the temperature data as a function of the altitude.
-    /*!
-     *  Vector containing the temperature data as a function of the altitude.
-     */
-    std::vector< double > temperatureData_;
-
-    //! Cubic spline interpolation for density.
-    /*!
-     *  Cubic spline interpolation for density.
-     */
-    interpolators::CubicSplineInterpolatorDoublePointer cubicSplineInterpolationForDensity_;
-
-    //! Cubic spline interpolation for pressure.
-    /*!
-     *  Cubic spline interpolation for pressure.
-     */
-    interpolators::CubicSplineInterpolatorDoublePointer cubicSplineInterpolationForPressure_;
-
-    //! Cubic spline interpolation for temperature.
+    //! Cubic spline interpolation for density, pressure and temperature.
     /*!
-     *  Cubic spline interpolation for temperature.
+     *  Multi-channel cubic spline interpolation for density, pressure and temperature, which
+     *  shares the interval look-up of the altitude between the three properties.
      */
-    interpolators::CubicSplineInterpolatorDoublePointer cubicSplineInterpolationForTemperature_;
+    interpolators::MultiChannelCubicSplineInterpolatorDoublePointer
+    cubicSplineInterpolationForAtmosphereProperties_;
 };
 
 //! Typedef for shared-pointer to TabulatedAtmosphere object.
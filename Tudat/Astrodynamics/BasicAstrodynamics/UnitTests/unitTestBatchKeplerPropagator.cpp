@@ -0,0 +1,155 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h>
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/batchKeplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_batch_kepler_propagator )
+
+//! Test batch propagation against propagation of individual orbits.
+BOOST_AUTO_TEST_CASE( testBatchKeplerPropagator )
+{
+    using basic_mathematics::mathematical_constants::PI;
+    using basic_astrodynamics::trueAnomalyIndex;
+    using basic_astrodynamics::orbital_element_conversions::convertEccentricAnomalyToMeanAnomaly;
+    using basic_astrodynamics::orbital_element_conversions::convertKeplerianToCartesianElements;
+    using basic_astrodynamics::orbital_element_conversions::convertTrueAnomalyToEccentricAnomaly;
+    using basic_astrodynamics::orbital_element_conversions::propagateKeplerOrbit;
+    using basic_astrodynamics::orbital_element_conversions::propagateKeplerOrbitsToCartesianStates;
+
+    const double earthGravitationalParameter = 3.986004415e14;
+
+    // Set up catalog of orbits with various eccentricities, orientations and anomalies, which
+    // spans multiple sub-blocks of the batch propagator. The propagation times include backward
+    // propagation and many revolutions.
+    const double eccentricities[ ] = { 0.0, 0.001, 0.1, 0.5, 0.8, 0.95, 0.99 };
+    const int numberOfObjects = 700;
+    Eigen::MatrixXd keplerianElementsWithTrueAnomaly( numberOfObjects, 6 );
+    Eigen::MatrixXd keplerianElementsWithMeanAnomaly( numberOfObjects, 6 );
+    Eigen::VectorXd propagationTimes( numberOfObjects );
+    for ( int i = 0; i < numberOfObjects; i++ )
+    {
+        keplerianElementsWithTrueAnomaly.row( i )
+                << 7.0e6 + 1.0e5 * ( i % 13 ) * ( 1.0 + 30.0 * ( i % 3 ) ),
+                eccentricities[ i % 7 ], PI * ( i % 11 ) / 10.0, 2.0 * PI * ( i % 17 ) / 17.0,
+                2.0 * PI * ( i % 19 ) / 19.0, -PI + 2.0 * PI * ( i % 23 ) / 23.0;
+        propagationTimes( i ) = 1.0e3 * ( i % 29 - 10 ) * ( 1.0 + 100.0 * ( i % 2 ) );
+
+        keplerianElementsWithMeanAnomaly.row( i ) = keplerianElementsWithTrueAnomaly.row( i );
+        keplerianElementsWithMeanAnomaly( i, trueAnomalyIndex )
+                = convertEccentricAnomalyToMeanAnomaly(
+                    convertTrueAnomalyToEccentricAnomaly(
+                        keplerianElementsWithTrueAnomaly( i, trueAnomalyIndex ),
+                        eccentricities[ i % 7 ] ), eccentricities[ i % 7 ] );
+    }
+
+    // Propagate catalog with a single thread and with multiple threads.
+    const Eigen::MatrixXd cartesianStates
+            = propagateKeplerOrbitsToCartesianStates(
+                keplerianElementsWithMeanAnomaly, propagationTimes,
+                earthGravitationalParameter, 1 );
+    const Eigen::MatrixXd cartesianStatesFromThreads
+            = propagateKeplerOrbitsToCartesianStates(
+                keplerianElementsWithMeanAnomaly, propagationTimes,
+                earthGravitationalParameter, 3 );
+
+    // Check that results are independent of the number of threads.
+    BOOST_CHECK( cartesianStates == cartesianStatesFromThreads );
+
+    // Check results against propagation of individual orbits.
+    for ( int i = 0; i < numberOfObjects; i++ )
+    {
+        const basic_mathematics::Vector6d finalKeplerianElements
+                = propagateKeplerOrbit( keplerianElementsWithTrueAnomaly.row( i ).transpose( ),
+                                        propagationTimes( i ), earthGravitationalParameter );
+        const basic_mathematics::Vector6d expectedCartesianState
+                = convertKeplerianToCartesianElements(
+                    finalKeplerianElements, earthGravitationalParameter );
+
+        BOOST_CHECK_SMALL( ( cartesianStates.block( i, 0, 1, 3 ).transpose( )
+                             - expectedCartesianState.segment( 0, 3 ) ).norm( )
+                           / expectedCartesianState.segment( 0, 3 ).norm( ), 1.0e-10 );
+        BOOST_CHECK_SMALL( ( cartesianStates.block( i, 3, 1, 3 ).transpose( )
+                             - expectedCartesianState.segment( 3, 3 ) ).norm( )
+                           / expectedCartesianState.segment( 3, 3 ).norm( ), 1.0e-10 );
+    }
+}
+
+//! Test that invalid catalogs are rejected.
+BOOST_AUTO_TEST_CASE( testBatchKeplerPropagatorErrors )
+{
+    using basic_astrodynamics::orbital_element_conversions::propagateKeplerOrbitsToCartesianStates;
+
+    Eigen::MatrixXd keplerianElements( 2, 6 );
+    keplerianElements << 7.0e6, 0.1, 0.5, 0.0, 0.0, 0.0,
+            8.0e6, 1.0, 0.5, 0.0, 0.0, 0.0;
+
+    // Check that parabolic orbits and inconsistent sizes are rejected.
+    BOOST_CHECK_THROW( propagateKeplerOrbitsToCartesianStates(
+                           keplerianElements, Eigen::VectorXd::Zero( 2 ), 3.986004415e14 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( propagateKeplerOrbitsToCartesianStates(
+                           keplerianElements.topRows( 1 ), Eigen::VectorXd::Zero( 2 ),
+                           3.986004415e14 ),
+                       std::runtime_error );
+
+    // Check that an empty catalog is accepted.
+    BOOST_CHECK_EQUAL( propagateKeplerOrbitsToCartesianStates(
+                           Eigen::MatrixXd( 0, 6 ), Eigen::VectorXd( 0 ),
+                           3.986004415e14 ).rows( ), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
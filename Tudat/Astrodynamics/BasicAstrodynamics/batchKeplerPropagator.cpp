@@ -0,0 +1,253 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      Vallado, D.A. Fundamentals of Astrodynamics and Applications, Third Edition, Microcosm
+ *          Press, 2007.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/thread.hpp>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/batchKeplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+//! Propagate elliptical Kepler orbits of a catalog of objects to Cartesian states.
+Eigen::MatrixXd propagateKeplerOrbitsToCartesianStates(
+        const Eigen::MatrixXd& keplerianElements,
+        const Eigen::VectorXd& propagationTimes,
+        const double centralBodyGravitationalParameter,
+        const unsigned int numberOfThreads )
+{
+    if ( keplerianElements.cols( ) != 6
+         || keplerianElements.rows( ) != propagationTimes.rows( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Keplerian elements must have 6 columns and one row "
+                                            "per propagation time." ) ) );
+    }
+
+    if ( keplerianElements.rows( ) > 0
+         && ( keplerianElements.col( eccentricityIndex ).minCoeff( ) < 0.0
+              || keplerianElements.col( eccentricityIndex ).maxCoeff( ) >= 1.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Only elliptical orbits (eccentricity in [0, 1)) are "
+                                            "supported." ) ) );
+    }
+
+    const int numberOfObjects = keplerianElements.rows( );
+    Eigen::MatrixXd cartesianStates( numberOfObjects, 6 );
+
+    // Distribute the objects over the threads in contiguous ranges of whole sub-blocks, using no
+    // more threads than sub-blocks.
+    const int subBlockSize = 256;
+    const int numberOfSubBlocks = ( numberOfObjects + subBlockSize - 1 ) / subBlockSize;
+    int numberOfUsedThreads = numberOfThreads > 0
+            ? static_cast< int >( numberOfThreads )
+            : static_cast< int >( boost::thread::hardware_concurrency( ) );
+    numberOfUsedThreads = std::max( std::min( numberOfUsedThreads, numberOfSubBlocks ), 1 );
+
+    if ( numberOfUsedThreads == 1 )
+    {
+        propagateKeplerOrbitsToCartesianStatesOfBlock(
+                    keplerianElements, propagationTimes, centralBodyGravitationalParameter,
+                    0, numberOfObjects, cartesianStates );
+    }
+
+    else
+    {
+        boost::thread_group threads;
+        for ( int i = 0; i < numberOfUsedThreads; i++ )
+        {
+            const int firstObject = i * numberOfSubBlocks / numberOfUsedThreads * subBlockSize;
+            const int lastObject = std::min(
+                        ( i + 1 ) * numberOfSubBlocks / numberOfUsedThreads * subBlockSize,
+                        numberOfObjects );
+
+            threads.create_thread(
+                        boost::bind( &propagateKeplerOrbitsToCartesianStatesOfBlock,
+                                     boost::cref( keplerianElements ),
+                                     boost::cref( propagationTimes ),
+                                     centralBodyGravitationalParameter,
+                                     firstObject, lastObject - firstObject,
+                                     boost::ref( cartesianStates ) ) );
+        }
+        threads.join_all( );
+    }
+
+    return cartesianStates;
+}
+
+//! Propagate block of elliptical Kepler orbits to Cartesian states.
+void propagateKeplerOrbitsToCartesianStatesOfBlock(
+        const Eigen::MatrixXd& keplerianElements,
+        const Eigen::VectorXd& propagationTimes,
+        const double centralBodyGravitationalParameter,
+        const int firstObject, const int numberOfObjects,
+        Eigen::MatrixXd& cartesianStates )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    typedef Eigen::Map< const Eigen::ArrayXd > ConstantArrayMap;
+    typedef Eigen::Map< Eigen::ArrayXd > ArrayMap;
+
+    const int subBlockSize = 256;
+    for ( int firstObjectOfSubBlock = firstObject;
+          firstObjectOfSubBlock < firstObject + numberOfObjects;
+          firstObjectOfSubBlock += subBlockSize )
+    {
+        const int size = std::min( subBlockSize,
+                                   firstObject + numberOfObjects - firstObjectOfSubBlock );
+        const int row = firstObjectOfSubBlock;
+
+        // Map the columns of the elements of the sub-block, which are contiguous.
+        const ConstantArrayMap semiMajorAxes(
+                    &keplerianElements( row, semiMajorAxisIndex ), size );
+        const ConstantArrayMap eccentricities(
+                    &keplerianElements( row, eccentricityIndex ), size );
+        const ConstantArrayMap inclinations(
+                    &keplerianElements( row, inclinationIndex ), size );
+        const ConstantArrayMap argumentsOfPeriapsis(
+                    &keplerianElements( row, argumentOfPeriapsisIndex ), size );
+        const ConstantArrayMap longitudesOfAscendingNode(
+                    &keplerianElements( row, longitudeOfAscendingNodeIndex ), size );
+        const ConstantArrayMap initialMeanAnomalies(
+                    &keplerianElements( row, trueAnomalyIndex ), size );
+        const ConstantArrayMap times( &propagationTimes( row ), size );
+
+        // Compute mean anomalies at final epoch, reduced to the range [-PI, PI].
+        Eigen::ArrayXd meanAnomalies = initialMeanAnomalies
+                + ( centralBodyGravitationalParameter / semiMajorAxes.cube( ) ).sqrt( ) * times;
+        for ( int i = 0; i < size; i++ )
+        {
+            meanAnomalies( i ) -= 2.0 * PI * std::floor( meanAnomalies( i ) / ( 2.0 * PI ) + 0.5 );
+        }
+
+        // Solve Kepler's equation for all objects of the sub-block simultaneously, starting from
+        // the mean anomaly, or from PI for high eccentricities (Vallado, 2007).
+        Eigen::ArrayXd eccentricAnomalies( size );
+        for ( int i = 0; i < size; i++ )
+        {
+            eccentricAnomalies( i ) = eccentricities( i ) < 0.8
+                    ? meanAnomalies( i ) : ( meanAnomalies( i ) < 0.0 ? -PI : PI );
+        }
+
+        for ( int iteration = 0; iteration < 50; iteration++ )
+        {
+            const Eigen::ArrayXd corrections
+                    = ( eccentricAnomalies - eccentricities * eccentricAnomalies.sin( )
+                        - meanAnomalies )
+                    / ( 1.0 - eccentricities * eccentricAnomalies.cos( ) );
+            eccentricAnomalies -= corrections;
+
+            if ( corrections.abs( ).maxCoeff( ) < 5.0e-14 )
+            {
+                break;
+            }
+        }
+
+        // Compute position and velocity in the perifocal frame.
+        const Eigen::ArrayXd sinesOfEccentricAnomaly = eccentricAnomalies.sin( );
+        const Eigen::ArrayXd cosinesOfEccentricAnomaly = eccentricAnomalies.cos( );
+        const Eigen::ArrayXd semiMinorAxisRatios = ( 1.0 - eccentricities.square( ) ).sqrt( );
+        const Eigen::ArrayXd velocityFactors
+                = ( centralBodyGravitationalParameter / semiMajorAxes ).sqrt( )
+                / ( 1.0 - eccentricities * cosinesOfEccentricAnomaly );
+
+        const Eigen::ArrayXd perifocalPositionsX
+                = semiMajorAxes * ( cosinesOfEccentricAnomaly - eccentricities );
+        const Eigen::ArrayXd perifocalPositionsY
+                = semiMajorAxes * semiMinorAxisRatios * sinesOfEccentricAnomaly;
+        const Eigen::ArrayXd perifocalVelocitiesX = -velocityFactors * sinesOfEccentricAnomaly;
+        const Eigen::ArrayXd perifocalVelocitiesY
+                = velocityFactors * semiMinorAxisRatios * cosinesOfEccentricAnomaly;
+
+        // Compute the unit vectors of the perifocal frame, towards periapsis (P) and in the
+        // orbital plane perpendicular to it (Q), in the inertial frame.
+        const Eigen::ArrayXd cosinesOfInclination = inclinations.cos( );
+        const Eigen::ArrayXd sinesOfInclination = inclinations.sin( );
+        const Eigen::ArrayXd cosinesOfArgumentOfPeriapsis = argumentsOfPeriapsis.cos( );
+        const Eigen::ArrayXd sinesOfArgumentOfPeriapsis = argumentsOfPeriapsis.sin( );
+        const Eigen::ArrayXd cosinesOfLongitudeOfAscendingNode = longitudesOfAscendingNode.cos( );
+        const Eigen::ArrayXd sinesOfLongitudeOfAscendingNode = longitudesOfAscendingNode.sin( );
+
+        Eigen::ArrayXd unitVectorP[ 3 ];
+        unitVectorP[ 0 ] = cosinesOfLongitudeOfAscendingNode * cosinesOfArgumentOfPeriapsis
+                - sinesOfLongitudeOfAscendingNode * sinesOfArgumentOfPeriapsis
+                * cosinesOfInclination;
+        unitVectorP[ 1 ] = sinesOfLongitudeOfAscendingNode * cosinesOfArgumentOfPeriapsis
+                + cosinesOfLongitudeOfAscendingNode * sinesOfArgumentOfPeriapsis
+                * cosinesOfInclination;
+        unitVectorP[ 2 ] = sinesOfArgumentOfPeriapsis * sinesOfInclination;
+
+        Eigen::ArrayXd unitVectorQ[ 3 ];
+        unitVectorQ[ 0 ] = -cosinesOfLongitudeOfAscendingNode * sinesOfArgumentOfPeriapsis
+                - sinesOfLongitudeOfAscendingNode * cosinesOfArgumentOfPeriapsis
+                * cosinesOfInclination;
+        unitVectorQ[ 1 ] = -sinesOfLongitudeOfAscendingNode * sinesOfArgumentOfPeriapsis
+                + cosinesOfLongitudeOfAscendingNode * cosinesOfArgumentOfPeriapsis
+                * cosinesOfInclination;
+        unitVectorQ[ 2 ] = cosinesOfArgumentOfPeriapsis * sinesOfInclination;
+
+        // Transform states to inertial frame, and store them in the contiguous columns of the
+        // sub-block.
+        for ( int i = 0; i < 3; i++ )
+        {
+            ArrayMap( &cartesianStates( row, xCartesianPositionIndex + i ), size )
+                    = unitVectorP[ i ] * perifocalPositionsX
+                    + unitVectorQ[ i ] * perifocalPositionsY;
+            ArrayMap( &cartesianStates( row, xCartesianVelocityIndex + i ), size )
+                    = unitVectorP[ i ] * perifocalVelocitiesX
+                    + unitVectorQ[ i ] * perifocalVelocitiesY;
+        }
+    }
+}
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
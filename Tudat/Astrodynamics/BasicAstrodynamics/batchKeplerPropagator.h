@@ -0,0 +1,108 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      Vallado, D.A. Fundamentals of Astrodynamics and Applications, Third Edition, Microcosm
+ *          Press, 2007.
+ *
+ *    Notes
+ *      The orbits are propagated as unperturbed Kepler orbits, as done by propagateKeplerOrbit( );
+ *      for TLE data, this is a two-body approximation of SGP-type propagation, suitable for
+ *      coarse screening only.
+ *
+ */
+
+#ifndef TUDAT_BATCH_KEPLER_PROPAGATOR_H
+#define TUDAT_BATCH_KEPLER_PROPAGATOR_H
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+//! Propagate elliptical Kepler orbits of a catalog of objects to Cartesian states.
+/*!
+ * Propagates the elliptical Kepler orbits of a catalog of objects, and converts the final states
+ * to Cartesian elements. The elements and states are stored as structure of arrays, i.e., with
+ * one row per object and one (contiguous) column per element, so that all objects are processed
+ * in blocks: Kepler's equation is solved by Newton-Raphson iterations on entire blocks of objects,
+ * which removes the per-object root-finder overhead of propagateKeplerOrbit( ), and the blocks
+ * are divided over a number of threads. The Newton-Raphson iterations are started at the mean
+ * anomaly (eccentricity below 0.8) or at PI (Vallado, 2007), and continue until all corrections
+ * in a block are below 5.0e-14, or for at most 50 iterations.
+ * \param keplerianElements Keplerian elements of the objects at their epochs, one row per object.
+ *          The columns are given by the Keplerian element indices (semi-major axis [m],
+ *          eccentricity [-], inclination [rad], argument of periapsis [rad], longitude of
+ *          ascending node [rad]), except that the last column contains the MEAN anomaly [rad]
+ *          instead of the true anomaly.
+ * \param propagationTimes Propagation time of each object, i.e., the difference between the
+ *          final epoch and the epoch of the elements of the object.                            [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.   [m^3 s^-2]
+ * \param numberOfThreads Number of threads; if zero, the number of hardware threads is used.
+ * \return Cartesian states of objects at final epoch, one row per object, with the columns given
+ *          by the Cartesian element indices (position [m], velocity [m s^-1]).
+ * \throws std::runtime_error If the sizes of the elements and propagation times are inconsistent,
+ *          or if any eccentricity is not in the range [0, 1).
+ */
+Eigen::MatrixXd propagateKeplerOrbitsToCartesianStates(
+        const Eigen::MatrixXd& keplerianElements,
+        const Eigen::VectorXd& propagationTimes,
+        const double centralBodyGravitationalParameter,
+        const unsigned int numberOfThreads = 0 );
+
+//! Propagate block of elliptical Kepler orbits to Cartesian states.
+/*!
+ * Propagates the elliptical Kepler orbits of a contiguous block of objects of a catalog to
+ * Cartesian states, see propagateKeplerOrbitsToCartesianStates( ). The block is processed in
+ * sub-blocks of 256 objects, such that the temporary arrays remain in cache. Executed by each of
+ * the threads of propagateKeplerOrbitsToCartesianStates( ); the elements are not checked.
+ * \param keplerianElements Keplerian elements (with mean anomaly) of all objects, one row per
+ *          object.
+ * \param propagationTimes Propagation time of each object.                                    [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.   [m^3 s^-2]
+ * \param firstObject Index of first object of block.
+ * \param numberOfObjects Number of objects in block.
+ * \param cartesianStates Cartesian states of all objects, of which the rows of the block are set
+ *          (returned by reference).
+ */
+void propagateKeplerOrbitsToCartesianStatesOfBlock(
+        const Eigen::MatrixXd& keplerianElements,
+        const Eigen::VectorXd& propagationTimes,
+        const double centralBodyGravitationalParameter,
+        const int firstObject, const int numberOfObjects,
+        Eigen::MatrixXd& cartesianStates );
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
+
+#endif // TUDAT_BATCH_KEPLER_PROPAGATOR_H
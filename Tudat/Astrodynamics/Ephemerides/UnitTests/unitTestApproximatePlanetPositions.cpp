@@ -37,6 +37,7 @@
  *      120513    P. Musegaas       Boostified unit test.
  *      130218    D. Dirx           Adapted unit test for Julian date conversions and for changes
  *                                  in ephemeris base class.
+ *      261016    agent             Added unit test for evaluation of states at multiple epochs.
  *
  *    References
  *      HORIZONS Web-Interface, http://ssd.jpl.nasa.gov/horizons.cgi, last accessed: 5 April, 2011.
@@ -56,8 +57,13 @@
 
 #define BOOST_TEST_MAIN
 
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 
 #include <TudatCore/Basics/testMacros.h>
 #include <TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h>
@@ -71,6 +77,15 @@ namespace tudat
 namespace unit_tests
 {
 
+//! Compute Cartesian states of planet at multiple epochs.
+void computeCartesianStatesOfPlanet(
+        const boost::shared_ptr< ephemerides::ApproximatePlanetPositions > planetEphemeris,
+        const Eigen::VectorXd& secondsSinceEpoch, Eigen::MatrixXd& cartesianStates )
+{
+    cartesianStates = planetEphemeris->getCartesianStatesFromEphemeris( secondsSinceEpoch,
+                                                                        2451545.0 );
+}
+
 //! Test the functionality of the approximate planet position functions
 BOOST_AUTO_TEST_SUITE( test_approximate_planet_positions )
 
@@ -142,6 +157,61 @@ BOOST_AUTO_TEST_CASE( testCircularCoplannar )
     BOOST_CHECK_EQUAL( marsEphemeris.getReferenceFrameOrigin( ), "Sun" );
 }
 
+//! Test the evaluation of states at multiple epochs against evaluation at single epochs.
+BOOST_AUTO_TEST_CASE( testMultipleEpochs )
+{
+    using namespace tudat::ephemerides;
+
+    // Create ephemerides of Mars and of Jupiter, which has additional terms.
+    std::vector< ApproximatePlanetPositionsPointer > planetEphemerides;
+    planetEphemerides.push_back( boost::make_shared< ApproximatePlanetPositions >(
+                                     ApproximatePlanetPositions::mars ) );
+    planetEphemerides.push_back( boost::make_shared< ApproximatePlanetPositions >(
+                                     ApproximatePlanetPositions::jupiter ) );
+
+    // Set epochs over two centuries, around J2000.
+    const Eigen::VectorXd secondsSinceEpoch
+            = Eigen::VectorXd::LinSpaced( 1001, -3.15576e9, 3.15576e9 );
+
+    // Check that states match states at single epochs.
+    const Eigen::MatrixXd cartesianStates
+            = getCartesianStatesOfPlanets( planetEphemerides, secondsSinceEpoch, 2451545.0 );
+    BOOST_REQUIRE_EQUAL( cartesianStates.cols( ), 12 );
+    for ( unsigned int i = 0; i < planetEphemerides.size( ); i++ )
+    {
+        for ( int j = 0; j < secondsSinceEpoch.rows( ); j++ )
+        {
+            const basic_mathematics::Vector6d expectedState
+                    = planetEphemerides[ i ]->getCartesianStateFromEphemeris(
+                        secondsSinceEpoch( j ), 2451545.0 );
+            BOOST_CHECK_SMALL( ( cartesianStates.block( j, 6 * i, 1, 3 ).transpose( )
+                                 - expectedState.segment( 0, 3 ) ).norm( )
+                               / expectedState.segment( 0, 3 ).norm( ), 1.0e-10 );
+            BOOST_CHECK_SMALL( ( cartesianStates.block( j, 6 * i + 3, 1, 3 ).transpose( )
+                                 - expectedState.segment( 3, 3 ) ).norm( )
+                               / expectedState.segment( 3, 3 ).norm( ), 1.0e-10 );
+        }
+    }
+
+    // Check that states computed concurrently with a single ephemeris object are identical.
+    const int numberOfThreads = 4;
+    std::vector< Eigen::MatrixXd > concurrentStates( numberOfThreads );
+    boost::thread_group threads;
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        threads.create_thread( boost::bind( &computeCartesianStatesOfPlanet,
+                                            planetEphemerides[ 1 ],
+                                            boost::cref( secondsSinceEpoch ),
+                                            boost::ref( concurrentStates[ i ] ) ) );
+    }
+    threads.join_all( );
+
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        BOOST_CHECK( concurrentStates[ i ] == cartesianStates.block( 0, 6, 1001, 6 ) );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,221 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Tudat/Astrodynamics/Ephemerides/cachedEphemeris.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::ephemerides;
+
+//! Analytical ephemeris of a perturbed orbit, which counts the number of calls.
+class AnalyticalTestEphemeris : public Ephemeris
+{
+public:
+
+    //! Constructor.
+    AnalyticalTestEphemeris( )
+        : Ephemeris( "Earth", "J2000" ),
+          numberOfCalls_( 0 )
+    { }
+
+    //! Get state from ephemeris.
+    basic_mathematics::Vector6d getCartesianStateFromEphemeris(
+            const double secondsSinceEpoch,
+            const double julianDayAtEpoch = basic_astrodynamics::JULIAN_DAY_ON_J2000 )
+    {
+        numberOfCalls_++;
+
+        // Compute time since J2000.
+        const double time = secondsSinceEpoch + ( julianDayAtEpoch
+                                                  - basic_astrodynamics::JULIAN_DAY_ON_J2000 )
+                * physical_constants::JULIAN_DAY;
+        const double meanMotion = 2.0 * basic_mathematics::mathematical_constants::PI
+                / physical_constants::JULIAN_DAY;
+        const double angle = meanMotion * time;
+
+        basic_mathematics::Vector6d state;
+        state << 4.0e8 * std::cos( angle ) + 2.0e7 * std::cos( 3.0 * angle ),
+                4.0e8 * std::sin( angle ),
+                3.0e7 * std::sin( 2.0 * angle ),
+                -meanMotion * ( 4.0e8 * std::sin( angle ) + 6.0e7 * std::sin( 3.0 * angle ) ),
+                meanMotion * 4.0e8 * std::cos( angle ),
+                meanMotion * 6.0e7 * std::cos( 2.0 * angle );
+        return state;
+    }
+
+    //! Get number of calls.
+    unsigned int getNumberOfCalls( ) { return numberOfCalls_; }
+
+private:
+
+    //! Number of calls to getCartesianStateFromEphemeris( ).
+    unsigned int numberOfCalls_;
+};
+
+//! Compute states from cached ephemeris at given times.
+void computeCachedStates( const CachedEphemerisPointer cachedEphemeris,
+                          const Eigen::VectorXd& times, Eigen::MatrixXd& states )
+{
+    states.resize( times.rows( ), 6 );
+    for ( int i = 0; i < times.rows( ); i++ )
+    {
+        states.row( i )
+                = cachedEphemeris->getCartesianStateFromEphemeris( times( i ) ).transpose( );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_cached_ephemeris )
+
+//! Test accuracy of cached ephemeris.
+BOOST_AUTO_TEST_CASE( testCachedEphemerisAccuracy )
+{
+    // Cache ephemeris over 30 days, starting 10 days after J2000.
+    const double startTime = 10.0 * physical_constants::JULIAN_DAY;
+    const double endTime = 40.0 * physical_constants::JULIAN_DAY;
+    const double positionTolerance = 1.0e-2;
+    const double velocityTolerance = 1.0e-6;
+    const boost::shared_ptr< AnalyticalTestEphemeris > analyticalEphemeris
+            = boost::make_shared< AnalyticalTestEphemeris >( );
+    CachedEphemeris cachedEphemeris( analyticalEphemeris, startTime, endTime,
+                                     positionTolerance, velocityTolerance );
+    const unsigned int numberOfSamples = analyticalEphemeris->getNumberOfCalls( );
+
+    BOOST_CHECK_GT( cachedEphemeris.getNumberOfSegments( ), 1 );
+    BOOST_CHECK_EQUAL( cachedEphemeris.getReferenceFrameOrigin( ), "Earth" );
+    BOOST_CHECK_EQUAL( cachedEphemeris.getReferenceFrameOrientation( ), "J2000" );
+
+    // Check states over entire interval, including its boundaries.
+    const int numberOfTimes = 10001;
+    for ( int i = 0; i < numberOfTimes; i++ )
+    {
+        const double time = startTime + ( endTime - startTime ) * i / ( numberOfTimes - 1 );
+        const basic_mathematics::Vector6d stateError
+                = cachedEphemeris.getCartesianStateFromEphemeris( time )
+                - analyticalEphemeris->getCartesianStateFromEphemeris( time );
+        BOOST_CHECK_SMALL( stateError.segment( 0, 3 ).norm( ), 2.0 * positionTolerance );
+        BOOST_CHECK_SMALL( stateError.segment( 3, 3 ).norm( ), 2.0 * velocityTolerance );
+    }
+
+    // Check that cached states do not depend on reference epoch of input time.
+    BOOST_CHECK( cachedEphemeris.getCartesianStateFromEphemeris(
+                     12.0 * physical_constants::JULIAN_DAY )
+                 == cachedEphemeris.getCartesianStateFromEphemeris(
+                     2.0 * physical_constants::JULIAN_DAY,
+                     basic_astrodynamics::JULIAN_DAY_ON_J2000 + 10.0 ) );
+
+    // Check that the analytical ephemeris was only sampled during construction.
+    BOOST_CHECK_EQUAL( analyticalEphemeris->getNumberOfCalls( ),
+                       numberOfSamples + numberOfTimes );
+}
+
+//! Test concurrent use of cached ephemeris.
+BOOST_AUTO_TEST_CASE( testCachedEphemerisConcurrency )
+{
+    const CachedEphemerisPointer cachedEphemeris = boost::make_shared< CachedEphemeris >(
+                boost::make_shared< AnalyticalTestEphemeris >( ),
+                0.0, 5.0 * physical_constants::JULIAN_DAY, 1.0e-2, 1.0e-6 );
+
+    // Compute expected states in main thread.
+    const int numberOfThreads = 8;
+    std::vector< Eigen::VectorXd > times( numberOfThreads );
+    std::vector< Eigen::MatrixXd > expectedStates( numberOfThreads );
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        times[ i ] = Eigen::VectorXd::LinSpaced(
+                    10000, 0.0, 5.0 * physical_constants::JULIAN_DAY ).array( ) / ( 1.0 + i );
+        computeCachedStates( cachedEphemeris, times[ i ], expectedStates[ i ] );
+    }
+
+    // Compute states concurrently, and check that results match results of main thread.
+    std::vector< Eigen::MatrixXd > computedStates( numberOfThreads );
+    boost::thread_group threads;
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        threads.create_thread( boost::bind( &computeCachedStates, cachedEphemeris,
+                                            boost::cref( times[ i ] ),
+                                            boost::ref( computedStates[ i ] ) ) );
+    }
+    threads.join_all( );
+
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        BOOST_CHECK( computedStates[ i ] == expectedStates[ i ] );
+    }
+}
+
+//! Test errors of cached ephemeris.
+BOOST_AUTO_TEST_CASE( testCachedEphemerisErrors )
+{
+    const EphemerisPointer analyticalEphemeris = boost::make_shared< AnalyticalTestEphemeris >( );
+
+    // Check that empty intervals and unreachable tolerances are rejected.
+    BOOST_CHECK_THROW( CachedEphemeris( analyticalEphemeris, 1.0, 1.0, 1.0e-2, 1.0e-6 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( CachedEphemeris( analyticalEphemeris, 0.0, physical_constants::JULIAN_DAY,
+                                        1.0e-2, 1.0e-6, basic_astrodynamics::JULIAN_DAY_ON_J2000,
+                                        2, 3600.0 ),
+                       std::runtime_error );
+
+    // Check that times outside the cached interval are rejected.
+    CachedEphemeris cachedEphemeris( analyticalEphemeris, 0.0, physical_constants::JULIAN_DAY,
+                                     1.0e-2, 1.0e-6 );
+    BOOST_CHECK_THROW( cachedEphemeris.getCartesianStateFromEphemeris( -1.0 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( cachedEphemeris.getCartesianStateFromEphemeris(
+                           0.0, basic_astrodynamics::JULIAN_DAY_ON_J2000 + 1.5 ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -31,6 +31,7 @@
  *      120322    D. Dirkx          Modified to new Ephemeris interfaces.
  *      120522    P. Musegaas       Fixed bug for coordinates of outer planets.
  *      130120    D. Dirkx          Updated with new Julian day + seconds since Julian day input.
+ *      261016    agent             Added evaluation of states at multiple epochs.
  *
  *    References
  *      Standish, E.M. Keplerian Elements for Approximate Positions of the Major Planets,
@@ -45,6 +46,7 @@
 #include <TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h>
 #include <TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h>
 
+#include "Tudat/Astrodynamics/BasicAstrodynamics/batchKeplerPropagator.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
 #include "Tudat/Astrodynamics/Ephemerides/approximatePlanetPositions.h"
@@ -187,5 +189,83 @@ basic_mathematics::Vector6d ApproximatePlanetPositions::getKeplerianStateFromEph
     return planetKeplerianElementsAtGivenJulianDate_;
 }
 
+//! Get Cartesian states from ephemeris at multiple epochs.
+Eigen::MatrixXd ApproximatePlanetPositions::getCartesianStatesFromEphemeris(
+        const Eigen::VectorXd& secondsSinceEpoch, const double julianDayAtEpoch ) const
+{
+    using namespace basic_astrodynamics;
+
+    const ApproximatePlanetPositionsDataContainer& data = approximatePlanetPositionsDataContainer_;
+    const double degreesToRadians
+            = tudat::basic_astrodynamics::unit_conversions::convertDegreesToRadians( 1.0 );
+
+    // Compute number of centuries past J2000 at all epochs.
+    Eigen::ArrayXd numberOfCenturiesPastJ2000( secondsSinceEpoch.rows( ) );
+    for ( int i = 0; i < secondsSinceEpoch.rows( ); i++ )
+    {
+        numberOfCenturiesPastJ2000( i ) = ( convertSecondsSinceEpochToJulianDay(
+                                                secondsSinceEpoch( i ), julianDayAtEpoch )
+                                            - 2451545.0 ) / 36525.0;
+    }
+
+    // Compute Keplerian elements at all epochs, with mean anomaly instead of true anomaly, in
+    // standard units (see getKeplerianStateFromEphemeris( )).
+    Eigen::MatrixXd keplerianElements( secondsSinceEpoch.rows( ), 6 );
+    keplerianElements.col( semiMajorAxisIndex )
+            = tudat::basic_astrodynamics::unit_conversions::convertAstronomicalUnitsToMeters( 1.0 )
+            * ( data.semiMajorAxis_
+                + data.rateOfChangeOfSemiMajorAxis_ * numberOfCenturiesPastJ2000 ).matrix( );
+    keplerianElements.col( eccentricityIndex )
+            = ( data.eccentricity_
+                + data.rateOfChangeOfEccentricity_ * numberOfCenturiesPastJ2000 ).matrix( );
+    keplerianElements.col( inclinationIndex )
+            = degreesToRadians
+            * ( data.inclination_
+                + data.rateOfChangeOfInclination_ * numberOfCenturiesPastJ2000 ).matrix( );
+
+    const Eigen::ArrayXd longitudeOfAscendingNode
+            = data.longitudeOfAscendingNode_
+            + data.rateOfChangeOfLongitudeOfAscendingNode_ * numberOfCenturiesPastJ2000;
+    const Eigen::ArrayXd longitudeOfPerihelion
+            = data.longitudeOfPerihelion_
+            + data.rateOfChangeOfLongitudeOfPerihelion_ * numberOfCenturiesPastJ2000;
+    keplerianElements.col( longitudeOfAscendingNodeIndex )
+            = degreesToRadians * longitudeOfAscendingNode.matrix( );
+    keplerianElements.col( argumentOfPeriapsisIndex )
+            = degreesToRadians * ( longitudeOfPerihelion - longitudeOfAscendingNode ).matrix( );
+    keplerianElements.col( trueAnomalyIndex )
+            = degreesToRadians
+            * ( data.meanLongitude_
+                + data.rateOfChangeOfMeanLongitude_ * numberOfCenturiesPastJ2000
+                - longitudeOfPerihelion
+                + data.additionalTermB_ * numberOfCenturiesPastJ2000.square( )
+                + data.additionalTermC_ * ( data.additionalTermF_
+                                            * numberOfCenturiesPastJ2000 ).cos( )
+                + data.additionalTermS_ * ( data.additionalTermF_
+                                            * numberOfCenturiesPastJ2000 ).sin( ) ).matrix( );
+
+    // Solve Kepler's equation and convert to Cartesian elements for all epochs at once.
+    return tudat::basic_astrodynamics::orbital_element_conversions::
+            propagateKeplerOrbitsToCartesianStates(
+                keplerianElements, Eigen::VectorXd::Zero( secondsSinceEpoch.rows( ) ),
+                sunGravitationalParameter, 1 );
+}
+
+//! Get Cartesian states of planets at multiple epochs.
+Eigen::MatrixXd getCartesianStatesOfPlanets(
+        const std::vector< ApproximatePlanetPositionsPointer >& planetEphemerides,
+        const Eigen::VectorXd& secondsSinceEpoch, const double julianDayAtEpoch )
+{
+    Eigen::MatrixXd cartesianStates( secondsSinceEpoch.rows( ), 6 * planetEphemerides.size( ) );
+    for ( unsigned int i = 0; i < planetEphemerides.size( ); i++ )
+    {
+        cartesianStates.block( 0, 6 * i, secondsSinceEpoch.rows( ), 6 )
+                = planetEphemerides[ i ]->getCartesianStatesFromEphemeris( secondsSinceEpoch,
+                                                                           julianDayAtEpoch );
+    }
+
+    return cartesianStates;
+}
+
 } // namespace ephemerides
 } // namespace tudat
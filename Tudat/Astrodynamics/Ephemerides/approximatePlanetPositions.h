@@ -30,6 +30,7 @@
  *      120322    D. Dirkx          Modified to new Ephemeris interfaces.
  *      130120    K. Kumar          Updated VectorXd to Vector6d; added shared-ptr typedef.
  *      130120    D. Dirkx          Updated with new Julian day + seconds since Julian day input.
+ *      261016    agent             Added evaluation of states at multiple epochs.
  *
  *    References
  *      Standish, E.M. Keplerian Elements for Approximate Positions of the Major Planets,
@@ -42,8 +43,12 @@
 #ifndef TUDAT_APPROXIMATE_PLANET_POSITIONS_H
 #define TUDAT_APPROXIMATE_PLANET_POSITIONS_H
 
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 
+#include <Eigen/Core>
+
 #include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/convertMeanAnomalyToEccentricAnomaly.h"
@@ -99,6 +104,20 @@ public:
     basic_mathematics::Vector6d getKeplerianStateFromEphemeris(
             const double secondsSinceEpoch, const double julianDayAtEpoch );
 
+    //! Get Cartesian states from ephemeris at multiple epochs.
+    /*!
+     * Returns Cartesian states from ephemeris at multiple epochs. Contrary to
+     * getCartesianStateFromEphemeris( ), the object is not modified, so that states can be
+     * computed by multiple threads concurrently. Kepler's equation is solved for all epochs
+     * simultaneously (see propagateKeplerOrbitsToCartesianStates( )), instead of by a root
+     * finder per epoch.
+     * \param secondsSinceEpoch Seconds since epoch, one per epoch at which state is computed.
+     * \param julianDayAtEpoch Reference epoch in Julian day.
+     * \return States in Cartesian elements from ephemeris, one row per epoch.
+     */
+    Eigen::MatrixXd getCartesianStatesFromEphemeris( const Eigen::VectorXd& secondsSinceEpoch,
+                                                     const double julianDayAtEpoch ) const;
+
 protected:
 
 private:
@@ -131,6 +150,20 @@ private:
 //! Typedef for shared-pointer to ApproximatePlanetPositions object.
 typedef boost::shared_ptr< ApproximatePlanetPositions > ApproximatePlanetPositionsPointer;
 
+//! Get Cartesian states of planets at multiple epochs.
+/*!
+ * Returns Cartesian states of a number of planets at multiple epochs, using
+ * ApproximatePlanetPositions::getCartesianStatesFromEphemeris( ).
+ * \param planetEphemerides Ephemerides of planets.
+ * \param secondsSinceEpoch Seconds since epoch, one per epoch at which states are computed.
+ * \param julianDayAtEpoch Reference epoch in Julian day.
+ * \return States in Cartesian elements, with one row per epoch, and six columns per planet (in
+ *          the order of planetEphemerides).
+ */
+Eigen::MatrixXd getCartesianStatesOfPlanets(
+        const std::vector< ApproximatePlanetPositionsPointer >& planetEphemerides,
+        const Eigen::VectorXd& secondsSinceEpoch, const double julianDayAtEpoch );
+
 } // namespace ephemerides
 } // namespace tudat
 
@@ -0,0 +1,210 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      Press, W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Tudat/Astrodynamics/Ephemerides/cachedEphemeris.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+//! Constructor.
+CachedEphemeris::CachedEphemeris( const EphemerisPointer ephemeris,
+                                  const double startTime, const double endTime,
+                                  const double positionTolerance,
+                                  const double velocityTolerance,
+                                  const double referenceJulianDay,
+                                  const unsigned int polynomialDegree,
+                                  const double minimumSegmentDuration )
+    : Ephemeris( ephemeris->getReferenceFrameOrigin( ),
+                 ephemeris->getReferenceFrameOrientation( ) ),
+      referenceJulianDay_( referenceJulianDay ),
+      polynomialDegree_( polynomialDegree )
+{
+    if ( !( endTime > startTime ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "End time of cached ephemeris must be larger than "
+                                            "start time." ) ) );
+    }
+
+    // Fit segments, bisecting the interval where needed.
+    segmentBoundaries_.push_back( startTime );
+    fitSegment( ephemeris, startTime, endTime, positionTolerance, velocityTolerance,
+                minimumSegmentDuration );
+}
+
+//! Get state from ephemeris.
+basic_mathematics::Vector6d CachedEphemeris::getCartesianStateFromEphemeris(
+        const double secondsSinceEpoch, const double julianDayAtEpoch )
+{
+    // Determine number of seconds since reference epoch of cache.
+    double time = secondsSinceEpoch;
+    if ( julianDayAtEpoch != referenceJulianDay_ )
+    {
+        time -= ( referenceJulianDay_ - julianDayAtEpoch ) * physical_constants::JULIAN_DAY;
+    }
+
+    if ( time < segmentBoundaries_.front( ) || time > segmentBoundaries_.back( ) )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Time " << time << " s is outside cached interval ["
+                     << segmentBoundaries_.front( ) << ", " << segmentBoundaries_.back( )
+                     << "] s." << std::endl;
+        boost::throw_exception( boost::enable_error_info(
+                                    std::runtime_error( errorMessage.str( ) ) ) );
+    }
+
+    // Find segment that contains time; the end of the interval belongs to the last segment.
+    const std::size_t segmentIndex = std::upper_bound( segmentBoundaries_.begin( ) + 1,
+                                                       segmentBoundaries_.end( ) - 1, time )
+            - ( segmentBoundaries_.begin( ) + 1 );
+    const double segmentStartTime = segmentBoundaries_[ segmentIndex ];
+    const double segmentEndTime = segmentBoundaries_[ segmentIndex + 1 ];
+
+    // Evaluate polynomials at normalized time in segment.
+    return evaluateChebyshevPolynomials(
+                &chebyshevCoefficients_[ segmentIndex * 6 * ( polynomialDegree_ + 1 ) ],
+                ( 2.0 * time - segmentStartTime - segmentEndTime )
+                / ( segmentEndTime - segmentStartTime ) );
+}
+
+//! Fit Chebyshev polynomials to segment of ephemeris.
+void CachedEphemeris::fitSegment( const EphemerisPointer ephemeris,
+                                  const double segmentStartTime, const double segmentEndTime,
+                                  const double positionTolerance,
+                                  const double velocityTolerance,
+                                  const double minimumSegmentDuration )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    const unsigned int numberOfNodes = polynomialDegree_ + 1;
+    const double segmentMidTime = 0.5 * ( segmentStartTime + segmentEndTime );
+    const double segmentHalfDuration = 0.5 * ( segmentEndTime - segmentStartTime );
+
+    // Compute Chebyshev coefficients from states at Chebyshev nodes (Press et al., 2002).
+    Eigen::MatrixXd coefficients = Eigen::MatrixXd::Zero( 6, numberOfNodes );
+    for ( unsigned int k = 0; k < numberOfNodes; k++ )
+    {
+        const double nodeAngle = PI * ( k + 0.5 ) / numberOfNodes;
+        const basic_mathematics::Vector6d stateAtNode
+                = ephemeris->getCartesianStateFromEphemeris(
+                    segmentMidTime + segmentHalfDuration * std::cos( nodeAngle ),
+                    referenceJulianDay_ );
+        for ( unsigned int j = 0; j < numberOfNodes; j++ )
+        {
+            coefficients.col( j ) += stateAtNode * std::cos( j * nodeAngle );
+        }
+    }
+    coefficients *= 2.0 / numberOfNodes;
+    coefficients.col( 0 ) *= 0.5;
+
+    // Check polynomials halfway between nodes, including segment boundaries.
+    bool isToleranceMet = true;
+    for ( unsigned int k = 0; k <= numberOfNodes && isToleranceMet; k++ )
+    {
+        const double normalizedTime = std::cos( PI * k / numberOfNodes );
+        const basic_mathematics::Vector6d stateError
+                = evaluateChebyshevPolynomials( coefficients.data( ), normalizedTime )
+                - ephemeris->getCartesianStateFromEphemeris(
+                    segmentMidTime + segmentHalfDuration * normalizedTime,
+                    referenceJulianDay_ );
+        isToleranceMet = stateError.segment( 0, 3 ).norm( ) <= positionTolerance
+                && stateError.segment( 3, 3 ).norm( ) <= velocityTolerance;
+    }
+
+    if ( isToleranceMet )
+    {
+        chebyshevCoefficients_.insert( chebyshevCoefficients_.end( ), coefficients.data( ),
+                                       coefficients.data( ) + coefficients.size( ) );
+        segmentBoundaries_.push_back( segmentEndTime );
+    }
+
+    else if ( segmentHalfDuration < minimumSegmentDuration )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Tolerances of cached ephemeris cannot be met in segment ["
+                     << segmentStartTime << ", " << segmentEndTime << "] s." << std::endl;
+        boost::throw_exception( boost::enable_error_info(
+                                    std::runtime_error( errorMessage.str( ) ) ) );
+    }
+
+    else
+    {
+        fitSegment( ephemeris, segmentStartTime, segmentMidTime,
+                    positionTolerance, velocityTolerance, minimumSegmentDuration );
+        fitSegment( ephemeris, segmentMidTime, segmentEndTime,
+                    positionTolerance, velocityTolerance, minimumSegmentDuration );
+    }
+}
+
+//! Evaluate Chebyshev polynomials of segment.
+basic_mathematics::Vector6d CachedEphemeris::evaluateChebyshevPolynomials(
+        const double* coefficients, const double normalizedTime ) const
+{
+    typedef Eigen::Map< const basic_mathematics::Vector6d > CoefficientMap;
+
+    // Apply Clenshaw's recurrence to all state elements simultaneously.
+    basic_mathematics::Vector6d recurrenceTerm = basic_mathematics::Vector6d::Zero( );
+    basic_mathematics::Vector6d previousRecurrenceTerm = basic_mathematics::Vector6d::Zero( );
+    for ( unsigned int j = polynomialDegree_; j > 0; j-- )
+    {
+        const basic_mathematics::Vector6d nextRecurrenceTerm
+                = 2.0 * normalizedTime * recurrenceTerm - previousRecurrenceTerm
+                + CoefficientMap( coefficients + 6 * j );
+        previousRecurrenceTerm = recurrenceTerm;
+        recurrenceTerm = nextRecurrenceTerm;
+    }
+
+    return normalizedTime * recurrenceTerm - previousRecurrenceTerm
+            + CoefficientMap( coefficients );
+}
+
+} // namespace ephemerides
+} // namespace tudat
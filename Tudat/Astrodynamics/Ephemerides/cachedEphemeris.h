@@ -0,0 +1,181 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      Press, W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *
+ *    Notes
+ *      The cache is filled completely in the constructor, after which the wrapped ephemeris is no
+ *      longer used. This makes it suitable for ephemerides that are expensive to evaluate, or
+ *      that cannot be called concurrently, such as SpiceEphemeris.
+ *
+ */
+
+#ifndef TUDAT_CACHED_EPHEMERIS_H
+#define TUDAT_CACHED_EPHEMERIS_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+//! Ephemeris that caches another ephemeris as piecewise Chebyshev polynomials.
+/*!
+ * Ephemeris that samples another ephemeris (e.g., a SpiceEphemeris) over a given interval, and
+ * approximates each Cartesian state element by piecewise Chebyshev polynomials of a given degree
+ * (Press et al., 2002). The interval is bisected recursively until the polynomials of each
+ * segment reproduce the sampled ephemeris to within a given position and velocity tolerance at
+ * the nodes and at the points halfway between the nodes (including the segment boundaries).
+ * States are subsequently computed from the polynomial coefficients only, without calling the
+ * sampled ephemeris. The object is not modified after construction, so that states can be
+ * retrieved from many threads concurrently.
+ */
+class CachedEphemeris : public Ephemeris
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, samples the given ephemeris over the given interval, and determines the
+     * Chebyshev polynomials of all segments. The reference frame of the cached ephemeris is that
+     * of the sampled ephemeris.
+     * \param ephemeris Ephemeris that is to be sampled.
+     * \param startTime Start of interval over which ephemeris is cached, in seconds since
+     *          referenceJulianDay.                                                          [s]
+     * \param endTime End of interval over which ephemeris is cached, in seconds since
+     *          referenceJulianDay.                                                          [s]
+     * \param positionTolerance Maximum position error of polynomials at check points.       [m]
+     * \param velocityTolerance Maximum velocity error of polynomials at check points.   [m s^-1]
+     * \param referenceJulianDay Julian day of reference epoch of start and end time.
+     * \param polynomialDegree Degree of Chebyshev polynomials of each segment.
+     * \param minimumSegmentDuration Duration below which segments are not bisected further. [s]
+     * \throws std::runtime_error If the interval is empty, or if the tolerances are not met by
+     *          segments of the minimum duration.
+     */
+    CachedEphemeris( const EphemerisPointer ephemeris,
+                     const double startTime, const double endTime,
+                     const double positionTolerance, const double velocityTolerance,
+                     const double referenceJulianDay = basic_astrodynamics::JULIAN_DAY_ON_J2000,
+                     const unsigned int polynomialDegree = 12,
+                     const double minimumSegmentDuration = 1.0 );
+
+    //! Get state from ephemeris.
+    /*!
+     * Returns Cartesian state, evaluated from the Chebyshev polynomials of the segment that
+     * contains the given time. Thread-safe.
+     * \param secondsSinceEpoch Seconds since epoch.                                          [s]
+     * \param julianDayAtEpoch Reference epoch in Julian days.
+     * \return State from ephemeris.
+     * \throws std::runtime_error If the time is outside the cached interval.
+     */
+    basic_mathematics::Vector6d getCartesianStateFromEphemeris(
+            const double secondsSinceEpoch,
+            const double julianDayAtEpoch = basic_astrodynamics::JULIAN_DAY_ON_J2000 );
+
+    //! Get number of segments.
+    /*!
+     * Returns the number of segments into which the cached interval is divided.
+     * \return Number of segments.
+     */
+    unsigned int getNumberOfSegments( ) { return segmentBoundaries_.size( ) - 1; }
+
+private:
+
+    //! Fit Chebyshev polynomials to segment of ephemeris.
+    /*!
+     * Fits Chebyshev polynomials to the sampled ephemeris over the given segment, and adds the
+     * coefficients if the tolerances are met. Otherwise, the two halves of the segment are
+     * fitted instead. Segments are added in chronological order.
+     * \param ephemeris Ephemeris that is to be sampled.
+     * \param segmentStartTime Start time of segment, in seconds since reference Julian day.  [s]
+     * \param segmentEndTime End time of segment, in seconds since reference Julian day.     [s]
+     * \param positionTolerance Maximum position error of polynomials at check points.       [m]
+     * \param velocityTolerance Maximum velocity error of polynomials at check points.   [m s^-1]
+     * \param minimumSegmentDuration Duration below which segments are not bisected further. [s]
+     * \throws std::runtime_error If the tolerances are not met by a segment of the minimum
+     *          duration.
+     */
+    void fitSegment( const EphemerisPointer ephemeris,
+                     const double segmentStartTime, const double segmentEndTime,
+                     const double positionTolerance, const double velocityTolerance,
+                     const double minimumSegmentDuration );
+
+    //! Evaluate Chebyshev polynomials of segment.
+    /*!
+     * Evaluates the Chebyshev polynomials of the Cartesian state elements of a segment, using
+     * Clenshaw's recurrence (Press et al., 2002).
+     * \param coefficients Pointer to coefficients of segment, stored per degree, with the
+     *          coefficients of the six state elements contiguous.
+     * \param normalizedTime Time normalized to the range [-1, 1] of the segment.
+     * \return Cartesian state.
+     */
+    basic_mathematics::Vector6d evaluateChebyshevPolynomials(
+            const double* coefficients, const double normalizedTime ) const;
+
+    //! Julian day of reference epoch.
+    /*!
+     * Julian day of reference epoch, from which the times of the segment boundaries are counted.
+     */
+    const double referenceJulianDay_;
+
+    //! Degree of Chebyshev polynomials.
+    /*!
+     * Degree of Chebyshev polynomials of each segment.
+     */
+    const unsigned int polynomialDegree_;
+
+    //! Boundaries of segments.
+    /*!
+     * Times of boundaries of segments, in seconds since reference Julian day, in ascending order.
+     */
+    std::vector< double > segmentBoundaries_;
+
+    //! Chebyshev coefficients of segments.
+    /*!
+     * Chebyshev coefficients of all segments, stored per segment, then per degree, then per
+     * Cartesian state element.
+     */
+    std::vector< double > chebyshevCoefficients_;
+};
+
+//! Typedef for shared-pointer to CachedEphemeris object.
+typedef boost::shared_ptr< CachedEphemeris > CachedEphemerisPointer;
+
+} // namespace ephemerides
+} // namespace tudat
+
+#endif // TUDAT_CACHED_EPHEMERIS_H
@@ -40,6 +40,7 @@
  *      110310    K. Kumar          Changed naming from Laplacian to gradient tensor.
  *      120326    D. Dirkx          Changed raw pointers to shared pointers.
  *      120521    F. Belien         Boostified unit test.
+ *      261016    agent             Added test of batch evaluation of potential and its gradient.
  *
  *    References
  *
@@ -160,6 +161,51 @@ BOOST_AUTO_TEST_CASE( testGetPotential )
                                        std::numeric_limits< double >::epsilon( ) );
 }
 
+BOOST_AUTO_TEST_CASE( testGetPotentialsAndGradientsOfPotential )
+{
+    // Set positions with respect to geometric center as rows.
+    const Eigen::MatrixXd cartesianPositions = ( Eigen::MatrixXd( 3, 3 )
+                                                 << 5.0e6, 3.0e6, 1.0e6,
+                                                 -2.0e6, 7.0e6, 4.0e6,
+                                                 1.0e5, -3.0e6, -6.0e6 ).finished( );
+
+    // Create gravity field for myPlanet, with origin offset from the geometric center.
+    using gravitation::SphericalHarmonicsGravityField;
+    SphericalHarmonicsGravityField myPlanetGravityField;
+    myPlanetGravityField.setGravitationalParameter( 22032.00 );
+    myPlanetGravityField.setOrigin( Eigen::Vector3d( 1.0e3, -2.0e3, 3.0e3 ) );
+
+    // Get the potentials and gradients of the potential for all positions at once.
+    const Eigen::VectorXd computedPotentials
+            = myPlanetGravityField.getPotentials( cartesianPositions );
+    const Eigen::MatrixXd computedGradientsOfPotential
+            = myPlanetGravityField.getGradientsOfPotential( cartesianPositions );
+
+    // Check that computed values match values for single positions.
+    BOOST_CHECK_EQUAL( computedPotentials.rows( ), 3 );
+    BOOST_CHECK_EQUAL( computedGradientsOfPotential.rows( ), 3 );
+    for ( int i = 0; i < cartesianPositions.rows( ); i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    computedPotentials( i ),
+                    myPlanetGravityField.getPotential( cartesianPositions.row( i ).transpose( ) ),
+                    std::numeric_limits< double >::epsilon( ) );
+
+        const Eigen::Vector3d expectedGradientOfPotential
+                = myPlanetGravityField.getGradientOfPotential(
+                    cartesianPositions.row( i ).transpose( ) );
+        const Eigen::Vector3d computedGradientOfPotential
+                = computedGradientsOfPotential.row( i ).transpose( );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedGradientOfPotential,
+                                           computedGradientOfPotential,
+                                           4.0 * std::numeric_limits< double >::epsilon( ) );
+    }
+
+    // Check that positions that are not given as rows of three coordinates are rejected.
+    BOOST_CHECK_THROW( myPlanetGravityField.getPotentials( Eigen::MatrixXd::Zero( 3, 2 ) ),
+                       std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace tudat
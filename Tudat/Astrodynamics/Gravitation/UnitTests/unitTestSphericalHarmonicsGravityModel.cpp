@@ -26,6 +26,8 @@
  *      YYMMDD    Author            Comment
  *      121017    E. Dekens         Created file.
  *      121022    K. Kumar          Added unit test for wrapper class.
+ *      261016    agent             Added comparison of acceleration sum with sum of single terms.
+ *      261016    agent             Added test of batch evaluation of accelerations and potentials.
  *
  *    References
  *      Mathworks. gravitysphericalharmonic, Implement spherical harmonic representation of
@@ -311,6 +313,173 @@ BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationWrapperCla
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, acceleration, 1.0e-15 );
 }
 
+// Check the sum of all harmonics terms up to degree = 30 and order = 20 against the sum of the
+// accelerations due to the single terms.
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationSumOfSingleTerms )
+{
+    // Short-cuts.
+    using namespace gravitation;
+
+    // Define gravitational parameter and radius of Earth.
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    // Define arbitrary geodesy-normalized coefficients, with magnitudes decreasing with degree.
+    const int highestDegree = 31;
+    const int highestOrder = 21;
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( highestDegree, highestOrder );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( highestDegree, highestOrder );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    for ( int degree = 2; degree < highestDegree; degree++ )
+    {
+        for ( int order = 0; order <= degree && order < highestOrder; order++ )
+        {
+            cosineCoefficients( degree, order ) = 1.0e-5 * std::cos( 1.0 + degree * order )
+                    / static_cast< double >( degree * degree );
+            if ( order > 0 )
+            {
+                sineCoefficients( degree, order ) = 1.0e-5 * std::sin( 2.0 + degree - order )
+                        / static_cast< double >( degree * degree );
+            }
+        }
+    }
+
+    // Define arbitrary Cartesian position [m].
+    const Eigen::Vector3d position( -4.0e6, 3.0e6, 5.5e6 );
+
+    // Compute acceleration as sum of accelerations due to single terms [m s^-2].
+    Eigen::Vector3d expectedAcceleration = Eigen::Vector3d::Zero( );
+    for ( int degree = 0; degree < highestDegree; degree++ )
+    {
+        for ( int order = 0; order <= degree && order < highestOrder; order++ )
+        {
+            expectedAcceleration += computeSingleGeodesyNormalizedGravitationalAcceleration(
+                        position, gravitationalParameter, planetaryRadius, degree, order,
+                        cosineCoefficients( degree, order ), sineCoefficients( degree, order ) );
+        }
+    }
+
+    // Compute acceleration using the acceleration sum, twice with the same cache [m s^-2].
+    basic_mathematics::SphericalHarmonicsCache sphericalHarmonicsCache;
+    for ( int evaluation = 0; evaluation < 2; evaluation++ )
+    {
+        const Eigen::Vector3d acceleration = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    position, gravitationalParameter, planetaryRadius,
+                    cosineCoefficients, sineCoefficients, sphericalHarmonicsCache );
+
+        // Check if expected result matches computed result.
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, acceleration, 1.0e-13 );
+    }
+}
+
+// Check the batch evaluation of accelerations and potentials for a grid of positions.
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationsAndPotentials )
+{
+    // Short-cuts.
+    using namespace gravitation;
+
+    // Define gravitational parameter and radius of Earth.
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    // Define arbitrary geodesy-normalized coefficients up to degree and order 12.
+    const int highestDegree = 13;
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( highestDegree, highestDegree );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( highestDegree, highestDegree );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    for ( int degree = 2; degree < highestDegree; degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            cosineCoefficients( degree, order ) = 1.0e-6 * std::cos( 0.5 * degree + order );
+            if ( order > 0 )
+            {
+                sineCoefficients( degree, order ) = 1.0e-6 * std::sin( degree - 0.3 * order );
+            }
+        }
+    }
+
+    // Define grid of positions, with positions at the same latitude in consecutive rows [m].
+    const int numberOfLatitudes = 7;
+    const int numberOfLongitudes = 9;
+    const double radius = 7.0e6;
+    Eigen::MatrixXd positions( numberOfLatitudes * numberOfLongitudes, 3 );
+    for ( int i = 0; i < numberOfLatitudes; i++ )
+    {
+        const double latitude = -1.2 + 0.4 * i;
+        for ( int j = 0; j < numberOfLongitudes; j++ )
+        {
+            const double longitude = -3.0 + 0.7 * j;
+            positions.row( i * numberOfLongitudes + j )
+                    << radius * std::cos( latitude ) * std::cos( longitude ),
+                    radius * std::cos( latitude ) * std::sin( longitude ),
+                    radius * std::sin( latitude );
+        }
+    }
+
+    // Compute accelerations and potentials, serially and using multiple threads.
+    Eigen::MatrixXd serialAccelerations, parallelAccelerations;
+    Eigen::VectorXd serialPotentials, parallelPotentials;
+    computeGeodesyNormalizedGravitationalAccelerationsAndPotentials(
+                positions, gravitationalParameter, planetaryRadius, cosineCoefficients,
+                sineCoefficients, serialAccelerations, serialPotentials );
+    computeGeodesyNormalizedGravitationalAccelerationsAndPotentials(
+                positions, gravitationalParameter, planetaryRadius, cosineCoefficients,
+                sineCoefficients, parallelAccelerations, parallelPotentials, 4 );
+
+    // Check that results match single-position evaluation.
+    for ( int i = 0; i < positions.rows( ); i++ )
+    {
+        const Eigen::Vector3d position = positions.row( i ).transpose( );
+        const Eigen::Vector3d expectedAcceleration
+                = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    position, gravitationalParameter, planetaryRadius,
+                    cosineCoefficients, sineCoefficients );
+
+        const Eigen::Vector3d serialAcceleration = serialAccelerations.row( i ).transpose( );
+        const Eigen::Vector3d parallelAcceleration = parallelAccelerations.row( i ).transpose( );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, serialAcceleration, 1.0e-15 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, parallelAcceleration, 1.0e-15 );
+        BOOST_CHECK_EQUAL( serialPotentials( i ), parallelPotentials( i ) );
+
+        // Check that potential is dominated by central term.
+        BOOST_CHECK_CLOSE_FRACTION( serialPotentials( i ), gravitationalParameter / radius,
+                                    1.0e-4 );
+    }
+
+    // Check that potential gradient matches acceleration, using central differences along the
+    // Cartesian axes.
+    const double positionPerturbation = 10.0;
+    Eigen::MatrixXd perturbedPositions( 6, 3 );
+    for ( int axis = 0; axis < 3; axis++ )
+    {
+        perturbedPositions.row( 2 * axis ) = positions.row( 10 );
+        perturbedPositions( 2 * axis, axis ) += positionPerturbation;
+        perturbedPositions.row( 2 * axis + 1 ) = positions.row( 10 );
+        perturbedPositions( 2 * axis + 1, axis ) -= positionPerturbation;
+    }
+
+    Eigen::MatrixXd perturbedAccelerations;
+    Eigen::VectorXd perturbedPotentials;
+    computeGeodesyNormalizedGravitationalAccelerationsAndPotentials(
+                perturbedPositions, gravitationalParameter, planetaryRadius, cosineCoefficients,
+                sineCoefficients, perturbedAccelerations, perturbedPotentials, 2 );
+    for ( int axis = 0; axis < 3; axis++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    ( perturbedPotentials( 2 * axis ) - perturbedPotentials( 2 * axis + 1 ) )
+                    / ( 2.0 * positionPerturbation ), serialAccelerations( 10, axis ), 1.0e-6 );
+    }
+
+    // Check that an exception thrown by one of the threads is rethrown.
+    positions.row( 20 ) *= 0.5;
+    BOOST_CHECK_THROW( computeGeodesyNormalizedGravitationalAccelerationsAndPotentials(
+                           positions, gravitationalParameter, planetaryRadius,
+                           cosineCoefficients, sineCoefficients,
+                           parallelAccelerations, parallelPotentials, 4 ),
+                       std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
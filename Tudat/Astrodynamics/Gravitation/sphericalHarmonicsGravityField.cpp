@@ -38,6 +38,7 @@
  *      110805    K. Kumar          Added predefined functionality with WGS-72 and WGS-84 predefined
  *                                  predefined Earth gravity fields.
  *      120326    D. Dirkx          Changed raw pointers to shared pointers.
+ *      261016    agent             Added batch evaluation of potential and its gradient.
  *
  *    References
  *      Vallado, D. A., Crawford, P., Hujsak, R., & Kelso, T. Revisiting Spacetrack Report #3:
@@ -49,6 +50,9 @@
  */
 
 #include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
 
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityField.h"
 
@@ -117,6 +121,49 @@ void SphericalHarmonicsGravityField::setPredefinedSphericalHarmonicsGravityField
     };
 }
 
+//! Get the gravitational potential at multiple positions.
+Eigen::VectorXd SphericalHarmonicsGravityField::getPotentials( const Eigen::MatrixXd& positions )
+{
+    // If positions are not given as rows of three Cartesian coordinates...
+    if ( positions.cols( ) != 3 )
+    {
+        // ...throw runtime error.
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Positions must be given as a matrix with three columns." ) ) );
+    }
+
+    // Compute and return potentials, from distances with respect to origin.
+    return gravitationalParameter_
+            * ( positions.rowwise( ) - positionOfOrigin_.transpose( ) ).rowwise( ).norm( )
+            .array( ).inverse( ).matrix( );
+}
+
+//! Get the gradient of the gravitational potential at multiple positions.
+Eigen::MatrixXd SphericalHarmonicsGravityField::getGradientsOfPotential(
+        const Eigen::MatrixXd& positions )
+{
+    // If positions are not given as rows of three Cartesian coordinates...
+    if ( positions.cols( ) != 3 )
+    {
+        // ...throw runtime error.
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Positions must be given as a matrix with three columns." ) ) );
+    }
+
+    // Compute relative positions with respect to origin.
+    const Eigen::MatrixXd relativePositions = positions.rowwise( ) - positionOfOrigin_.transpose( );
+
+    // Compute and return gradients of potential.
+    const Eigen::ArrayXd inverseCubedDistances
+            = relativePositions.rowwise( ).norm( ).array( ).cube( ).inverse( );
+    return -gravitationalParameter_
+            * ( relativePositions.array( ).colwise( ) * inverseCubedDistances ).matrix( );
+}
+
 //! Get gradient tensor of the gravitational potential.
 Eigen::Matrix3d SphericalHarmonicsGravityField::
         getGradientTensorOfPotential( const Eigen::Vector3d& position )
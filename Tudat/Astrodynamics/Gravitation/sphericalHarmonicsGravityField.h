@@ -37,6 +37,7 @@
  *                                  predefined Earth gravity fields.
  *      120326    D. Dirkx          Changed raw pointers to shared pointers.
  *      130121    K. Kumar          Added shared-ptr typedef.
+ *      261016    agent             Added batch evaluation of potential and its gradient.
  *
  *    References
  *      Vallado, D. A., Crawford, P., Hujsak, R., & Kelso, T. Revisiting Spacetrack Report #3:
@@ -164,6 +165,29 @@ public:
                 / pow( relativePosition_.norm( ), 3.0 );
     }
 
+    //! Get the gravitational potential at multiple positions.
+    /*!
+     * Returns the values of the gravitational potential, expressed in spherical harmonics, for
+     * the given positions, in the same way as getPotential( ), but evaluated for all positions
+     * at once. For the evaluation of full spherical harmonics expansions at multiple positions,
+     * see computeGeodesyNormalizedGravitationalAccelerationsAndPotentials( ).
+     * \param positions Matrix with positions at which potential is to be determined as rows
+     *          (N x 3).
+     * \return Vector of gravitational potentials (N x 1).
+     */
+    Eigen::VectorXd getPotentials( const Eigen::MatrixXd& positions );
+
+    //! Get the gradient of the gravitational potential at multiple positions.
+    /*!
+     * Returns the values of the gradient of the gravitational potential, expressed in spherical
+     * harmonics, for the given positions, in the same way as getGradientOfPotential( ), but
+     * evaluated for all positions at once.
+     * \param positions Matrix with positions at which gradient of potential is to be determined
+     *          as rows (N x 3).
+     * \return Matrix with gradients of gravitational potential as rows (N x 3).
+     */
+    Eigen::MatrixXd getGradientsOfPotential( const Eigen::MatrixXd& positions );
+
     //! Get gradient tensor of the gravitational potential.
     /*!
      * Returns the value of the gradient tensor of the gravitational potential expressed in
@@ -25,6 +25,13 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      121017    E. Dekens         Code created.
+ *      261016    agent             Replaced cached Legendre polynomial lookups in acceleration
+ *                                  sum by dense Legendre table.
+ *      261016    agent             Replaced term-by-term evaluation of acceleration sum by
+ *                                  vectorized summation over degree, using recurrences for
+ *                                  radius powers and multiple-longitude sines and cosines.
+ *      261016    agent             Added potential to acceleration sum; added batch evaluation of
+ *                                  accelerations and potentials.
  *
  *    References
  *
@@ -32,12 +39,16 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <vector>
 
+#include <boost/bind.hpp>
 #include <boost/exception/all.hpp>
 #include <boost/math/constants/constants.hpp>
+#include <boost/thread.hpp>
 
 #include "Eigen/Core"
 
@@ -65,6 +76,45 @@ Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
         const double equatorialRadius,
         const Eigen::MatrixXd& cosineHarmonicCoefficients,
         const Eigen::MatrixXd& sineHarmonicCoefficients )
+{
+    // Declare spherical harmonics cache, and compute acceleration.
+    basic_mathematics::SphericalHarmonicsCache sphericalHarmonicsCache;
+    return computeGeodesyNormalizedGravitationalAccelerationSum(
+                positionOfBodySubjectToAcceleration, gravitationalParameter, equatorialRadius,
+                cosineHarmonicCoefficients, sineHarmonicCoefficients, sphericalHarmonicsCache );
+}
+
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, defined using
+//! geodesy-normalization, using a preallocated spherical harmonics cache.
+Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        basic_mathematics::SphericalHarmonicsCache& sphericalHarmonicsCache )
+{
+    // Declare acceleration and potential, and compute both.
+    Eigen::Vector3d acceleration;
+    double potential;
+    computeGeodesyNormalizedGravitationalAccelerationAndPotentialSum(
+                positionOfBodySubjectToAcceleration, gravitationalParameter, equatorialRadius,
+                cosineHarmonicCoefficients, sineHarmonicCoefficients, sphericalHarmonicsCache,
+                acceleration, potential );
+    return acceleration;
+}
+
+//! Compute gravitational acceleration and potential due to multiple spherical harmonics terms,
+//! defined using geodesy-normalization.
+void computeGeodesyNormalizedGravitationalAccelerationAndPotentialSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        basic_mathematics::SphericalHarmonicsCache& sphericalHarmonicsCache,
+        Eigen::Vector3d& acceleration,
+        double& potential )
 {
     // Set highest degree and order.
     const int highestDegree = cosineHarmonicCoefficients.rows( );
@@ -114,49 +164,231 @@ Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
     // Compute gradient premultiplier.
     const double preMultiplier = gravitationalParameter / equatorialRadius;
 
-    // Initialize gradient vector.
+    // Compute Legendre polynomials, radius ratio powers and sines and cosines of multiples of the
+    // longitude, through recurrence relations, for the current position.
+    const int highestComputedOrder = std::min( highestOrder, highestDegree );
+    sphericalHarmonicsCache.setMaximumDegreeAndOrder(
+                std::max( highestDegree - 1, 0 ), std::max( highestComputedOrder - 1, 0 ) );
+    sphericalHarmonicsCache.update(
+                sphericalpositionOfBodySubjectToAcceleration( 0 ),
+                std::sin( sphericalpositionOfBodySubjectToAcceleration( 1 ) ),
+                sphericalpositionOfBodySubjectToAcceleration( 2 ),
+                equatorialRadius );
+
+    const basic_mathematics::GeodesyLegendreTable& legendreTable
+            = sphericalHarmonicsCache.getLegendreTable( );
+    const Eigen::VectorXd& radiusRatioPowers = sphericalHarmonicsCache.getRadiusRatioPowers( );
+    const Eigen::VectorXd& cosinesOfMultipleLongitude
+            = sphericalHarmonicsCache.getCosinesOfMultipleLongitude( );
+    const Eigen::VectorXd& sinesOfMultipleLongitude
+            = sphericalHarmonicsCache.getSinesOfMultipleLongitude( );
+
+    // Initialize gradient vector and potential.
     Eigen::Vector3d sphericalGradient = Eigen::Vector3d::Zero( );
+    potential = 0.0;
+
+    // Loop through all orders. For each order, the contributions of all degrees are summed over
+    // contiguous memory: the Legendre polynomials are stored order-by-order, and the coefficient
+    // matrices column-by-column. The sines and cosines of the order times the longitude are common
+    // to all terms of one order, and are applied after the summation (see
+    // basic_mathematics::computePotentialGradient( ) for the gradient of a single term).
+    for ( int order = 0; order < highestComputedOrder; order++ )
+    {
+        const int numberOfDegrees = highestDegree - order;
+
+        const Eigen::Map< const Eigen::ArrayXd > legendrePolynomials(
+                    legendreTable.getLegendrePolynomialsOfOrder( order ), numberOfDegrees );
+        const Eigen::Map< const Eigen::ArrayXd > legendrePolynomialDerivatives(
+                    legendreTable.getLegendrePolynomialDerivativesOfOrder( order ),
+                    numberOfDegrees );
+        const Eigen::Map< const Eigen::ArrayXd > powers(
+                    &radiusRatioPowers( order ), numberOfDegrees );
+        const Eigen::Map< const Eigen::ArrayXd > cosineCoefficients(
+                    &cosineHarmonicCoefficients( order, order ), numberOfDegrees );
+        const Eigen::Map< const Eigen::ArrayXd > sineCoefficients(
+                    &sineHarmonicCoefficients( order, order ), numberOfDegrees );
+
+        // Compute sums over degree of the terms multiplying the cosine and sine coefficients.
+        const double cosineRadialSum = ( powers * legendrePolynomials * cosineCoefficients
+                                         * Eigen::ArrayXd::LinSpaced(
+                                             numberOfDegrees, order + 1.0,
+                                             static_cast< double >( highestDegree ) ) ).sum( );
+        const double sineRadialSum = ( powers * legendrePolynomials * sineCoefficients
+                                       * Eigen::ArrayXd::LinSpaced(
+                                           numberOfDegrees, order + 1.0,
+                                           static_cast< double >( highestDegree ) ) ).sum( );
+        const double cosineLatitudeSum
+                = ( powers * legendrePolynomialDerivatives * cosineCoefficients ).sum( );
+        const double sineLatitudeSum
+                = ( powers * legendrePolynomialDerivatives * sineCoefficients ).sum( );
+        const double cosineLongitudeSum
+                = ( powers * legendrePolynomials * cosineCoefficients ).sum( );
+        const double sineLongitudeSum
+                = ( powers * legendrePolynomials * sineCoefficients ).sum( );
+
+        // Add the contributions of this order to the potential gradient.
+        sphericalGradient( basic_mathematics::radiusIndex ) -= preMultiplier
+                / sphericalpositionOfBodySubjectToAcceleration( 0 )
+                * ( cosinesOfMultipleLongitude( order ) * cosineRadialSum
+                    + sinesOfMultipleLongitude( order ) * sineRadialSum );
+        sphericalGradient( basic_mathematics::latitudeIndex ) += preMultiplier
+                * std::cos( sphericalpositionOfBodySubjectToAcceleration( 1 ) )
+                * ( cosinesOfMultipleLongitude( order ) * cosineLatitudeSum
+                    + sinesOfMultipleLongitude( order ) * sineLatitudeSum );
+        sphericalGradient( basic_mathematics::longitudeIndex ) += preMultiplier
+                * static_cast< double >( order )
+                * ( cosinesOfMultipleLongitude( order ) * sineLongitudeSum
+                    - sinesOfMultipleLongitude( order ) * cosineLongitudeSum );
+        potential += preMultiplier
+                * ( cosinesOfMultipleLongitude( order ) * cosineLongitudeSum
+                    + sinesOfMultipleLongitude( order ) * sineLongitudeSum );
+    }
 
-    // Loop through all degrees.
-    for ( int degree = 0; degree < highestDegree; degree++ )
+    // Convert from spherical gradient to Cartesian gradient (which equals acceleration vector).
+    acceleration = basic_mathematics::coordinate_conversions::convertSphericalToCartesianGradient(
+                sphericalGradient, positionOfBodySubjectToAcceleration );
+}
+
+//! Compute gravitational accelerations and potentials due to multiple spherical harmonics terms
+//! for a block of positions.
+void computeGeodesyNormalizedGravitationalAccelerationsAndPotentialsOfBlock(
+        const Eigen::MatrixXd& positionsOfBodiesSubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        Eigen::MatrixXd& accelerations,
+        Eigen::VectorXd& potentials,
+        boost::exception_ptr& exceptionPointer )
+{
+    try
     {
-        // Loop through all orders.
-        for ( int order = 0; order <= degree && order < highestOrder; order++ )
+        const int numberOfPositions = positionsOfBodiesSubjectToAcceleration.rows( );
+        accelerations.resize( numberOfPositions, 3 );
+        potentials.resize( numberOfPositions );
+
+        // Declare spherical harmonics cache, which is shared by all positions in the block, such
+        // that the Legendre polynomials are only recomputed if the latitude changes.
+        basic_mathematics::SphericalHarmonicsCache sphericalHarmonicsCache;
+
+        Eigen::Vector3d acceleration;
+        for ( int position = 0; position < numberOfPositions; position++ )
         {
-            // Compute geodesy-normalized Legendre polynomials.
-            const double legendrePolynomial = basic_mathematics::computeGeodesyLegendrePolynomial(
-                        degree, order,
-                        std::sin( sphericalpositionOfBodySubjectToAcceleration( 1 ) ) );
-            const double incrementedLegendrePolynomial =
-                    basic_mathematics::computeGeodesyLegendrePolynomial(
-                        degree, order + 1,
-                        std::sin( sphericalpositionOfBodySubjectToAcceleration( 1 ) ) );
-
-            // Compute geodesy-normalized Legendre polynomial derivative.
-            const double legendrePolynomialDerivative =
-                    basic_mathematics::computeGeodesyLegendrePolynomialDerivative(
-                        degree, order,
-                        std::sin( sphericalpositionOfBodySubjectToAcceleration( 1 ) ),
-                        legendrePolynomial, incrementedLegendrePolynomial );
-
-            // Compute the potential gradient of a single spherical harmonic term.
-            sphericalGradient += basic_mathematics::computePotentialGradient(
-                        sphericalpositionOfBodySubjectToAcceleration,
-                        equatorialRadius,
-                        preMultiplier,
-                        degree,
-                        order,
-                        cosineHarmonicCoefficients( degree, order ),
-                        sineHarmonicCoefficients( degree, order ),
-                        legendrePolynomial,
-                        legendrePolynomialDerivative );
+            computeGeodesyNormalizedGravitationalAccelerationAndPotentialSum(
+                        positionsOfBodiesSubjectToAcceleration.row( position ).transpose( ),
+                        gravitationalParameter, equatorialRadius,
+                        cosineHarmonicCoefficients, sineHarmonicCoefficients,
+                        sphericalHarmonicsCache, acceleration, potentials( position ) );
+            accelerations.row( position ) = acceleration.transpose( );
         }
     }
 
-    // Convert from spherical gradient to Cartesian gradient (which equals acceleration vector) and
-    // return the resulting acceleration vector.
-    return basic_mathematics::coordinate_conversions::convertSphericalToCartesianGradient(
-                sphericalGradient, positionOfBodySubjectToAcceleration );
+    catch ( ... )
+    {
+        exceptionPointer = boost::current_exception( );
+    }
+}
+
+//! Compute gravitational accelerations and potentials due to multiple spherical harmonics terms
+//! for multiple positions.
+void computeGeodesyNormalizedGravitationalAccelerationsAndPotentials(
+        const Eigen::MatrixXd& positionsOfBodiesSubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        Eigen::MatrixXd& accelerations,
+        Eigen::VectorXd& potentials,
+        const unsigned int numberOfThreads )
+{
+    // If positions are not given as rows of three Cartesian coordinates...
+    if ( positionsOfBodiesSubjectToAcceleration.cols( ) != 3 )
+    {
+        // ...throw runtime error.
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Positions must be given as a matrix with three columns." ) ) );
+    }
+
+    const int numberOfPositions = positionsOfBodiesSubjectToAcceleration.rows( );
+
+    // Determine the number of blocks, such that each thread handles at least one position.
+    const int numberOfBlocks = std::max(
+                1, std::min( numberOfPositions, static_cast< int >( numberOfThreads ) ) );
+
+    std::vector< boost::exception_ptr > exceptionPointers( numberOfBlocks );
+
+    if ( numberOfBlocks == 1 )
+    {
+        computeGeodesyNormalizedGravitationalAccelerationsAndPotentialsOfBlock(
+                    positionsOfBodiesSubjectToAcceleration,
+                    gravitationalParameter, equatorialRadius,
+                    cosineHarmonicCoefficients, sineHarmonicCoefficients,
+                    accelerations, potentials, exceptionPointers[ 0 ] );
+    }
+
+    else
+    {
+        // Distribute the positions over the blocks as evenly as possible, keeping consecutive
+        // positions together.
+        std::vector< int > firstPositionsOfBlocks( numberOfBlocks + 1, 0 );
+        for ( int block = 0; block < numberOfBlocks; block++ )
+        {
+            firstPositionsOfBlocks[ block + 1 ] = firstPositionsOfBlocks[ block ]
+                    + numberOfPositions / numberOfBlocks
+                    + ( block < numberOfPositions % numberOfBlocks ? 1 : 0 );
+        }
+
+        std::vector< Eigen::MatrixXd > positionsOfBlocks( numberOfBlocks );
+        std::vector< Eigen::MatrixXd > accelerationsOfBlocks( numberOfBlocks );
+        std::vector< Eigen::VectorXd > potentialsOfBlocks( numberOfBlocks );
+
+        boost::thread_group threads;
+        for ( int block = 0; block < numberOfBlocks; block++ )
+        {
+            positionsOfBlocks[ block ] = positionsOfBodiesSubjectToAcceleration.middleRows(
+                        firstPositionsOfBlocks[ block ],
+                        firstPositionsOfBlocks[ block + 1 ] - firstPositionsOfBlocks[ block ] );
+
+            threads.create_thread( boost::bind(
+                    &computeGeodesyNormalizedGravitationalAccelerationsAndPotentialsOfBlock,
+                    boost::cref( positionsOfBlocks[ block ] ),
+                    gravitationalParameter, equatorialRadius,
+                    boost::cref( cosineHarmonicCoefficients ),
+                    boost::cref( sineHarmonicCoefficients ),
+                    boost::ref( accelerationsOfBlocks[ block ] ),
+                    boost::ref( potentialsOfBlocks[ block ] ),
+                    boost::ref( exceptionPointers[ block ] ) ) );
+        }
+
+        threads.join_all( );
+
+        // Collect the results of the blocks.
+        accelerations.resize( numberOfPositions, 3 );
+        potentials.resize( numberOfPositions );
+        for ( int block = 0; block < numberOfBlocks; block++ )
+        {
+            if ( !exceptionPointers[ block ] )
+            {
+                accelerations.middleRows( firstPositionsOfBlocks[ block ],
+                                          positionsOfBlocks[ block ].rows( ) )
+                        = accelerationsOfBlocks[ block ];
+                potentials.segment( firstPositionsOfBlocks[ block ],
+                                    positionsOfBlocks[ block ].rows( ) )
+                        = potentialsOfBlocks[ block ];
+            }
+        }
+    }
+
+    // Rethrow the first exception encountered by any of the blocks.
+    for ( int block = 0; block < numberOfBlocks; block++ )
+    {
+        if ( exceptionPointers[ block ] )
+        {
+            boost::rethrow_exception( exceptionPointers[ block ] );
+        }
+    }
 }
 
 //! Compute gravitational acceleration due to single spherical harmonics term.
@@ -30,6 +30,11 @@
  *                                  renamed file, and merged content from other files.
  *      121210    D. Dirkx          Simplified class by removing template parameters.
  *      130224    K. Kumar          Updated include guard name; corrected Doxygen errors.
+ *      261016    agent             Added overload of acceleration sum using a Legendre table;
+ *                                  model now reuses its own Legendre table between calls.
+ *      261016    agent             Replaced Legendre table by spherical harmonics cache.
+ *      261016    agent             Added computation of potential, and batch evaluation of
+ *                                  accelerations and potentials for multiple positions.
  *
  *    References
  *      Heiskanen, W.A., Moritz, H. Physical geodesy. Freeman, 1967.
@@ -46,6 +51,7 @@
 
 #include <stdexcept>
 
+#include <boost/exception_ptr.hpp>
 #include <boost/function.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/shared_ptr.hpp>
@@ -54,6 +60,7 @@
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
+#include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
 
 namespace tudat
 {
@@ -110,6 +117,152 @@ Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
         const Eigen::MatrixXd& cosineHarmonicCoefficients,
         const Eigen::MatrixXd& sineHarmonicCoefficients );
 
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, defined using
+//! geodesy-normalization, using a preallocated spherical harmonics cache.
+/*!
+ * This function computes the acceleration caused by gravitational spherical harmonics, with the
+ * coefficients expressed using a geodesy-normalization, in the same way as the function above.
+ * The geodesy-normalized Legendre polynomials and their derivatives, the powers of the radius
+ * ratio and the sines and cosines of multiples of the longitude are computed once, through
+ * recurrence relations, and stored in the spherical harmonics cache provided, which can be reused
+ * between calls to avoid memory allocation. The contributions of all degrees of a given order are
+ * summed using (vectorizable) array operations on contiguous memory.
+ * \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the
+ *          reference frame that is associated with the harmonic coefficients.
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+ *          coefficients.
+ * \param sphericalHarmonicsCache Spherical harmonics cache, which is resized if its maximum
+ *          degree and order do not match the coefficient matrices, and updated for the current
+ *          position.
+ * \return Cartesian acceleration vector resulting from the summation of all harmonic terms.
+ */
+Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        basic_mathematics::SphericalHarmonicsCache& sphericalHarmonicsCache );
+
+//! Compute gravitational acceleration and potential due to multiple spherical harmonics terms,
+//! defined using geodesy-normalization.
+/*!
+ * This function computes the acceleration caused by gravitational spherical harmonics, in the
+ * same way as computeGeodesyNormalizedGravitationalAccelerationSum( ), as well as the associated
+ * gravitational potential:
+ * \f[
+ *     U = \frac{ \mu }{ R } \sum_{ n = 0 }^{ N } \sum_{ m = 0 }^{ n }
+ *     \left( \frac{ R }{ r } \right)^{ n + 1 } \bar{ P }_{ n, m }( \sin \phi )
+ *     \left[ \bar{ C }_{ n, m } \cos( m \lambda ) + \bar{ S }_{ n, m } \sin( m \lambda ) \right]
+ * \f]
+ * which is defined such that its gradient is equal to the acceleration (i.e., the potential of
+ * the central term is \f$ \mu / r \f$). The potential is obtained from the same sums as the
+ * acceleration, at negligible additional cost.
+ * \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the
+ *          reference frame that is associated with the harmonic coefficients.
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+ *          coefficients.
+ * \param sphericalHarmonicsCache Spherical harmonics cache, which is resized if required, and
+ *          updated for the current position.
+ * \param acceleration Cartesian acceleration vector resulting from the summation of all
+ *          harmonic terms [m s^-2] (returned by reference).
+ * \param potential Gravitational potential resulting from the summation of all harmonic terms
+ *          [m^2 s^-2] (returned by reference).
+ */
+void computeGeodesyNormalizedGravitationalAccelerationAndPotentialSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        basic_mathematics::SphericalHarmonicsCache& sphericalHarmonicsCache,
+        Eigen::Vector3d& acceleration,
+        double& potential );
+
+//! Compute gravitational accelerations and potentials due to multiple spherical harmonics terms
+//! for a block of positions.
+/*!
+ * This function computes the accelerations and potentials caused by gravitational spherical
+ * harmonics for a block of positions, using
+ * computeGeodesyNormalizedGravitationalAccelerationAndPotentialSum( ). A single spherical
+ * harmonics cache is used for all positions in the block, such that the Legendre polynomials are
+ * not recomputed for consecutive positions at the same latitude (i.e., with identical sine of the
+ * latitude). Each block has its own output matrices, such that blocks can be computed
+ * concurrently. Any exception thrown is caught and stored, such that it can be rethrown by the
+ * calling thread.
+ * \param positionsOfBodiesSubjectToAcceleration Matrix with Cartesian position vectors [m] of
+ *          block as rows (N x 3).
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+ *          coefficients.
+ * \param accelerations Matrix with Cartesian acceleration vectors [m s^-2] as rows (N x 3)
+ *          (returned by reference).
+ * \param potentials Vector with gravitational potentials [m^2 s^-2] (N x 1) (returned by
+ *          reference).
+ * \param exceptionPointer Pointer to exception thrown during computation, if any (returned by
+ *          reference).
+ */
+void computeGeodesyNormalizedGravitationalAccelerationsAndPotentialsOfBlock(
+        const Eigen::MatrixXd& positionsOfBodiesSubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        Eigen::MatrixXd& accelerations,
+        Eigen::VectorXd& potentials,
+        boost::exception_ptr& exceptionPointer );
+
+//! Compute gravitational accelerations and potentials due to multiple spherical harmonics terms
+//! for multiple positions.
+/*!
+ * This function computes the accelerations and potentials caused by gravitational spherical
+ * harmonics, with the coefficients expressed using a geodesy-normalization, for multiple
+ * positions at once (e.g., a grid of points). The positions are distributed over the given
+ * number of threads in contiguous blocks of rows, each of which is evaluated with a single
+ * spherical harmonics cache (see
+ * computeGeodesyNormalizedGravitationalAccelerationsAndPotentialsOfBlock( )). To benefit from the
+ * reuse of the Legendre polynomials, positions at the same latitude should therefore be stored in
+ * consecutive rows.
+ * \param positionsOfBodiesSubjectToAcceleration Matrix with Cartesian position vectors [m] as
+ *          rows (N x 3).
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+ *          coefficients.
+ * \param accelerations Matrix with Cartesian acceleration vectors [m s^-2] as rows (N x 3)
+ *          (returned by reference).
+ * \param potentials Vector with gravitational potentials [m^2 s^-2] (N x 1) (returned by
+ *          reference).
+ * \param numberOfThreads Number of threads over which the positions are distributed
+ *          (default = 1).
+ */
+void computeGeodesyNormalizedGravitationalAccelerationsAndPotentials(
+        const Eigen::MatrixXd& positionsOfBodiesSubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        Eigen::MatrixXd& accelerations,
+        Eigen::VectorXd& potentials,
+        const unsigned int numberOfThreads = 1 );
+
 //! Compute gravitational acceleration due to single spherical harmonics term.
 /*!
  * This function computes the acceleration caused by a single gravitational spherical harmonics
@@ -318,6 +471,13 @@ private:
      * spherical harmonics expansion.
      */
     const CoefficientMatrixReturningFunction getSineHarmonicsCoefficients;
+
+    //! Spherical harmonics cache.
+    /*!
+     * Cache of Legendre polynomials, radius ratio powers and multiple-longitude sines and cosines,
+     * reused between calls to getAcceleration( ).
+     */
+    basic_mathematics::SphericalHarmonicsCache sphericalHarmonicsCache;
 };
 
 //! Typedef for SphericalHarmonicsGravitationalAccelerationModelXd.
@@ -343,7 +503,8 @@ Eigen::Vector3d SphericalHarmonicsGravitationalAccelerationModel< CoefficientMat
                 gravitationalParameter,
                 equatorialRadius,
                 cosineHarmonicCoefficients,
-                sineHarmonicCoefficients );
+                sineHarmonicCoefficients,
+                sphericalHarmonicsCache );
 }
 
 } // namespace gravitation
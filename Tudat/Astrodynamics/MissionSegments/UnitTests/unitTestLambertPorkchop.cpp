@@ -0,0 +1,243 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+#include "Tudat/Astrodynamics/MissionSegments/lambertPorkchop.h"
+#include "Tudat/Astrodynamics/MissionSegments/multiRevolutionLambertTargeterIzzo.h"
+#include "Tudat/Mathematics/BasicMathematics/convergenceException.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Ephemeris of body in circular, equatorial orbit, which counts the number of requested states.
+class CircularOrbitEphemeris : public ephemerides::Ephemeris
+{
+public:
+
+    //! Constructor.
+    CircularOrbitEphemeris( const double orbitalRadius, const double gravitationalParameter,
+                            const double initialPhase )
+        : orbitalRadius_( orbitalRadius ),
+          meanMotion_( std::sqrt( gravitationalParameter
+                                  / ( orbitalRadius * orbitalRadius * orbitalRadius ) ) ),
+          initialPhase_( initialPhase ),
+          numberOfRequestedStates_( 0 )
+    { }
+
+    //! Get state from ephemeris.
+    basic_mathematics::Vector6d getCartesianStateFromEphemeris(
+            const double secondsSinceEpoch, const double julianDayAtEpoch )
+    {
+        numberOfRequestedStates_++;
+
+        const double phase = initialPhase_ + meanMotion_ * secondsSinceEpoch;
+        basic_mathematics::Vector6d state;
+        state << orbitalRadius_ * std::cos( phase ), orbitalRadius_ * std::sin( phase ), 0.0,
+                -orbitalRadius_ * meanMotion_ * std::sin( phase ),
+                orbitalRadius_ * meanMotion_ * std::cos( phase ), 0.0;
+        return state;
+    }
+
+    //! Get number of requested states.
+    int getNumberOfRequestedStates( ) { return numberOfRequestedStates_; }
+
+private:
+
+    //! Orbital radius.
+    const double orbitalRadius_;
+
+    //! Mean motion.
+    const double meanMotion_;
+
+    //! Phase at epoch.
+    const double initialPhase_;
+
+    //! Number of requested states.
+    int numberOfRequestedStates_;
+};
+
+BOOST_AUTO_TEST_SUITE( test_lambert_porkchop )
+
+//! Test porkchop grid of Earth-Mars transfers.
+BOOST_AUTO_TEST_CASE( testEarthMarsPorkchopGrid )
+{
+    using namespace mission_segments;
+
+    // Define central body and orbits of departure and arrival bodies.
+    const double astronomicalUnit = 1.49597870691e11;
+    const double sunGravitationalParameter = 1.32712440018e20;
+    const double secondsPerDay = 86400.0;
+    const boost::shared_ptr< CircularOrbitEphemeris > earthEphemeris
+            = boost::make_shared< CircularOrbitEphemeris >(
+                astronomicalUnit, sunGravitationalParameter, 0.0 );
+    const boost::shared_ptr< CircularOrbitEphemeris > marsEphemeris
+            = boost::make_shared< CircularOrbitEphemeris >(
+                1.524 * astronomicalUnit, sunGravitationalParameter, 0.8 );
+
+    // Define departure and arrival times, such that the first arrival time precedes the last
+    // departure times.
+    const int numberOfDepartureTimes = 8;
+    const int numberOfArrivalTimes = 9;
+    const Eigen::VectorXd departureTimes = Eigen::VectorXd::LinSpaced(
+                numberOfDepartureTimes, 0.0, 140.0 * secondsPerDay );
+    const Eigen::VectorXd arrivalTimes = Eigen::VectorXd::LinSpaced(
+                numberOfArrivalTimes, 100.0 * secondsPerDay, 900.0 * secondsPerDay );
+
+    // Compute porkchop grids, serially and using multiple threads, allowing one revolution.
+    LambertPorkchop porkchop( earthEphemeris, marsEphemeris, 2451545.0,
+                              sunGravitationalParameter, 1 );
+    const LambertPorkchopGrid serialGrid = porkchop.computeGrid( departureTimes, arrivalTimes );
+    porkchop.setNumberOfThreads( 3 );
+    const LambertPorkchopGrid parallelGrid = porkchop.computeGrid( departureTimes, arrivalTimes );
+
+    // Check that the ephemerides were only queried once per epoch.
+    BOOST_CHECK_EQUAL( earthEphemeris->getNumberOfRequestedStates( ), numberOfDepartureTimes );
+    BOOST_CHECK_EQUAL( marsEphemeris->getNumberOfRequestedStates( ), numberOfArrivalTimes );
+    BOOST_CHECK_EQUAL( porkchop.getNumberOfCachedStates( ),
+                       numberOfDepartureTimes + numberOfArrivalTimes );
+
+    // Check grid dimensions.
+    BOOST_CHECK_EQUAL( serialGrid.deltaVs.rows( ), numberOfDepartureTimes );
+    BOOST_CHECK_EQUAL( serialGrid.deltaVs.cols( ), numberOfArrivalTimes );
+
+    bool hasMultiRevolutionTransfer = false;
+    for ( int row = 0; row < numberOfDepartureTimes; row++ )
+    {
+        const basic_mathematics::Vector6d departureState
+                = earthEphemeris->getCartesianStateFromEphemeris( departureTimes( row ), 0.0 );
+
+        for ( int column = 0; column < numberOfArrivalTimes; column++ )
+        {
+            // Check that the serial and parallel grids are identical.
+            BOOST_CHECK_EQUAL( serialGrid.numbersOfRevolutions( row, column ),
+                               parallelGrid.numbersOfRevolutions( row, column ) );
+            BOOST_CHECK_EQUAL( serialGrid.rightBranchFlags( row, column ),
+                               parallelGrid.rightBranchFlags( row, column ) );
+
+            // Check that cells in which the arrival time does not exceed the departure time are
+            // infeasible.
+            if ( arrivalTimes( column ) <= departureTimes( row ) )
+            {
+                BOOST_CHECK( serialGrid.deltaVs( row, column )
+                             != serialGrid.deltaVs( row, column ) );
+                BOOST_CHECK( serialGrid.departureC3s( row, column )
+                             != serialGrid.departureC3s( row, column ) );
+                BOOST_CHECK_EQUAL( serialGrid.numbersOfRevolutions( row, column ), -1 );
+                continue;
+            }
+
+            BOOST_CHECK_EQUAL( serialGrid.deltaVs( row, column ),
+                               parallelGrid.deltaVs( row, column ) );
+            BOOST_CHECK_EQUAL( serialGrid.departureC3s( row, column ),
+                               parallelGrid.departureC3s( row, column ) );
+
+            // Solve the Lambert problem for the stored number of revolutions and branch directly,
+            // and check that the delta-V and C3 match.
+            const basic_mathematics::Vector6d arrivalState
+                    = marsEphemeris->getCartesianStateFromEphemeris( arrivalTimes( column ), 0.0 );
+            MultiRevolutionLambertTargeterIzzo lambertTargeter(
+                        departureState.segment( 0, 3 ), arrivalState.segment( 0, 3 ),
+                        arrivalTimes( column ) - departureTimes( row ),
+                        sunGravitationalParameter,
+                        serialGrid.numbersOfRevolutions( row, column ),
+                        serialGrid.rightBranchFlags( row, column ) );
+            const double expectedDepartureExcessVelocity
+                    = ( lambertTargeter.getInertialVelocityAtDeparture( )
+                        - departureState.segment( 3, 3 ) ).norm( );
+            const double expectedArrivalExcessVelocity
+                    = ( lambertTargeter.getInertialVelocityAtArrival( )
+                        - arrivalState.segment( 3, 3 ) ).norm( );
+
+            BOOST_CHECK_CLOSE_FRACTION( serialGrid.deltaVs( row, column ),
+                                        expectedDepartureExcessVelocity
+                                        + expectedArrivalExcessVelocity, 1.0e-12 );
+            BOOST_CHECK_CLOSE_FRACTION( serialGrid.departureC3s( row, column ),
+                                        expectedDepartureExcessVelocity
+                                        * expectedDepartureExcessVelocity, 1.0e-12 );
+
+            // Check that the zero-revolution transfer does not have a lower delta-V.
+            ZeroRevolutionLambertTargeterIzzo zeroRevolutionLambertTargeter(
+                        departureState.segment( 0, 3 ), arrivalState.segment( 0, 3 ),
+                        arrivalTimes( column ) - departureTimes( row ),
+                        sunGravitationalParameter );
+            BOOST_CHECK_LE( serialGrid.deltaVs( row, column ),
+                            ( zeroRevolutionLambertTargeter.getInertialVelocityAtDeparture( )
+                              - departureState.segment( 3, 3 ) ).norm( )
+                            + ( zeroRevolutionLambertTargeter.getInertialVelocityAtArrival( )
+                                - arrivalState.segment( 3, 3 ) ).norm( ) );
+
+            if ( serialGrid.numbersOfRevolutions( row, column ) > 0 )
+            {
+                hasMultiRevolutionTransfer = true;
+            }
+        }
+    }
+
+    // Check that the multi-revolution branches were considered for long transfers.
+    BOOST_CHECK( hasMultiRevolutionTransfer );
+}
+
+//! Test that invalid porkchop settings are rejected.
+BOOST_AUTO_TEST_CASE( testInvalidPorkchopSettings )
+{
+    using namespace mission_segments;
+
+    const boost::shared_ptr< CircularOrbitEphemeris > ephemeris
+            = boost::make_shared< CircularOrbitEphemeris >( 1.0e11, 1.0e20, 0.0 );
+
+    BOOST_CHECK_THROW( LambertPorkchop( ephemeris, ephemeris, 2451545.0, -1.0e20 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( LambertPorkchop( ephemeris, ephemeris, 2451545.0, 1.0e20, -1 ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -41,6 +41,7 @@
  *      120416    T. Secretin       Boostified unit test.
  *      120418    T. Secretin       Adapted to new free function implementation.
  *      120704    P. Musegaas       Minor changes during code check, changed tolerances.
+ *      261016    agent             Added tests of batch Lambert solver.
  *
  *    References
  *      Noomen, R., Lambert targeter Excel file.
@@ -62,6 +63,9 @@
 
 #define BOOST_TEST_MAIN
 
+#include <cmath>
+
+#include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <Eigen/Core>
@@ -71,6 +75,7 @@
 #include <TudatCore/Basics/testMacros.h>
 
 #include "Tudat/Astrodynamics/MissionSegments/lambertRoutines.h"
+#include "Tudat/Mathematics/BasicMathematics/convergenceException.h"
 
 namespace tudat
 {
@@ -578,6 +583,187 @@ BOOST_AUTO_TEST_CASE( testsolveLambertProblemGoodingElliptical )
     BOOST_CHECK_SMALL( testInertialVelocityAtArrival.z( ), tolerance );
 }
 
+//! Test the normalized time-of-flight computation of Izzo's revisited formulation.
+BOOST_AUTO_TEST_CASE( testIzzoNormalizedTimeOfFlightAndDerivatives )
+{
+    // Set transfer geometry in normalized units (departure radius equal to one), for short- and
+    // long-way transfers.
+    const double radiusAtArrival = 1.5;
+    const double transferAngle = 1.0;
+    const double chord = std::sqrt( 1.0 + radiusAtArrival
+                                    * ( radiusAtArrival - 2.0 * std::cos( transferAngle ) ) );
+    const double semiPerimeter = 0.5 * ( 1.0 + radiusAtArrival + chord );
+
+    // Set x-parameters for elliptic, near-parabolic and hyperbolic transfers.
+    const double xParameters[ 6 ] = { -0.7, 0.0, 0.6, 0.995, 1.004, 2.5 };
+
+    for ( int isLongway = 0; isLongway < 2; isLongway++ )
+    {
+        const double lambdaParameter = ( isLongway ? -1.0 : 1.0 )
+                * std::sqrt( 1.0 - chord / semiPerimeter );
+
+        for ( int i = 0; i < 6; i++ )
+        {
+            // Check that time-of-flight matches Lagrange's equation, scaled by the normalization
+            // of the revisited formulation.
+            double firstDerivative, secondDerivative, thirdDerivative;
+            const double normalizedTimeOfFlight
+                    = mission_segments::computeNormalizedTimeOfFlightAndDerivativesIzzo(
+                        xParameters[ i ], lambdaParameter,
+                        firstDerivative, secondDerivative, thirdDerivative );
+            BOOST_CHECK_CLOSE_FRACTION(
+                        normalizedTimeOfFlight,
+                        std::sqrt( 2.0 / ( semiPerimeter * semiPerimeter * semiPerimeter ) )
+                        * mission_segments::computeTimeOfFlightIzzo(
+                            xParameters[ i ], semiPerimeter, chord, isLongway,
+                            semiPerimeter / 2.0 ), 1.0e-10 );
+
+            // Check derivatives using central differences of the lower derivatives.
+            const double xPerturbation = 1.0e-6;
+            double perturbedFirstDerivatives[ 2 ], perturbedSecondDerivatives[ 2 ],
+                    perturbedTimesOfFlight[ 2 ], unusedDerivative;
+            for ( int j = 0; j < 2; j++ )
+            {
+                perturbedTimesOfFlight[ j ]
+                        = mission_segments::computeNormalizedTimeOfFlightAndDerivativesIzzo(
+                            xParameters[ i ] + ( 2 * j - 1 ) * xPerturbation, lambdaParameter,
+                            perturbedFirstDerivatives[ j ], perturbedSecondDerivatives[ j ],
+                            unusedDerivative );
+            }
+
+            BOOST_CHECK_CLOSE_FRACTION(
+                        firstDerivative, ( perturbedTimesOfFlight[ 1 ]
+                                           - perturbedTimesOfFlight[ 0 ] )
+                        / ( 2.0 * xPerturbation ), 1.0e-6 );
+            BOOST_CHECK_CLOSE_FRACTION(
+                        secondDerivative, ( perturbedFirstDerivatives[ 1 ]
+                                            - perturbedFirstDerivatives[ 0 ] )
+                        / ( 2.0 * xPerturbation ), 1.0e-6 );
+            BOOST_CHECK_CLOSE_FRACTION(
+                        thirdDerivative, ( perturbedSecondDerivatives[ 1 ]
+                                           - perturbedSecondDerivatives[ 0 ] )
+                        / ( 2.0 * xPerturbation ), 1.0e-4 );
+        }
+    }
+}
+
+//! Test the batch Izzo Lambert routine against the single-problem Izzo Lambert routine.
+BOOST_AUTO_TEST_CASE( testSolveLambertProblemsIzzo )
+{
+    // Set central body (the Sun) gravitational parameter. Value taken from keptoolbox.
+    const double solarGravitationalParameter = 1.32712428e20;
+    const double astronomicalUnit = 1.49597870691e11;
+
+    // Set up batch of heliocentric transfers with pseudo-random geometry and time-of-flight,
+    // including short- and long-way, and elliptic and hyperbolic transfers.
+    const int numberOfProblems = 200;
+    Eigen::MatrixXd positionsAtDeparture( numberOfProblems, 3 );
+    Eigen::MatrixXd positionsAtArrival( numberOfProblems, 3 );
+    Eigen::VectorXd timesOfFlight( numberOfProblems );
+    for ( int problem = 0; problem < numberOfProblems; problem++ )
+    {
+        const double departureAngle = 0.1 * problem;
+        const double arrivalAngle = departureAngle + 0.2
+                + 6.0 * std::fabs( std::sin( 7.3 * problem ) );
+        const double radiusAtArrival = astronomicalUnit
+                * ( 0.7 + 1.5 * std::fabs( std::sin( 3.1 * problem ) ) );
+        positionsAtDeparture.row( problem ) << astronomicalUnit * std::cos( departureAngle ),
+                astronomicalUnit * std::sin( departureAngle ), 0.01 * astronomicalUnit;
+        positionsAtArrival.row( problem ) << radiusAtArrival * std::cos( arrivalAngle ),
+                radiusAtArrival * std::sin( arrivalAngle ),
+                -0.05 * radiusAtArrival * std::sin( 1.7 * problem );
+        timesOfFlight( problem ) = unit_conversions::convertJulianDaysToSeconds(
+                    20.0 + 500.0 * std::fabs( std::sin( 5.7 * problem ) ) );
+    }
+
+    // Solve batch for prograde and retrograde motion, with and without warm starts.
+    for ( int isRetrograde = 0; isRetrograde < 2; isRetrograde++ )
+    {
+        Eigen::MatrixXd velocitiesAtDeparture, velocitiesAtArrival;
+        mission_segments::solveLambertProblemsIzzo(
+                    positionsAtDeparture, positionsAtArrival, timesOfFlight,
+                    solarGravitationalParameter, velocitiesAtDeparture, velocitiesAtArrival,
+                    isRetrograde, false );
+
+        Eigen::MatrixXd warmStartedVelocitiesAtDeparture, warmStartedVelocitiesAtArrival;
+        mission_segments::solveLambertProblemsIzzo(
+                    positionsAtDeparture, positionsAtArrival, timesOfFlight,
+                    solarGravitationalParameter, warmStartedVelocitiesAtDeparture,
+                    warmStartedVelocitiesAtArrival, isRetrograde, true );
+
+        for ( int problem = 0; problem < numberOfProblems; problem++ )
+        {
+            // Compute expected velocities using single-problem routine.
+            Eigen::Vector3d expectedVelocityAtDeparture, expectedVelocityAtArrival;
+            mission_segments::solveLambertProblemIzzo(
+                        positionsAtDeparture.row( problem ).transpose( ),
+                        positionsAtArrival.row( problem ).transpose( ),
+                        timesOfFlight( problem ), solarGravitationalParameter,
+                        expectedVelocityAtDeparture, expectedVelocityAtArrival, isRetrograde,
+                        1.0e-12, 100 );
+
+            const Eigen::Vector3d velocityAtDeparture
+                    = velocitiesAtDeparture.row( problem ).transpose( );
+            const Eigen::Vector3d velocityAtArrival
+                    = velocitiesAtArrival.row( problem ).transpose( );
+            const Eigen::Vector3d warmStartedVelocityAtDeparture
+                    = warmStartedVelocitiesAtDeparture.row( problem ).transpose( );
+            const Eigen::Vector3d warmStartedVelocityAtArrival
+                    = warmStartedVelocitiesAtArrival.row( problem ).transpose( );
+
+            // Check that velocities match within tolerance (relative to speed).
+            BOOST_CHECK_SMALL( ( velocityAtDeparture - expectedVelocityAtDeparture ).norm( )
+                               / expectedVelocityAtDeparture.norm( ), 1.0e-9 );
+            BOOST_CHECK_SMALL( ( velocityAtArrival - expectedVelocityAtArrival ).norm( )
+                               / expectedVelocityAtArrival.norm( ), 1.0e-9 );
+            BOOST_CHECK_SMALL( ( warmStartedVelocityAtDeparture - velocityAtDeparture ).norm( )
+                               / velocityAtDeparture.norm( ), 1.0e-12 );
+            BOOST_CHECK_SMALL( ( warmStartedVelocityAtArrival - velocityAtArrival ).norm( )
+                               / velocityAtArrival.norm( ), 1.0e-12 );
+        }
+    }
+}
+
+//! Test the warm start of the batch Izzo Lambert routine.
+BOOST_AUTO_TEST_CASE( testSolveLambertProblemsIzzoWarmStart )
+{
+    // Set up batch of transfers with slowly varying time-of-flight, as in a grid search.
+    const int numberOfProblems = 100;
+    const Eigen::Vector3d positionAtDeparture( 1.0, 0.0, 0.0 );
+    const Eigen::Vector3d positionAtArrival( -0.5, 1.2, 0.1 );
+    const Eigen::MatrixXd positionsAtDeparture
+            = positionAtDeparture.transpose( ).replicate( numberOfProblems, 1 );
+    const Eigen::MatrixXd positionsAtArrival
+            = positionAtArrival.transpose( ).replicate( numberOfProblems, 1 );
+    const Eigen::VectorXd timesOfFlight = Eigen::VectorXd::LinSpaced( numberOfProblems, 1.0, 3.0 );
+
+    // Solve batch with and without warm start, in canonical units.
+    Eigen::MatrixXd velocitiesAtDeparture, velocitiesAtArrival;
+    const unsigned int numberOfIterations = mission_segments::solveLambertProblemsIzzo(
+                positionsAtDeparture, positionsAtArrival, timesOfFlight, 1.0,
+                velocitiesAtDeparture, velocitiesAtArrival, false, false );
+    const unsigned int numberOfWarmStartedIterations = mission_segments::solveLambertProblemsIzzo(
+                positionsAtDeparture, positionsAtArrival, timesOfFlight, 1.0,
+                velocitiesAtDeparture, velocitiesAtArrival, false, true );
+
+    // Check that warm start reduces number of iterations.
+    BOOST_CHECK_LT( numberOfWarmStartedIterations, numberOfIterations );
+
+    // Check that invalid input is rejected.
+    BOOST_CHECK_THROW( mission_segments::solveLambertProblemsIzzo(
+                           positionsAtDeparture, positionsAtArrival, -timesOfFlight, 1.0,
+                           velocitiesAtDeparture, velocitiesAtArrival ), std::runtime_error );
+    BOOST_CHECK_THROW( mission_segments::solveLambertProblemsIzzo(
+                           positionsAtDeparture.leftCols( 2 ), positionsAtArrival, timesOfFlight,
+                           1.0, velocitiesAtDeparture, velocitiesAtArrival ), std::runtime_error );
+
+    // Check that failure to converge is reported.
+    BOOST_CHECK_THROW( mission_segments::solveLambertProblemsIzzo(
+                           positionsAtDeparture, positionsAtArrival, timesOfFlight, 1.0,
+                           velocitiesAtDeparture, velocitiesAtArrival, false, true, 1.0e-11, 1 ),
+                       basic_mathematics::ConvergenceException );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,286 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      PyKEP toolbox, Dario Izzo, ESA Advanced Concepts Team.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/thread.hpp>
+
+#include "Tudat/Astrodynamics/MissionSegments/lambertPorkchop.h"
+#include "Tudat/Astrodynamics/MissionSegments/multiRevolutionLambertTargeterIzzo.h"
+#include "Tudat/Mathematics/BasicMathematics/convergenceException.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Constructor.
+LambertPorkchop::LambertPorkchop( const ephemerides::EphemerisPointer departureBodyEphemeris,
+                                  const ephemerides::EphemerisPointer arrivalBodyEphemeris,
+                                  const double julianDayAtEpoch,
+                                  const double centralBodyGravitationalParameter,
+                                  const int maximumNumberOfRevolutions,
+                                  const bool isRetrograde )
+    : departureBodyEphemeris_( departureBodyEphemeris ),
+      arrivalBodyEphemeris_( arrivalBodyEphemeris ),
+      julianDayAtEpoch_( julianDayAtEpoch ),
+      centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+      maximumNumberOfRevolutions_( maximumNumberOfRevolutions ),
+      isRetrograde_( isRetrograde ),
+      numberOfThreads_( 1 )
+{
+    // Check if gravitational parameter is positive.
+    if ( centralBodyGravitationalParameter_ <= 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Gravitational parameter of central body must be positive." ) ) );
+    }
+
+    // Check if maximum number of revolutions is non-negative.
+    if ( maximumNumberOfRevolutions_ < 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Maximum number of revolutions must be non-negative." ) ) );
+    }
+}
+
+//! Compute porkchop grid.
+LambertPorkchopGrid LambertPorkchop::computeGrid( const Eigen::VectorXd& departureTimes,
+                                                  const Eigen::VectorXd& arrivalTimes )
+{
+    // Retrieve states of bodies at all departure and arrival times, from cache where possible.
+    const Eigen::MatrixXd departureStates = getStates(
+                departureTimes, departureBodyEphemeris_, departureBodyStateCache_ );
+    const Eigen::MatrixXd arrivalStates = getStates(
+                arrivalTimes, arrivalBodyEphemeris_, arrivalBodyStateCache_ );
+
+    // Initialize grid.
+    LambertPorkchopGrid grid;
+    grid.departureTimes = departureTimes;
+    grid.arrivalTimes = arrivalTimes;
+    grid.deltaVs.resize( departureTimes.rows( ), arrivalTimes.rows( ) );
+    grid.departureC3s.resize( departureTimes.rows( ), arrivalTimes.rows( ) );
+    grid.numbersOfRevolutions.resize( departureTimes.rows( ), arrivalTimes.rows( ) );
+    grid.rightBranchFlags.resize( departureTimes.rows( ), arrivalTimes.rows( ) );
+
+    // Determine the number of blocks of rows, such that each thread handles at least one row.
+    const int numberOfRows = departureTimes.rows( );
+    const int numberOfBlocks = std::max(
+                1, std::min( numberOfRows, static_cast< int >( numberOfThreads_ ) ) );
+
+    std::vector< boost::exception_ptr > exceptionPointers( numberOfBlocks );
+
+    if ( numberOfBlocks == 1 )
+    {
+        computeRows( departureStates, arrivalStates, 0, numberOfRows, grid,
+                     exceptionPointers[ 0 ] );
+    }
+
+    else
+    {
+        // Distribute the rows over the blocks as evenly as possible.
+        boost::thread_group threads;
+        int firstRow = 0;
+        for ( int block = 0; block < numberOfBlocks; block++ )
+        {
+            const int numberOfRowsInBlock = numberOfRows / numberOfBlocks
+                    + ( block < numberOfRows % numberOfBlocks ? 1 : 0 );
+
+            threads.create_thread( boost::bind(
+                    &LambertPorkchop::computeRows, this,
+                    boost::cref( departureStates ), boost::cref( arrivalStates ),
+                    firstRow, numberOfRowsInBlock, boost::ref( grid ),
+                    boost::ref( exceptionPointers[ block ] ) ) );
+
+            firstRow += numberOfRowsInBlock;
+        }
+
+        threads.join_all( );
+    }
+
+    // Rethrow the first exception encountered by any of the blocks.
+    for ( int block = 0; block < numberOfBlocks; block++ )
+    {
+        if ( exceptionPointers[ block ] )
+        {
+            boost::rethrow_exception( exceptionPointers[ block ] );
+        }
+    }
+
+    return grid;
+}
+
+//! Get states from cache.
+Eigen::MatrixXd LambertPorkchop::getStates( const Eigen::VectorXd& times,
+                                            const ephemerides::EphemerisPointer ephemeris,
+                                            StateCache& stateCache )
+{
+    Eigen::MatrixXd states( times.rows( ), 6 );
+    for ( int i = 0; i < times.rows( ); i++ )
+    {
+        StateCache::iterator cachedState = stateCache.find( times( i ) );
+
+        // If the state is not yet cached, retrieve it from the ephemeris.
+        if ( cachedState == stateCache.end( ) )
+        {
+            cachedState = stateCache.insert(
+                        std::make_pair( times( i ), Eigen::VectorXd(
+                                            ephemeris->getCartesianStateFromEphemeris(
+                                                times( i ), julianDayAtEpoch_ ) ) ) ).first;
+        }
+
+        states.row( i ) = cachedState->second.transpose( );
+    }
+
+    return states;
+}
+
+//! Compute rows of porkchop grid.
+void LambertPorkchop::computeRows( const Eigen::MatrixXd& departureStates,
+                                   const Eigen::MatrixXd& arrivalStates,
+                                   const int firstRow,
+                                   const int numberOfRows,
+                                   LambertPorkchopGrid& grid,
+                                   boost::exception_ptr& exceptionPointer )
+{
+    try
+    {
+        for ( int row = firstRow; row < firstRow + numberOfRows; row++ )
+        {
+            const Eigen::VectorXd departureState = departureStates.row( row ).transpose( );
+            for ( int column = 0; column < arrivalStates.rows( ); column++ )
+            {
+                computeCell( departureState, arrivalStates.row( column ).transpose( ),
+                             grid.arrivalTimes( column ) - grid.departureTimes( row ),
+                             row, column, grid );
+            }
+        }
+    }
+
+    catch ( ... )
+    {
+        exceptionPointer = boost::current_exception( );
+    }
+}
+
+//! Compute cell of porkchop grid.
+void LambertPorkchop::computeCell( const Eigen::VectorXd& departureState,
+                                   const Eigen::VectorXd& arrivalState,
+                                   const double timeOfFlight,
+                                   const int row,
+                                   const int column,
+                                   LambertPorkchopGrid& grid )
+{
+    // Initialize cell as infeasible.
+    grid.deltaVs( row, column ) = std::numeric_limits< double >::quiet_NaN( );
+    grid.departureC3s( row, column ) = std::numeric_limits< double >::quiet_NaN( );
+    grid.numbersOfRevolutions( row, column ) = -1;
+    grid.rightBranchFlags( row, column ) = false;
+
+    // If the arrival time does not exceed the departure time, no transfer is possible.
+    if ( !( timeOfFlight > 0.0 ) )
+    {
+        return;
+    }
+
+    // Set up Lambert problem, which is reused for all numbers of revolutions and branches.
+    MultiRevolutionLambertTargeterIzzo lambertTargeter(
+                departureState.segment( 0, 3 ), arrivalState.segment( 0, 3 ), timeOfFlight,
+                centralBodyGravitationalParameter_, 0, false, isRetrograde_ );
+
+    // Determine the number of revolutions to consider; this must be done before solving the
+    // problem, since the maximum number of revolutions is only computed for an unsolved problem.
+    int maximumNumberOfRevolutions = 0;
+    if ( maximumNumberOfRevolutions_ > 0 )
+    {
+        maximumNumberOfRevolutions = std::min(
+                    maximumNumberOfRevolutions_,
+                    lambertTargeter.getMaximumNumberOfRevolutions( ) );
+    }
+
+    // Loop over all numbers of revolutions and branches (only one branch for zero revolutions),
+    // and store the transfer with the lowest total delta-V.
+    for ( int numberOfRevolutions = 0; numberOfRevolutions <= maximumNumberOfRevolutions;
+          numberOfRevolutions++ )
+    {
+        for ( int branch = 0; branch < ( numberOfRevolutions == 0 ? 1 : 2 ); branch++ )
+        {
+            try
+            {
+                lambertTargeter.computeForRevolutionsAndBranch( numberOfRevolutions,
+                                                                branch == 1 );
+            }
+
+            // If the root finder did not converge for this number of revolutions and branch,
+            // continue with the next. Other errors cannot be caused by the transfer geometry,
+            // since the time of flight is positive and the number of revolutions is bounded by
+            // the maximum of the Lambert problem, and are therefore propagated.
+            catch ( basic_mathematics::ConvergenceException& )
+            {
+                continue;
+            }
+
+            const double departureExcessVelocity
+                    = ( lambertTargeter.getInertialVelocityAtDeparture( )
+                        - departureState.segment( 3, 3 ) ).norm( );
+            const double arrivalExcessVelocity
+                    = ( lambertTargeter.getInertialVelocityAtArrival( )
+                        - arrivalState.segment( 3, 3 ) ).norm( );
+            const double deltaV = departureExcessVelocity + arrivalExcessVelocity;
+
+            if ( grid.numbersOfRevolutions( row, column ) < 0
+                 || deltaV < grid.deltaVs( row, column ) )
+            {
+                grid.deltaVs( row, column ) = deltaV;
+                grid.departureC3s( row, column )
+                        = departureExcessVelocity * departureExcessVelocity;
+                grid.numbersOfRevolutions( row, column ) = numberOfRevolutions;
+                grid.rightBranchFlags( row, column ) = ( branch == 1 );
+            }
+        }
+    }
+}
+
+} // namespace mission_segments
+} // namespace tudat
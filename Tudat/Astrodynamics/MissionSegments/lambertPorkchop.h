@@ -0,0 +1,270 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      PyKEP toolbox, Dario Izzo, ESA Advanced Concepts Team.
+ *
+ *    Notes
+ *
+ */
+
+#ifndef TUDAT_LAMBERT_PORKCHOP_H
+#define TUDAT_LAMBERT_PORKCHOP_H
+
+#include <map>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Porkchop grid of Lambert transfers.
+/*!
+ * Porkchop grid of Lambert transfers between two bodies, in which each row corresponds to a
+ * departure time, and each column to an arrival time. For each cell, only the properties of the
+ * transfer with the lowest total delta-V are stored. Cells for which no transfer is possible
+ * (e.g., because the arrival time does not exceed the departure time) have a delta-V and C3 equal
+ * to NaN, and a number of revolutions equal to -1.
+ */
+struct LambertPorkchopGrid
+{
+public:
+
+    //! Departure times of the rows of the grid [s].
+    Eigen::VectorXd departureTimes;
+
+    //! Arrival times of the columns of the grid [s].
+    Eigen::VectorXd arrivalTimes;
+
+    //! Total delta-V of the transfers [m/s].
+    /*!
+     * Total delta-V of the transfers, given by the sum of the norms of the hyperbolic excess
+     * velocities at departure and arrival [m/s].
+     */
+    Eigen::MatrixXd deltaVs;
+
+    //! Characteristic energies at departure of the transfers [m^2/s^2].
+    /*!
+     * Characteristic energies at departure of the transfers, given by the square of the norm of
+     * the hyperbolic excess velocity at departure [m^2/s^2].
+     */
+    Eigen::MatrixXd departureC3s;
+
+    //! Numbers of revolutions of the transfers.
+    Eigen::MatrixXi numbersOfRevolutions;
+
+    //! Flags indicating whether the transfers are on the right branch (multi-revolution only).
+    Eigen::Matrix< bool, Eigen::Dynamic, Eigen::Dynamic > rightBranchFlags;
+};
+
+//! Typedef for shared-pointer to LambertPorkchopGrid object.
+typedef boost::shared_ptr< LambertPorkchopGrid > LambertPorkchopGridPointer;
+
+//! Lambert porkchop grid generator.
+/*!
+ * Class to generate porkchop grids of Lambert transfers between two bodies, for which the states
+ * are retrieved from ephemerides. For each combination of departure and arrival time, the Lambert
+ * problem is solved using Izzo's algorithm for the zero-revolution case, and for both branches of
+ * each feasible number of revolutions up to the given maximum (see
+ * MultiRevolutionLambertTargeterIzzo).
+ *
+ * The states of the bodies are retrieved from the ephemerides only once per epoch, and are kept
+ * in a cache, such that they are reused by all cells of the grid and by subsequent grids (e.g.,
+ * when refining a grid). Since ephemerides are not required to be thread-safe, the states are
+ * retrieved in the calling thread, after which the rows of the grid are distributed over the
+ * given number of threads.
+ */
+class LambertPorkchop
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the ephemerides of the bodies, and the settings of the Lambert problems.
+     * \param departureBodyEphemeris Ephemeris of departure body.
+     * \param arrivalBodyEphemeris Ephemeris of arrival body.
+     * \param julianDayAtEpoch Reference epoch of departure and arrival times, in Julian days.
+     * \param centralBodyGravitationalParameter Gravitational parameter of the central body
+     *          [m^3/s^2].
+     * \param maximumNumberOfRevolutions Maximum number of revolutions of the transfers
+     *          (default 0).
+     * \param isRetrograde Flag to indicate retrograde motion (default false).
+     */
+    LambertPorkchop( const ephemerides::EphemerisPointer departureBodyEphemeris,
+                     const ephemerides::EphemerisPointer arrivalBodyEphemeris,
+                     const double julianDayAtEpoch,
+                     const double centralBodyGravitationalParameter,
+                     const int maximumNumberOfRevolutions = 0,
+                     const bool isRetrograde = false );
+
+    //! Set number of threads.
+    /*!
+     * Sets the number of threads over which the rows of the grid are distributed. The default
+     * number of threads is one, in which case the grid is computed in the calling thread.
+     * \param numberOfThreads Number of threads.
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        numberOfThreads_ = numberOfThreads;
+    }
+
+    //! Get number of threads.
+    /*!
+     * Returns the number of threads over which the rows of the grid are distributed.
+     * \return Number of threads.
+     */
+    unsigned int getNumberOfThreads( ) const { return numberOfThreads_; }
+
+    //! Compute porkchop grid.
+    /*!
+     * Computes porkchop grid for given departure and arrival times.
+     * \param departureTimes Departure times, in seconds since the reference epoch [s].
+     * \param arrivalTimes Arrival times, in seconds since the reference epoch [s].
+     * \return Porkchop grid.
+     */
+    LambertPorkchopGrid computeGrid( const Eigen::VectorXd& departureTimes,
+                                     const Eigen::VectorXd& arrivalTimes );
+
+    //! Get number of cached ephemeris states.
+    /*!
+     * Returns the total number of states of the departure and arrival body stored in the cache.
+     * \return Number of cached ephemeris states.
+     */
+    int getNumberOfCachedStates( ) const
+    {
+        return departureBodyStateCache_.size( ) + arrivalBodyStateCache_.size( );
+    }
+
+    //! Clear cache of ephemeris states.
+    void clearStateCache( )
+    {
+        departureBodyStateCache_.clear( );
+        arrivalBodyStateCache_.clear( );
+    }
+
+protected:
+
+private:
+
+    //! Typedef for cache of states, per time.
+    typedef std::map< double, Eigen::VectorXd > StateCache;
+
+    //! Get states from cache.
+    /*!
+     * Returns states of a body at given times, as rows of a matrix. States that are not yet in the
+     * cache are retrieved from the ephemeris and added to the cache.
+     * \param times Times, in seconds since the reference epoch [s].
+     * \param ephemeris Ephemeris of body.
+     * \param stateCache Cache of states of body.
+     * \return Matrix with states at given times as rows.
+     */
+    Eigen::MatrixXd getStates( const Eigen::VectorXd& times,
+                               const ephemerides::EphemerisPointer ephemeris,
+                               StateCache& stateCache );
+
+    //! Compute rows of porkchop grid.
+    /*!
+     * Computes given rows (departure times) of porkchop grid. Only the given rows of the grid are
+     * written, such that disjoint sets of rows can be computed concurrently. Any exception thrown
+     * is caught and stored, such that it can be rethrown by the calling thread.
+     * \param departureStates Matrix with states of departure body at departure times as rows.
+     * \param arrivalStates Matrix with states of arrival body at arrival times as rows.
+     * \param firstRow Index of first row to compute.
+     * \param numberOfRows Number of rows to compute.
+     * \param grid Porkchop grid, of which the times are set and the matrices are sized (returned
+     *          by reference).
+     * \param exceptionPointer Pointer to exception thrown during computation, if any (returned by
+     *          reference).
+     */
+    void computeRows( const Eigen::MatrixXd& departureStates,
+                      const Eigen::MatrixXd& arrivalStates,
+                      const int firstRow,
+                      const int numberOfRows,
+                      LambertPorkchopGrid& grid,
+                      boost::exception_ptr& exceptionPointer );
+
+    //! Compute cell of porkchop grid.
+    /*!
+     * Computes the transfer with the lowest total delta-V between the given states of the
+     * departure and arrival body, considering all feasible numbers of revolutions and branches.
+     * \param departureState State of departure body at departure.
+     * \param arrivalState State of arrival body at arrival.
+     * \param timeOfFlight Time-of-flight [s].
+     * \param row Row of cell.
+     * \param column Column of cell.
+     * \param grid Porkchop grid, of which the given cell is set (returned by reference).
+     */
+    void computeCell( const Eigen::VectorXd& departureState,
+                      const Eigen::VectorXd& arrivalState,
+                      const double timeOfFlight,
+                      const int row,
+                      const int column,
+                      LambertPorkchopGrid& grid );
+
+    //! Ephemeris of departure body.
+    const ephemerides::EphemerisPointer departureBodyEphemeris_;
+
+    //! Ephemeris of arrival body.
+    const ephemerides::EphemerisPointer arrivalBodyEphemeris_;
+
+    //! Reference epoch of departure and arrival times, in Julian days.
+    const double julianDayAtEpoch_;
+
+    //! Gravitational parameter of the central body [m^3/s^2].
+    const double centralBodyGravitationalParameter_;
+
+    //! Maximum number of revolutions of the transfers.
+    const int maximumNumberOfRevolutions_;
+
+    //! Flag to indicate retrograde motion.
+    const bool isRetrograde_;
+
+    //! Number of threads over which the rows of the grid are distributed.
+    unsigned int numberOfThreads_;
+
+    //! Cache of states of departure body.
+    StateCache departureBodyStateCache_;
+
+    //! Cache of states of arrival body.
+    StateCache arrivalBodyStateCache_;
+};
+
+//! Typedef for shared-pointer to LambertPorkchop object.
+typedef boost::shared_ptr< LambertPorkchop > LambertPorkchopPointer;
+
+} // namespace mission_segments
+} // namespace tudat
+
+#endif // TUDAT_LAMBERT_PORKCHOP_H
@@ -62,11 +62,14 @@
  *      120704    P. Musegaas       Various small changes during code check.
  *      120713    P. Musegaas       Changed tolerance to relative tolerance in Gooding's rootfinder.
  *      120813    P. Musegaas       Changed code to new root finding structure.
+ *      261016    agent             Added batch Lambert solver using Izzo's Householder iteration.
  *
  *    References
  *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics,
  *          AIAA Education Series, 1999.
  *      Izzo, D. lambert_problem.h, keptoolbox.
+ *      Izzo, D. Revisiting Lambert's problem, Celestial Mechanics and Dynamical Astronomy,
+ *          121(1):1-15, 2015.
  *      Gooding, R.H. A procedure for the solution of Lambert's orbital boundary-value problem,
  *          Celestial Mechanics and Dynamical Astronomy, 48:145-165, 1990.
  *
@@ -74,6 +77,7 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <sstream>
@@ -91,6 +95,7 @@
 #include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
 
 #include "Tudat/Astrodynamics/MissionSegments/lambertRoutines.h"
+#include "Tudat/Mathematics/BasicMathematics/convergenceException.h"
 #include "Tudat/Mathematics/BasicMathematics/functionProxy.h"
 
 namespace tudat
@@ -418,6 +423,318 @@ double computeTimeOfFlightIzzo( const double xParameter, const double semiPerime
 
 }
 
+//! Compute normalized time-of-flight and its derivatives using Izzo's revisited formulation.
+double computeNormalizedTimeOfFlightAndDerivativesIzzo( const double xParameter,
+                                                        const double lambdaParameter,
+                                                        double& firstDerivative,
+                                                        double& secondDerivative,
+                                                        double& thirdDerivative )
+{
+    const double lambdaSquared = lambdaParameter * lambdaParameter;
+    const double lambdaCubed = lambdaSquared * lambdaParameter;
+    const double oneMinusXSquared = 1.0 - xParameter * xParameter;
+    const double yParameter = std::sqrt( 1.0 - lambdaSquared * oneMinusXSquared );
+
+    double normalizedTimeOfFlight;
+
+    // If close to the parabolic case, use Battin's series.
+    if ( std::fabs( xParameter - 1.0 ) < 0.01 )
+    {
+        const double etaParameter = yParameter - lambdaParameter * xParameter;
+        const double hypergeometricArgument
+                = 0.5 * ( 1.0 - lambdaParameter - xParameter * etaParameter );
+
+        // Sum hypergeometric series 2F1( 3, 1; 5/2; S1 ).
+        double hypergeometricFunction = 1.0;
+        double hypergeometricTerm = 1.0;
+        for ( int j = 0; std::fabs( hypergeometricTerm ) > 1.0e-15 && j < 100; j++ )
+        {
+            hypergeometricTerm *= ( 3.0 + j ) * ( 1.0 + j ) / ( 2.5 + j )
+                    * hypergeometricArgument / ( j + 1.0 );
+            hypergeometricFunction += hypergeometricTerm;
+        }
+
+        normalizedTimeOfFlight = 0.5 * ( etaParameter * etaParameter * etaParameter
+                                         * 4.0 / 3.0 * hypergeometricFunction
+                                         + 4.0 * lambdaParameter * etaParameter );
+    }
+
+    // Otherwise, use Lancaster's expression.
+    else
+    {
+        const double squareRootOfAbsoluteOneMinusXSquared
+                = std::sqrt( std::fabs( oneMinusXSquared ) );
+        const double gParameter = xParameter * yParameter
+                + lambdaParameter * oneMinusXSquared;
+
+        // Compute the eccentric anomaly difference (elliptic) or its hyperbolic equivalent.
+        double dParameter;
+        if ( oneMinusXSquared > 0.0 )
+        {
+            dParameter = std::acos( gParameter );
+        }
+        else
+        {
+            dParameter = std::log( squareRootOfAbsoluteOneMinusXSquared
+                                   * ( yParameter - lambdaParameter * xParameter )
+                                   + gParameter );
+        }
+
+        normalizedTimeOfFlight = ( xParameter - lambdaParameter * yParameter
+                                   - dParameter / squareRootOfAbsoluteOneMinusXSquared )
+                / ( -oneMinusXSquared );
+    }
+
+    // Compute derivatives with respect to x-parameter.
+    const double yParameterCubed = yParameter * yParameter * yParameter;
+    firstDerivative = ( 3.0 * normalizedTimeOfFlight * xParameter - 2.0
+                        + 2.0 * lambdaCubed * xParameter / yParameter ) / oneMinusXSquared;
+    secondDerivative = ( 3.0 * normalizedTimeOfFlight + 5.0 * xParameter * firstDerivative
+                         + 2.0 * ( 1.0 - lambdaSquared ) * lambdaCubed / yParameterCubed )
+            / oneMinusXSquared;
+    thirdDerivative = ( 7.0 * xParameter * secondDerivative + 8.0 * firstDerivative
+                        - 6.0 * ( 1.0 - lambdaSquared ) * lambdaSquared * lambdaCubed
+                        * xParameter / yParameterCubed / ( yParameter * yParameter ) )
+            / oneMinusXSquared;
+
+    return normalizedTimeOfFlight;
+}
+
+//! Solve normalized time-of-flight equation using Householder's method.
+unsigned int solveNormalizedTimeOfFlightEquationIzzo(
+        const double normalizedTimeOfFlight, const double lambdaParameter, double& xParameter,
+        double& firstDerivative, const double convergenceTolerance,
+        const unsigned int maximumNumberOfIterations )
+{
+    double secondDerivative, thirdDerivative;
+    for ( unsigned int iteration = 1; iteration <= maximumNumberOfIterations; iteration++ )
+    {
+        const double timeOfFlightError = computeNormalizedTimeOfFlightAndDerivativesIzzo(
+                    xParameter, lambdaParameter,
+                    firstDerivative, secondDerivative, thirdDerivative )
+                - normalizedTimeOfFlight;
+        const double firstDerivativeSquared = firstDerivative * firstDerivative;
+
+        // Compute Householder (third-order) update.
+        const double xParameterUpdate = timeOfFlightError
+                * ( firstDerivativeSquared - 0.5 * timeOfFlightError * secondDerivative )
+                / ( firstDerivative * ( firstDerivativeSquared
+                                        - timeOfFlightError * secondDerivative )
+                    + thirdDerivative * timeOfFlightError * timeOfFlightError / 6.0 );
+        xParameter -= xParameterUpdate;
+
+        // Check for convergence; note that a NaN update never converges.
+        if ( std::fabs( xParameterUpdate ) <= convergenceTolerance )
+        {
+            return iteration;
+        }
+        else if ( !( xParameter > -1.0 ) )
+        {
+            break;
+        }
+    }
+
+    return maximumNumberOfIterations + 1;
+}
+
+//! Solve batch of Lambert problems using Izzo's algorithm.
+unsigned int solveLambertProblemsIzzo( const Eigen::MatrixXd& cartesianPositionsAtDeparture,
+                                       const Eigen::MatrixXd& cartesianPositionsAtArrival,
+                                       const Eigen::VectorXd& timesOfFlight,
+                                       const double gravitationalParameter,
+                                       Eigen::MatrixXd& cartesianVelocitiesAtDeparture,
+                                       Eigen::MatrixXd& cartesianVelocitiesAtArrival,
+                                       const bool isRetrograde,
+                                       const bool useWarmStart,
+                                       const double convergenceTolerance,
+                                       const unsigned int maximumNumberOfIterations )
+{
+    const int numberOfProblems = timesOfFlight.rows( );
+
+    // Sanity check for dimensions of input.
+    if ( cartesianPositionsAtDeparture.rows( ) != numberOfProblems
+         || cartesianPositionsAtArrival.rows( ) != numberOfProblems
+         || cartesianPositionsAtDeparture.cols( ) != 3
+         || cartesianPositionsAtArrival.cols( ) != 3 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Positions must be given as matrices with three columns, and one row "
+                            "per time-of-flight." ) ) );
+    }
+
+    // Sanity check for specified times-of-flight and gravitational parameter.
+    if ( numberOfProblems > 0 && !( timesOfFlight.minCoeff( ) > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Specified times-of-flight must be strictly positive." ) ) );
+    }
+
+    if ( !( gravitationalParameter > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Specified gravitational parameter must be strictly positive." ) ) );
+    }
+
+    // Compute transfer geometry of all problems.
+    const Eigen::ArrayXd radiiAtDeparture = cartesianPositionsAtDeparture.rowwise( ).norm( );
+    const Eigen::ArrayXd radiiAtArrival = cartesianPositionsAtArrival.rowwise( ).norm( );
+    const Eigen::ArrayXd chords = ( cartesianPositionsAtArrival
+                                    - cartesianPositionsAtDeparture ).rowwise( ).norm( );
+    const Eigen::ArrayXd semiPerimeters = 0.5 * ( radiiAtDeparture + radiiAtArrival + chords );
+
+    // Compute radial unit vectors, and angular momentum unit vectors.
+    Eigen::ArrayXXd radialUnitVectorsAtDeparture = cartesianPositionsAtDeparture.array( );
+    radialUnitVectorsAtDeparture.colwise( ) /= radiiAtDeparture;
+    Eigen::ArrayXXd radialUnitVectorsAtArrival = cartesianPositionsAtArrival.array( );
+    radialUnitVectorsAtArrival.colwise( ) /= radiiAtArrival;
+
+    Eigen::ArrayXXd angularMomentumUnitVectors( numberOfProblems, 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        angularMomentumUnitVectors.col( i )
+                = radialUnitVectorsAtDeparture.col( ( i + 1 ) % 3 )
+                * radialUnitVectorsAtArrival.col( ( i + 2 ) % 3 )
+                - radialUnitVectorsAtDeparture.col( ( i + 2 ) % 3 )
+                * radialUnitVectorsAtArrival.col( ( i + 1 ) % 3 );
+    }
+    const Eigen::ArrayXd angularMomentumNorms
+            = angularMomentumUnitVectors.matrix( ).rowwise( ).norm( );
+    angularMomentumUnitVectors.colwise( ) /= angularMomentumNorms;
+
+    // Determine direction of motion: the lambda parameter and transverse unit vectors change sign
+    // for transfer angles larger than pi (assuming prograde motion), and for retrograde motion.
+    Eigen::ArrayXd directionSigns( numberOfProblems );
+    for ( int problem = 0; problem < numberOfProblems; problem++ )
+    {
+        directionSigns( problem )
+                = ( ( angularMomentumUnitVectors( problem, 2 ) < 0.0 ) != isRetrograde )
+                ? -1.0 : 1.0;
+    }
+
+    const Eigen::ArrayXd lambdaParameters
+            = directionSigns * ( 1.0 - chords / semiPerimeters ).sqrt( );
+    const Eigen::ArrayXd normalizedTimesOfFlight = timesOfFlight.array( )
+            * ( 2.0 * gravitationalParameter / semiPerimeters.cube( ) ).sqrt( );
+
+    // Solve time-of-flight equation for each problem.
+    Eigen::ArrayXd xParameters( numberOfProblems );
+    double firstDerivative = TUDAT_NAN;
+    unsigned int totalNumberOfIterations = 0;
+    for ( int problem = 0; problem < numberOfProblems; problem++ )
+    {
+        const double lambdaParameter = lambdaParameters( problem );
+        const double normalizedTimeOfFlight = normalizedTimesOfFlight( problem );
+        unsigned int numberOfIterations = maximumNumberOfIterations + 1;
+
+        // Start from solution of previous problem, if requested, corrected to first order for
+        // the difference in normalized time-of-flight.
+        if ( useWarmStart && problem > 0 )
+        {
+            xParameters( problem ) = xParameters( problem - 1 )
+                    + ( normalizedTimeOfFlight - normalizedTimesOfFlight( problem - 1 ) )
+                    / firstDerivative;
+            if ( !( xParameters( problem ) > -1.0 ) )
+            {
+                xParameters( problem ) = xParameters( problem - 1 );
+            }
+
+            numberOfIterations = solveNormalizedTimeOfFlightEquationIzzo(
+                        normalizedTimeOfFlight, lambdaParameter, xParameters( problem ),
+                        firstDerivative, convergenceTolerance, maximumNumberOfIterations );
+            totalNumberOfIterations += std::min( numberOfIterations, maximumNumberOfIterations );
+        }
+
+        // If not (yet) converged, start from initial guess of Izzo (2015), based on the
+        // normalized times-of-flight at x = 0 and x = 1.
+        if ( numberOfIterations > maximumNumberOfIterations )
+        {
+            const double zeroXTimeOfFlight = std::acos( lambdaParameter ) + lambdaParameter
+                    * std::sqrt( 1.0 - lambdaParameter * lambdaParameter );
+            const double parabolicTimeOfFlight = 2.0 / 3.0
+                    * ( 1.0 - lambdaParameter * lambdaParameter * lambdaParameter );
+
+            if ( normalizedTimeOfFlight >= zeroXTimeOfFlight )
+            {
+                xParameters( problem ) = -( normalizedTimeOfFlight - zeroXTimeOfFlight )
+                        / ( normalizedTimeOfFlight - zeroXTimeOfFlight + 4.0 );
+            }
+            else if ( normalizedTimeOfFlight <= parabolicTimeOfFlight )
+            {
+                xParameters( problem ) = parabolicTimeOfFlight
+                        * ( parabolicTimeOfFlight - normalizedTimeOfFlight )
+                        / ( 0.4 * ( 1.0 - std::pow( lambdaParameter, 5.0 ) )
+                            * normalizedTimeOfFlight ) + 1.0;
+            }
+            else
+            {
+                xParameters( problem ) = std::pow(
+                            normalizedTimeOfFlight / zeroXTimeOfFlight,
+                            std::log( 2.0 ) / std::log( parabolicTimeOfFlight
+                                                        / zeroXTimeOfFlight ) ) - 1.0;
+            }
+
+            numberOfIterations = solveNormalizedTimeOfFlightEquationIzzo(
+                        normalizedTimeOfFlight, lambdaParameter, xParameters( problem ),
+                        firstDerivative, convergenceTolerance, maximumNumberOfIterations );
+            totalNumberOfIterations += std::min( numberOfIterations, maximumNumberOfIterations );
+        }
+
+        // Verify that root-finder has converged.
+        if ( numberOfIterations > maximumNumberOfIterations )
+        {
+            BOOST_THROW_EXCEPTION( basic_mathematics::ConvergenceException(
+                                       "Batch Lambert solver failed to converge to a solution." ) );
+        }
+    }
+
+    // Reconstruct radial and transverse velocity components of all problems.
+    const Eigen::ArrayXd gammaParameters
+            = ( 0.5 * gravitationalParameter * semiPerimeters ).sqrt( );
+    const Eigen::ArrayXd rhoParameters = ( radiiAtDeparture - radiiAtArrival ) / chords;
+    const Eigen::ArrayXd sigmaParameters = ( 1.0 - rhoParameters.square( ) ).sqrt( );
+    const Eigen::ArrayXd yParameters
+            = ( 1.0 - lambdaParameters.square( ) * ( 1.0 - xParameters.square( ) ) ).sqrt( );
+    const Eigen::ArrayXd lambdaYMinusX = lambdaParameters * yParameters - xParameters;
+    const Eigen::ArrayXd lambdaYPlusX = lambdaParameters * yParameters + xParameters;
+
+    const Eigen::ArrayXd radialVelocitiesAtDeparture = gammaParameters
+            * ( lambdaYMinusX - rhoParameters * lambdaYPlusX ) / radiiAtDeparture;
+    const Eigen::ArrayXd radialVelocitiesAtArrival = -gammaParameters
+            * ( lambdaYMinusX + rhoParameters * lambdaYPlusX ) / radiiAtArrival;
+    const Eigen::ArrayXd transverseVelocities = directionSigns * gammaParameters
+            * sigmaParameters * ( yParameters + lambdaParameters * xParameters );
+
+    // Compute inertial velocity vectors, using transverse unit vectors h x r (multiplied by the
+    // direction sign, which is included in the transverse velocities).
+    cartesianVelocitiesAtDeparture.resize( numberOfProblems, 3 );
+    cartesianVelocitiesAtArrival.resize( numberOfProblems, 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        cartesianVelocitiesAtDeparture.col( i ) = (
+                    radialVelocitiesAtDeparture * radialUnitVectorsAtDeparture.col( i )
+                    + transverseVelocities / radiiAtDeparture
+                    * ( angularMomentumUnitVectors.col( ( i + 1 ) % 3 )
+                        * radialUnitVectorsAtDeparture.col( ( i + 2 ) % 3 )
+                        - angularMomentumUnitVectors.col( ( i + 2 ) % 3 )
+                        * radialUnitVectorsAtDeparture.col( ( i + 1 ) % 3 ) ) ).matrix( );
+        cartesianVelocitiesAtArrival.col( i ) = (
+                    radialVelocitiesAtArrival * radialUnitVectorsAtArrival.col( i )
+                    + transverseVelocities / radiiAtArrival
+                    * ( angularMomentumUnitVectors.col( ( i + 1 ) % 3 )
+                        * radialUnitVectorsAtArrival.col( ( i + 2 ) % 3 )
+                        - angularMomentumUnitVectors.col( ( i + 2 ) % 3 )
+                        * radialUnitVectorsAtArrival.col( ( i + 1 ) % 3 ) ) ).matrix( );
+    }
+
+    return totalNumberOfIterations;
+}
+
 //! Solve Lambert Problem using Gooding's algorithm.
 void solveLambertProblemGooding( const Eigen::Vector3d& cartesianPositionAtDeparture,
                                  const Eigen::Vector3d& cartesianPositionAtArrival,
@@ -44,11 +44,14 @@
  *      120813    P. Musegaas       Changed code to new root finding structure. Added option to
  *                                  specify which rootfinder and termination conditions to use.
  *      130121    K. Kumar          Added shared-ptr typedef.
+ *      261016    agent             Added batch Lambert solver using Izzo's Householder iteration.
  *
  *    References
  *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics,
  *          AIAA Education Series, 1999.
  *      Izzo, D. lambert_problem.h, keptoolbox.
+ *      Izzo, D. Revisiting Lambert's problem, Celestial Mechanics and Dynamical Astronomy,
+ *          121(1):1-15, 2015.
  *      Gooding, R.H. A procedure for the solution of Lambert's orbital boundary-value problem,
  *          Celestial Mechanics and Dynamical Astronomy, 48:145-165, 1990.
  *
@@ -123,6 +126,91 @@ double computeTimeOfFlightIzzo( const double xParameter, const double semiPerime
                                 const double chord, const bool isLongway,
                                 const double semiMajorAxisOfTheMinimumEnergyEllipse );
 
+//! Compute normalized time-of-flight and its derivatives using Izzo's revisited formulation.
+/*!
+ * Computes the zero-revolution time-of-flight \f$ T \f$, normalized by
+ * \f$ \sqrt{ s^3 / ( 2 \mu ) } \f$, as a function of the x-parameter and the lambda parameter
+ * \f$ \lambda = \pm \sqrt{ 1 - c / s } \f$ (negative for transfer angles larger than pi), as
+ * well as its first three derivatives with respect to the x-parameter (Izzo, 2015). Battin's
+ * series is used close to the parabolic case (x = 1), and Lancaster's expression elsewhere.
+ * \param xParameter x-parameter, equal to \f$ \sqrt{ 1 - a_m / a } \f$ for elliptic transfers.
+ * \param lambdaParameter Lambda parameter.
+ * \param firstDerivative First derivative of normalized time-of-flight (returned by reference).
+ * \param secondDerivative Second derivative of normalized time-of-flight (returned by
+ *          reference).
+ * \param thirdDerivative Third derivative of normalized time-of-flight (returned by reference).
+ * \return Normalized time-of-flight.
+ */
+double computeNormalizedTimeOfFlightAndDerivativesIzzo( const double xParameter,
+                                                        const double lambdaParameter,
+                                                        double& firstDerivative,
+                                                        double& secondDerivative,
+                                                        double& thirdDerivative );
+
+//! Solve normalized time-of-flight equation using Householder's method.
+/*!
+ * Solves the zero-revolution time-of-flight equation for the x-parameter using Householder's
+ * third-order method, starting from the given initial guess (Izzo, 2015).
+ * \param normalizedTimeOfFlight Time-of-flight, normalized by \f$ \sqrt{ s^3 / ( 2 \mu ) } \f$.
+ * \param lambdaParameter Lambda parameter.
+ * \param xParameter Initial guess for x-parameter on input, and computed x-parameter on output.
+ * \param firstDerivative First derivative of normalized time-of-flight with respect to the
+ *          x-parameter, evaluated at the last iterate (returned by reference).
+ * \param convergenceTolerance Convergence tolerance on the x-parameter.
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \return Number of iterations, or maximumNumberOfIterations + 1 if the iteration did not
+ *          converge.
+ */
+unsigned int solveNormalizedTimeOfFlightEquationIzzo(
+        const double normalizedTimeOfFlight, const double lambdaParameter, double& xParameter,
+        double& firstDerivative, const double convergenceTolerance,
+        const unsigned int maximumNumberOfIterations );
+
+//! Solve batch of Lambert problems using Izzo's algorithm.
+/*!
+ * Solves a batch of zero-revolution Lambert problems, sharing the same central body, using the
+ * revisited algorithm of Izzo (2015). The geometry of all problems and the reconstruction of the
+ * velocities are computed for the whole batch at once, using array operations. For each problem,
+ * the time-of-flight equation is solved using an inlined Householder iteration
+ * (see solveNormalizedTimeOfFlightEquationIzzo( )), without callbacks or object allocations.
+ *
+ * If warm starts are used, the iteration of each problem is started from the solution of the
+ * previous problem in the batch, corrected to first order for the difference in normalized
+ * time-of-flight, which reduces the number of iterations if consecutive problems
+ * are similar (e.g., neighbouring cells in a grid search, or neighbouring individuals in an
+ * optimizer). If the iteration does not converge from the warm start, it is restarted from
+ * Izzo's initial guess.
+ * \param cartesianPositionsAtDeparture Matrix with Cartesian positions at departure [m] as rows
+ *          (N x 3).
+ * \param cartesianPositionsAtArrival Matrix with Cartesian positions at arrival [m] as rows
+ *          (N x 3).
+ * \param timesOfFlight Vector with times-of-flight [s] (N x 1).
+ * \param gravitationalParameter Gravitational parameter of the central body [m^3/s^2].
+ * \param cartesianVelocitiesAtDeparture Matrix with Cartesian velocities at departure [m/s] as
+ *          rows (N x 3) (returned by reference).
+ * \param cartesianVelocitiesAtArrival Matrix with Cartesian velocities at arrival [m/s] as rows
+ *          (N x 3) (returned by reference).
+ * \param isRetrograde Boolean flag to indicate direction of motion (default false).
+ * \param useWarmStart Boolean flag to indicate whether warm starts are used (default true).
+ * \param convergenceTolerance Convergence tolerance on the x-parameter (default 1.0e-11).
+ * \param maximumNumberOfIterations Maximum number of iterations per problem (default 15).
+ * \return Total number of iterations used for the batch.
+ * \throws std::runtime_error For inconsistent dimensions, and non-positive times-of-flight and
+ *          gravitational parameter.
+ * \throws basic_mathematics::ConvergenceException If the iteration of any of the problems fails
+ *          to converge.
+ */
+unsigned int solveLambertProblemsIzzo( const Eigen::MatrixXd& cartesianPositionsAtDeparture,
+                                       const Eigen::MatrixXd& cartesianPositionsAtArrival,
+                                       const Eigen::VectorXd& timesOfFlight,
+                                       const double gravitationalParameter,
+                                       Eigen::MatrixXd& cartesianVelocitiesAtDeparture,
+                                       Eigen::MatrixXd& cartesianVelocitiesAtArrival,
+                                       const bool isRetrograde = false,
+                                       const bool useWarmStart = true,
+                                       const double convergenceTolerance = 1.0e-11,
+                                       const unsigned int maximumNumberOfIterations = 15 );
+
 //! Solve Lambert Problem using Gooding's algorithm.
 /*!
  * Solves the Lambert Problem using Lancaster and Blanchard's algorithm with further improvements
@@ -29,6 +29,8 @@
  *      120913    K. Kumar          Rewrote unit test to use test state derivative models;
  *                                  implemented matrix-based and vector-based composite state
  *                                  tests.
+ *      261016    agent             Added tests for parallel block evaluation and block timing.
+ *      261016    agent             Added test for overlapping blocks.
  *
  *    References
  *
@@ -58,6 +60,18 @@ namespace tudat
 namespace unit_tests
 {
 
+//! Update time only.
+/*!
+ * Updates the time stored in the data repository; used for composite states that consist only of
+ * uncoupled part states.
+ * \param independentVariable Independent variable (time).
+ * \param compositeState Composite state (unused).
+ */
+void updateTimeOnly( const double independentVariable, const Eigen::VectorXd& compositeState )
+{
+    time = independentVariable;
+}
+
 BOOST_AUTO_TEST_SUITE( test_composite_state_derivative_model )
 
 //! Test whether composite state derivative model works correctly with matrices.
@@ -172,6 +186,149 @@ BOOST_AUTO_TEST_CASE( test_CompositeStateDerivativeModelWithVectors )
                                expectedCompositeStateDerivative.coeff( row, col ) );
 }
 
+//! Test whether parallel evaluation of blocks gives the same result as serial evaluation.
+BOOST_AUTO_TEST_CASE( test_CompositeStateDerivativeModelParallelBlockEvaluation )
+{
+    // Shortcuts.
+    typedef state_derivative_models::CompositeStateDerivativeModel<
+            double, Eigen::VectorXd, Eigen::VectorXd > CompositeStateDerivativeModel;
+    typedef boost::shared_ptr< CompositeStateDerivativeModel >
+            CompositeStateDerivativeModelPointer;
+
+    // Set current time.
+    time = 2.2;
+
+    // Set current composite state, consisting of alternating Vector3d and Vector2d states, of
+    // which the last element is not covered by any of the blocks.
+    const unsigned int numberOfStatePairs = 20;
+    Eigen::VectorXd currentCompositeState( 5 * numberOfStatePairs + 1 );
+    for ( unsigned int i = 0; i < numberOfStatePairs; i++ )
+    {
+        currentCompositeState.segment( 5 * i, 5 )
+                << 6.6 + i, -1.13, 4.78 - 0.1 * i, 1.3 * i, -0.45;
+    }
+    currentCompositeState( 5 * numberOfStatePairs ) = 3.0;
+
+    // Create state derivative model map.
+    CompositeStateDerivativeModel::VectorStateDerivativeModelMap stateDerivativeModelMap;
+    for ( unsigned int i = 0; i < numberOfStatePairs; i++ )
+    {
+        stateDerivativeModelMap[ std::make_pair( 5 * i, 3 ) ] = &computeVector3dStateDerivative;
+        stateDerivativeModelMap[ std::make_pair( 5 * i + 3, 2 ) ]
+                = &computeVector2dStateDerivative;
+    }
+
+    // Create composite state derivative model, evaluated in serial.
+    CompositeStateDerivativeModelPointer compositeStateDerivativeModel
+            = boost::make_shared< CompositeStateDerivativeModel >(
+                stateDerivativeModelMap, &updateTimeOnly );
+    BOOST_CHECK_EQUAL( compositeStateDerivativeModel->getNumberOfThreads( ), 1 );
+
+    // Compute composite state derivative in serial.
+    const Eigen::VectorXd serialCompositeStateDerivative
+            = compositeStateDerivativeModel->computeStateDerivative( time, currentCompositeState );
+
+    // Check that element not covered by any of the blocks is set to zero.
+    BOOST_CHECK_EQUAL( serialCompositeStateDerivative( 5 * numberOfStatePairs ), 0.0 );
+
+    // Compute composite state derivative in parallel, into a preallocated state derivative that
+    // contains non-zero values.
+    compositeStateDerivativeModel->setNumberOfThreads( 4 );
+    BOOST_CHECK_EQUAL( compositeStateDerivativeModel->getNumberOfThreads( ), 4 );
+
+    Eigen::VectorXd parallelCompositeStateDerivative
+            = Eigen::VectorXd::Constant( currentCompositeState.rows( ), 1.0 );
+    for ( unsigned int evaluation = 0; evaluation < 10; evaluation++ )
+    {
+        compositeStateDerivativeModel->computeStateDerivativeInto(
+                    time, currentCompositeState, parallelCompositeStateDerivative );
+
+        // Check that parallel result matches serial result exactly.
+        TUDAT_CHECK_MATRIX_BASE( parallelCompositeStateDerivative,
+                                 serialCompositeStateDerivative )
+                BOOST_CHECK_EQUAL( parallelCompositeStateDerivative.coeff( row, col ),
+                                   serialCompositeStateDerivative.coeff( row, col ) );
+    }
+
+    // Switch back to serial evaluation.
+    compositeStateDerivativeModel->setNumberOfThreads( 1 );
+    BOOST_CHECK_EQUAL( compositeStateDerivativeModel->getNumberOfThreads( ), 1 );
+}
+
+//! Test whether block evaluation times are recorded for each block.
+BOOST_AUTO_TEST_CASE( test_CompositeStateDerivativeModelBlockEvaluationTiming )
+{
+    // Shortcuts.
+    typedef state_derivative_models::CompositeStateDerivativeModel<
+            double, Vector5d, Eigen::VectorXd > CompositeStateDerivativeModel;
+
+    // Set current composite state.
+    const Vector5d currentCompositeState
+            = ( Eigen::VectorXd( 5 ) << 6.6, -1.13, 4.78, 1.3, -0.45 ).finished( );
+
+    // Create state derivative model map ([Vector3d Vector2d] composite state structure).
+    CompositeStateDerivativeModel::VectorStateDerivativeModelMap stateDerivativeModelMap;
+    stateDerivativeModelMap[ std::make_pair( 0, 3 ) ] = &computeVector3dStateDerivative;
+    stateDerivativeModelMap[ std::make_pair( 3, 2 ) ] = &computeVector2dStateDerivative;
+
+    // Create composite state derivative model, with timing enabled.
+    CompositeStateDerivativeModel compositeStateDerivativeModel(
+                stateDerivativeModelMap, &updateVectorData );
+    compositeStateDerivativeModel.enableBlockEvaluationTiming( );
+    compositeStateDerivativeModel.setNumberOfThreads( 2 );
+
+    for ( unsigned int evaluation = 0; evaluation < 100; evaluation++ )
+    {
+        compositeStateDerivativeModel.computeStateDerivative( 2.2, currentCompositeState );
+    }
+
+    // Check that a non-negative time is recorded for each block.
+    CompositeStateDerivativeModel::BlockEvaluationTimeMap blockEvaluationTimes
+            = compositeStateDerivativeModel.getBlockEvaluationTimes( );
+    BOOST_CHECK_EQUAL( blockEvaluationTimes.size( ), 2 );
+    BOOST_CHECK_GE( blockEvaluationTimes[ boost::make_tuple( 0, 0, 3, 1 ) ], 0.0 );
+    BOOST_CHECK_GE( blockEvaluationTimes[ boost::make_tuple( 3, 0, 2, 1 ) ], 0.0 );
+
+    // Check that times are reset to zero.
+    compositeStateDerivativeModel.resetBlockEvaluationTimes( );
+    blockEvaluationTimes = compositeStateDerivativeModel.getBlockEvaluationTimes( );
+    BOOST_CHECK_EQUAL( blockEvaluationTimes[ boost::make_tuple( 0, 0, 3, 1 ) ], 0.0 );
+    BOOST_CHECK_EQUAL( blockEvaluationTimes[ boost::make_tuple( 3, 0, 2, 1 ) ], 0.0 );
+}
+
+//! Test whether overlapping blocks leave no uninitialized elements, and are evaluated in serial.
+BOOST_AUTO_TEST_CASE( test_CompositeStateDerivativeModelOverlappingBlocks )
+{
+    // Shortcuts.
+    typedef state_derivative_models::CompositeStateDerivativeModel<
+            double, Eigen::VectorXd, Eigen::VectorXd > CompositeStateDerivativeModel;
+
+    // Set current composite state.
+    const Eigen::VectorXd currentCompositeState
+            = ( Eigen::VectorXd( 6 ) << 6.6, -1.13, 4.78, 1.3, -0.45, 2.0 ).finished( );
+
+    // Create state derivative model map with two overlapping Vector3d blocks, which together
+    // contain as many elements as the composite state, but do not cover its last element.
+    CompositeStateDerivativeModel::VectorStateDerivativeModelMap stateDerivativeModelMap;
+    stateDerivativeModelMap[ std::make_pair( 0, 3 ) ] = &computeVector3dStateDerivative;
+    stateDerivativeModelMap[ std::make_pair( 2, 3 ) ] = &computeVector3dStateDerivative;
+
+    CompositeStateDerivativeModel compositeStateDerivativeModel(
+                stateDerivativeModelMap, &updateTimeOnly );
+
+    // Check that uncovered element of preallocated state derivative is set to zero.
+    Eigen::VectorXd compositeStateDerivative
+            = Eigen::VectorXd::Constant( currentCompositeState.rows( ), 1.0 );
+    compositeStateDerivativeModel.computeStateDerivativeInto(
+                2.2, currentCompositeState, compositeStateDerivative );
+    BOOST_CHECK_EQUAL( compositeStateDerivative( 5 ), 0.0 );
+
+    // Check that parallel evaluation of overlapping blocks is rejected.
+    BOOST_CHECK_THROW( compositeStateDerivativeModel.setNumberOfThreads( 2 ),
+                       std::runtime_error );
+    BOOST_CHECK_EQUAL( compositeStateDerivativeModel.getNumberOfThreads( ), 1 );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
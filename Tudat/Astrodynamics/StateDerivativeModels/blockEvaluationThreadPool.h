@@ -0,0 +1,276 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *      The thread pool uses dynamic scheduling: every thread (including the calling thread)
+ *      repeatedly takes the next unevaluated block, such that blocks with different evaluation
+ *      costs are balanced over the threads automatically.
+ *
+ */
+
+#ifndef TUDAT_BLOCK_EVALUATION_THREAD_POOL_H
+#define TUDAT_BLOCK_EVALUATION_THREAD_POOL_H
+
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Thread pool for the evaluation of independent blocks.
+/*!
+ * Thread pool that evaluates a number of independent blocks (e.g., the parts of a composite state
+ * derivative) concurrently. The worker threads are created once, in the constructor, and wait for
+ * work in between evaluations, such that the pool can be used efficiently for evaluations that are
+ * repeated many times (e.g., every stage of a numerical integrator). Only a single evaluation can
+ * be in progress at any time; the pool should therefore not be shared between threads.
+ */
+class BlockEvaluationThreadPool : boost::noncopyable
+{
+public:
+
+    //! Typedef for a function that evaluates a single block, given its index.
+    typedef boost::function< void( const unsigned int ) > BlockEvaluationFunction;
+
+    //! Constructor taking the number of threads.
+    /*!
+     * Constructor taking the number of threads. The calling thread also evaluates blocks, such
+     * that numberOfThreads - 1 worker threads are created.
+     * \param numberOfThreads Total number of threads used to evaluate blocks.
+     */
+    explicit BlockEvaluationThreadPool( const unsigned int numberOfThreads )
+        : numberOfThreads_( numberOfThreads < 1 ? 1 : numberOfThreads ),
+          numberOfBlocks_( 0 ),
+          nextBlock_( 0 ),
+          numberOfEvaluatedBlocks_( 0 ),
+          evaluationCounter_( 0 ),
+          isStopRequested_( false )
+    {
+        for ( unsigned int thread = 1; thread < numberOfThreads_; thread++ )
+        {
+            workerThreads_.create_thread(
+                        boost::bind( &BlockEvaluationThreadPool::runWorkerThread, this ) );
+        }
+    }
+
+    //! Destructor.
+    /*!
+     * Destructor, which stops and joins all worker threads.
+     */
+    ~BlockEvaluationThreadPool( )
+    {
+        {
+            boost::lock_guard< boost::mutex > lock( mutex_ );
+            isStopRequested_ = true;
+        }
+        isWorkAvailable_.notify_all( );
+        workerThreads_.join_all( );
+    }
+
+    //! Get number of threads.
+    /*!
+     * Returns the total number of threads used to evaluate blocks, including the calling thread.
+     * \return Number of threads.
+     */
+    unsigned int getNumberOfThreads( ) const { return numberOfThreads_; }
+
+    //! Evaluate blocks.
+    /*!
+     * Evaluates the blocks with indices 0 to numberOfBlocks - 1 concurrently, and returns once
+     * all blocks have been evaluated. If any block evaluation throws an exception, the first
+     * exception is rethrown in the calling thread after all blocks have been processed.
+     * \param blockEvaluationFunction Function that evaluates a single block, given its index. This
+     *          function is called concurrently and must be thread-safe for different indices.
+     * \param numberOfBlocks Number of blocks to evaluate.
+     */
+    void evaluateBlocks( const BlockEvaluationFunction& blockEvaluationFunction,
+                         const unsigned int numberOfBlocks )
+    {
+        // Publish the new evaluation to the worker threads.
+        {
+            boost::lock_guard< boost::mutex > lock( mutex_ );
+            blockEvaluationFunction_ = blockEvaluationFunction;
+            numberOfBlocks_ = numberOfBlocks;
+            nextBlock_ = 0;
+            numberOfEvaluatedBlocks_ = 0;
+            blockEvaluationException_ = boost::exception_ptr( );
+            evaluationCounter_++;
+        }
+        isWorkAvailable_.notify_all( );
+
+        // Evaluate blocks in the calling thread as well.
+        evaluateAvailableBlocks( );
+
+        // Wait for the worker threads to finish their last blocks.
+        boost::exception_ptr blockEvaluationException;
+        {
+            boost::unique_lock< boost::mutex > lock( mutex_ );
+            while ( numberOfEvaluatedBlocks_ < numberOfBlocks_ )
+            {
+                isEvaluationCompleted_.wait( lock );
+            }
+
+            blockEvaluationException = blockEvaluationException_;
+        }
+
+        if ( blockEvaluationException )
+        {
+            boost::rethrow_exception( blockEvaluationException );
+        }
+    }
+
+protected:
+
+private:
+
+    //! Run worker thread.
+    /*!
+     * Main loop of the worker threads, which waits for new evaluations and evaluates blocks until
+     * the pool is destroyed.
+     */
+    void runWorkerThread( )
+    {
+        unsigned long lastEvaluationCounter = 0;
+        while ( true )
+        {
+            {
+                boost::unique_lock< boost::mutex > lock( mutex_ );
+                while ( !isStopRequested_ && evaluationCounter_ == lastEvaluationCounter )
+                {
+                    isWorkAvailable_.wait( lock );
+                }
+
+                if ( isStopRequested_ )
+                {
+                    return;
+                }
+
+                lastEvaluationCounter = evaluationCounter_;
+            }
+
+            evaluateAvailableBlocks( );
+        }
+    }
+
+    //! Evaluate available blocks.
+    /*!
+     * Takes and evaluates unevaluated blocks of the current evaluation, until none are left.
+     */
+    void evaluateAvailableBlocks( )
+    {
+        while ( true )
+        {
+            // Take the next block.
+            unsigned int block;
+            {
+                boost::lock_guard< boost::mutex > lock( mutex_ );
+                if ( nextBlock_ >= numberOfBlocks_ )
+                {
+                    return;
+                }
+
+                block = nextBlock_++;
+            }
+
+            // Evaluate the block outside of the lock, storing the first exception thrown.
+            boost::exception_ptr blockEvaluationException;
+            try
+            {
+                blockEvaluationFunction_( block );
+            }
+            catch ( ... )
+            {
+                blockEvaluationException = boost::current_exception( );
+            }
+
+            // Register the evaluated block, and notify the calling thread if all blocks are done.
+            boost::lock_guard< boost::mutex > lock( mutex_ );
+            if ( blockEvaluationException && !blockEvaluationException_ )
+            {
+                blockEvaluationException_ = blockEvaluationException;
+            }
+
+            if ( ++numberOfEvaluatedBlocks_ == numberOfBlocks_ )
+            {
+                isEvaluationCompleted_.notify_all( );
+            }
+        }
+    }
+
+    //! Total number of threads, including the calling thread.
+    const unsigned int numberOfThreads_;
+
+    //! Worker threads.
+    boost::thread_group workerThreads_;
+
+    //! Mutex protecting all data below.
+    boost::mutex mutex_;
+
+    //! Condition signalling that a new evaluation is available, or that the pool is stopped.
+    boost::condition_variable isWorkAvailable_;
+
+    //! Condition signalling that all blocks of the current evaluation have been evaluated.
+    boost::condition_variable isEvaluationCompleted_;
+
+    //! Block evaluation function of the current evaluation.
+    BlockEvaluationFunction blockEvaluationFunction_;
+
+    //! Number of blocks of the current evaluation.
+    unsigned int numberOfBlocks_;
+
+    //! Index of the next block to be evaluated.
+    unsigned int nextBlock_;
+
+    //! Number of blocks of the current evaluation that have been evaluated.
+    unsigned int numberOfEvaluatedBlocks_;
+
+    //! Counter of evaluations, used by the worker threads to detect new evaluations.
+    unsigned long evaluationCounter_;
+
+    //! Flag indicating that the worker threads should stop.
+    bool isStopRequested_;
+
+    //! First exception thrown by a block evaluation of the current evaluation.
+    boost::exception_ptr blockEvaluationException_;
+};
+
+//! Typedef for shared-pointer to BlockEvaluationThreadPool object.
+typedef boost::shared_ptr< BlockEvaluationThreadPool > BlockEvaluationThreadPoolPointer;
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_BLOCK_EVALUATION_THREAD_POOL_H
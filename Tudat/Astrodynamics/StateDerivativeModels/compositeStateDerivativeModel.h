@@ -27,6 +27,8 @@
  *      120817    K. Kumar          File created.
  *      120817    K. Kumar          Completed Doxygen documentation.
  *      120913    K. Kumar          Rewrote class to work with generic matrices.
+ *      261016    agent             Added optional parallel evaluation of blocks, evaluation into
+ *                                  preallocated state derivative and per-block timing.
  *
  *    References
  *
@@ -36,15 +38,27 @@
  *      are Eigen-specific. At present, these functions must be available in any other data types
  *      used.
  *
+ *      By default, the blocks in the state-derivative model map are evaluated one after another.
+ *      Parallel evaluation of the blocks can be enabled with setNumberOfThreads( ), in which case
+ *      the part state derivative functions are called concurrently, after the update function has
+ *      been called. The part state derivative functions must then be thread-safe, i.e., they may
+ *      only read shared data (such as the data updated by the update function).
+ *
  */
 
 #ifndef TUDAT_COMPOSITE_STATE_DERIVATIVE_MODEL_H
 #define TUDAT_COMPOSITE_STATE_DERIVATIVE_MODEL_H
 
 #include <map>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/exception/all.hpp>
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tuple/tuple_comparison.hpp>
@@ -52,6 +66,7 @@
 
 #include <Eigen/Core>
 
+#include "Tudat/Astrodynamics/StateDerivativeModels/blockEvaluationThreadPool.h"
 #include "Tudat/Astrodynamics/StateDerivativeModels/stateDerivativeModel.h"
 
 namespace tudat
@@ -123,6 +138,13 @@ public:
     typedef std::map< StateSegmentIndices, PartStateDerivativeFunction >
     VectorStateDerivativeModelMap;
 
+    //! Typedef for map of block evaluation times.
+    /*!
+     * Typedef for map of accumulated evaluation times [s] per part state, indexed in the same way
+     * as the state-derivative model map.
+     */
+    typedef std::map< StateBlockIndices, double > BlockEvaluationTimeMap;
+
     //! Constructor taking a state-derivative model map (matrix) and an update function.
     /*!
      * Constructor taking a state-derivative model map, that maps part states (matrices) in the
@@ -139,8 +161,11 @@ public:
                                    const IndependentVariableAndStateUpdateFunction
                                    anUpdateIndependentVariableAndStateFunction )
         : stateDerivativeModelMap( aStateDerivativeModelMap ),
-          updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction )
-    { }
+          updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction ),
+          isBlockEvaluationTimingEnabled( false )
+    {
+        setBlocks( );
+    }
 
     //! Constructor taking a state-derivative model map (vector) and an update function.
     /*!
@@ -172,10 +197,119 @@ public:
             const IndependentVariableType independentVariable,
             const CompositeStateType& compositeState );
 
+    //! Compute state derivative into preallocated composite state derivative.
+    /*!
+     * Computes the state derivative based on the state-derivative model map provided through the
+     * constructor, and writes each part directly into the given composite state derivative.
+     * Elements of the composite state derivative that are not covered by any of the part states
+     * are set to zero.
+     * \param independentVariable Current independent variable value.
+     * \param compositeState Current composite state.
+     * \param compositeStateDerivative Composite state derivative (returned by reference). This
+     *          matrix is resized to the size of the composite state if required.
+     */
+    void computeStateDerivativeInto( const IndependentVariableType independentVariable,
+                                     const CompositeStateType& compositeState,
+                                     CompositeStateDerivativeType& compositeStateDerivative );
+
+    //! Set number of threads used to evaluate the blocks.
+    /*!
+     * Sets the number of threads used to evaluate the blocks of the composite state derivative.
+     * If the number of threads is larger than one, a thread pool is created, and the part state
+     * derivative functions are called concurrently; these must then be thread-safe. Copies of
+     * this object share the same thread pool, and should therefore not be evaluated concurrently.
+     * Parallel evaluation requires that the part states do not overlap.
+     * \param numberOfThreads Total number of threads used to evaluate the blocks (default is 1,
+     *          i.e., serial evaluation).
+     * \throws std::runtime_error If more than one thread is requested and the part states in the
+     *          state-derivative model map overlap.
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        if ( numberOfThreads > 1 && areBlocksOverlapping )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Part states overlap, blocks cannot be evaluated in "
+                                "parallel." ) ) );
+        }
+
+        if ( numberOfThreads > 1 )
+        {
+            blockEvaluationThreadPool
+                    = boost::make_shared< BlockEvaluationThreadPool >( numberOfThreads );
+        }
+
+        else
+        {
+            blockEvaluationThreadPool.reset( );
+        }
+    }
+
+    //! Get number of threads used to evaluate the blocks.
+    /*!
+     * Returns the total number of threads used to evaluate the blocks.
+     * \return Number of threads used to evaluate the blocks.
+     */
+    unsigned int getNumberOfThreads( ) const
+    {
+        return blockEvaluationThreadPool ? blockEvaluationThreadPool->getNumberOfThreads( ) : 1;
+    }
+
+    //! Enable or disable timing of block evaluations.
+    /*!
+     * Enables or disables timing of the evaluation of each block. When enabled, the wall-clock
+     * time spent in each part state derivative function is accumulated.
+     * \param isTimingEnabled Flag indicating whether block evaluations should be timed.
+     */
+    void enableBlockEvaluationTiming( const bool isTimingEnabled = true )
+    {
+        isBlockEvaluationTimingEnabled = isTimingEnabled;
+    }
+
+    //! Get accumulated block evaluation times.
+    /*!
+     * Returns the accumulated wall-clock time [s] spent in the evaluation of each block, since
+     * timing was enabled or last reset.
+     * \return Map of accumulated evaluation times per part state.
+     */
+    BlockEvaluationTimeMap getBlockEvaluationTimes( ) const
+    {
+        BlockEvaluationTimeMap blockEvaluationTimeMap;
+        for ( unsigned int block = 0; block < blockIndices.size( ); block++ )
+        {
+            blockEvaluationTimeMap[ blockIndices[ block ] ] = blockEvaluationTimes[ block ];
+        }
+
+        return blockEvaluationTimeMap;
+    }
+
+    //! Reset accumulated block evaluation times.
+    void resetBlockEvaluationTimes( )
+    {
+        blockEvaluationTimes.assign( blockIndices.size( ), 0.0 );
+    }
+
 protected:
 
 private:
 
+    //! Set blocks from state-derivative model map.
+    /*!
+     * Sets the lists of block indices and part state derivative functions, used to evaluate the
+     * blocks by index, from the state-derivative model map.
+     */
+    void setBlocks( );
+
+    //! Evaluate a single block.
+    /*!
+     * Evaluates the part state derivative function of a single block, and writes the result into
+     * the current composite state derivative.
+     * \param block Index of the block to evaluate.
+     */
+    void evaluateBlock( const unsigned int block );
+
     //! State-derivative model map.
     /*!
      * State-derivative model map that maps part states in the composite state with associated
@@ -189,6 +323,33 @@ private:
      * variable and state data to the current values.
      */
     const IndependentVariableAndStateUpdateFunction updateIndependentVariableAndState;
+
+    //! Block indices of the part states, in the order of the state-derivative model map.
+    std::vector< StateBlockIndices > blockIndices;
+
+    //! Part state derivative functions, in the order of the state-derivative model map.
+    std::vector< PartStateDerivativeFunction > blockFunctions;
+
+    //! Flag indicating whether any of the part states overlap.
+    bool areBlocksOverlapping;
+
+    //! Flag indicating whether block evaluations are timed.
+    bool isBlockEvaluationTimingEnabled;
+
+    //! Accumulated block evaluation times [s], in the order of the state-derivative model map.
+    std::vector< double > blockEvaluationTimes;
+
+    //! Thread pool used to evaluate blocks in parallel (not set for serial evaluation).
+    BlockEvaluationThreadPoolPointer blockEvaluationThreadPool;
+
+    //! Independent variable of the evaluation in progress.
+    IndependentVariableType currentIndependentVariable;
+
+    //! Pointer to the composite state of the evaluation in progress.
+    const CompositeStateType* currentCompositeState;
+
+    //! Pointer to the composite state derivative of the evaluation in progress.
+    CompositeStateDerivativeType* currentCompositeStateDerivative;
 };
 
 //! Constructor taking a state-derivative model map (vector) and an update function.
@@ -197,7 +358,8 @@ CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType, Part
 CompositeStateDerivativeModel( const VectorStateDerivativeModelMap& aVectorStateDerivativeModelMap,
                                const IndependentVariableAndStateUpdateFunction
                                anUpdateIndependentVariableAndStateFunction )
-    : updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction )
+    : updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction ),
+      isBlockEvaluationTimingEnabled( false )
 {
     // Loop through vector state derivative model map and copy to matrix state derivative model
     // map.
@@ -212,6 +374,8 @@ CompositeStateDerivativeModel( const VectorStateDerivativeModelMap& aVectorState
                     iteratorVectorStateDerivativeModelMap->first.second, 1 ) ]
                 = iteratorVectorStateDerivativeModelMap->second;
     }
+
+    setBlocks( );
 }
 
 //! Compute state derivative.
@@ -219,38 +383,131 @@ template< typename IndependentVariableType, typename CompositeStateType, typenam
 CompositeStateType CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType,
 PartStateType >::computeStateDerivative( const IndependentVariableType independentVariable,
                                          const CompositeStateType& compositeState )
+{
+    // Declare composite state derivative, without initializing it.
+    CompositeStateDerivativeType compositeStateDerivative;
+
+    // Compute the composite state derivative directly into the declared matrix.
+    computeStateDerivativeInto( independentVariable, compositeState, compositeStateDerivative );
+
+    // Return the composite state derivative computed.
+    return compositeStateDerivative;
+}
+
+//! Compute state derivative into preallocated composite state derivative.
+template< typename IndependentVariableType, typename CompositeStateType, typename PartStateType >
+void CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType, PartStateType >::
+computeStateDerivativeInto( const IndependentVariableType independentVariable,
+                            const CompositeStateType& compositeState,
+                            CompositeStateDerivativeType& compositeStateDerivative )
 {
     // Update to current data.
     updateIndependentVariableAndState( independentVariable, compositeState );
 
-    // Declare composite state derivative to be the same size as the composite state.
-    CompositeStateType compositeStateDerivative
-            = CompositeStateType::Zero( compositeState.rows( ), compositeState.cols( ) );
+    // Set the composite state derivative to be the same size as the composite state, and set
+    // all elements to zero, so that elements not covered by any part state are initialized.
+    compositeStateDerivative.resize( compositeState.rows( ), compositeState.cols( ) );
+    compositeStateDerivative.setZero( );
 
-    // Loop through the state-derivative model map and compute the elements of the composite
-    // state derivative.
+    // Set the data of the current evaluation, used by evaluateBlock( ).
+    currentIndependentVariable = independentVariable;
+    currentCompositeState = &compositeState;
+    currentCompositeStateDerivative = &compositeStateDerivative;
+
+    // Compute the elements of the composite state derivative, either one after another, or in
+    // parallel using the thread pool.
+    if ( blockEvaluationThreadPool )
+    {
+        blockEvaluationThreadPool->evaluateBlocks(
+                    boost::bind( &CompositeStateDerivativeModel::evaluateBlock, this, _1 ),
+                    blockFunctions.size( ) );
+    }
+
+    else
+    {
+        for ( unsigned int block = 0; block < blockFunctions.size( ); block++ )
+        {
+            evaluateBlock( block );
+        }
+    }
+}
+
+//! Set blocks from state-derivative model map.
+template< typename IndependentVariableType, typename CompositeStateType, typename PartStateType >
+void CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType, PartStateType >::
+setBlocks( )
+{
+    blockIndices.clear( );
+    blockFunctions.clear( );
+    areBlocksOverlapping = false;
+
+    // Loop through the state-derivative model map and store the block indices and functions.
     for ( typename StateDerivativeModelMap::const_iterator iteratorStateDerivativeModels
           = stateDerivativeModelMap.begin( );
           iteratorStateDerivativeModels != stateDerivativeModelMap.end( );
           iteratorStateDerivativeModels++ )
     {
-        // Set block indices for part state derivative.
-        unsigned int startRow = boost::get< 0 >( iteratorStateDerivativeModels->first );
-        unsigned int startColumn = boost::get< 1 >( iteratorStateDerivativeModels->first );
-        unsigned int numberOfRows = boost::get< 2 >( iteratorStateDerivativeModels->first );
-        unsigned int numberOfColumns = boost::get< 3 >( iteratorStateDerivativeModels->first );
-
-        // Compute the associated part in the composite state derivative based on the mapping
-        // provided.
-        compositeStateDerivative.block( startRow, startColumn, numberOfRows, numberOfColumns )
-                = iteratorStateDerivativeModels->second( independentVariable,
-                                                         compositeState.block(
-                                                             startRow, startColumn,
-                                                             numberOfRows, numberOfColumns ) );
+        blockIndices.push_back( iteratorStateDerivativeModels->first );
+        blockFunctions.push_back( iteratorStateDerivativeModels->second );
     }
 
-    // Return the composite state derivative computed.
-    return compositeStateDerivative;
+    // Check whether any two part states overlap, i.e., whether both their row and column ranges
+    // intersect.
+    for ( unsigned int i = 0; i < blockIndices.size( ); i++ )
+    {
+        for ( unsigned int j = i + 1; j < blockIndices.size( ); j++ )
+        {
+            const bool areRowsOverlapping
+                    = boost::get< 0 >( blockIndices[ i ] ) < boost::get< 0 >( blockIndices[ j ] )
+                    + boost::get< 2 >( blockIndices[ j ] )
+                    && boost::get< 0 >( blockIndices[ j ] ) < boost::get< 0 >( blockIndices[ i ] )
+                    + boost::get< 2 >( blockIndices[ i ] );
+            const bool areColumnsOverlapping
+                    = boost::get< 1 >( blockIndices[ i ] ) < boost::get< 1 >( blockIndices[ j ] )
+                    + boost::get< 3 >( blockIndices[ j ] )
+                    && boost::get< 1 >( blockIndices[ j ] ) < boost::get< 1 >( blockIndices[ i ] )
+                    + boost::get< 3 >( blockIndices[ i ] );
+            if ( areRowsOverlapping && areColumnsOverlapping )
+            {
+                areBlocksOverlapping = true;
+            }
+        }
+    }
+
+    blockEvaluationTimes.assign( blockIndices.size( ), 0.0 );
+}
+
+//! Evaluate a single block.
+template< typename IndependentVariableType, typename CompositeStateType, typename PartStateType >
+void CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType, PartStateType >::
+evaluateBlock( const unsigned int block )
+{
+    // Set block indices for part state derivative.
+    const unsigned int startRow = boost::get< 0 >( blockIndices[ block ] );
+    const unsigned int startColumn = boost::get< 1 >( blockIndices[ block ] );
+    const unsigned int numberOfRows = boost::get< 2 >( blockIndices[ block ] );
+    const unsigned int numberOfColumns = boost::get< 3 >( blockIndices[ block ] );
+
+    boost::posix_time::ptime startTime;
+    if ( isBlockEvaluationTimingEnabled )
+    {
+        startTime = boost::posix_time::microsec_clock::universal_time( );
+    }
+
+    // Compute the associated part in the composite state derivative based on the mapping
+    // provided. Each block only writes its own part, so blocks can be evaluated concurrently.
+    currentCompositeStateDerivative->block( startRow, startColumn, numberOfRows, numberOfColumns )
+            = blockFunctions[ block ]( currentIndependentVariable,
+                                       currentCompositeState->block(
+                                           startRow, startColumn,
+                                           numberOfRows, numberOfColumns ) );
+
+    if ( isBlockEvaluationTimingEnabled )
+    {
+        blockEvaluationTimes[ block ] += static_cast< double >(
+                    ( boost::posix_time::microsec_clock::universal_time( ) - startTime )
+                    .total_microseconds( ) ) * 1.0e-6;
+    }
 }
 
 //! Typedef for a composite state derivative model with independent-variable-type = double,
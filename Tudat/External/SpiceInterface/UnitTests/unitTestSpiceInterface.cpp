@@ -26,6 +26,8 @@
  *      YYMMDD    Author            Comment
  *      120717    D. Dirkx          Creation of file.
  *      121001    M. Ganeff         Added unit test for clearing and loading spice kernels.
+ *      261016    agent             Added unit test for batched, prefetched and concurrent
+ *                                  retrieval of states.
  *
  *    References
  *
@@ -48,9 +50,13 @@
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
+#include <boost/bind.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 
 #include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
 #include <TudatCore/Basics/testMacros.h>
@@ -67,6 +73,37 @@ namespace unit_tests
 
 using tudat::basic_mathematics::Vector6d;
 
+//! Retrieve states of bodies from Spice, using prefetching for every other ephemeris time.
+void retrieveBodyCartesianStates( const std::vector< std::string >& targets,
+                                  const std::vector< double >& ephemerisTimes,
+                                  Eigen::MatrixXd& states )
+{
+    using namespace tudat::spice_interface;
+
+    // Prefetch states at every other ephemeris time.
+    std::vector< double > prefetchedEphemerisTimes;
+    for ( unsigned int j = 0; j < ephemerisTimes.size( ); j += 2 )
+    {
+        prefetchedEphemerisTimes.push_back( ephemerisTimes[ j ] );
+    }
+    prefetchBodyCartesianStates( targets, "Solar System Barycenter", "J2000", "NONE",
+                                 prefetchedEphemerisTimes );
+
+    // Retrieve states individually.
+    states.resize( 6 * targets.size( ), ephemerisTimes.size( ) );
+    for ( unsigned int i = 0; i < targets.size( ); i++ )
+    {
+        for ( unsigned int j = 0; j < ephemerisTimes.size( ); j++ )
+        {
+            states.block( 6 * i, j, 6, 1 ) = getBodyCartesianStateAtEpoch(
+                        targets[ i ], "Solar System Barycenter", "J2000", "NONE",
+                        ephemerisTimes[ j ] );
+        }
+    }
+
+    clearPrefetchedBodyCartesianStates( );
+}
+
 BOOST_AUTO_TEST_SUITE( test_spice_wrappers )
 
 // Test 1: Test Julian day <-> Ephemeris time conversions at J2000.
@@ -416,8 +453,86 @@ BOOST_AUTO_TEST_CASE( testSpiceWrappers_6 )
     }
 }
 
-// Test 7: Loading and clearing kernels.
+// Test 7: Batched, prefetched and concurrent retrieval of states.
 BOOST_AUTO_TEST_CASE( testSpiceWrappers_7 )
+{
+    using namespace tudat::spice_interface;
+
+    // Create settings at which states are to be evaluated.
+    std::vector< std::string > targets;
+    targets.push_back( "Mars" );
+    targets.push_back( "Moon" );
+    targets.push_back( "Sun" );
+    const std::string observer = "Solar System Barycenter";
+    const std::string referenceFrame = "J2000";
+    std::vector< double > ephemerisTimes;
+    for ( int j = 0; j < 20; j++ )
+    {
+        ephemerisTimes.push_back( 1.0e6 + 3.0e4 * j );
+    }
+
+    // Check that batched states and rotations are equal to individually retrieved ones.
+    const Eigen::MatrixXd batchedStates = getBodyCartesianStatesAtEpochs(
+                targets, observer, referenceFrame, "NONE", ephemerisTimes );
+    const QuaternionVector batchedRotations = computeRotationQuaternionsBetweenFrames(
+                "J2000", "IAU_EARTH", ephemerisTimes );
+    BOOST_REQUIRE_EQUAL( batchedStates.rows( ), 18 );
+    BOOST_REQUIRE_EQUAL( batchedStates.cols( ), 20 );
+    BOOST_REQUIRE_EQUAL( batchedRotations.size( ), 20 );
+    for ( unsigned int j = 0; j < ephemerisTimes.size( ); j++ )
+    {
+        for ( unsigned int i = 0; i < targets.size( ); i++ )
+        {
+            BOOST_CHECK( batchedStates.block( 6 * i, j, 6, 1 )
+                         == getBodyCartesianStateAtEpoch( targets[ i ], observer, referenceFrame,
+                                                          "NONE", ephemerisTimes[ j ] ) );
+        }
+
+        BOOST_CHECK( batchedRotations[ j ].coeffs( )
+                     == computeRotationQuaternionBetweenFrames(
+                         "J2000", "IAU_EARTH", ephemerisTimes[ j ] ).coeffs( ) );
+    }
+
+    // Check that prefetched states are found, and only for the prefetched settings.
+    prefetchBodyCartesianStates( targets, observer, referenceFrame, "NONE", ephemerisTimes );
+    Vector6d prefetchedState;
+    BOOST_CHECK( findPrefetchedBodyCartesianState( "Moon", observer, referenceFrame, "NONE",
+                                                   ephemerisTimes[ 3 ], prefetchedState ) );
+    BOOST_CHECK( prefetchedState == batchedStates.block( 6, 3, 6, 1 ) );
+    BOOST_CHECK( !findPrefetchedBodyCartesianState( "Moon", observer, referenceFrame, "NONE",
+                                                    ephemerisTimes[ 3 ] + 1.0,
+                                                    prefetchedState ) );
+    BOOST_CHECK( !findPrefetchedBodyCartesianState( "Moon", observer, referenceFrame, "LT",
+                                                    ephemerisTimes[ 3 ], prefetchedState ) );
+    BOOST_CHECK( getBodyCartesianPositionAtEpoch( "Sun", observer, referenceFrame, "NONE",
+                                                  ephemerisTimes[ 5 ] )
+                 == batchedStates.block( 12, 5, 3, 1 ) );
+
+    // Check that prefetched states are cleared.
+    clearPrefetchedBodyCartesianStates( );
+    BOOST_CHECK( !findPrefetchedBodyCartesianState( "Moon", observer, referenceFrame, "NONE",
+                                                    ephemerisTimes[ 3 ], prefetchedState ) );
+
+    // Retrieve states concurrently, and check that results match batched states.
+    const int numberOfThreads = 8;
+    std::vector< Eigen::MatrixXd > concurrentStates( numberOfThreads );
+    boost::thread_group threads;
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        threads.create_thread( boost::bind( &retrieveBodyCartesianStates, boost::cref( targets ),
+                                            boost::cref( ephemerisTimes ),
+                                            boost::ref( concurrentStates[ i ] ) ) );
+    }
+    threads.join_all( );
+
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        BOOST_CHECK( concurrentStates[ i ] == batchedStates );
+    }
+}
+
+// Test 8: Loading and clearing kernels.
+BOOST_AUTO_TEST_CASE( testSpiceWrappers_8 )
 {
     using namespace tudat::spice_interface;
     using namespace tudat::input_output;
@@ -27,6 +27,10 @@
  *      120717    D. Dirkx          Creation of file.
  *      120921    M.I. Ganeff       Added the functions getTotalCountOfKernelsLoaded and
  *                                  clearSpiceKernels.
+ *      261016    agent             Serialized access to Spice; added batched retrieval of states
+ *                                  and rotations, and thread-local prefetching of states.
+ *      261016    agent             Defined Spice mutex and prefetched states at namespace scope;
+ *                                  keyed prefetched states by their settings.
  *
  *    References
  *
@@ -34,7 +38,11 @@
  *
  */
 
+#include <algorithm>
+#include <cstddef>
+
 #include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
 
 #include <TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h>
 
@@ -47,6 +55,28 @@ namespace spice_interface
 
 using tudat::basic_mathematics::Vector6d;
 
+namespace
+{
+
+//! Mutex that serializes access to Spice.
+/*!
+ * Mutex that serializes access to Spice. It is defined at namespace scope, rather than as a
+ * function-local static, so that it is constructed before main( ) is entered, and not by
+ * whichever threads first call Spice (which is not thread-safe without thread-safe statics).
+ */
+boost::recursive_mutex spiceMutex;
+
+//! Prefetched Cartesian states of each thread.
+boost::thread_specific_ptr< PrefetchedBodyCartesianStatesVector > prefetchedBodyCartesianStates;
+
+} // namespace
+
+//! Get mutex that serializes access to Spice.
+boost::recursive_mutex& getSpiceMutex( )
+{
+    return spiceMutex;
+}
+
 //! Convert a Julian date to ephemeris time (equivalent to TDB in Spice).
 double convertJulianDateToEphemerisTime( const double julianDate )
 {
@@ -62,6 +92,9 @@ double convertEphemerisTimeToJulianDate( const double ephemerisTime )
 //! Converts a date string to ephemeris time.
 double convertDateStringToEphemerisTime( const std::string& dateString )
 {
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     double ephemerisTime = 0.0;
     str2et_c( dateString.c_str( ), &ephemerisTime );
     return ephemerisTime;
@@ -73,18 +106,28 @@ Vector6d getBodyCartesianStateAtEpoch(
         const std::string& referenceFrameName, const std::string& abberationCorrections,
         const double ephemerisTime )
 {
+    // Return state prefetched by current thread, if available.
+    Vector6d cartesianStateVector;
+    if ( findPrefetchedBodyCartesianState( targetBodyName, observerBodyName, referenceFrameName,
+                                           abberationCorrections, ephemerisTime,
+                                           cartesianStateVector ) )
+    {
+        return cartesianStateVector;
+    }
 
     // Declare variables for cartesian state and light-time to be determined by Spice.
     double stateAtEpoch[ 6 ];
     double lightTime;
 
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     // Call Spice function to calculate state and light-time.
     spkezr_c( targetBodyName.c_str( ), ephemerisTime, referenceFrameName.c_str( ),
               abberationCorrections.c_str( ), observerBodyName.c_str( ), stateAtEpoch,
               &lightTime );
 
     // Put result in Eigen Vector.
-    Vector6d cartesianStateVector;
     for ( unsigned int i = 0; i < 6 ; i++ )
     {
         cartesianStateVector[ i ] = stateAtEpoch[ i ];
@@ -95,6 +138,35 @@ Vector6d getBodyCartesianStateAtEpoch(
                 cartesianStateVector );
 }
 
+//! Get Cartesian states of bodies at multiple epochs, as observed from another body.
+Eigen::MatrixXd getBodyCartesianStatesAtEpochs(
+        const std::vector< std::string >& targetBodyNames, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections,
+        const std::vector< double >& ephemerisTimes )
+{
+    Eigen::MatrixXd cartesianStates( 6 * targetBodyNames.size( ), ephemerisTimes.size( ) );
+
+    {
+        // Serialize access to Spice.
+        boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
+        // Call Spice function to calculate states and light-times.
+        double lightTime;
+        for ( unsigned int i = 0; i < targetBodyNames.size( ); i++ )
+        {
+            for ( unsigned int j = 0; j < ephemerisTimes.size( ); j++ )
+            {
+                spkezr_c( targetBodyNames[ i ].c_str( ), ephemerisTimes[ j ],
+                          referenceFrameName.c_str( ), abberationCorrections.c_str( ),
+                          observerBodyName.c_str( ), &cartesianStates( 6 * i, j ), &lightTime );
+            }
+        }
+    }
+
+    // Convert from km(/s) to m(/s).
+    return unit_conversions::convertKilometersToMeters< Eigen::MatrixXd >( cartesianStates );
+}
+
 //! Get Cartesian position of a body, as observed from another body.
 Eigen::Vector3d getBodyCartesianPositionAtEpoch( const std::string& targetBodyName,
                                                  const std::string& observerBodyName,
@@ -102,10 +174,22 @@ Eigen::Vector3d getBodyCartesianPositionAtEpoch( const std::string& targetBodyNa
                                                  const std::string& abberationCorrections,
                                                  const double ephemerisTime )
 {
+    // Return position prefetched by current thread, if available.
+    Vector6d prefetchedState;
+    if ( findPrefetchedBodyCartesianState( targetBodyName, observerBodyName, referenceFrameName,
+                                           abberationCorrections, ephemerisTime,
+                                           prefetchedState ) )
+    {
+        return prefetchedState.segment( 0, 3 );
+    }
+
     // Declare variables for cartesian position and light-time to be determined by Spice.
     double positionAtEpoch[ 3 ];
     double lightTime;
 
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     // Call Spice function to calculate position and light-time.
     spkpos_c( targetBodyName.c_str( ), ephemerisTime, referenceFrameName.c_str( ),
               abberationCorrections.c_str( ), observerBodyName.c_str( ), positionAtEpoch,
@@ -131,6 +215,9 @@ Eigen::Quaterniond computeRotationQuaternionBetweenFrames( const std::string& or
     // Declare rotation matrix.
     double rotationArray[ 3 ][ 3 ];
 
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     // Calculate rotation matrix.
     pxform_c( originalFrame.c_str( ), newFrame.c_str( ), ephemerisTime, rotationArray );
 
@@ -148,6 +235,179 @@ Eigen::Quaterniond computeRotationQuaternionBetweenFrames( const std::string& or
     return Eigen::Quaterniond( rotationMatrix );
 }
 
+//! Compute quaternions of rotation between two frames at multiple epochs.
+QuaternionVector computeRotationQuaternionsBetweenFrames(
+        const std::string& originalFrame, const std::string& newFrame,
+        const std::vector< double >& ephemerisTimes )
+{
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
+    QuaternionVector rotationQuaternions;
+    rotationQuaternions.reserve( ephemerisTimes.size( ) );
+    for ( unsigned int i = 0; i < ephemerisTimes.size( ); i++ )
+    {
+        rotationQuaternions.push_back( computeRotationQuaternionBetweenFrames(
+                                           originalFrame, newFrame, ephemerisTimes[ i ] ) );
+    }
+
+    return rotationQuaternions;
+}
+
+//! Compare key of prefetched Cartesian states with settings.
+int compareToPrefetchedBodyCartesianStatesKey(
+        const PrefetchedBodyCartesianStatesKey& key,
+        const std::string& targetBodyName, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections )
+{
+    int comparison = key.targetBodyName.compare( targetBodyName );
+    if ( comparison == 0 )
+    {
+        comparison = key.observerBodyName.compare( observerBodyName );
+    }
+    if ( comparison == 0 )
+    {
+        comparison = key.referenceFrameName.compare( referenceFrameName );
+    }
+    if ( comparison == 0 )
+    {
+        comparison = key.abberationCorrections.compare( abberationCorrections );
+    }
+
+    return comparison;
+}
+
+//! Find prefetched Cartesian states of a body.
+PrefetchedBodyCartesianStatesVector::iterator findPrefetchedBodyCartesianStatesOfBody(
+        PrefetchedBodyCartesianStatesVector& prefetchedStates,
+        const std::string& targetBodyName, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections )
+{
+    // Bisect prefetched states, which are in ascending order of their keys.
+    PrefetchedBodyCartesianStatesVector::iterator firstNotBefore = prefetchedStates.begin( );
+    std::ptrdiff_t numberOfCandidates = prefetchedStates.size( );
+    while ( numberOfCandidates > 0 )
+    {
+        const std::ptrdiff_t halfNumberOfCandidates = numberOfCandidates / 2;
+        const PrefetchedBodyCartesianStatesVector::iterator middle
+                = firstNotBefore + halfNumberOfCandidates;
+        if ( compareToPrefetchedBodyCartesianStatesKey(
+                 middle->key, targetBodyName, observerBodyName, referenceFrameName,
+                 abberationCorrections ) < 0 )
+        {
+            firstNotBefore = middle + 1;
+            numberOfCandidates -= halfNumberOfCandidates + 1;
+        }
+        else
+        {
+            numberOfCandidates = halfNumberOfCandidates;
+        }
+    }
+
+    return firstNotBefore;
+}
+
+//! Get prefetched Cartesian states of current thread.
+PrefetchedBodyCartesianStatesVector& getPrefetchedBodyCartesianStates( )
+{
+    if ( prefetchedBodyCartesianStates.get( ) == NULL )
+    {
+        prefetchedBodyCartesianStates.reset( new PrefetchedBodyCartesianStatesVector( ) );
+    }
+
+    return *prefetchedBodyCartesianStates;
+}
+
+//! Prefetch Cartesian states of bodies at multiple epochs for current thread.
+void prefetchBodyCartesianStates(
+        const std::vector< std::string >& targetBodyNames, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections,
+        const std::vector< double >& ephemerisTimes )
+{
+    // Sort ephemeris times, and remove duplicates.
+    std::vector< double > sortedEphemerisTimes( ephemerisTimes );
+    std::sort( sortedEphemerisTimes.begin( ), sortedEphemerisTimes.end( ) );
+    sortedEphemerisTimes.erase( std::unique( sortedEphemerisTimes.begin( ),
+                                             sortedEphemerisTimes.end( ) ),
+                                sortedEphemerisTimes.end( ) );
+
+    // Retrieve states of all bodies in a single batch.
+    const Eigen::MatrixXd cartesianStates = getBodyCartesianStatesAtEpochs(
+                targetBodyNames, observerBodyName, referenceFrameName, abberationCorrections,
+                sortedEphemerisTimes );
+
+    // Store states of each body for current thread, replacing states with the same settings.
+    PrefetchedBodyCartesianStatesVector& prefetchedStates = getPrefetchedBodyCartesianStates( );
+    for ( unsigned int i = 0; i < targetBodyNames.size( ); i++ )
+    {
+        PrefetchedBodyCartesianStatesVector::iterator position
+                = findPrefetchedBodyCartesianStatesOfBody(
+                    prefetchedStates, targetBodyNames[ i ], observerBodyName, referenceFrameName,
+                    abberationCorrections );
+        if ( position == prefetchedStates.end( )
+             || compareToPrefetchedBodyCartesianStatesKey(
+                 position->key, targetBodyNames[ i ], observerBodyName, referenceFrameName,
+                 abberationCorrections ) != 0 )
+        {
+            position = prefetchedStates.insert(
+                        position, PrefetchedBodyCartesianStates(
+                            PrefetchedBodyCartesianStatesKey(
+                                targetBodyNames[ i ], observerBodyName, referenceFrameName,
+                                abberationCorrections ) ) );
+        }
+
+        PrefetchedBodyCartesianStates& prefetchedStatesOfBody = *position;
+        prefetchedStatesOfBody.ephemerisTimes = sortedEphemerisTimes;
+        prefetchedStatesOfBody.cartesianStates = cartesianStates.block(
+                    6 * i, 0, 6, sortedEphemerisTimes.size( ) );
+    }
+}
+
+//! Find prefetched Cartesian state of current thread.
+bool findPrefetchedBodyCartesianState(
+        const std::string& targetBodyName, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections,
+        const double ephemerisTime, basic_mathematics::Vector6d& cartesianState )
+{
+    PrefetchedBodyCartesianStatesVector& prefetchedStates = getPrefetchedBodyCartesianStates( );
+    if ( prefetchedStates.empty( ) )
+    {
+        return false;
+    }
+
+    // Find prefetched states of body, without constructing a key.
+    const PrefetchedBodyCartesianStatesVector::const_iterator prefetchedStatesOfBody
+            = findPrefetchedBodyCartesianStatesOfBody(
+                prefetchedStates, targetBodyName, observerBodyName, referenceFrameName,
+                abberationCorrections );
+    if ( prefetchedStatesOfBody == prefetchedStates.end( )
+         || compareToPrefetchedBodyCartesianStatesKey(
+             prefetchedStatesOfBody->key, targetBodyName, observerBodyName, referenceFrameName,
+             abberationCorrections ) != 0 )
+    {
+        return false;
+    }
+
+    // Find ephemeris time among prefetched ephemeris times.
+    const std::vector< double >& ephemerisTimes = prefetchedStatesOfBody->ephemerisTimes;
+    const std::vector< double >::const_iterator ephemerisTimeIterator
+            = std::lower_bound( ephemerisTimes.begin( ), ephemerisTimes.end( ), ephemerisTime );
+    if ( ephemerisTimeIterator == ephemerisTimes.end( ) || *ephemerisTimeIterator != ephemerisTime )
+    {
+        return false;
+    }
+
+    cartesianState = prefetchedStatesOfBody->cartesianStates.col(
+                ephemerisTimeIterator - ephemerisTimes.begin( ) );
+    return true;
+}
+
+//! Clear prefetched Cartesian states of current thread.
+void clearPrefetchedBodyCartesianStates( )
+{
+    getPrefetchedBodyCartesianStates( ).clear( );
+}
+
 //! Get property of a body from Spice.
 std::vector< double > getBodyProperties( const std::string& body, const std::string& property,
                                          const int maximumNumberOfValues )
@@ -155,6 +415,9 @@ std::vector< double > getBodyProperties( const std::string& body, const std::str
     // Delcare variable in which raw result is to be put by Spice function.
     double propertyArray[ maximumNumberOfValues ];
 
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     // Call Spice function to retrieve property.
     SpiceInt numberOfReturnedParameters;
     bodvrd_c( body.c_str( ), property.c_str( ), maximumNumberOfValues, &numberOfReturnedParameters,
@@ -176,6 +439,9 @@ double getBodyGravitationalParameter( const std::string& body )
     // Delcare variable in which raw result is to be put by Spice function.
     double gravitationalParameter[ 1 ];
 
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     // Call Spice function to retrieve gravitational parameter.
     SpiceInt numberOfReturnedParameters;
     bodvrd_c( body.c_str( ), "GM", 1, &numberOfReturnedParameters, gravitationalParameter );
@@ -193,6 +459,9 @@ double getAverageRadius( const std::string& body )
     // Delcare variable in which raw result is to be put by Spice function.
     double radii[ 3 ];
 
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     // Call Spice function to retrieve gravitational parameter.
     SpiceInt numberOfReturnedParameters;
     bodvrd_c( body.c_str( ), "RADII", 3, &numberOfReturnedParameters, radii );
@@ -205,6 +474,9 @@ double getAverageRadius( const std::string& body )
 //! Convert a body name to its NAIF identification number.
 int convertBodyNameToNaifId( const std::string& bodyName )
 {
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     // Convert body name to NAIF ID number.
     SpiceInt bodyNaifId;
     SpiceBoolean isIdFound;
@@ -220,6 +492,9 @@ bool checkBodyPropertyInKernelPool( const std::string& bodyName, const std::stri
     // Convert body name to NAIF ID.
     const int naifId = convertBodyNameToNaifId( bodyName );
 
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     // Determine if property is in pool.
     SpiceBoolean isPropertyInPool = bodfnd_c( naifId, bodyProperty.c_str( ) );
     return static_cast< bool >( isPropertyInPool );
@@ -228,19 +503,31 @@ bool checkBodyPropertyInKernelPool( const std::string& bodyName, const std::stri
 //! Load a Spice kernel.
 void loadSpiceKernelInTudat( const std::string& fileName )
 {
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     furnsh_c(  fileName.c_str( ) );
 }
 
 //! Get the amount of loaded Spice kernels.
 int getTotalCountOfKernelsLoaded( )
 {
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
     SpiceInt count;
     ktotal_c( "ALL", &count );
     return count;
 }
 
 //! Clear all Spice kernels.
-void clearSpiceKernels( ) { kclear_c( ); }
+void clearSpiceKernels( )
+{
+    // Serialize access to Spice.
+    boost::lock_guard< boost::recursive_mutex > lock( getSpiceMutex( ) );
+
+    kclear_c( );
+}
 
 } // namespace spice_interface
 } // namespace tudat
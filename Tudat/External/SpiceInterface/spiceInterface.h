@@ -27,6 +27,10 @@
  *      120717    D. Dirkx          Creation of file.
  *      120921    M.I. Ganeff       Added the functions getTotalCountOfKernelsLoaded and
  *                                  clearSpiceKernels.
+ *      261016    agent             Serialized access to Spice; added batched retrieval of states
+ *                                  and rotations, and thread-local prefetching of states.
+ *      261016    agent             Keyed prefetched states by their settings, instead of by a
+ *                                  joined string.
  *
  *    References
  *
@@ -42,6 +46,12 @@
  *
  *      In addition, the USE_CSPICE variable needs to be set to 1 in the top-level CMakeLists.txt.
  *
+ *      Spice has global state and is not thread-safe. All functions in this file therefore lock
+ *      the mutex returned by getSpiceMutex( ), so that they can be called from multiple threads.
+ *      Since the Spice calls themselves are serialized, threads that require many states should
+ *      retrieve them in batches (see getBodyCartesianStatesAtEpochs( )), or prefetch them (see
+ *      prefetchBodyCartesianStates( )).
+ *
  */
 
 #ifndef TUDAT_SPICE_INTERFACE_H
@@ -50,8 +60,11 @@
 #include <string>
 #include <vector>
 
+#include <boost/thread/recursive_mutex.hpp>
+
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <Eigen/StdVector>
 
 #include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
 
@@ -66,6 +79,82 @@ namespace tudat
 namespace spice_interface
 {
 
+//! Typedef for vector of quaternions.
+typedef std::vector< Eigen::Quaterniond, Eigen::aligned_allocator< Eigen::Quaterniond > >
+QuaternionVector;
+
+//! Key of prefetched Cartesian states of a body.
+/*!
+ * Settings with which the Cartesian states of a body are prefetched (see
+ * prefetchBodyCartesianStates( )). Keys are ordered lexicographically by their members, in the
+ * order in which they are declared.
+ */
+struct PrefetchedBodyCartesianStatesKey
+{
+    //! Constructor.
+    PrefetchedBodyCartesianStatesKey( const std::string& aTargetBodyName,
+                                      const std::string& anObserverBodyName,
+                                      const std::string& aReferenceFrameName,
+                                      const std::string& someAbberationCorrections )
+        : targetBodyName( aTargetBodyName ),
+          observerBodyName( anObserverBodyName ),
+          referenceFrameName( aReferenceFrameName ),
+          abberationCorrections( someAbberationCorrections )
+    { }
+
+    //! Name of the body of which the states are obtained.
+    std::string targetBodyName;
+
+    //! Name of the body relative to which the states are obtained.
+    std::string observerBodyName;
+
+    //! Name of the reference frame in which the states are expressed.
+    std::string referenceFrameName;
+
+    //! Setting for aberration corrections.
+    std::string abberationCorrections;
+};
+
+//! Prefetched Cartesian states of a body.
+/*!
+ * Cartesian states of a body, as observed from another body, prefetched from Spice at a number of
+ * ephemeris times (see prefetchBodyCartesianStates( )).
+ */
+struct PrefetchedBodyCartesianStates
+{
+    //! Constructor.
+    PrefetchedBodyCartesianStates( const PrefetchedBodyCartesianStatesKey& aKey )
+        : key( aKey )
+    { }
+
+    //! Settings with which states are prefetched.
+    PrefetchedBodyCartesianStatesKey key;
+
+    //! Ephemeris times of prefetched states, in ascending order.
+    std::vector< double > ephemerisTimes;
+
+    //! Prefetched Cartesian states, one column per ephemeris time.
+    Eigen::MatrixXd cartesianStates;
+};
+
+//! Typedef for vector of prefetched Cartesian states.
+/*!
+ * Typedef for vector of prefetched Cartesian states, in ascending order of their keys. A sorted
+ * vector is used instead of a map, so that prefetched states can be found by bisection without
+ * constructing a key (see findPrefetchedBodyCartesianStatesOfBody( )).
+ */
+typedef std::vector< PrefetchedBodyCartesianStates > PrefetchedBodyCartesianStatesVector;
+
+//! Get mutex that serializes access to Spice.
+/*!
+ * Returns the mutex that serializes all calls to Spice, which has global state and is not
+ * thread-safe. The mutex is locked by all functions in this file. It is recursive, so that users
+ * that call Spice functions directly can lock it around (sequences of) Spice calls, including
+ * calls to the functions in this file.
+ * \return Mutex that serializes access to Spice.
+ */
+boost::recursive_mutex& getSpiceMutex( );
+
 //! Convert a Julian date to ephemeris time (equivalent to TDB in Spice).
 /*!
  * Function to convert a Julian date to ephemeris time, which is equivalent to barycentric
@@ -118,12 +207,36 @@ double convertDateStringToEphemerisTime( const std::string& dateString );
  * \param epehemerisTime Observation time (or transmission time of observed light, see description
  *          of abberationCorrections)
  * \return Cartesian state vector (x,y,z, position+velocity).
+ *
+ * If the state has been prefetched by the current thread (see prefetchBodyCartesianStates( )),
+ * the prefetched state is returned without calling Spice.
  */
 basic_mathematics::Vector6d getBodyCartesianStateAtEpoch(
         const std::string& targetBodyName, const std::string& observerBodyName,
         const std::string& referenceFrameName, const std::string& abberationCorrections,
         const double ephemerisTime );
 
+//! Get Cartesian states of bodies at multiple epochs, as observed from another body.
+/*!
+ * This function returns the states of a number of bodies, relative to another body, in a frame
+ * specified by the user, at a number of ephemeris times (see getBodyCartesianStateAtEpoch( )).
+ * Access to Spice is obtained only once for all states, so that concurrent threads can retrieve
+ * all states they require in a single round trip. Wrapper for spkezr_c spice function.
+ * \param targetBodyNames Names of the bodies of which the states are to be obtained.
+ * \param observerBodyName Name of the body relative to which the states are to be obtained.
+ * \param referenceFrameName The spice-recognized name of the reference frame in which the states
+ *          are to be returned.
+ * \param abberationCorrections Setting for aberration corrections, see
+ *          getBodyCartesianStateAtEpoch( ).
+ * \param ephemerisTimes Observation times (or transmission times of observed light).
+ * \return Cartesian states, with one column per ephemeris time, and six rows per target body (in
+ *          the order of targetBodyNames).
+ */
+Eigen::MatrixXd getBodyCartesianStatesAtEpochs(
+        const std::vector< std::string >& targetBodyNames, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections,
+        const std::vector< double >& ephemerisTimes );
+
 //! Get Cartesian position of a body, as observed from another body.
 /*!
  * This function returns the position of a body, relative to another body, in a frame specified
@@ -148,6 +261,9 @@ basic_mathematics::Vector6d getBodyCartesianStateAtEpoch(
  * \param ephemerisTime Observation time (or transmission time of observed light, see description
  *          of abberationCorrections)
  * \return Cartesian position vector (x,y,z, position).
+ *
+ * If the state has been prefetched by the current thread (see prefetchBodyCartesianStates( )),
+ * the prefetched position is returned without calling Spice.
  */
 Eigen::Vector3d getBodyCartesianPositionAtEpoch( const std::string& targetBodyName,
                                                  const std::string& observerBodyName,
@@ -168,6 +284,107 @@ Eigen::Quaterniond computeRotationQuaternionBetweenFrames( const std::string& or
                                                            const std::string& newFrame,
                                                            const double ephemerisTime );
 
+//! Compute quaternions of rotation between two frames at multiple epochs.
+/*!
+ * This function computes the quaternions of rotation between two frames at a number of time
+ * instants (see computeRotationQuaternionBetweenFrames( )). Access to Spice is obtained only once
+ * for all rotations. Wrapper for pxform_c spice function.
+ * \param originalFrame Reference frame from which the rotation is made.
+ * \param newFrame Reference frame to which the rotation is made.
+ * \param ephemerisTimes Values of ephemeris time at which rotation is to be determined.
+ * \return Quaternions of rotation, one per ephemeris time.
+ */
+QuaternionVector computeRotationQuaternionsBetweenFrames(
+        const std::string& originalFrame, const std::string& newFrame,
+        const std::vector< double >& ephemerisTimes );
+
+//! Compare key of prefetched Cartesian states with settings.
+/*!
+ * Compares a key of prefetched Cartesian states lexicographically with the settings of states,
+ * without constructing a key from these settings.
+ * \param key Key of prefetched Cartesian states.
+ * \param targetBodyName Name of the body of which the states are obtained.
+ * \param observerBodyName Name of the body relative to which the states are obtained.
+ * \param referenceFrameName Name of the reference frame in which the states are expressed.
+ * \param abberationCorrections Setting for aberration corrections.
+ * \return Negative value, zero or positive value if the key is ordered before, equal to or after
+ *          the settings, respectively.
+ */
+int compareToPrefetchedBodyCartesianStatesKey(
+        const PrefetchedBodyCartesianStatesKey& key,
+        const std::string& targetBodyName, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections );
+
+//! Find prefetched Cartesian states of a body.
+/*!
+ * Finds, by bisection, the first prefetched Cartesian states of which the key is not ordered
+ * before the given settings (see compareToPrefetchedBodyCartesianStatesKey( )). This is the
+ * position at which states with these settings are, or are to be inserted.
+ * \param prefetchedStates Prefetched Cartesian states, in ascending order of their keys.
+ * \param targetBodyName Name of the body of which the states are obtained.
+ * \param observerBodyName Name of the body relative to which the states are obtained.
+ * \param referenceFrameName Name of the reference frame in which the states are expressed.
+ * \param abberationCorrections Setting for aberration corrections.
+ * \return Iterator to first prefetched Cartesian states not ordered before the settings.
+ */
+PrefetchedBodyCartesianStatesVector::iterator findPrefetchedBodyCartesianStatesOfBody(
+        PrefetchedBodyCartesianStatesVector& prefetchedStates,
+        const std::string& targetBodyName, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections );
+
+//! Get prefetched Cartesian states of current thread.
+/*!
+ * Returns the Cartesian states that have been prefetched by the current thread. Each thread has
+ * its own prefetched states, which can therefore be accessed without locking.
+ * \return Prefetched Cartesian states of current thread.
+ */
+PrefetchedBodyCartesianStatesVector& getPrefetchedBodyCartesianStates( );
+
+//! Prefetch Cartesian states of bodies at multiple epochs for current thread.
+/*!
+ * Retrieves the states of a number of bodies, as observed from another body, at a number of
+ * ephemeris times in a single batch (see getBodyCartesianStatesAtEpochs( )), and stores them for
+ * the current thread. Subsequent calls of getBodyCartesianStateAtEpoch( ) and
+ * getBodyCartesianPositionAtEpoch( ) from the current thread, with the same settings and one of
+ * these ephemeris times, return the prefetched states without calling Spice. Prefetched states
+ * of the same target body, observer body, reference frame and aberration corrections are
+ * replaced. Prefetched states are not updated when kernels are loaded or cleared.
+ * \param targetBodyNames Names of the bodies of which the states are to be obtained.
+ * \param observerBodyName Name of the body relative to which the states are to be obtained.
+ * \param referenceFrameName The spice-recognized name of the reference frame in which the states
+ *          are to be returned.
+ * \param abberationCorrections Setting for aberration corrections, see
+ *          getBodyCartesianStateAtEpoch( ).
+ * \param ephemerisTimes Observation times (or transmission times of observed light).
+ */
+void prefetchBodyCartesianStates(
+        const std::vector< std::string >& targetBodyNames, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections,
+        const std::vector< double >& ephemerisTimes );
+
+//! Find prefetched Cartesian state of current thread.
+/*!
+ * Finds a Cartesian state that has been prefetched by the current thread (see
+ * prefetchBodyCartesianStates( )).
+ * \param targetBodyName Name of the body of which the state is to be obtained.
+ * \param observerBodyName Name of the body relative to which the state is to be obtained.
+ * \param referenceFrameName Name of the reference frame in which the state is expressed.
+ * \param abberationCorrections Setting for aberration corrections.
+ * \param ephemerisTime Observation time (or transmission time of observed light).
+ * \param cartesianState Prefetched Cartesian state, if found (returned by reference).
+ * \return True if the state has been prefetched, false if not.
+ */
+bool findPrefetchedBodyCartesianState(
+        const std::string& targetBodyName, const std::string& observerBodyName,
+        const std::string& referenceFrameName, const std::string& abberationCorrections,
+        const double ephemerisTime, basic_mathematics::Vector6d& cartesianState );
+
+//! Clear prefetched Cartesian states of current thread.
+/*!
+ * Removes all Cartesian states that have been prefetched by the current thread.
+ */
+void clearPrefetchedBodyCartesianStates( );
+
 //! Get property of a body from Spice.
 /*!
  * Function to retrieve a property of a body from Spice, wraps the bodvrd_c Spice function.
@@ -0,0 +1,101 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/InputOutput/fieldRange.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::input_output;
+
+//! Create field range from null-terminated string.
+FieldRange createFieldRange( const char* text )
+{
+    return FieldRange( text, text + std::strlen( text ) );
+}
+
+// Define Boost test suite.
+BOOST_AUTO_TEST_SUITE( test_field_range )
+
+//! Test trimming of whitespace off fields.
+BOOST_AUTO_TEST_CASE( testFieldRangeTrim )
+{
+    BOOST_CHECK_EQUAL( convertFieldToString( trimField( createFieldRange( " \t12 3\r\n" ) ) ),
+                       "12 3" );
+    BOOST_CHECK_EQUAL( convertFieldToString( trimField( createFieldRange( "abc" ) ) ), "abc" );
+    BOOST_CHECK( trimField( createFieldRange( "  \t " ) ).empty( ) );
+    BOOST_CHECK( trimField( createFieldRange( "" ) ).empty( ) );
+}
+
+//! Test conversion of fields to numbers, which must be equal to conversion by the C library.
+BOOST_AUTO_TEST_CASE( testFieldRangeConversion )
+{
+    BOOST_CHECK_EQUAL( convertFieldToDouble( createFieldRange( " 3.9501468 " ) ), 3.9501468 );
+    BOOST_CHECK_EQUAL( convertFieldToDouble( createFieldRange( "-2.5e-3" ) ), -2.5e-3 );
+    BOOST_CHECK_EQUAL( convertFieldToDouble( createFieldRange( "1.7976931348623157e308" ) ),
+                       std::numeric_limits< double >::max( ) );
+    BOOST_CHECK_EQUAL( convertFieldToInteger( createFieldRange( " 2011542" ) ), 2011542 );
+    BOOST_CHECK_EQUAL( convertFieldToInteger( createFieldRange( "-154" ) ), -154 );
+
+    // Check that a field is converted without reading beyond its end.
+    const char* line = "1.25,7";
+    BOOST_CHECK_EQUAL( convertFieldToDouble( FieldRange( line, line + 4 ) ), 1.25 );
+    BOOST_CHECK_EQUAL( convertFieldToInteger( FieldRange( line, line + 1 ) ), 1 );
+
+    // Check that invalid fields are not converted.
+    BOOST_CHECK_THROW( convertFieldToDouble( createFieldRange( "" ) ), std::runtime_error );
+    BOOST_CHECK_THROW( convertFieldToDouble( createFieldRange( "1.5a" ) ), std::runtime_error );
+    BOOST_CHECK_THROW( convertFieldToDouble( createFieldRange( "JPL 154" ) ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( convertFieldToInteger( createFieldRange( "1.5" ) ), std::runtime_error );
+    BOOST_CHECK_THROW( convertFieldToDouble( createFieldRange(
+                           "0.00000000000000000000000000000000000000000000000000000000000001" ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
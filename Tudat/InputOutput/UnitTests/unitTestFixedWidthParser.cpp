@@ -28,6 +28,7 @@
  *      120615    D.J. Gondelach    Adapted code to Boost test suite.
  *      120718    A. Ronse          Added multiline and non-trim unit test.
  *      130301    S. Billemont      Updated tests to new FieldValue definition.
+ *      261016    agent             Added test of streaming mode.
  *
  *    References
  *
@@ -38,9 +39,11 @@
 #define BOOST_TEST_MAIN
 
 #include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+#include "Tudat/InputOutput/fieldRange.h"
 #include "Tudat/InputOutput/fieldType.h"
 #include "Tudat/InputOutput/fixedWidthParser.h"
 #include "Tudat/InputOutput/parsedDataVectorUtilities.h"
@@ -50,6 +53,29 @@ namespace tudat
 namespace unit_tests
 {
 
+//! Line visitor that stores the fields of all lines parsed in streaming mode as strings.
+struct FieldCollector
+{
+    //! Constructor, taking the container in which the fields are stored.
+    FieldCollector( std::vector< std::vector< std::string > >& parsedLines )
+        : parsedLines_( parsedLines )
+    { }
+
+    //! Store fields of parsed line.
+    void operator( )( const std::vector< tudat::input_output::FieldRange >& fields )
+    {
+        parsedLines_.push_back( std::vector< std::string >( ) );
+        for ( unsigned int i = 0; i < fields.size( ); i++ )
+        {
+            parsedLines_.back( ).push_back(
+                        tudat::input_output::convertFieldToString( fields[ i ] ) );
+        }
+    }
+
+    //! Fields of parsed lines.
+    std::vector< std::vector< std::string > >& parsedLines_;
+};
+
 BOOST_AUTO_TEST_SUITE( test_fixedwidth_parser )
 
 //! Test if a single line is correctly parsed.
@@ -191,6 +217,58 @@ BOOST_AUTO_TEST_CASE( testFixedWidthParserMultiLineWithoutTrim )
     BOOST_CHECK_EQUAL( Line2Data->find( time::epoch )->second->getRaw( ), ( "   54000" ) );
 }
 
+//! Test if multiple lines are parsed in streaming mode as in line based mode.
+BOOST_AUTO_TEST_CASE( testFixedWidthParserStreaming )
+{
+    using namespace tudat::input_output::parsed_data_vector_utilities;
+    using namespace tudat::input_output::field_types;
+
+    // Create GTOC2AsteroidEphemerides fixed width parser.
+    tudat::input_output::FixedWidthParser
+        testFixedWidthParser( 8,
+                              general::id,
+                              state::semiMajorAxis,
+                              state::eccentricity,
+                              state::inclination,
+                              state::longitudeOfAscendingNode,
+                              state::argumentOfPeriapsis,
+                              state::meanAnomaly,
+                              time::epoch,
+                              11, 18, 18, 15, 16, 15, 17, 8 );
+
+    // Create test data, of which the last line is shorter than the sum of the field widths.
+    std::string testString( "2011542          3.9501468       0.2391642         6.87574        "
+                            "16.88982         48.9603       229.49648       54000\n2001038       "
+                            "   3.9619932        0.227483         9.22988        58.20488       "
+                            "307.19412       201.38868       54" );
+
+    for ( int trim = 0; trim < 2; trim++ )
+    {
+        testFixedWidthParser.setTrim( trim == 1 );
+
+        // Parse the data in streaming and line based mode.
+        std::vector< std::vector< std::string > > parsedLines;
+        testFixedWidthParser.parseBuffer( testString.data( ),
+                                          testString.data( ) + testString.size( ),
+                                          FieldCollector( parsedLines ) );
+        ParsedDataVectorPtr testResult = testFixedWidthParser.parse( testString );
+
+        // Check that lines are parsed identically.
+        BOOST_CHECK_EQUAL( parsedLines.size( ), 2 );
+        for ( unsigned int i = 0; i < parsedLines.size( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( parsedLines[ i ].size( ), 8 );
+            for ( unsigned int j = 0; j < parsedLines[ i ].size( ); j++ )
+            {
+                BOOST_CHECK_EQUAL( parsedLines[ i ][ j ],
+                                   testResult->at( i )->find(
+                                       testFixedWidthParser.getFieldTypes( )[ j ] )
+                                   ->second->getRaw( ) );
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
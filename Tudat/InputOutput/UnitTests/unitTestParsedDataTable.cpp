@@ -0,0 +1,233 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/regex.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/InputOutput/fieldType.h"
+#include "Tudat/InputOutput/parsedDataTable.h"
+#include "Tudat/InputOutput/parsedDataVectorUtilities.h"
+#include "Tudat/InputOutput/separatedParser.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::input_output;
+
+//! Create parsed data table of test data.
+/*!
+ * Creates a parsed data table of test data (lines of GTOC2 problem data file, with names added),
+ * with a text column for the name and numeric columns for the other fields, by parsing the data
+ * in streaming mode. The line based parsed data is returned as well.
+ * \param parsedDataVector Parsed data vector of test data (returned by reference).
+ * \return Parsed data table of test data.
+ */
+ParsedDataTable createTestTable( parsed_data_vector_utilities::ParsedDataVectorPtr&
+                                 parsedDataVector )
+{
+    SeparatedParser parser( " ", 5,
+                            field_types::general::name,
+                            field_types::general::id,
+                            field_types::state::semiMajorAxis,
+                            field_types::state::eccentricity,
+                            field_types::time::epoch );
+
+    std::string testData( "Ast1 2011542 3.9501468 0.2391642 54000\n"
+                          "Ast2 2001038 3.9619932 0.227483 54000\n"
+                          "Cmt1 3000140 4.1084594 0.3564372 54100\n"
+                          "Ast3 2000165 4.5209082 0.1416004 54000" );
+
+    ParsedDataTable table( parser.getFieldTypes( ),
+                           boost::assign::list_of( ParsedDataTable::text_column )
+                           ( ParsedDataTable::numeric_column )( ParsedDataTable::numeric_column )
+                           ( ParsedDataTable::numeric_column )
+                           ( ParsedDataTable::numeric_column ) );
+    parser.parseBuffer( testData.data( ), testData.data( ) + testData.size( ),
+                        table.getRowAppender( ) );
+
+    parsedDataVector = boost::make_shared< parsed_data_vector_utilities::ParsedDataVector >(
+                *parser.parse( testData ) );
+    return table;
+}
+
+BOOST_AUTO_TEST_SUITE( test_parsed_data_table )
+
+//! Test that table is filled by parser in streaming mode.
+BOOST_AUTO_TEST_CASE( testParsedDataTableStreaming )
+{
+    parsed_data_vector_utilities::ParsedDataVectorPtr parsedDataVector;
+    const ParsedDataTable table = createTestTable( parsedDataVector );
+
+    BOOST_CHECK_EQUAL( table.getNumberOfRows( ), 4 );
+    BOOST_CHECK_EQUAL( table.getNumberOfColumns( ), 5 );
+    BOOST_CHECK( table.hasColumn( field_types::state::eccentricity ) );
+    BOOST_CHECK( !table.hasColumn( field_types::state::inclination ) );
+    BOOST_CHECK_EQUAL( table.getColumnType( field_types::general::name ),
+                       ParsedDataTable::text_column );
+
+    // Check that values are equal to those of the parsed data vector.
+    const std::vector< double >& semiMajorAxes
+            = table.getNumericColumn( field_types::state::semiMajorAxis );
+    BOOST_CHECK_EQUAL( semiMajorAxes.size( ), 4 );
+    for ( unsigned int i = 0; i < parsedDataVector->size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( table.getText( field_types::general::name, i ),
+                           parsed_data_vector_utilities::getField< std::string >(
+                               parsedDataVector->at( i ), field_types::general::name ) );
+        BOOST_CHECK_EQUAL( semiMajorAxes[ i ],
+                           parsed_data_vector_utilities::getField< double >(
+                               parsedDataVector->at( i ), field_types::state::semiMajorAxis ) );
+        BOOST_CHECK_EQUAL( table.getNumericColumn( field_types::general::id )[ i ],
+                           parsed_data_vector_utilities::getField< int >(
+                               parsedDataVector->at( i ), field_types::general::id ) );
+    }
+
+    // Check that columns are only accessed with their type.
+    BOOST_CHECK_THROW( table.getNumericColumn( field_types::general::name ), std::runtime_error );
+    BOOST_CHECK_THROW( table.getText( field_types::time::epoch, 0 ), std::runtime_error );
+    BOOST_CHECK_THROW( table.getNumericColumn( field_types::state::inclination ),
+                       std::runtime_error );
+}
+
+//! Test that table is left unchanged if a row cannot be appended.
+BOOST_AUTO_TEST_CASE( testParsedDataTableInvalidRow )
+{
+    parsed_data_vector_utilities::ParsedDataVectorPtr parsedDataVector;
+    ParsedDataTable table = createTestTable( parsedDataVector );
+
+    std::string invalidLine( "Ast4 2000166 4.52x 0.14 54000" );
+    SeparatedParser parser( " ", 5,
+                            field_types::general::name,
+                            field_types::general::id,
+                            field_types::state::semiMajorAxis,
+                            field_types::state::eccentricity,
+                            field_types::time::epoch );
+    BOOST_CHECK_THROW( parser.parseBuffer( invalidLine.data( ),
+                                           invalidLine.data( ) + invalidLine.size( ),
+                                           table.getRowAppender( ) ),
+                       std::runtime_error );
+
+    BOOST_CHECK_EQUAL( table.getNumberOfRows( ), 4 );
+    BOOST_CHECK_EQUAL( table.getNumericColumn( field_types::general::id ).size( ), 4 );
+    BOOST_CHECK_THROW( table.getText( field_types::general::name, 4 ), std::out_of_range );
+}
+
+//! Test filter, select and convert operations.
+BOOST_AUTO_TEST_CASE( testParsedDataTableOperations )
+{
+    parsed_data_vector_utilities::ParsedDataVectorPtr parsedDataVector;
+    ParsedDataTable table = createTestTable( parsedDataVector );
+
+    // Filter rows on numeric and text columns.
+    const std::vector< std::size_t > rowsInRange
+            = table.findRowsInRange( field_types::state::semiMajorAxis, 3.96, 4.2 );
+    BOOST_CHECK_EQUAL( rowsInRange.size( ), 2 );
+    BOOST_CHECK_EQUAL( rowsInRange[ 0 ], 1 );
+    BOOST_CHECK_EQUAL( rowsInRange[ 1 ], 2 );
+
+    const std::vector< std::size_t > matchingRows
+            = table.findRowsMatching( field_types::general::name, boost::regex( "^Ast" ) );
+    BOOST_CHECK_EQUAL( matchingRows.size( ), 3 );
+    BOOST_CHECK_EQUAL( matchingRows[ 2 ], 3 );
+
+    // Select rows.
+    const ParsedDataTable selectedRows = table.selectRows( matchingRows );
+    BOOST_CHECK_EQUAL( selectedRows.getNumberOfRows( ), 3 );
+    BOOST_CHECK_EQUAL( selectedRows.getNumberOfColumns( ), 5 );
+    BOOST_CHECK_EQUAL( selectedRows.getText( field_types::general::name, 2 ), "Ast3" );
+    BOOST_CHECK_EQUAL( selectedRows.getNumericColumn( field_types::state::eccentricity )[ 2 ],
+                       0.1416004 );
+    BOOST_CHECK_THROW( table.selectRows( boost::assign::list_of( 4 ) ), std::runtime_error );
+
+    // Select columns.
+    const ParsedDataTable selectedColumns = table.selectColumns(
+                boost::assign::list_of( field_types::time::epoch )( field_types::general::name ) );
+    BOOST_CHECK_EQUAL( selectedColumns.getNumberOfRows( ), 4 );
+    BOOST_CHECK_EQUAL( selectedColumns.getNumberOfColumns( ), 2 );
+    BOOST_CHECK_EQUAL( selectedColumns.getFieldTypes( )[ 0 ], field_types::time::epoch );
+    BOOST_CHECK_EQUAL( selectedColumns.getText( field_types::general::name, 2 ), "Cmt1" );
+    BOOST_CHECK_EQUAL( selectedColumns.getNumericColumn( field_types::time::epoch )[ 2 ],
+                       54100.0 );
+    BOOST_CHECK( !selectedColumns.hasColumn( field_types::state::semiMajorAxis ) );
+
+    // Convert epochs from modified Julian days to Julian days.
+    table.transformNumericColumn( field_types::time::epoch, 1.0, 2400000.5 );
+    BOOST_CHECK_EQUAL( table.getNumericColumn( field_types::time::epoch )[ 2 ], 2454100.5 );
+    BOOST_CHECK_EQUAL( selectedColumns.getNumericColumn( field_types::time::epoch )[ 2 ],
+                       54100.0 );
+}
+
+//! Test conversion of parsed data vector to table.
+BOOST_AUTO_TEST_CASE( testParsedDataTableFromParsedDataVector )
+{
+    parsed_data_vector_utilities::ParsedDataVectorPtr parsedDataVector;
+    const ParsedDataTable table = createTestTable( parsedDataVector );
+
+    // Add line without epoch, which is skipped in conversion.
+    parsed_data_vector_utilities::ParsedDataLineMapPtr incompleteLine
+            = boost::make_shared< parsed_data_vector_utilities::ParsedDataLineMap >(
+                *parsedDataVector->at( 0 ) );
+    incompleteLine->erase( field_types::time::epoch );
+    parsedDataVector->insert( parsedDataVector->begin( ) + 1, incompleteLine );
+
+    const ParsedDataTable convertedTable(
+                parsedDataVector,
+                boost::assign::list_of( field_types::general::name )( field_types::time::epoch ),
+                boost::assign::list_of( ParsedDataTable::text_column )
+                ( ParsedDataTable::numeric_column ) );
+
+    BOOST_CHECK_EQUAL( convertedTable.getNumberOfRows( ), 4 );
+    for ( unsigned int i = 0; i < table.getNumberOfRows( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( convertedTable.getText( field_types::general::name, i ),
+                           table.getText( field_types::general::name, i ) );
+        BOOST_CHECK_EQUAL( convertedTable.getNumericColumn( field_types::time::epoch )[ i ],
+                           table.getNumericColumn( field_types::time::epoch )[ i ] );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -28,6 +28,7 @@
  *      111130    S. Billemont      Rewrote tests in boost.test form.
  *      120718    A. Ronse          Added unit test from "whitespaceparser".
  *      130301    S. Billemont      Updated tests to new FieldValue definition.
+ *      261016    agent             Added tests of streaming mode.
  *
  *    References
  *
@@ -37,16 +38,22 @@
 
 #define BOOST_TEST_MAIN
 
+#include <fstream>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <boost/assign.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h>
 
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/fieldRange.h"
 #include "Tudat/InputOutput/fieldType.h"
 #include "Tudat/InputOutput/parsedDataVectorUtilities.h"
 #include "Tudat/InputOutput/separatedParser.h"
@@ -61,6 +68,29 @@ BOOST_AUTO_TEST_SUITE( test_suite_separated_parser )
 
 using namespace tudat::input_output::parsed_data_vector_utilities;
 
+//! Line visitor that stores the fields of all lines parsed in streaming mode as strings.
+struct FieldCollector
+{
+    //! Constructor, taking the container in which the fields are stored.
+    FieldCollector( std::vector< std::vector< std::string > >& parsedLines )
+        : parsedLines_( parsedLines )
+    { }
+
+    //! Store fields of parsed line.
+    void operator( )( const std::vector< tudat::input_output::FieldRange >& fields )
+    {
+        parsedLines_.push_back( std::vector< std::string >( ) );
+        for ( unsigned int i = 0; i < fields.size( ); i++ )
+        {
+            parsedLines_.back( ).push_back(
+                        tudat::input_output::convertFieldToString( fields[ i ] ) );
+        }
+    }
+
+    //! Fields of parsed lines.
+    std::vector< std::vector< std::string > >& parsedLines_;
+};
+
 //! Create a parser that will be used in all tests (see fixtures).
 struct test_separated_parser_fixture
 {
@@ -347,6 +377,102 @@ BOOST_AUTO_TEST_CASE( testSeparatedParserFieldTransform )
     BOOST_CHECK( testLineData->find( field_types::state::trueAnomaly ) == testLineData->end( ) );
 }
 
+BOOST_AUTO_TEST_CASE( testSeparatedParserStreamingBuffer )
+{
+    using namespace tudat::input_output::field_types;
+
+    // Create test data, with Windows and Unix line endings and an empty line.
+    std::string csvText( " 12 , 1, 2, 3\r\n24, 5, 6, 7\n\na, b c, d, e\n" );
+
+    // Parse the data in streaming mode.
+    std::vector< std::vector< std::string > > parsedLines;
+    parser.parseBuffer( csvText.data( ), csvText.data( ) + csvText.size( ),
+                        FieldCollector( parsedLines ) );
+
+    // Check that the three lines are parsed as in line based parsing, which requires the data
+    // without empty lines.
+    std::string lineBasedCsvText( " 12 , 1, 2, 3\n24, 5, 6, 7\na, b c, d, e" );
+    ParsedDataVectorPtr result = parser.parse( lineBasedCsvText );
+    BOOST_CHECK_EQUAL( parsedLines.size( ), 3 );
+    BOOST_CHECK_EQUAL( parser.getFieldTypes( ).size( ), 4 );
+    for ( unsigned int i = 0; i < parsedLines.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( parsedLines[ i ].size( ), 4 );
+        for ( unsigned int j = 0; j < parsedLines[ i ].size( ); j++ )
+        {
+            BOOST_CHECK_EQUAL( parsedLines[ i ][ j ],
+                               result->at( i )->find( parser.getFieldTypes( )[ j ] )
+                               ->second->getRaw( ) );
+        }
+    }
+
+    // Check that a line with too few fields is not parsed.
+    std::string invalidText( "1, 2, 3" );
+    BOOST_CHECK_THROW( parser.parseBuffer( invalidText.data( ),
+                                           invalidText.data( ) + invalidText.size( ),
+                                           FieldCollector( parsedLines ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( testSeparatedParserStreamingFile )
+{
+    using namespace tudat::input_output;
+
+    // Create GTOC2 white space parser.
+    SeparatedParser testWhiteSpaceParser( " ",
+                                          8,
+                                          field_types::general::id,
+                                          field_types::state::semiMajorAxis,
+                                          field_types::state::eccentricity,
+                                          field_types::state::inclination,
+                                          field_types::state::longitudeOfAscendingNode,
+                                          field_types::state::argumentOfPeriapsis,
+                                          field_types::state::meanAnomaly,
+                                          field_types::time::epoch );
+
+    // Write test file (first lines in GTOC2 problem data file with additional whitespaces).
+    const std::string testFileName = getTudatRootPath( )
+            + "InputOutput/UnitTests/separatedParserStreamingTest.txt";
+    std::string testString(
+                "  2011542 3.9501468 0.2391642   6.87574   16.88982  48.9603 229.49648 54000\n"
+                "2001038 3.9619932 0.227483 9.22988 58.20488 307.19412 201.38868 54000\n" );
+    {
+        std::ofstream testFile( testFileName.c_str( ) );
+        testFile << testString;
+    }
+
+    // Parse the file in streaming mode, and the data in line based mode.
+    std::vector< std::vector< std::string > > parsedLines;
+    testWhiteSpaceParser.parseFile( testFileName, FieldCollector( parsedLines ) );
+    boost::filesystem::remove( testFileName );
+
+    ParsedDataVectorPtr result = testWhiteSpaceParser.parse(
+                testString.erase( testString.size( ) - 1 ) );
+
+    // Check that both lines are parsed as in line based parsing, and that numbers are converted
+    // as by the field values.
+    BOOST_CHECK_EQUAL( parsedLines.size( ), 2 );
+    for ( unsigned int i = 0; i < parsedLines.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( parsedLines[ i ].size( ), 8 );
+        for ( unsigned int j = 0; j < parsedLines[ i ].size( ); j++ )
+        {
+            FieldValuePtr fieldValue = result->at( i )->find(
+                        testWhiteSpaceParser.getFieldTypes( )[ j ] )->second;
+            BOOST_CHECK_EQUAL( parsedLines[ i ][ j ], fieldValue->getRaw( ) );
+
+            const FieldRange field( parsedLines[ i ][ j ].data( ),
+                                    parsedLines[ i ][ j ].data( ) + parsedLines[ i ][ j ].size( ) );
+            BOOST_CHECK_EQUAL( convertFieldToDouble( field ), fieldValue->get< double >( ) );
+        }
+    }
+
+    // Check that a non-existing file is not parsed.
+    BOOST_CHECK_THROW( testWhiteSpaceParser.parseFile( testFileName,
+                                                       FieldCollector( parsedLines ) ),
+                       std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( ) // test_suite_separated_parser
 
 BOOST_AUTO_TEST_SUITE_END( ) // testsuite_ephemeris
@@ -0,0 +1,207 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *      261016    agent             Wrote test archive to temporary directory, and removed it on
+ *                                  failure.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/twoLineElementArchive.h"
+#include "Tudat/InputOutput/twoLineElementsTextFileReader.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::input_output;
+
+BOOST_AUTO_TEST_SUITE( test_two_line_element_archive )
+
+//! Remover of a file when going out of scope.
+/*!
+ * Removes a file when going out of scope, such that test files are also removed when a test
+ * requirement fails or an exception is thrown.
+ */
+struct ScopedFileRemover
+{
+    //! Constructor, taking the path of the file to remove.
+    explicit ScopedFileRemover( const boost::filesystem::path& aFilePath )
+        : filePath( aFilePath )
+    { }
+
+    //! Destructor, removing the file if it exists.
+    ~ScopedFileRemover( )
+    {
+        boost::system::error_code errorCode;
+        boost::filesystem::remove( filePath, errorCode );
+    }
+
+    //! Path of the file to remove.
+    boost::filesystem::path filePath;
+};
+
+//! Test computation of Julian day of TLE epoch.
+BOOST_AUTO_TEST_CASE( testJulianDayOfTwoLineElementEpoch )
+{
+    // Check against Julian days of J2000 (January 1, 2000, 12h) and the Unix epoch.
+    BOOST_CHECK_EQUAL( computeJulianDayOfTwoLineElementEpoch( 2000, 1.5 ), 2451545.0 );
+    BOOST_CHECK_EQUAL( computeJulianDayOfTwoLineElementEpoch( 1970, 1.0 ), 2440587.5 );
+
+    // Check leap years and end of year.
+    BOOST_CHECK_EQUAL( computeJulianDayOfTwoLineElementEpoch( 2001, 1.0 )
+                       - computeJulianDayOfTwoLineElementEpoch( 2000, 1.0 ), 366.0 );
+    BOOST_CHECK_EQUAL( computeJulianDayOfTwoLineElementEpoch( 1901, 1.0 )
+                       - computeJulianDayOfTwoLineElementEpoch( 1900, 1.0 ), 365.0 );
+    BOOST_CHECK_EQUAL( computeJulianDayOfTwoLineElementEpoch( 2011, 366.0 ),
+                       computeJulianDayOfTwoLineElementEpoch( 2012, 1.0 ) );
+}
+
+//! Test writing and reading of TLE archive.
+BOOST_AUTO_TEST_CASE( testTwoLineElementArchive )
+{
+    // Read valid objects of test catalog.
+    TwoLineElementsTextFileReader reader;
+    reader.setLineNumberTypeForTwoLineElementInputData(
+                TwoLineElementsTextFileReader::threeLineType );
+    reader.setRelativeDirectoryPath( "InputOutput/UnitTests/" );
+    reader.setFileName( "testTwoLineElementsTextFile3Line.txt" );
+    reader.setCurrentYear( 2011 );
+    reader.readAndStoreTwoLineElementDataInParallel( );
+    std::vector< TwoLineElementData > twoLineElementData = reader.getTwoLineElementData( );
+    BOOST_REQUIRE_EQUAL( twoLineElementData.size( ), 3 );
+
+    // Add two later element sets of the last object before the original one, to check sorting.
+    TwoLineElementData laterElementSet = twoLineElementData[ 2 ];
+    laterElementSet.epochDay += 20.0;
+    laterElementSet.tleNumber += 2;
+    twoLineElementData.insert( twoLineElementData.begin( ), laterElementSet );
+    laterElementSet.epochDay -= 10.0;
+    laterElementSet.tleNumber -= 1;
+    twoLineElementData.insert( twoLineElementData.begin( ), laterElementSet );
+
+    // Write and open archive in the temporary directory, such that no files are left in the
+    // source tree.
+    const std::string archiveFileName
+            = ( boost::filesystem::temp_directory_path( )
+                / boost::filesystem::unique_path( "twoLineElementArchiveTest-%%%%-%%%%.bin" ) )
+            .string( );
+    const ScopedFileRemover archiveFileRemover( archiveFileName );
+    TwoLineElementArchive::writeArchive( archiveFileName, twoLineElementData );
+    {
+        const TwoLineElementArchive archive( archiveFileName );
+        BOOST_CHECK_EQUAL( archive.getNumberOfRecords( ), 5 );
+        BOOST_CHECK_THROW( archive.getRecord( 5 ), std::out_of_range );
+
+        // Check that records are sorted by object identification number and epoch.
+        for ( unsigned int i = 1; i < archive.getNumberOfRecords( ); i++ )
+        {
+            BOOST_CHECK( !compareTwoLineElementRecords( archive.getRecord( i ),
+                                                        archive.getRecord( i - 1 ) ) );
+        }
+
+        // Check that converted records are equal to the original TLE data.
+        const TwoLineElementData& originalData = twoLineElementData[ 2 ];
+        const TwoLineElementData convertedData
+                = convertToTwoLineElementData( archive.getRecord( 0 ) );
+        BOOST_CHECK_EQUAL( convertedData.objectNameString, "VANGUARD 1" );
+        BOOST_REQUIRE_EQUAL( convertedData.objectName.size( ), 2 );
+        BOOST_CHECK_EQUAL( convertedData.objectName[ 1 ], originalData.objectName[ 1 ] );
+        BOOST_CHECK_EQUAL( convertedData.objectIdentificationNumber,
+                           originalData.objectIdentificationNumber );
+        BOOST_CHECK_EQUAL( convertedData.launchPart, originalData.launchPart );
+        BOOST_CHECK_EQUAL( convertedData.launchYear, originalData.launchYear );
+        BOOST_CHECK_EQUAL( convertedData.fourDigitEpochYear, originalData.fourDigitEpochYear );
+        BOOST_CHECK_EQUAL( convertedData.epochDay, originalData.epochDay );
+        BOOST_CHECK_EQUAL( convertedData.bStar, originalData.bStar );
+        BOOST_CHECK_EQUAL( convertedData.meanAnomaly, originalData.meanAnomaly );
+        BOOST_CHECK_EQUAL( convertedData.totalRevolutionNumber,
+                           originalData.totalRevolutionNumber );
+        BOOST_CHECK_EQUAL( convertedData.apogee, originalData.apogee );
+        for ( int j = 0; j < 5; j++ )
+        {
+            BOOST_CHECK_EQUAL( convertedData.TLEKeplerianElements( j ),
+                               originalData.TLEKeplerianElements( j ) );
+        }
+
+        // Check range of records of object with three element sets.
+        const unsigned int objectIdentificationNumber
+                = twoLineElementData[ 0 ].objectIdentificationNumber;
+        const TwoLineElementArchive::TwoLineElementRecordRange recordsOfObject
+                = archive.getRecordsOfObject( objectIdentificationNumber );
+        BOOST_CHECK_EQUAL( recordsOfObject.second - recordsOfObject.first, 3 );
+        BOOST_CHECK_EQUAL( recordsOfObject.first->tleNumber, twoLineElementData[ 4 ].tleNumber );
+        BOOST_CHECK( archive.getRecordsOfObject( 12345 ).first
+                     == archive.getRecordsOfObject( 12345 ).second );
+
+        // Check latest element sets before epochs.
+        const double firstEpoch = recordsOfObject.first->epochInJulianDays;
+        BOOST_CHECK( archive.findLatestRecordBeforeEpoch(
+                         objectIdentificationNumber, firstEpoch - 1.0 ) == NULL );
+        BOOST_CHECK( archive.findLatestRecordBeforeEpoch(
+                         objectIdentificationNumber, firstEpoch ) == recordsOfObject.first );
+        BOOST_CHECK( archive.findLatestRecordBeforeEpoch(
+                         objectIdentificationNumber, firstEpoch + 15.0 )
+                     == recordsOfObject.first + 1 );
+        BOOST_CHECK( archive.findLatestRecordBeforeEpoch(
+                         objectIdentificationNumber, firstEpoch + 1000.0 )
+                     == recordsOfObject.first + 2 );
+        BOOST_CHECK_EQUAL( archive.findLatestRecordBeforeEpoch(
+                               objectIdentificationNumber, firstEpoch + 1000.0 )->tleNumber,
+                           twoLineElementData[ 1 ].tleNumber );
+        BOOST_CHECK( archive.findLatestRecordBeforeEpoch( 1, firstEpoch + 1000.0 ) == NULL );
+        BOOST_CHECK( archive.findLatestRecordBeforeEpoch( 99999, firstEpoch + 1000.0 ) == NULL );
+    }
+
+    boost::filesystem::remove( archiveFileName );
+
+    // Check that files that are not TLE archives are rejected.
+    BOOST_CHECK_THROW( TwoLineElementArchive archive( archiveFileName ), std::runtime_error );
+    BOOST_CHECK_THROW( TwoLineElementArchive archive(
+                           getTudatRootPath( )
+                           + "InputOutput/UnitTests/testTwoLineElementsTextFile3Line.txt" ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,138 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h>
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/convertMeanAnomalyToEccentricAnomaly.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/InputOutput/twoLineElementArchive.h"
+#include "Tudat/InputOutput/twoLineElementCatalogPropagation.h"
+#include "Tudat/InputOutput/twoLineElementsTextFileReader.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::input_output;
+
+BOOST_AUTO_TEST_SUITE( test_two_line_element_catalog_propagation )
+
+//! Test computation of Cartesian states of TLE catalog against propagation of individual objects.
+BOOST_AUTO_TEST_CASE( testTwoLineElementCatalogPropagation )
+{
+    using basic_astrodynamics::argumentOfPeriapsisIndex;
+    using basic_astrodynamics::eccentricityIndex;
+    using basic_astrodynamics::inclinationIndex;
+    using basic_astrodynamics::longitudeOfAscendingNodeIndex;
+    using basic_astrodynamics::semiMajorAxisIndex;
+    using basic_astrodynamics::orbital_element_conversions::ConvertMeanAnomalyToEccentricAnomaly;
+    using basic_astrodynamics::orbital_element_conversions::convertEccentricAnomalyToTrueAnomaly;
+    using basic_astrodynamics::orbital_element_conversions::convertKeplerianToCartesianElements;
+    using basic_astrodynamics::orbital_element_conversions::propagateKeplerOrbit;
+    using unit_conversions::convertDegreesToRadians;
+
+    // Read valid objects of test catalog.
+    TwoLineElementsTextFileReader reader;
+    reader.setLineNumberTypeForTwoLineElementInputData(
+                TwoLineElementsTextFileReader::threeLineType );
+    reader.setRelativeDirectoryPath( "InputOutput/UnitTests/" );
+    reader.setFileName( "testTwoLineElementsTextFile3Line.txt" );
+    reader.setCurrentYear( 2011 );
+    reader.readAndStoreTwoLineElementDataInParallel( );
+    const std::vector< TwoLineElementData > twoLineElementData
+            = reader.getTwoLineElementData( );
+    BOOST_REQUIRE_EQUAL( twoLineElementData.size( ), 3 );
+
+    // Compute states of catalog half a day after the epoch of the first object.
+    const double epochInJulianDays = computeJulianDayOfTwoLineElementEpoch(
+                twoLineElementData[ 0 ].fourDigitEpochYear,
+                twoLineElementData[ 0 ].epochDay ) + 0.5;
+    const Eigen::MatrixXd cartesianStates
+            = computeCartesianStatesOfTwoLineElementCatalog( twoLineElementData,
+                                                             epochInJulianDays );
+    BOOST_REQUIRE_EQUAL( cartesianStates.rows( ), 3 );
+
+    // Check states against propagation of individual objects.
+    const double earthWithWorldGeodeticSystem72GravitationalParameter = 398600.8e9;
+    for ( unsigned int i = 0; i < twoLineElementData.size( ); i++ )
+    {
+        // Set initial Keplerian elements, in radians, with true anomaly.
+        const basic_mathematics::Vector6d& elements = twoLineElementData[ i ].TLEKeplerianElements;
+        const double eccentricity = elements( eccentricityIndex );
+        ConvertMeanAnomalyToEccentricAnomaly convertMeanAnomalyToEccentricAnomaly(
+                    eccentricity, convertDegreesToRadians( twoLineElementData[ i ].meanAnomaly ) );
+
+        basic_mathematics::Vector6d initialKeplerianElements;
+        initialKeplerianElements << elements( semiMajorAxisIndex ), eccentricity,
+                convertDegreesToRadians( elements( inclinationIndex ) ),
+                convertDegreesToRadians( elements( argumentOfPeriapsisIndex ) ),
+                convertDegreesToRadians( elements( longitudeOfAscendingNodeIndex ) ),
+                convertEccentricAnomalyToTrueAnomaly(
+                    convertMeanAnomalyToEccentricAnomaly.convert( ), eccentricity );
+
+        // Propagate object.
+        const double propagationTime = unit_conversions::convertJulianDaysToSeconds(
+                    epochInJulianDays - computeJulianDayOfTwoLineElementEpoch(
+                        twoLineElementData[ i ].fourDigitEpochYear,
+                        twoLineElementData[ i ].epochDay ) );
+        const basic_mathematics::Vector6d expectedCartesianState
+                = convertKeplerianToCartesianElements(
+                    propagateKeplerOrbit( initialKeplerianElements, propagationTime,
+                                          earthWithWorldGeodeticSystem72GravitationalParameter ),
+                    earthWithWorldGeodeticSystem72GravitationalParameter );
+
+        BOOST_CHECK_SMALL( ( cartesianStates.block( i, 0, 1, 3 ).transpose( )
+                             - expectedCartesianState.segment( 0, 3 ) ).norm( )
+                           / expectedCartesianState.segment( 0, 3 ).norm( ), 1.0e-9 );
+        BOOST_CHECK_SMALL( ( cartesianStates.block( i, 3, 1, 3 ).transpose( )
+                             - expectedCartesianState.segment( 3, 3 ) ).norm( )
+                           / expectedCartesianState.segment( 3, 3 ).norm( ), 1.0e-9 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -31,6 +31,7 @@
  *      110826    J. Leloux         Updated test for 2-line and 3-line cases.
  *      111027    K. Kumar          Removed dynamic memory allocation.
  *      120627    A. Ronse          Boostified unit test.
+ *      261016    agent             Added test of parallel reading of TLE catalogs.
  *
  *    References
  *      Leloux, J. Filtering Techniques for Orbital Debris Conjunction Analysis - applied to SSN
@@ -58,6 +59,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -69,6 +71,94 @@ namespace tudat
 namespace unit_tests
 {
 
+//! Read TLE catalog serially and in parallel, and compare results.
+/*!
+ * Reads a TLE catalog serially, followed by an integrity check, and in parallel with the given
+ * number of threads, and checks that the parallel reader returns the same TLE data and errors.
+ * \param fileName File name of TLE catalog in the InputOutput/UnitTests/ directory.
+ * \param lineNumberType Line number type of TLE catalog: 2-line or 3-line.
+ * \param numberOfThreads Number of threads of parallel reader.
+ */
+void compareSerialAndParallelTwoLineElementsTextFileReaders(
+        const std::string& fileName,
+        const input_output::TwoLineElementsTextFileReader::LineNumberTypesForTwoLineElementInputData
+        lineNumberType, const unsigned int numberOfThreads )
+{
+    using input_output::TwoLineElementData;
+    using input_output::TwoLineElementsTextFileReader;
+
+    // Read catalog serially.
+    TwoLineElementsTextFileReader serialReader;
+    serialReader.setLineNumberTypeForTwoLineElementInputData( lineNumberType );
+    serialReader.setRelativeDirectoryPath( "InputOutput/UnitTests/" );
+    serialReader.setFileName( fileName );
+    serialReader.openFile( );
+    serialReader.readAndStoreData( );
+    serialReader.closeFile( );
+    serialReader.setCurrentYear( 2011 );
+    serialReader.storeTwoLineElementData( );
+    const std::multimap< int, std::string > serialErrors
+            = serialReader.checkTwoLineElementsFileIntegrity( );
+    const std::vector< TwoLineElementData > serialData = serialReader.getTwoLineElementData( );
+
+    // Read catalog in parallel.
+    TwoLineElementsTextFileReader parallelReader;
+    parallelReader.setLineNumberTypeForTwoLineElementInputData( lineNumberType );
+    parallelReader.setRelativeDirectoryPath( "InputOutput/UnitTests/" );
+    parallelReader.setFileName( fileName );
+    parallelReader.setCurrentYear( 2011 );
+    const std::multimap< int, std::string > parallelErrors
+            = parallelReader.readAndStoreTwoLineElementDataInParallel( numberOfThreads );
+    const std::vector< TwoLineElementData > parallelData
+            = parallelReader.getTwoLineElementData( );
+
+    // Check that the same objects are found to be corrupted, for the same reasons.
+    BOOST_CHECK_EQUAL( parallelReader.getNumberOfObjects( ), serialReader.getNumberOfObjects( ) );
+    BOOST_CHECK( parallelErrors == serialErrors );
+
+    // Check that the TLE data of the remaining objects is identical.
+    BOOST_REQUIRE_EQUAL( parallelData.size( ), serialData.size( ) );
+    for ( unsigned int i = 0; i < serialData.size( ); i++ )
+    {
+        BOOST_CHECK( parallelData[ i ].twoLineElementStrings
+                     == serialData[ i ].twoLineElementStrings );
+        BOOST_CHECK( parallelData[ i ].objectName == serialData[ i ].objectName );
+        BOOST_CHECK_EQUAL( parallelData[ i ].objectNameString, serialData[ i ].objectNameString );
+        BOOST_CHECK_EQUAL( parallelData[ i ].objectIdentificationNumber,
+                           serialData[ i ].objectIdentificationNumber );
+        BOOST_CHECK_EQUAL( parallelData[ i ].tleClassification,
+                           serialData[ i ].tleClassification );
+        BOOST_CHECK_EQUAL( parallelData[ i ].fourDigitlaunchYear,
+                           serialData[ i ].fourDigitlaunchYear );
+        BOOST_CHECK_EQUAL( parallelData[ i ].launchNumber, serialData[ i ].launchNumber );
+        BOOST_CHECK_EQUAL( parallelData[ i ].launchPart, serialData[ i ].launchPart );
+        BOOST_CHECK_EQUAL( parallelData[ i ].fourDigitEpochYear,
+                           serialData[ i ].fourDigitEpochYear );
+        BOOST_CHECK_EQUAL( parallelData[ i ].epochDay, serialData[ i ].epochDay );
+        BOOST_CHECK_EQUAL( parallelData[ i ].firstDerivativeOfMeanMotionDividedByTwo,
+                           serialData[ i ].firstDerivativeOfMeanMotionDividedByTwo );
+        BOOST_CHECK_EQUAL( parallelData[ i ].secondDerivativeOfMeanMotionDividedBySix,
+                           serialData[ i ].secondDerivativeOfMeanMotionDividedBySix );
+        BOOST_CHECK_EQUAL( parallelData[ i ].bStar, serialData[ i ].bStar );
+        BOOST_CHECK_EQUAL( parallelData[ i ].tleNumber, serialData[ i ].tleNumber );
+        BOOST_CHECK_EQUAL( parallelData[ i ].meanAnomaly, serialData[ i ].meanAnomaly );
+        BOOST_CHECK_EQUAL( parallelData[ i ].meanMotionInRevolutionsPerDay,
+                           serialData[ i ].meanMotionInRevolutionsPerDay );
+        BOOST_CHECK_EQUAL( parallelData[ i ].totalRevolutionNumber,
+                           serialData[ i ].totalRevolutionNumber );
+        BOOST_CHECK_EQUAL( parallelData[ i ].perigee, serialData[ i ].perigee );
+        BOOST_CHECK_EQUAL( parallelData[ i ].apogee, serialData[ i ].apogee );
+
+        // The true anomaly is not set by the readers, so that only the first five elements are
+        // compared.
+        for ( int j = 0; j < 5; j++ )
+        {
+            BOOST_CHECK_EQUAL( parallelData[ i ].TLEKeplerianElements( j ),
+                               serialData[ i ].TLEKeplerianElements( j ) );
+        }
+    }
+}
+
 //! Test implementation of TLE text file reader class.
 BOOST_AUTO_TEST_SUITE( test_Two_Line_Elements_Text_File_Reader )
 
@@ -208,6 +298,32 @@ BOOST_AUTO_TEST_CASE( testTwoLineElementsTextFileReaderForThreeLine )
     BOOST_CHECK_EQUAL( twoLineElementDataAfterIntegrityCheck.at( 2 ).revolutionNumber, 57038 );
 }
 
+//! Test parallel reading of TLE catalogs.
+BOOST_AUTO_TEST_CASE( testTwoLineElementsTextFileReaderInParallel )
+{
+    using tudat::input_output::TwoLineElementsTextFileReader;
+
+    // Compare serial and parallel readers, for a single thread and more threads than objects.
+    for ( unsigned int numberOfThreads = 1; numberOfThreads <= 16; numberOfThreads *= 4 )
+    {
+        compareSerialAndParallelTwoLineElementsTextFileReaders(
+                    "testTwoLineElementsTextFile2Line.txt",
+                    TwoLineElementsTextFileReader::twoLineType, numberOfThreads );
+        compareSerialAndParallelTwoLineElementsTextFileReaders(
+                    "testTwoLineElementsTextFile3Line.txt",
+                    TwoLineElementsTextFileReader::threeLineType, numberOfThreads );
+    }
+
+    // Check that a catalog with an incomplete object is rejected.
+    TwoLineElementsTextFileReader threeLineReaderForTwoLineFile;
+    threeLineReaderForTwoLineFile.setLineNumberTypeForTwoLineElementInputData(
+                TwoLineElementsTextFileReader::threeLineType );
+    threeLineReaderForTwoLineFile.setRelativeDirectoryPath( "InputOutput/UnitTests/" );
+    threeLineReaderForTwoLineFile.setFileName( "testTwoLineElementsTextFile2Line.txt" );
+    BOOST_CHECK_THROW( threeLineReaderForTwoLineFile.readAndStoreTwoLineElementDataInParallel( ),
+                       std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 }   // namespace unit_tests
@@ -0,0 +1,126 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/InputOutput/fieldRange.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Copy field to null-terminated buffer.
+std::size_t copyFieldToBuffer( const FieldRange& field, char* buffer )
+{
+    const FieldRange trimmedField = trimField( field );
+    const std::size_t fieldSize = trimmedField.size( );
+    if ( fieldSize == 0 || fieldSize > 63 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Field '" + convertFieldToString( field )
+                                            + "' cannot be converted to a number." ) ) );
+    }
+
+    std::memcpy( buffer, trimmedField.begin( ), fieldSize );
+    buffer[ fieldSize ] = '\0';
+    return fieldSize;
+}
+
+//! Trim whitespace off field.
+FieldRange trimField( const FieldRange& field )
+{
+    const char* begin = field.begin( );
+    const char* end = field.end( );
+
+    while ( begin != end && isWhitespaceCharacter( *begin ) )
+    {
+        ++begin;
+    }
+
+    while ( end != begin && isWhitespaceCharacter( *( end - 1 ) ) )
+    {
+        --end;
+    }
+
+    return FieldRange( begin, end );
+}
+
+//! Convert field to double.
+double convertFieldToDouble( const FieldRange& field )
+{
+    char buffer[ 64 ];
+    const std::size_t fieldSize = copyFieldToBuffer( field, buffer );
+
+    char* endOfNumber;
+    const double value = std::strtod( buffer, &endOfNumber );
+    if ( endOfNumber != buffer + fieldSize )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Field '" + convertFieldToString( field )
+                                            + "' is not a valid floating-point number." ) ) );
+    }
+
+    return value;
+}
+
+//! Convert field to integer.
+long convertFieldToInteger( const FieldRange& field )
+{
+    char buffer[ 64 ];
+    const std::size_t fieldSize = copyFieldToBuffer( field, buffer );
+
+    char* endOfNumber;
+    errno = 0;
+    const long value = std::strtol( buffer, &endOfNumber, 10 );
+    if ( endOfNumber != buffer + fieldSize || errno == ERANGE )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Field '" + convertFieldToString( field )
+                                            + "' is not a valid integer." ) ) );
+    }
+
+    return value;
+}
+
+} // namespace input_output
+} // namespace tudat
@@ -0,0 +1,146 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#ifndef TUDAT_FIELD_RANGE_H
+#define TUDAT_FIELD_RANGE_H
+
+#include <cstddef>
+#include <string>
+
+#include <boost/range/iterator_range.hpp>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Typedef for range of characters of a field in a text buffer.
+/*!
+ * Typedef for range of characters of a field in a text buffer, which refers to the characters in
+ * the buffer instead of copying them. Used by the streaming mode of the text parsers, see
+ * TextParser::parseBuffer( ).
+ */
+typedef boost::iterator_range< const char* > FieldRange;
+
+//! Check whether character is whitespace.
+/*!
+ * Checks whether a character is whitespace, i.e., a space, tab, carriage return, newline,
+ * vertical tab or form feed.
+ * \param character Character to check.
+ * \return True if character is whitespace, false otherwise.
+ */
+inline bool isWhitespaceCharacter( const char character )
+{
+    return character == ' ' || character == '\t' || character == '\r' || character == '\n'
+            || character == '\v' || character == '\f';
+}
+
+//! Trim whitespace off field.
+/*!
+ * Returns the range of a field without leading and trailing whitespace (spaces, tabs, carriage
+ * returns, newlines, vertical tabs and form feeds).
+ * \param field Range of characters of field.
+ * \return Range of characters of field without leading and trailing whitespace.
+ */
+FieldRange trimField( const FieldRange& field );
+
+//! Get field at fixed columns of line.
+/*!
+ * Returns the range of characters of a field at fixed columns of a line, e.g., of a
+ * fixed-width record. The field is truncated at the end of the line.
+ * \param line Range of characters of line.
+ * \param firstColumn Index of first column of field (zero-based).
+ * \param numberOfColumns Number of columns of field.
+ * \return Range of characters of field.
+ */
+inline FieldRange getFieldAtColumns( const FieldRange& line, const std::size_t firstColumn,
+                                     const std::size_t numberOfColumns )
+{
+    const std::size_t lineSize = line.size( );
+    const std::size_t fieldBegin = firstColumn < lineSize ? firstColumn : lineSize;
+    const std::size_t fieldEnd = firstColumn + numberOfColumns < lineSize
+            ? firstColumn + numberOfColumns : lineSize;
+    return FieldRange( line.begin( ) + fieldBegin, line.begin( ) + fieldEnd );
+}
+
+//! Copy field to null-terminated buffer.
+/*!
+ * Copies a field, without leading and trailing whitespace, to a null-terminated buffer, as
+ * required by the conversion functions of the C standard library.
+ * \param field Range of characters of field.
+ * \param buffer Buffer of (at least) 64 characters to which field is copied (returned by
+ *          reference).
+ * \return Number of characters of field, without whitespace.
+ * \throws std::runtime_error If the field is empty or longer than 63 characters.
+ */
+std::size_t copyFieldToBuffer( const FieldRange& field, char* buffer );
+
+//! Convert field to double.
+/*!
+ * Converts a field to a double, without allocating memory. Leading and trailing whitespace is
+ * ignored. The conversion is performed by std::strtod, and therefore accepts the same formats
+ * (e.g., 1.5, -2.5e3, inf).
+ * \param field Range of characters of field.
+ * \return Value of field.
+ * \throws std::runtime_error If the field is empty, is longer than 63 characters, or is not
+ *          a valid number.
+ */
+double convertFieldToDouble( const FieldRange& field );
+
+//! Convert field to integer.
+/*!
+ * Converts a field to an integer, without allocating memory. Leading and trailing whitespace is
+ * ignored.
+ * \param field Range of characters of field.
+ * \return Value of field.
+ * \throws std::runtime_error If the field is empty, is longer than 63 characters, or is not
+ *          a valid integer.
+ */
+long convertFieldToInteger( const FieldRange& field );
+
+//! Convert field to string.
+/*!
+ * Copies the characters of a field to a string.
+ * \param field Range of characters of field.
+ * \return Characters of field.
+ */
+inline std::string convertFieldToString( const FieldRange& field )
+{
+    return std::string( field.begin( ), field.end( ) );
+}
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_FIELD_RANGE_H
@@ -26,6 +26,7 @@
  *      YYMMDD    Author            Comment
  *      111209    D.J. Gondelach    File created.
  *      120718    A. Ronse          Code check. Implemented optional trim.
+ *      261016    agent             Added tokenization of lines for streaming mode.
  *
  *    References
  *
@@ -35,6 +36,8 @@
 
 #include "Tudat/InputOutput/fixedWidthParser.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 namespace tudat
@@ -162,5 +165,28 @@ void FixedWidthParser::parseLine( std::string& line )
     }
 }
 
+//! Divides one line of text into fields, for parsing in streaming mode.
+void FixedWidthParser::tokenizeLine( const char* begin, const char* end,
+                                     std::vector< FieldRange >& fields )
+{
+    // An empty line has no fields.
+    if ( begin == end )
+    {
+        return;
+    }
+
+    const char* fieldBegin = begin;
+    for ( unsigned int currentFieldNumber = 0; currentFieldNumber < numberOfFields_;
+          currentFieldNumber++ )
+    {
+        // Determine end of field, truncated at the end of the line.
+        const char* fieldEnd = fieldBegin + std::min< std::ptrdiff_t >(
+                    sizeList[ currentFieldNumber ], end - fieldBegin );
+        fields.push_back( doTrim ? trimField( FieldRange( fieldBegin, fieldEnd ) )
+                                 : FieldRange( fieldBegin, fieldEnd ) );
+        fieldBegin = fieldEnd;
+    }
+}
+
 } // namespace input_output
 } // namespace tudat
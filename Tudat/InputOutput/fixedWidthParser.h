@@ -28,6 +28,7 @@
  *      120718    A. Ronse          Code check. Implemented optional trim.
  *      130121    K. Kumar          Added shared-ptr typedef.
  *      131221    K. Kumar          Fixed Doxygen comments.
+ *      261016    agent             Added tokenization of lines for streaming mode.
  *
  *    References
  *
@@ -71,6 +72,9 @@ public:
     //! Get trim setting: Trim whitespace off fields (default=true).
     bool getTrim( ) { return doTrim; }
 
+    //! Get field types, in the order in which the fields are parsed.
+    const std::vector< FieldType >& getFieldTypes( ) const { return typeList; }
+
     //! Set unit transformation map.
     void setUnitTransformationMap (
             std::map< FieldType, boost::shared_ptr< FieldTransform > > unitTransformationMap )
@@ -88,6 +92,16 @@ protected:
      */
     void parseLine( std::string& line );
 
+    //! Divides one line of text into fields, for parsing in streaming mode.
+    /*!
+     * Divides one line of text into fields using specified field widths, as parseLine( ).
+     * Fields extending beyond the end of the line are truncated. An empty line has no fields.
+     * \param begin Pointer to first character of line.
+     * \param end Pointer past last character of line.
+     * \param fields Ranges of characters of fields (returned by reference).
+     */
+    void tokenizeLine( const char* begin, const char* end, std::vector< FieldRange >& fields );
+
 private:
 
     //! Number of fields that is parsed.
@@ -0,0 +1,383 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+
+#include "Tudat/InputOutput/parsedDataTable.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Constructor, creating an empty table.
+ParsedDataTable::ParsedDataTable( const std::vector< FieldType >& fieldTypes,
+                                  const std::vector< ColumnType >& columnTypes )
+    : numberOfRows_( 0 )
+{
+    initializeColumns( fieldTypes, columnTypes );
+}
+
+//! Constructor, converting a parsed data vector.
+ParsedDataTable::ParsedDataTable(
+        const parsed_data_vector_utilities::ParsedDataVectorPtr parsedDataVector,
+        const std::vector< FieldType >& fieldTypes,
+        const std::vector< ColumnType >& columnTypes )
+    : numberOfRows_( 0 )
+{
+    using namespace parsed_data_vector_utilities;
+
+    initializeColumns( fieldTypes, columnTypes );
+    reserve( parsedDataVector->size( ) );
+
+    std::vector< FieldRange > fields( fieldTypes.size( ) );
+    for ( ParsedDataVector::const_iterator line = parsedDataVector->begin( );
+          line != parsedDataVector->end( ); line++ )
+    {
+        // Retrieve transformed values of fields, skipping lines that do not contain all fields.
+        bool isLineComplete = true;
+        for ( unsigned int i = 0; i < fieldTypes.size( ); i++ )
+        {
+            ParsedDataLineMap::const_iterator entry = ( *line )->find( fieldTypes[ i ] );
+            if ( entry == ( *line )->end( ) )
+            {
+                isLineComplete = false;
+                break;
+            }
+
+            const std::string& value = entry->second->getTransformed( );
+            fields[ i ] = FieldRange( value.data( ), value.data( ) + value.size( ) );
+        }
+
+        if ( isLineComplete )
+        {
+            appendRow( fields );
+        }
+    }
+}
+//! Append row.
+void ParsedDataTable::appendRow( const std::vector< FieldRange >& fields )
+{
+    if ( fields.size( ) != columns_.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Number of fields of row differs from number of "
+                                            "columns of parsed data table." ) ) );
+    }
+
+    // Convert all numeric fields before modifying the table, such that the table is unchanged
+    // if a field cannot be converted.
+    for ( unsigned int i = 0; i < columns_.size( ); i++ )
+    {
+        if ( columns_[ i ].columnType == numeric_column )
+        {
+            rowValues_[ i ] = convertFieldToDouble( fields[ i ] );
+        }
+    }
+
+    for ( unsigned int i = 0; i < columns_.size( ); i++ )
+    {
+        if ( columns_[ i ].columnType == numeric_column )
+        {
+            columns_[ i ].numericValues.push_back( rowValues_[ i ] );
+        }
+        else
+        {
+            appendTextField( columns_[ i ], fields[ i ] );
+        }
+    }
+
+    numberOfRows_++;
+}
+
+//! Get row appender.
+TextParser::LineVisitor ParsedDataTable::getRowAppender( )
+{
+    return boost::bind( &ParsedDataTable::appendRow, this, _1 );
+}
+
+//! Reserve memory for rows.
+void ParsedDataTable::reserve( const std::size_t numberOfRows )
+{
+    for ( unsigned int i = 0; i < columns_.size( ); i++ )
+    {
+        if ( columns_[ i ].columnType == numeric_column )
+        {
+            columns_[ i ].numericValues.reserve( numberOfRows );
+        }
+        else
+        {
+            columns_[ i ].fieldEnds.reserve( numberOfRows + 1 );
+        }
+    }
+}
+
+//! Get field types of columns.
+std::vector< FieldType > ParsedDataTable::getFieldTypes( ) const
+{
+    std::vector< FieldType > fieldTypes( columns_.size( ) );
+    for ( unsigned int i = 0; i < columns_.size( ); i++ )
+    {
+        fieldTypes[ i ] = columns_[ i ].fieldType;
+    }
+
+    return fieldTypes;
+}
+
+//! Get type of column.
+ParsedDataTable::ColumnType ParsedDataTable::getColumnType( const FieldType fieldType ) const
+{
+    std::map< FieldType, unsigned int >::const_iterator columnIndex
+            = columnIndices_.find( fieldType );
+    if ( columnIndex == columnIndices_.end( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Parsed data table has no column of field type." ) ) );
+    }
+
+    return columns_[ columnIndex->second ].columnType;
+}
+
+//! Get numeric column.
+const std::vector< double >& ParsedDataTable::getNumericColumn( const FieldType fieldType ) const
+{
+    return getColumn( fieldType, numeric_column ).numericValues;
+}
+
+//! Get text field.
+FieldRange ParsedDataTable::getTextField( const FieldType fieldType,
+                                          const std::size_t row ) const
+{
+    const Column& column = getColumn( fieldType, text_column );
+    const char* characters = column.characters.empty( ) ? 0 : &column.characters[ 0 ];
+    return FieldRange( characters + column.fieldEnds.at( row ),
+                       characters + column.fieldEnds.at( row + 1 ) );
+}
+
+//! Find rows with value of numeric column in range.
+std::vector< std::size_t > ParsedDataTable::findRowsInRange( const FieldType fieldType,
+                                                             const double lowerBound,
+                                                             const double upperBound ) const
+{
+    const std::vector< double >& values = getNumericColumn( fieldType );
+
+    // Determine whether each row is in range first, which can be vectorized, and collect the
+    // indices of the rows afterwards.
+    std::vector< unsigned char > isRowInRange( values.size( ) );
+    for ( std::size_t i = 0; i < values.size( ); i++ )
+    {
+        isRowInRange[ i ] = ( values[ i ] >= lowerBound ) & ( values[ i ] <= upperBound );
+    }
+
+    std::vector< std::size_t > rows;
+    for ( std::size_t i = 0; i < values.size( ); i++ )
+    {
+        if ( isRowInRange[ i ] )
+        {
+            rows.push_back( i );
+        }
+    }
+
+    return rows;
+}
+
+//! Find rows with value of text column matching regular expression.
+std::vector< std::size_t > ParsedDataTable::findRowsMatching(
+        const FieldType fieldType, const boost::regex& regularExpression ) const
+{
+    // Check that column exists.
+    getColumn( fieldType, text_column );
+
+    std::vector< std::size_t > rows;
+    for ( std::size_t i = 0; i < numberOfRows_; i++ )
+    {
+        const FieldRange field = getTextField( fieldType, i );
+        if ( boost::regex_search( field.begin( ), field.end( ), regularExpression ) )
+        {
+            rows.push_back( i );
+        }
+    }
+
+    return rows;
+}
+
+//! Select rows.
+ParsedDataTable ParsedDataTable::selectRows( const std::vector< std::size_t >& rows ) const
+{
+    std::vector< ColumnType > columnTypes( columns_.size( ) );
+    for ( unsigned int i = 0; i < columns_.size( ); i++ )
+    {
+        columnTypes[ i ] = columns_[ i ].columnType;
+    }
+
+    ParsedDataTable selectedTable( getFieldTypes( ), columnTypes );
+    selectedTable.reserve( rows.size( ) );
+    for ( std::size_t i = 0; i < rows.size( ); i++ )
+    {
+        if ( rows[ i ] >= numberOfRows_ )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Row index of parsed data table out of "
+                                                "range." ) ) );
+        }
+    }
+
+    // Copy rows column by column.
+    for ( unsigned int i = 0; i < columns_.size( ); i++ )
+    {
+        if ( columns_[ i ].columnType == numeric_column )
+        {
+            for ( std::size_t j = 0; j < rows.size( ); j++ )
+            {
+                selectedTable.columns_[ i ].numericValues.push_back(
+                            columns_[ i ].numericValues[ rows[ j ] ] );
+            }
+        }
+        else
+        {
+            const char* characters = columns_[ i ].characters.empty( )
+                    ? 0 : &columns_[ i ].characters[ 0 ];
+            for ( std::size_t j = 0; j < rows.size( ); j++ )
+            {
+                appendTextField( selectedTable.columns_[ i ],
+                                 FieldRange( characters + columns_[ i ].fieldEnds[ rows[ j ] ],
+                                             characters
+                                             + columns_[ i ].fieldEnds[ rows[ j ] + 1 ] ) );
+            }
+        }
+    }
+
+    selectedTable.numberOfRows_ = rows.size( );
+    return selectedTable;
+}
+
+//! Select columns.
+ParsedDataTable ParsedDataTable::selectColumns( const std::vector< FieldType >& fieldTypes ) const
+{
+    std::vector< ColumnType > columnTypes( fieldTypes.size( ) );
+    for ( unsigned int i = 0; i < fieldTypes.size( ); i++ )
+    {
+        columnTypes[ i ] = getColumnType( fieldTypes[ i ] );
+    }
+
+    ParsedDataTable selectedTable( fieldTypes, columnTypes );
+    for ( unsigned int i = 0; i < fieldTypes.size( ); i++ )
+    {
+        selectedTable.columns_[ i ] = columns_[ columnIndices_.find( fieldTypes[ i ] )->second ];
+    }
+
+    selectedTable.numberOfRows_ = numberOfRows_;
+    return selectedTable;
+}
+
+//! Transform numeric column linearly.
+void ParsedDataTable::transformNumericColumn( const FieldType fieldType, const double slope,
+                                              const double intercept )
+{
+    // Check that column exists.
+    getColumn( fieldType, numeric_column );
+
+    std::vector< double >& values
+            = columns_[ columnIndices_.find( fieldType )->second ].numericValues;
+    for ( std::size_t i = 0; i < values.size( ); i++ )
+    {
+        values[ i ] = slope * values[ i ] + intercept;
+    }
+}
+
+//! Initialize columns.
+void ParsedDataTable::initializeColumns( const std::vector< FieldType >& fieldTypes,
+                                         const std::vector< ColumnType >& columnTypes )
+{
+    if ( fieldTypes.size( ) != columnTypes.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Numbers of field types and column types of parsed "
+                                            "data table differ." ) ) );
+    }
+
+    columns_.resize( fieldTypes.size( ) );
+    for ( unsigned int i = 0; i < fieldTypes.size( ); i++ )
+    {
+        if ( !columnIndices_.insert( std::make_pair( fieldTypes[ i ], i ) ).second )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Field type given more than once for parsed data "
+                                                "table." ) ) );
+        }
+
+        columns_[ i ].fieldType = fieldTypes[ i ];
+        columns_[ i ].columnType = columnTypes[ i ];
+        if ( columnTypes[ i ] == text_column )
+        {
+            columns_[ i ].fieldEnds.push_back( 0 );
+        }
+    }
+
+    rowValues_.resize( columns_.size( ) );
+}
+
+//! Get column.
+const ParsedDataTable::Column& ParsedDataTable::getColumn( const FieldType fieldType,
+                                                           const ColumnType columnType ) const
+{
+    if ( getColumnType( fieldType ) != columnType )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( columnType == numeric_column
+                                            ? "Column of parsed data table is not numeric."
+                                            : "Column of parsed data table is not text." ) ) );
+    }
+
+    return columns_[ columnIndices_.find( fieldType )->second ];
+}
+
+//! Append text field to column.
+void ParsedDataTable::appendTextField( Column& column, const FieldRange& field )
+{
+    column.characters.insert( column.characters.end( ), field.begin( ), field.end( ) );
+    column.fieldEnds.push_back( column.characters.size( ) );
+}
+
+} // namespace input_output
+} // namespace tudat
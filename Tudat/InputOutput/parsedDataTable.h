@@ -0,0 +1,324 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#ifndef TUDAT_PARSED_DATA_TABLE_H
+#define TUDAT_PARSED_DATA_TABLE_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/regex.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/InputOutput/fieldRange.h"
+#include "Tudat/InputOutput/fieldType.h"
+#include "Tudat/InputOutput/parsedDataVectorUtilities.h"
+#include "Tudat/InputOutput/textParser.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Columnar table of parsed data.
+/*!
+ * Table of parsed data, storing one contiguous column per FieldType, as an alternative to the
+ * ParsedDataVector of per-line maps. Numeric columns are stored as vectors of doubles, and text
+ * columns as a single buffer of characters with the offsets of the fields. As a result, the
+ * memory use per field is eight bytes for numeric fields, and the length of the field plus eight
+ * bytes for text fields. Rows can be appended directly by the streaming mode of the text parsers
+ * (see getRowAppender( )), and the table supports bulk filter, select and convert operations.
+ *
+ * Example usage:
+ *   SeparatedParser parser( " ", 2, field_types::general::name, field_types::time::epoch );
+ *   ParsedDataTable table( parser.getFieldTypes( ),
+ *                          boost::assign::list_of( ParsedDataTable::text_column )
+ *                          ( ParsedDataTable::numeric_column ) );
+ *   parser.parseFile( fileName, table.getRowAppender( ) );
+ *   const std::vector< double >& epochs = table.getNumericColumn( field_types::time::epoch );
+ */
+class ParsedDataTable
+{
+public:
+
+    //! Types of columns.
+    enum ColumnType
+    {
+        numeric_column,
+        text_column
+    };
+
+    //! Constructor, creating an empty table.
+    /*!
+     * Constructor, creating an empty table with the given columns.
+     * \param fieldTypes Field types of the columns, in the order of the fields of the rows.
+     * \param columnTypes Types of the columns.
+     * \throws std::runtime_error If the numbers of field types and column types differ, or if a
+     *          field type is given more than once.
+     */
+    ParsedDataTable( const std::vector< FieldType >& fieldTypes,
+                     const std::vector< ColumnType >& columnTypes );
+
+    //! Constructor, converting a parsed data vector.
+    /*!
+     * Constructor, creating a table from the (transformed) values of the given fields of a parsed
+     * data vector. As filterMapKey( ), lines that do not contain all fields are skipped.
+     * \param parsedDataVector Parsed data vector to convert.
+     * \param fieldTypes Field types of the columns.
+     * \param columnTypes Types of the columns.
+     * \throws std::runtime_error If the numbers of field types and column types differ, if a
+     *          field type is given more than once, or if a value of a numeric column is not a
+     *          valid number.
+     */
+    ParsedDataTable( const parsed_data_vector_utilities::ParsedDataVectorPtr parsedDataVector,
+                     const std::vector< FieldType >& fieldTypes,
+                     const std::vector< ColumnType >& columnTypes );
+
+    //! Append row.
+    /*!
+     * Appends a row to the table, converting the fields of numeric columns to doubles.
+     * \param fields Ranges of characters of the fields of the row, in the order of the columns.
+     * \throws std::runtime_error If the number of fields differs from the number of columns, or
+     *          if a field of a numeric column is not a valid number. In the latter case, the
+     *          table is left unchanged.
+     */
+    void appendRow( const std::vector< FieldRange >& fields );
+
+    //! Get row appender.
+    /*!
+     * Returns a line visitor that appends each parsed line as a row to this table, for use with
+     * the streaming mode of the text parsers (see TextParser::parseFile( )). The table must
+     * outlive the line visitor.
+     * \return Line visitor appending rows to this table.
+     */
+    TextParser::LineVisitor getRowAppender( );
+
+    //! Reserve memory for rows.
+    /*!
+     * Reserves memory for the given number of rows, to prevent reallocation while appending.
+     * \param numberOfRows Number of rows for which memory is reserved.
+     */
+    void reserve( const std::size_t numberOfRows );
+
+    //! Get number of rows.
+    std::size_t getNumberOfRows( ) const { return numberOfRows_; }
+
+    //! Get number of columns.
+    unsigned int getNumberOfColumns( ) const { return columns_.size( ); }
+
+    //! Get field types of columns.
+    std::vector< FieldType > getFieldTypes( ) const;
+
+    //! Check whether the table has a column.
+    /*!
+     * Checks whether the table has a column of the given field type.
+     * \param fieldType Field type of column.
+     * \return True if the table has the column, false otherwise.
+     */
+    bool hasColumn( const FieldType fieldType ) const
+    {
+        return columnIndices_.count( fieldType ) > 0;
+    }
+
+    //! Get type of column.
+    /*!
+     * Returns the type of the column of the given field type.
+     * \param fieldType Field type of column.
+     * \return Type of column.
+     * \throws std::runtime_error If the table has no column of the field type.
+     */
+    ColumnType getColumnType( const FieldType fieldType ) const;
+
+    //! Get numeric column.
+    /*!
+     * Returns the values of a numeric column, stored contiguously.
+     * \param fieldType Field type of column.
+     * \return Values of column.
+     * \throws std::runtime_error If the table has no numeric column of the field type.
+     */
+    const std::vector< double >& getNumericColumn( const FieldType fieldType ) const;
+
+    //! Get text field.
+    /*!
+     * Returns the range of characters of a field of a text column, which remains valid until
+     * rows are appended to the table.
+     * \param fieldType Field type of column.
+     * \param row Index of row.
+     * \return Range of characters of field.
+     * \throws std::runtime_error If the table has no text column of the field type.
+     */
+    FieldRange getTextField( const FieldType fieldType, const std::size_t row ) const;
+
+    //! Get text value.
+    /*!
+     * Returns a field of a text column as string.
+     * \param fieldType Field type of column.
+     * \param row Index of row.
+     * \return Value of field.
+     * \throws std::runtime_error If the table has no text column of the field type.
+     */
+    std::string getText( const FieldType fieldType, const std::size_t row ) const
+    {
+        return convertFieldToString( getTextField( fieldType, row ) );
+    }
+
+    //! Find rows with value of numeric column in range.
+    /*!
+     * Finds the rows of which the value of a numeric column is within a closed interval.
+     * \param fieldType Field type of numeric column.
+     * \param lowerBound Lower bound of interval.
+     * \param upperBound Upper bound of interval.
+     * \return Indices of rows, in ascending order.
+     * \throws std::runtime_error If the table has no numeric column of the field type.
+     */
+    std::vector< std::size_t > findRowsInRange( const FieldType fieldType,
+                                                const double lowerBound,
+                                                const double upperBound ) const;
+
+    //! Find rows with value of text column matching regular expression.
+    /*!
+     * Finds the rows of which the value of a text column has at least one match for a regular
+     * expression, as filterMapKeyValue( ).
+     * \param fieldType Field type of text column.
+     * \param regularExpression Regular expression to search for.
+     * \return Indices of rows, in ascending order.
+     * \throws std::runtime_error If the table has no text column of the field type.
+     */
+    std::vector< std::size_t > findRowsMatching( const FieldType fieldType,
+                                                 const boost::regex& regularExpression ) const;
+
+    //! Select rows.
+    /*!
+     * Creates a table containing the given rows of this table, with the same columns.
+     * \param rows Indices of rows to select.
+     * \return Table with selected rows.
+     * \throws std::runtime_error If a row index is out of range.
+     */
+    ParsedDataTable selectRows( const std::vector< std::size_t >& rows ) const;
+
+    //! Select columns.
+    /*!
+     * Creates a table containing the given columns of this table, with all rows.
+     * \param fieldTypes Field types of columns to select.
+     * \return Table with selected columns.
+     * \throws std::runtime_error If the table has no column of one of the field types.
+     */
+    ParsedDataTable selectColumns( const std::vector< FieldType >& fieldTypes ) const;
+
+    //! Transform numeric column linearly.
+    /*!
+     * Transforms all values of a numeric column linearly, in the same form as
+     * LinearFieldTransform: result = slope * value + intercept.
+     * \param fieldType Field type of numeric column.
+     * \param slope Slope of the transformation.
+     * \param intercept Intercept of the transformation.
+     * \throws std::runtime_error If the table has no numeric column of the field type.
+     */
+    void transformNumericColumn( const FieldType fieldType, const double slope,
+                                 const double intercept );
+
+protected:
+
+private:
+
+    //! Column of table.
+    struct Column
+    {
+        //! Field type of column.
+        FieldType fieldType;
+
+        //! Type of column.
+        ColumnType columnType;
+
+        //! Values of numeric column.
+        std::vector< double > numericValues;
+
+        //! Characters of all fields of text column.
+        std::vector< char > characters;
+
+        //! Offsets of the ends of the fields of text column in characters.
+        std::vector< std::size_t > fieldEnds;
+    };
+
+    //! Initialize columns.
+    /*!
+     * Initializes the empty columns of the table.
+     * \param fieldTypes Field types of the columns.
+     * \param columnTypes Types of the columns.
+     * \throws std::runtime_error If the numbers of field types and column types differ, or if a
+     *          field type is given more than once.
+     */
+    void initializeColumns( const std::vector< FieldType >& fieldTypes,
+                            const std::vector< ColumnType >& columnTypes );
+
+    //! Get column.
+    /*!
+     * Returns the column of a field type, checking that it exists and is of the given type.
+     * \param fieldType Field type of column.
+     * \param columnType Required type of column.
+     * \return Column of field type.
+     * \throws std::runtime_error If the table has no column of the field type and type.
+     */
+    const Column& getColumn( const FieldType fieldType, const ColumnType columnType ) const;
+
+    //! Append text field to column.
+    /*!
+     * Appends a text field to a text column.
+     * \param column Text column.
+     * \param field Range of characters of field.
+     */
+    static void appendTextField( Column& column, const FieldRange& field );
+
+    //! Columns of table.
+    std::vector< Column > columns_;
+
+    //! Map of indices of columns in columns_, identified by their field type.
+    std::map< FieldType, unsigned int > columnIndices_;
+
+    //! Number of rows of table.
+    std::size_t numberOfRows_;
+
+    //! Converted values of numeric columns of row, used while appending rows.
+    std::vector< double > rowValues_;
+};
+
+//! Typedef for shared-pointer to ParsedDataTable object.
+typedef boost::shared_ptr< ParsedDataTable > ParsedDataTablePointer;
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_PARSED_DATA_TABLE_H
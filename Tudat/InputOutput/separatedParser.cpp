@@ -28,6 +28,7 @@
  *      120706    D.J. Gondelach    Code check.
  *      120718    A. Ronse          Replaced custom split functions by
  *                                  boost::algorithm::make_split_iterator method.
+ *      261016    agent             Added tokenization of lines for streaming mode.
  *
  *    References
  *
@@ -35,9 +36,13 @@
  *
  */
 
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/exception/all.hpp>
 #include <boost/range/algorithm/copy.hpp>
 
 #include "Tudat/InputOutput/separatedParser.h"
@@ -150,5 +155,51 @@ void SeparatedParser::parseLine( std::string& line )
     }
 }
 
+//! Divides one line of text into fields, for parsing in streaming mode.
+void SeparatedParser::tokenizeLine( const char* begin, const char* end,
+                                    std::vector< FieldRange >& fields )
+{
+    // Split line based on provided separator, skipping empty fields due to a double separator.
+    const char* fieldBegin = begin;
+    while ( fieldBegin < end )
+    {
+        const char* fieldEnd = separator_.empty( ) ? end :
+                std::search( fieldBegin, end, separator_.begin( ), separator_.end( ) );
+        if ( fieldEnd != fieldBegin )
+        {
+            fields.push_back( FieldRange( fieldBegin, fieldEnd ) );
+        }
+
+        fieldBegin = ( fieldEnd == end ) ? end : fieldEnd + separator_.size( );
+    }
+
+    // Verify that number of fields corresponds to the specified number of fields.
+    if ( fields.size( ) > numberOfFields_ )
+    {
+        std::cerr << "Number of elements in the line (" << fields.size( )
+        << ") does not match the specified number of fields (" << numberOfFields_ << ")"
+        << std::endl;
+        fields.resize( numberOfFields_ );
+    }
+    else if ( !fields.empty( ) && fields.size( ) < numberOfFields_ )
+    {
+        std::ostringstream errorMessage;
+        errorMessage << "Number of elements in the line (" << fields.size( )
+                     << ") is smaller than the specified number of fields (" << numberOfFields_
+                     << ")";
+        boost::throw_exception( boost::enable_error_info(
+                                    std::runtime_error( errorMessage.str( ) ) ) );
+    }
+
+    // If we need to trim whitespace, do so.
+    if ( doTrim )
+    {
+        for ( unsigned int i = 0; i < fields.size( ); i++ )
+        {
+            fields[ i ] = trimField( fields[ i ] );
+        }
+    }
+}
+
 } // namespace input_output
 } // namespace tudat
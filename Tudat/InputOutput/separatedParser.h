@@ -28,6 +28,7 @@
  *      120706    D.J. Gondelach    Code check.
  *      130121    K. Kumar          Added shared-ptr typedef.
  *      131221    K. Kumar          Fixed missing Doxygen comments.
+ *      261016    agent             Added tokenization of lines for streaming mode.
  *
  *    References
  *
@@ -77,6 +78,9 @@ public:
     //! Get trim setting: Trim whitespace off fields (default=true).
     bool getTrim( ) { return doTrim; }
 
+    //! Get field types, in the order in which the fields are parsed.
+    const std::vector< FieldType >& getFieldTypes( ) const { return typeList; }
+
     //! Set unit transformation map.
     /*!
      * \param unitTransformationMap Map providing field transforms for any or all of the
@@ -97,6 +101,20 @@ protected:
      */
     void parseLine( std::string& line );
 
+    //! Divides one line of text into fields, for parsing in streaming mode.
+    /*!
+     * Divides one line of text into fields using the specified separator, skipping empty fields
+     * due to consecutive separators, as parseLine( ). Contrary to parseLine( ), the separator is
+     * matched case-sensitively. If the line contains more fields than the number of fields of
+     * the parser, a warning is given and the additional fields are ignored.
+     * \param begin Pointer to first character of line.
+     * \param end Pointer past last character of line.
+     * \param fields Ranges of characters of fields (returned by reference).
+     * \throws std::runtime_error If the line contains fewer fields than the number of fields of
+     *          the parser, but at least one.
+     */
+    void tokenizeLine( const char* begin, const char* end, std::vector< FieldRange >& fields );
+
 private:
 
     //! Number of fields that is parsed.
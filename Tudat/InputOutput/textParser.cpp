@@ -26,6 +26,7 @@
  *      YYMMDD    Author            Comment
  *      111206    S. Billemont      File created.
  *      120326    D. Dirkx          Code checked, minor layout changes.
+ *      261016    agent             Added streaming mode.
  *
  *    References
  *
@@ -33,6 +34,15 @@
  *
  */
 
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #include "Tudat/InputOutput/textParser.h"
 
 namespace tudat
@@ -79,5 +89,72 @@ ParsedDataVectorPtr TextParser::parse( std::istream& stream )
     return parsedData;
 }
 
+// Parse text buffer in streaming mode.
+void TextParser::parseBuffer( const char* begin, const char* end,
+                              const LineVisitor& lineVisitor )
+{
+    // Declare vector of fields, reused for all lines.
+    std::vector< FieldRange > fields;
+
+    const char* lineBegin = begin;
+    while ( lineBegin < end )
+    {
+        // Find end of line, and exclude line separator.
+        const char* lineSeparator = static_cast< const char* >(
+                    std::memchr( lineBegin, '\n', end - lineBegin ) );
+        const char* lineEnd = lineSeparator ? lineSeparator : end;
+        const char* nextLineBegin = lineSeparator ? lineSeparator + 1 : end;
+        if ( lineEnd != lineBegin && *( lineEnd - 1 ) == '\r' )
+        {
+            --lineEnd;
+        }
+
+        // Divide line into fields, and pass non-empty lines to visitor.
+        fields.clear( );
+        tokenizeLine( lineBegin, lineEnd, fields );
+        if ( !fields.empty( ) )
+        {
+            lineVisitor( fields );
+        }
+
+        lineBegin = nextLineBegin;
+    }
+}
+
+// Parse text file in streaming mode.
+void TextParser::parseFile( const std::string& fileName, const LineVisitor& lineVisitor )
+{
+    if ( !boost::filesystem::exists( fileName ) )
+    {
+        boost::throw_exception( boost::enable_error_info(
+                                    std::runtime_error( "File " + fileName + " not found." ) ) );
+    }
+
+    // An empty file cannot be mapped, and contains no lines.
+    if ( boost::filesystem::file_size( fileName ) == 0 )
+    {
+        return;
+    }
+
+    // Map file into memory.
+    boost::interprocess::mapped_region mappedFile;
+    try
+    {
+        boost::interprocess::file_mapping file( fileName.c_str( ),
+                                                boost::interprocess::read_only );
+        boost::interprocess::mapped_region(
+                    file, boost::interprocess::read_only ).swap( mappedFile );
+    }
+    catch ( boost::interprocess::interprocess_exception& )
+    {
+        boost::throw_exception( boost::enable_error_info(
+                                    std::runtime_error( "File " + fileName
+                                                        + " could not be mapped." ) ) );
+    }
+
+    const char* begin = static_cast< const char* >( mappedFile.get_address( ) );
+    parseBuffer( begin, begin + mappedFile.get_size( ), lineVisitor );
+}
+
 } // namespace input_output
 } // namespace tudat
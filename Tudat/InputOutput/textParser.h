@@ -28,6 +28,8 @@
  *      120326    D. Dirkx          Code checked, minor layout changes.
  *      130121    K. Kumar          Added shared-ptr typedef.
  *      131221    K. Kumar          Fixed Doxygen comments.
+ *      261016    agent             Added streaming mode, parsing buffers and memory-mapped files
+ *                                  into field ranges passed to a line visitor.
  *
  *    References
  *
@@ -39,9 +41,13 @@
 #define TUDAT_TEXT_PARSER_H
 
 #include <iostream>
+#include <string>
+#include <vector>
 
+#include <boost/function.hpp>
 #include <boost/make_shared.hpp>
 
+#include "Tudat/InputOutput/fieldRange.h"
 #include "Tudat/InputOutput/parser.h"
 
 namespace tudat
@@ -55,6 +61,11 @@ namespace input_output
  * process. The inheriting parsers can chose there prefered way of processing by calling 
  * TextParser(bool).
  *
+ * Line based parsers can additionally be used in streaming mode (see parseBuffer( ) and
+ * parseFile( )), in which the fields of each line are passed to a line visitor as ranges of
+ * characters in the text buffer, without storing the parsed data. This mode does not allocate
+ * memory per line or field, and is therefore suited for large files.
+ *
  * NOTE: This TextParser works with the FieldValue/FieldType architecture.
  * For simpler file reading, use, for instance, matrixTextFileReader.
  */
@@ -100,7 +111,37 @@ public:
      * \see Parser::parse(std::istream& stream).
      */
     parsed_data_vector_utilities::ParsedDataVectorPtr parse( std::istream& stream );
-	
+
+    //! Typedef for function called for each line parsed in streaming mode.
+    /*!
+     * Typedef for function called for each line parsed in streaming mode, taking the ranges of
+     * characters of the fields of the line, in the order of the field types of the parser. The
+     * ranges are only valid during the call.
+     */
+    typedef boost::function< void( const std::vector< FieldRange >& ) > LineVisitor;
+
+    //! Parse text buffer in streaming mode.
+    /*!
+     * Parses a text buffer line by line, and passes the fields of each line to a line visitor,
+     * without storing the parsed data. Lines are separated by newlines, optionally preceded by
+     * carriage returns. Lines without fields are skipped. Any unit transformations are not
+     * applied to the fields.
+     * \param begin Pointer to first character of buffer.
+     * \param end Pointer past last character of buffer.
+     * \param lineVisitor Function called for each parsed line.
+     */
+    void parseBuffer( const char* begin, const char* end, const LineVisitor& lineVisitor );
+
+    //! Parse text file in streaming mode.
+    /*!
+     * Parses a text file in streaming mode (see parseBuffer( )). The file is memory-mapped, such
+     * that the memory use does not depend on the size of the file.
+     * \param fileName Name of file.
+     * \param lineVisitor Function called for each parsed line.
+     * \throws std::runtime_error If the file does not exist or cannot be mapped.
+     */
+    void parseFile( const std::string& fileName, const LineVisitor& lineVisitor );
+
 protected:
 
     //! Data container of the parsed data.
@@ -145,6 +186,24 @@ protected:
                                                          ( "Must be overriden to be used" ) ) );
     }
 
+    //! Divide the given line into fields, for parsing in streaming mode.
+    /*!
+     * Divides a line into the ranges of characters of its fields, in the order of the field
+     * types of the parser.
+     *
+     * Needs to be overwritten to parse in streaming mode, otherwise an exception will be thrown!
+     *
+     * \param begin Pointer to first character of line.
+     * \param end Pointer past last character of line, excluding line separator.
+     * \param fields Ranges of characters of fields, cleared before use (returned by reference).
+     */
+    virtual void tokenizeLine( const char* begin, const char* end,
+                               std::vector< FieldRange >& fields )
+    {
+        boost::throw_exception( boost::enable_error_info( std::runtime_error
+                                                         ( "Must be overriden to be used" ) ) );
+    }
+
 private:
 };
 
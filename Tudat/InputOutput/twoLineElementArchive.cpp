@@ -0,0 +1,379 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      Celestrak (c). NORAD Two-Line Element Set Format,
+ *          http://celestrak.com/NORAD/documentation/tle-fmt.asp, 2004. Last accessed: 5 August,
+ *          2011.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/InputOutput/twoLineElementArchive.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+// Records are stored without padding, and aligned in the memory-mapped file.
+BOOST_STATIC_ASSERT( sizeof( TwoLineElementRecord ) == 176 );
+
+//! File identifier of TLE archive.
+const char TwoLineElementArchive::fileIdentifier_[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'T', 'L', 'E' };
+
+//! File format version of TLE archive.
+const boost::uint32_t TwoLineElementArchive::fileVersion_ = 1;
+
+//! Compute Julian day of TLE epoch.
+double computeJulianDayOfTwoLineElementEpoch( const unsigned int fourDigitEpochYear,
+                                              const double epochDay )
+{
+    // Compute number of days from January 1, 1970 to January 1 of epoch year in the Gregorian
+    // calendar, counting in 400-year cycles from March 1, 0000.
+    const int yearSinceMarch = static_cast< int >( fourDigitEpochYear ) - 1;
+    const int cycle = yearSinceMarch / 400;
+    const int yearOfCycle = yearSinceMarch - cycle * 400;
+    const int dayOfCycle = yearOfCycle * 365 + yearOfCycle / 4 - yearOfCycle / 100 + 306;
+    const int daysSince1970 = cycle * 146097 + dayOfCycle - 719468;
+
+    // Add Julian day of January 1, 1970, 0h; epoch day 1.0 corresponds to January 1, 0h.
+    return 2440587.5 + daysSince1970 + epochDay - 1.0;
+}
+
+//! Convert TLE data to TLE record.
+TwoLineElementRecord convertToTwoLineElementRecord(
+        const TwoLineElementData& twoLineElementData )
+{
+    TwoLineElementRecord twoLineElementRecord;
+
+    // Clear record, such that the unused characters of the name are null characters.
+    std::memset( &twoLineElementRecord, 0, sizeof( twoLineElementRecord ) );
+
+    twoLineElementRecord.epochInJulianDays = computeJulianDayOfTwoLineElementEpoch(
+                twoLineElementData.fourDigitEpochYear, twoLineElementData.epochDay );
+    twoLineElementRecord.epochDay = twoLineElementData.epochDay;
+    twoLineElementRecord.firstDerivativeOfMeanMotionDividedByTwo
+            = twoLineElementData.firstDerivativeOfMeanMotionDividedByTwo;
+    twoLineElementRecord.secondDerivativeOfMeanMotionDividedBySix
+            = twoLineElementData.secondDerivativeOfMeanMotionDividedBySix;
+    twoLineElementRecord.bStar = twoLineElementData.bStar;
+    twoLineElementRecord.semiMajorAxis = twoLineElementData.TLEKeplerianElements(
+                basic_astrodynamics::semiMajorAxisIndex );
+    twoLineElementRecord.eccentricity = twoLineElementData.TLEKeplerianElements(
+                basic_astrodynamics::eccentricityIndex );
+    twoLineElementRecord.inclination = twoLineElementData.TLEKeplerianElements(
+                basic_astrodynamics::inclinationIndex );
+    twoLineElementRecord.argumentOfPerigee = twoLineElementData.TLEKeplerianElements(
+                basic_astrodynamics::argumentOfPeriapsisIndex );
+    twoLineElementRecord.rightAscensionOfAscendingNode = twoLineElementData.TLEKeplerianElements(
+                basic_astrodynamics::longitudeOfAscendingNodeIndex );
+    twoLineElementRecord.meanAnomaly = twoLineElementData.meanAnomaly;
+    twoLineElementRecord.meanMotionInRevolutionsPerDay
+            = twoLineElementData.meanMotionInRevolutionsPerDay;
+    twoLineElementRecord.perigee = twoLineElementData.perigee;
+    twoLineElementRecord.apogee = twoLineElementData.apogee;
+
+    twoLineElementRecord.objectIdentificationNumber
+            = twoLineElementData.objectIdentificationNumber;
+    twoLineElementRecord.fourDigitLaunchYear = twoLineElementData.fourDigitlaunchYear;
+    twoLineElementRecord.launchNumber = twoLineElementData.launchNumber;
+    twoLineElementRecord.fourDigitEpochYear = twoLineElementData.fourDigitEpochYear;
+    twoLineElementRecord.orbitalModel = twoLineElementData.orbitalModel;
+    twoLineElementRecord.tleNumber = twoLineElementData.tleNumber;
+    twoLineElementRecord.revolutionNumber = twoLineElementData.revolutionNumber;
+    twoLineElementRecord.totalRevolutionNumber = twoLineElementData.totalRevolutionNumber;
+
+    twoLineElementRecord.tleClassification = twoLineElementData.tleClassification;
+
+    // Store launch part padded with spaces, as in the TLE format.
+    std::memset( twoLineElementRecord.launchPart, ' ', sizeof( twoLineElementRecord.launchPart ) );
+    twoLineElementData.launchPart.copy(
+                twoLineElementRecord.launchPart, sizeof( twoLineElementRecord.launchPart ) );
+
+    // Store name without trailing whitespace.
+    const std::string& objectNameString = twoLineElementData.objectNameString;
+    const std::size_t endOfName = objectNameString.find_last_not_of( " \t" );
+    if ( endOfName != std::string::npos )
+    {
+        objectNameString.copy( twoLineElementRecord.objectName,
+                               std::min( endOfName + 1,
+                                         sizeof( twoLineElementRecord.objectName ) ) );
+    }
+
+    return twoLineElementRecord;
+}
+
+//! Convert TLE record to TLE data.
+TwoLineElementData convertToTwoLineElementData( const TwoLineElementRecord& twoLineElementRecord )
+{
+    TwoLineElementData twoLineElementData;
+
+    twoLineElementData.objectNameString = std::string(
+                twoLineElementRecord.objectName,
+                std::find( twoLineElementRecord.objectName,
+                           twoLineElementRecord.objectName
+                           + sizeof( twoLineElementRecord.objectName ), '\0' ) );
+
+    // Split name into words, as TwoLineElementsTextFileReader does.
+    std::stringstream objectNameStream( twoLineElementData.objectNameString );
+    std::string namePart;
+    while ( objectNameStream >> namePart )
+    {
+        twoLineElementData.objectName.push_back( namePart );
+    }
+
+    twoLineElementData.lineNumberLine1 = 1;
+    twoLineElementData.objectIdentificationNumber
+            = twoLineElementRecord.objectIdentificationNumber;
+    twoLineElementData.tleClassification = twoLineElementRecord.tleClassification;
+    twoLineElementData.fourDigitlaunchYear = twoLineElementRecord.fourDigitLaunchYear;
+    twoLineElementData.launchYear = twoLineElementRecord.fourDigitLaunchYear % 100;
+    twoLineElementData.launchNumber = twoLineElementRecord.launchNumber;
+    twoLineElementData.launchPart = std::string(
+                twoLineElementRecord.launchPart,
+                sizeof( twoLineElementRecord.launchPart ) );
+    twoLineElementData.fourDigitEpochYear = twoLineElementRecord.fourDigitEpochYear;
+    twoLineElementData.epochYear = twoLineElementRecord.fourDigitEpochYear % 100;
+    twoLineElementData.epochDay = twoLineElementRecord.epochDay;
+    twoLineElementData.firstDerivativeOfMeanMotionDividedByTwo
+            = twoLineElementRecord.firstDerivativeOfMeanMotionDividedByTwo;
+    twoLineElementData.secondDerivativeOfMeanMotionDividedBySix
+            = twoLineElementRecord.secondDerivativeOfMeanMotionDividedBySix;
+    twoLineElementData.bStar = twoLineElementRecord.bStar;
+    twoLineElementData.orbitalModel = twoLineElementRecord.orbitalModel;
+    twoLineElementData.tleNumber = twoLineElementRecord.tleNumber;
+
+    twoLineElementData.lineNumberLine2 = 2;
+    twoLineElementData.objectIdentificationNumberLine2
+            = twoLineElementRecord.objectIdentificationNumber;
+    twoLineElementData.TLEKeplerianElements.setZero( );
+    twoLineElementData.TLEKeplerianElements( basic_astrodynamics::semiMajorAxisIndex )
+            = twoLineElementRecord.semiMajorAxis;
+    twoLineElementData.TLEKeplerianElements( basic_astrodynamics::eccentricityIndex )
+            = twoLineElementRecord.eccentricity;
+    twoLineElementData.TLEKeplerianElements( basic_astrodynamics::inclinationIndex )
+            = twoLineElementRecord.inclination;
+    twoLineElementData.TLEKeplerianElements( basic_astrodynamics::argumentOfPeriapsisIndex )
+            = twoLineElementRecord.argumentOfPerigee;
+    twoLineElementData.TLEKeplerianElements(
+                basic_astrodynamics::longitudeOfAscendingNodeIndex )
+            = twoLineElementRecord.rightAscensionOfAscendingNode;
+    twoLineElementData.meanAnomaly = twoLineElementRecord.meanAnomaly;
+    twoLineElementData.meanMotionInRevolutionsPerDay
+            = twoLineElementRecord.meanMotionInRevolutionsPerDay;
+    twoLineElementData.revolutionNumber = twoLineElementRecord.revolutionNumber;
+    twoLineElementData.totalRevolutionNumber = twoLineElementRecord.totalRevolutionNumber;
+    twoLineElementData.perigee = twoLineElementRecord.perigee;
+    twoLineElementData.apogee = twoLineElementRecord.apogee;
+
+    return twoLineElementData;
+}
+
+//! Compare TLE records by object identification number and epoch.
+bool compareTwoLineElementRecords( const TwoLineElementRecord& firstRecord,
+                                   const TwoLineElementRecord& secondRecord )
+{
+    if ( firstRecord.objectIdentificationNumber != secondRecord.objectIdentificationNumber )
+    {
+        return firstRecord.objectIdentificationNumber < secondRecord.objectIdentificationNumber;
+    }
+
+    return firstRecord.epochInJulianDays < secondRecord.epochInJulianDays;
+}
+
+//! Constructor.
+TwoLineElementArchive::TwoLineElementArchive( const std::string& fileName )
+    : records_( NULL ),
+      numberOfRecords_( 0 )
+{
+    if ( !boost::filesystem::exists( fileName ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "TLE archive " + fileName + " not found." ) )
+                    << boost::errinfo_file_name( fileName ) );
+    }
+
+    // Map archive file into memory.
+    try
+    {
+        boost::interprocess::file_mapping file( fileName.c_str( ),
+                                                boost::interprocess::read_only );
+        boost::interprocess::mapped_region(
+                    file, boost::interprocess::read_only ).swap( mappedFile_ );
+    }
+    catch ( boost::interprocess::interprocess_exception& )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "TLE archive " + fileName + " could not be mapped." ) )
+                    << boost::errinfo_file_name( fileName ) );
+    }
+
+    // Check header, consisting of file identifier, file format version, record size and number
+    // of records, and size of archive file.
+    const char* fileData = static_cast< const char* >( mappedFile_.get_address( ) );
+    const std::size_t fileSize = mappedFile_.get_size( );
+    const std::size_t headerSize
+            = sizeof( fileIdentifier_ ) + 2 * sizeof( boost::uint32_t ) + sizeof( boost::uint64_t );
+
+    boost::uint32_t header[ 2 ] = { 0, 0 };
+    boost::uint64_t numberOfRecords = 0;
+    if ( fileSize >= headerSize )
+    {
+        std::memcpy( header, fileData + sizeof( fileIdentifier_ ), sizeof( header ) );
+        std::memcpy( &numberOfRecords, fileData + sizeof( fileIdentifier_ ) + sizeof( header ),
+                     sizeof( numberOfRecords ) );
+    }
+
+    if ( fileSize < headerSize
+         || std::memcmp( fileData, fileIdentifier_, sizeof( fileIdentifier_ ) )
+         || header[ 0 ] != fileVersion_ || header[ 1 ] != sizeof( TwoLineElementRecord )
+         || fileSize != headerSize + numberOfRecords * sizeof( TwoLineElementRecord ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "File " + fileName + " is not a valid TLE archive "
+                                            "of this version and platform." ) )
+                    << boost::errinfo_file_name( fileName ) );
+    }
+
+    records_ = reinterpret_cast< const TwoLineElementRecord* >( fileData + headerSize );
+    numberOfRecords_ = numberOfRecords;
+}
+
+//! Write TLE archive.
+void TwoLineElementArchive::writeArchive(
+        const std::string& fileName, const std::vector< TwoLineElementData >& twoLineElementData )
+{
+    // Convert and sort TLE data.
+    std::vector< TwoLineElementRecord > records;
+    records.reserve( twoLineElementData.size( ) );
+    for ( unsigned int i = 0; i < twoLineElementData.size( ); i++ )
+    {
+        records.push_back( convertToTwoLineElementRecord( twoLineElementData[ i ] ) );
+    }
+    std::stable_sort( records.begin( ), records.end( ), &compareTwoLineElementRecords );
+
+    // Write header and records.
+    std::ofstream archiveFile( fileName.c_str( ), std::ios::binary );
+    archiveFile.write( fileIdentifier_, sizeof( fileIdentifier_ ) );
+    const boost::uint32_t header[ 2 ] = { fileVersion_, sizeof( TwoLineElementRecord ) };
+    archiveFile.write( reinterpret_cast< const char* >( header ), sizeof( header ) );
+    const boost::uint64_t numberOfRecords = records.size( );
+    archiveFile.write( reinterpret_cast< const char* >( &numberOfRecords ),
+                       sizeof( numberOfRecords ) );
+    if ( !records.empty( ) )
+    {
+        archiveFile.write( reinterpret_cast< const char* >( &records[ 0 ] ),
+                           records.size( ) * sizeof( TwoLineElementRecord ) );
+    }
+
+    if ( !archiveFile )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Could not write TLE archive " + fileName + "." ) )
+                    << boost::errinfo_file_name( fileName ) );
+    }
+}
+
+//! Get TLE record.
+const TwoLineElementRecord& TwoLineElementArchive::getRecord( const std::size_t recordIndex ) const
+{
+    if ( recordIndex >= numberOfRecords_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::out_of_range( "TLE record index exceeds number of records." ) ) );
+    }
+
+    return records_[ recordIndex ];
+}
+
+//! Get TLE records of object.
+TwoLineElementArchive::TwoLineElementRecordRange TwoLineElementArchive::getRecordsOfObject(
+        const unsigned int objectIdentificationNumber ) const
+{
+    // Search for range of records between the earliest and latest possible epochs.
+    TwoLineElementRecord firstKey;
+    firstKey.objectIdentificationNumber = objectIdentificationNumber;
+    firstKey.epochInJulianDays = -std::numeric_limits< double >::infinity( );
+    TwoLineElementRecord lastKey = firstKey;
+    lastKey.epochInJulianDays = std::numeric_limits< double >::infinity( );
+
+    return TwoLineElementRecordRange(
+                std::lower_bound( records_, records_ + numberOfRecords_, firstKey,
+                                  &compareTwoLineElementRecords ),
+                std::upper_bound( records_, records_ + numberOfRecords_, lastKey,
+                                  &compareTwoLineElementRecords ) );
+}
+
+//! Find latest TLE record of object before epoch.
+const TwoLineElementRecord* TwoLineElementArchive::findLatestRecordBeforeEpoch(
+        const unsigned int objectIdentificationNumber, const double epochInJulianDays ) const
+{
+    TwoLineElementRecord key;
+    key.objectIdentificationNumber = objectIdentificationNumber;
+    key.epochInJulianDays = epochInJulianDays;
+
+    // Find first record after epoch; the record before it is the latest record at or before the
+    // epoch, if it belongs to the same object.
+    const TwoLineElementRecord* firstRecordAfterEpoch
+            = std::upper_bound( records_, records_ + numberOfRecords_, key,
+                                &compareTwoLineElementRecords );
+
+    if ( firstRecordAfterEpoch == records_
+         || ( firstRecordAfterEpoch - 1 )->objectIdentificationNumber
+         != objectIdentificationNumber )
+    {
+        return NULL;
+    }
+
+    return firstRecordAfterEpoch - 1;
+}
+
+} // namespace input_output
+} // namespace tudat
@@ -0,0 +1,296 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      Celestrak (c). NORAD Two-Line Element Set Format,
+ *          http://celestrak.com/NORAD/documentation/tle-fmt.asp, 2004. Last accessed: 5 August,
+ *          2011.
+ *
+ *    Notes
+ *      The archive is written in the native byte order and layout of the platform. Archives are
+ *      rejected if their file format version or record size do not match, but are not portable
+ *      between platforms with different byte orders.
+ *
+ */
+
+#ifndef TUDAT_TWO_LINE_ELEMENT_ARCHIVE_H
+#define TUDAT_TWO_LINE_ELEMENT_ARCHIVE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/InputOutput/twoLineElementData.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Fixed-size record of TLE data.
+/*!
+ * Fixed-size record of the converted TLE data of a single object, as stored in a TLE archive (see
+ * TwoLineElementArchive). Contrary to TwoLineElementData, the record contains no strings or other
+ * dynamically allocated members, so that it can be accessed directly in a memory-mapped file.
+ * Angles are given in degrees and distances in meters, as in TwoLineElementData.
+ */
+struct TwoLineElementRecord
+{
+    //! Epoch of TLE data in Julian days.
+    double epochInJulianDays;
+
+    //! Epoch day, i.e., fractional day of epoch year.
+    double epochDay;
+
+    //! First derivative of mean motion divided by two.
+    double firstDerivativeOfMeanMotionDividedByTwo;
+
+    //! Second derivative of mean motion divided by six.
+    double secondDerivativeOfMeanMotionDividedBySix;
+
+    //! B* drag term.
+    double bStar;
+
+    //! Semi-major axis.
+    double semiMajorAxis;
+
+    //! Eccentricity.
+    double eccentricity;
+
+    //! Inclination.
+    double inclination;
+
+    //! Argument of perigee.
+    double argumentOfPerigee;
+
+    //! Right ascension of ascending node.
+    double rightAscensionOfAscendingNode;
+
+    //! Mean anomaly.
+    double meanAnomaly;
+
+    //! Mean motion in revolutions per day.
+    double meanMotionInRevolutionsPerDay;
+
+    //! Perigee.
+    double perigee;
+
+    //! Apogee.
+    double apogee;
+
+    //! Object identification (NORAD catalog) number.
+    boost::uint32_t objectIdentificationNumber;
+
+    //! Four-digit launch year.
+    boost::int32_t fourDigitLaunchYear;
+
+    //! Launch number of the year.
+    boost::int32_t launchNumber;
+
+    //! Four-digit epoch year.
+    boost::int32_t fourDigitEpochYear;
+
+    //! Orbital model.
+    boost::int32_t orbitalModel;
+
+    //! TLE (element set) number.
+    boost::int32_t tleNumber;
+
+    //! Revolution number at epoch.
+    boost::int32_t revolutionNumber;
+
+    //! Total revolution number at epoch.
+    boost::int32_t totalRevolutionNumber;
+
+    //! TLE classification.
+    char tleClassification;
+
+    //! Launch part, padded with spaces.
+    char launchPart[ 3 ];
+
+    //! Object name, without trailing whitespace and padded with null characters.
+    /*!
+     * Object name, without trailing whitespace and padded with null characters. Names of 28
+     * characters are not null-terminated, and longer names are truncated.
+     */
+    char objectName[ 28 ];
+};
+
+//! Compute Julian day of TLE epoch.
+/*!
+ * Computes the Julian day of the epoch of TLE data, given as a four-digit year and fractional day
+ * of the year, where day 1.0 corresponds to January 1, 0h UTC (Celestrak (c), 2004).
+ * \param fourDigitEpochYear Four-digit epoch year.
+ * \param epochDay Fractional day of epoch year.
+ * \return Epoch in Julian days.
+ */
+double computeJulianDayOfTwoLineElementEpoch( const unsigned int fourDigitEpochYear,
+                                              const double epochDay );
+
+//! Convert TLE data to TLE record.
+/*!
+ * Converts TLE data to a fixed-size TLE record, e.g., for storage in a TLE archive.
+ * \param twoLineElementData TLE data.
+ * \return TLE record.
+ */
+TwoLineElementRecord convertToTwoLineElementRecord(
+        const TwoLineElementData& twoLineElementData );
+
+//! Convert TLE record to TLE data.
+/*!
+ * Converts a fixed-size TLE record to TLE data. The TLE strings, line numbers, checksums and the
+ * coefficients and exponents of the scientific notation fields are not stored in TLE records, and
+ * are left at their default values; the line-number fields are set to 1 and 2.
+ * \param twoLineElementRecord TLE record.
+ * \return TLE data.
+ */
+TwoLineElementData convertToTwoLineElementData( const TwoLineElementRecord& twoLineElementRecord );
+
+//! Compare TLE records by object identification number and epoch.
+/*!
+ * Compares TLE records by object identification number and, for equal numbers, by epoch. This is
+ * the order in which records are stored in a TLE archive.
+ * \param firstRecord First TLE record.
+ * \param secondRecord Second TLE record.
+ * \return True if the first record is ordered before the second record, false otherwise.
+ */
+bool compareTwoLineElementRecords( const TwoLineElementRecord& firstRecord,
+                                   const TwoLineElementRecord& secondRecord );
+
+//! TLE archive class.
+/*!
+ * TLE archive class, which provides random access to a binary TLE archive file. The archive
+ * consists of a short header followed by fixed-size TLE records (see TwoLineElementRecord),
+ * sorted by object identification number and epoch, so that the records themselves are the index
+ * of the archive. The file is memory-mapped on construction, so that records of an object can be
+ * found by binary search in O(log n) time, without reading the entire archive.
+ */
+class TwoLineElementArchive : boost::noncopyable
+{
+public:
+
+    //! Type definition of range of TLE records.
+    /*!
+     * Type definition of range of TLE records, given as pointers to the first record and past the
+     * last record.
+     */
+    typedef std::pair< const TwoLineElementRecord*, const TwoLineElementRecord* >
+    TwoLineElementRecordRange;
+
+    //! Constructor.
+    /*!
+     * Constructor, which maps the archive file into memory and checks its header.
+     * \param fileName Name of archive file.
+     * \throws std::runtime_error If the file does not exist, cannot be mapped, or is not a valid
+     *          TLE archive of this version and platform.
+     */
+    explicit TwoLineElementArchive( const std::string& fileName );
+
+    //! Write TLE archive.
+    /*!
+     * Converts TLE data to TLE records, sorts them by object identification number and epoch, and
+     * writes them to an archive file. Records with equal object identification number and epoch
+     * are kept, in their original order.
+     * \param fileName Name of archive file.
+     * \param twoLineElementData TLE data of catalog(s), e.g., from a
+     *          TwoLineElementsTextFileReader.
+     * \throws std::runtime_error If the file cannot be written.
+     */
+    static void writeArchive( const std::string& fileName,
+                              const std::vector< TwoLineElementData >& twoLineElementData );
+
+    //! Get number of records.
+    /*!
+     * Returns number of TLE records in archive.
+     * \return Number of TLE records.
+     */
+    std::size_t getNumberOfRecords( ) const { return numberOfRecords_; }
+
+    //! Get TLE record.
+    /*!
+     * Returns TLE record at given position in archive.
+     * \param recordIndex Index of TLE record.
+     * \return TLE record.
+     * \throws std::out_of_range If the index exceeds the number of records.
+     */
+    const TwoLineElementRecord& getRecord( const std::size_t recordIndex ) const;
+
+    //! Get TLE records of object.
+    /*!
+     * Returns all TLE records of an object, sorted by epoch.
+     * \param objectIdentificationNumber Object identification number.
+     * \return Range of TLE records of object, which is empty if the object is not in the archive.
+     */
+    TwoLineElementRecordRange getRecordsOfObject(
+            const unsigned int objectIdentificationNumber ) const;
+
+    //! Find latest TLE record of object before epoch.
+    /*!
+     * Finds the TLE record of an object with the latest epoch at or before a given epoch.
+     * \param objectIdentificationNumber Object identification number.
+     * \param epochInJulianDays Epoch in Julian days.
+     * \return Pointer to TLE record, or NULL if the archive contains no record of the object at
+     *          or before the epoch. The pointer is valid during the lifetime of the archive.
+     */
+    const TwoLineElementRecord* findLatestRecordBeforeEpoch(
+            const unsigned int objectIdentificationNumber,
+            const double epochInJulianDays ) const;
+
+protected:
+
+private:
+
+    //! File identifier of TLE archive.
+    static const char fileIdentifier_[ 8 ];
+
+    //! File format version of TLE archive.
+    static const boost::uint32_t fileVersion_;
+
+    //! Memory-mapped archive file.
+    boost::interprocess::mapped_region mappedFile_;
+
+    //! Pointer to first TLE record in memory-mapped file.
+    const TwoLineElementRecord* records_;
+
+    //! Number of TLE records.
+    std::size_t numberOfRecords_;
+};
+
+//! Typedef for shared-pointer to TwoLineElementArchive object.
+typedef boost::shared_ptr< TwoLineElementArchive > TwoLineElementArchivePointer;
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_TWO_LINE_ELEMENT_ARCHIVE_H
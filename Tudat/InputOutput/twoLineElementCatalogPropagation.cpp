@@ -0,0 +1,90 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/batchKeplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/InputOutput/twoLineElementArchive.h"
+#include "Tudat/InputOutput/twoLineElementCatalogPropagation.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Compute Cartesian states of TLE catalog at a given epoch.
+Eigen::MatrixXd computeCartesianStatesOfTwoLineElementCatalog(
+        const std::vector< TwoLineElementData >& twoLineElementData,
+        const double epochInJulianDays, const unsigned int numberOfThreads )
+{
+    using namespace basic_astrodynamics;
+    using unit_conversions::convertDegreesToRadians;
+
+    // Set gravitational parameter of the Earth in WGS72, as used to compute TLE semi-major axes.
+    const double earthWithWorldGeodeticSystem72GravitationalParameter = 398600.8e9;
+
+    // Collect elements (with mean anomaly), in radians, and propagation times of all objects.
+    const int numberOfObjects = static_cast< int >( twoLineElementData.size( ) );
+    Eigen::MatrixXd keplerianElements( numberOfObjects, 6 );
+    Eigen::VectorXd propagationTimes( numberOfObjects );
+    for ( int i = 0; i < numberOfObjects; i++ )
+    {
+        const basic_mathematics::Vector6d& elements = twoLineElementData[ i ].TLEKeplerianElements;
+        keplerianElements( i, semiMajorAxisIndex ) = elements( semiMajorAxisIndex );
+        keplerianElements( i, eccentricityIndex ) = elements( eccentricityIndex );
+        keplerianElements( i, inclinationIndex )
+                = convertDegreesToRadians( elements( inclinationIndex ) );
+        keplerianElements( i, argumentOfPeriapsisIndex )
+                = convertDegreesToRadians( elements( argumentOfPeriapsisIndex ) );
+        keplerianElements( i, longitudeOfAscendingNodeIndex )
+                = convertDegreesToRadians( elements( longitudeOfAscendingNodeIndex ) );
+        keplerianElements( i, trueAnomalyIndex )
+                = convertDegreesToRadians( twoLineElementData[ i ].meanAnomaly );
+
+        propagationTimes( i ) = unit_conversions::convertJulianDaysToSeconds(
+                    epochInJulianDays - computeJulianDayOfTwoLineElementEpoch(
+                        twoLineElementData[ i ].fourDigitEpochYear,
+                        twoLineElementData[ i ].epochDay ) );
+    }
+
+    // Propagate all objects to epoch.
+    return basic_astrodynamics::orbital_element_conversions::
+            propagateKeplerOrbitsToCartesianStates(
+                keplerianElements, propagationTimes,
+                earthWithWorldGeodeticSystem72GravitationalParameter, numberOfThreads );
+}
+
+} // namespace input_output
+} // namespace tudat
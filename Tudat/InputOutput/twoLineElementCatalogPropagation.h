@@ -0,0 +1,77 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      Celestrak (c). NORAD Two-Line Element Set Format,
+ *          http://celestrak.com/NORAD/documentation/tle-fmt.asp, 2004. Last accessed: 5 August,
+ *          2011.
+ *
+ *    Notes
+ *      The TLE data are propagated as unperturbed Kepler orbits about the Earth (see
+ *      batchKeplerPropagator.h), not with the SGP4/SDP4 models for which TLE data are generated.
+ *      The resulting states are suitable for coarse screening of catalogs only.
+ *
+ */
+
+#ifndef TUDAT_TWO_LINE_ELEMENT_CATALOG_PROPAGATION_H
+#define TUDAT_TWO_LINE_ELEMENT_CATALOG_PROPAGATION_H
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/InputOutput/twoLineElementData.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Compute Cartesian states of TLE catalog at a given epoch.
+/*!
+ * Computes the Cartesian states of all objects of a TLE catalog at a given epoch, by propagating
+ * the Keplerian elements and mean anomaly of each object from the epoch of its TLE data with
+ * propagateKeplerOrbitsToCartesianStates( ). The WGS72 gravitational parameter of the Earth,
+ * which is used to compute the semi-major axes of TLE data, is used as the central body
+ * gravitational parameter.
+ * \param twoLineElementData TLE data of the objects, as read by TwoLineElementsTextFileReader.
+ * \param epochInJulianDays Epoch at which states are computed, in Julian days.
+ * \param numberOfThreads Number of threads; if zero, the number of hardware threads is used.
+ * \return Cartesian states of the objects in the TEME frame of the TLE data, one row per object
+ *          (in the order of twoLineElementData), with the columns given by the Cartesian element
+ *          indices (position [m], velocity [m s^-1]).
+ * \throws std::runtime_error If the eccentricity of any object is not in the range [0, 1).
+ */
+Eigen::MatrixXd computeCartesianStatesOfTwoLineElementCatalog(
+        const std::vector< TwoLineElementData >& twoLineElementData,
+        const double epochInJulianDays, const unsigned int numberOfThreads = 0 );
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_TWO_LINE_ELEMENT_CATALOG_PROPAGATION_H
@@ -32,6 +32,7 @@
  *      110810    J. Leloux         Tested new setup and changed descriptions.
  *      110826    J. Leloux         Added functionality for 2-line and 3-line data.
  *      111027    K. Kumar          Modified 2-line and 3-line options using enum.
+ *      261016    agent             Added parallel reading of memory-mapped TLE catalogs.
  *
  *    References
  *      Leloux, J. Filtering Techniques for Orbital Debris Conjunction Analysis
@@ -57,15 +58,24 @@
  *
  */ 
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
 #include <boost/lexical_cast.hpp>
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/exception/all.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/thread.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
@@ -96,15 +106,7 @@ using std::pair;
 //! Open data file.
 void TwoLineElementsTextFileReader::openFile( )
 {
-    if ( absoluteDirectoryPath_.compare( "" ) == 0 )
-    {
-        absoluteFilePath_ = getTudatRootPath( ) + relativeDirectoryPath_ + fileName_;
-    }
-
-    else
-    {
-        absoluteFilePath_ = absoluteDirectoryPath_ + fileName_;
-    }
+    setAbsoluteFilePath( );
 
     // Open data file.
     dataFile_.open( absoluteFilePath_.c_str( ), std::ios::binary );
@@ -762,5 +764,461 @@ multimap< int, string > TwoLineElementsTextFileReader::checkTwoLineElementsFileI
     return corruptedTwoLineElementDataErrors_;
 }
 
+//! Read, convert and check TLE data in parallel.
+multimap< int, string > TwoLineElementsTextFileReader::readAndStoreTwoLineElementDataInParallel(
+        unsigned int numberOfThreads )
+{
+    setAbsoluteFilePath( );
+
+    if ( !boost::filesystem::exists( absoluteFilePath_ ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format( "Data file '%s' could not be opened." )
+                                 % absoluteFilePath_.c_str( ) ) ) )
+            << boost::errinfo_file_name( absoluteFilePath_.c_str( ) ) );
+    }
+
+    // Map file into memory; an empty file cannot be mapped, and contains no objects.
+    boost::interprocess::mapped_region mappedFile;
+    if ( boost::filesystem::file_size( absoluteFilePath_ ) > 0 )
+    {
+        try
+        {
+            boost::interprocess::file_mapping file( absoluteFilePath_.c_str( ),
+                                                    boost::interprocess::read_only );
+            boost::interprocess::mapped_region(
+                        file, boost::interprocess::read_only ).swap( mappedFile );
+        }
+        catch ( boost::interprocess::interprocess_exception& )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                boost::str( boost::format( "Data file '%s' could not be mapped." )
+                                     % absoluteFilePath_.c_str( ) ) ) )
+                << boost::errinfo_file_name( absoluteFilePath_.c_str( ) ) );
+        }
+    }
+
+    // Split file into lines. This is done serially, since records can only be identified from
+    // the start of the file, but only consists of a search for end-of-line characters.
+    const char* fileBegin = static_cast< const char* >( mappedFile.get_address( ) );
+    const char* fileEnd = fileBegin + mappedFile.get_size( );
+
+    vector< FieldRange > dataLines;
+    vector< unsigned int > dataLineNumbers;
+    containerOfDataFromFile_.clear( );
+
+    for ( const char* lineBegin = fileBegin; lineBegin < fileEnd; )
+    {
+        const char* lineEnd = static_cast< const char* >(
+                    std::memchr( lineBegin, '\n', fileEnd - lineBegin ) );
+        const char* nextLineBegin = lineEnd == NULL ? fileEnd : lineEnd + 1;
+        if ( lineEnd == NULL )
+        {
+            lineEnd = fileEnd;
+        }
+
+        // Strip carriage return of Windows line endings.
+        if ( lineEnd != lineBegin && *( lineEnd - 1 ) == '\r' )
+        {
+            --lineEnd;
+        }
+
+        const FieldRange line( lineBegin, lineEnd );
+        if ( lineCounter_ <= numberOfHeaderLines_ )
+        {
+            containerOfHeaderDataFromFile_[ lineCounter_ ] = convertFieldToString( line );
+        }
+
+        else if ( isDataLine( line ) )
+        {
+            dataLines.push_back( line );
+            dataLineNumbers.push_back( lineCounter_ );
+        }
+
+        lineCounter_++;
+        lineBegin = nextLineBegin;
+    }
+
+    if ( dataLines.size( ) % numberOfLinesPerTwoLineElementDatum_ != 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format( "Number of data lines of file '%s' is "
+                                                       "not a multiple of %d." )
+                                        % absoluteFilePath_.c_str( )
+                                        % numberOfLinesPerTwoLineElementDatum_ ) ) )
+            << boost::errinfo_file_name( absoluteFilePath_.c_str( ) ) );
+    }
+
+    const unsigned int numberOfRecords
+            = dataLines.size( ) / numberOfLinesPerTwoLineElementDatum_;
+    twoLineElementData_.clear( );
+    twoLineElementData_.resize( numberOfRecords );
+    vector< unsigned int > integrityErrors( numberOfRecords, 0 );
+
+    // Convert records in contiguous chunks, one per thread.
+    if ( numberOfThreads == 0 )
+    {
+        numberOfThreads = std::max( boost::thread::hardware_concurrency( ), 1u );
+    }
+    numberOfThreads = std::min( numberOfThreads, std::max( numberOfRecords, 1u ) );
+
+    if ( numberOfThreads == 1 )
+    {
+        convertTwoLineElementRecords( dataLines, dataLineNumbers, 0, numberOfRecords,
+                                      integrityErrors );
+    }
+
+    else
+    {
+        boost::thread_group threads;
+        for ( unsigned int i = 0; i < numberOfThreads; i++ )
+        {
+            threads.create_thread(
+                        boost::bind( &TwoLineElementsTextFileReader::convertTwoLineElementRecords,
+                                     this, boost::cref( dataLines ),
+                                     boost::cref( dataLineNumbers ),
+                                     i * numberOfRecords / numberOfThreads,
+                                     ( i + 1 ) * numberOfRecords / numberOfThreads,
+                                     boost::ref( integrityErrors ) ) );
+        }
+        threads.join_all( );
+    }
+
+    // Collect errors, in the same order as checkTwoLineElementsFileIntegrity( ), and remove
+    // corrupted objects.
+    const char* const integrityErrorMessages[ ] =
+    {
+        "Incorrect line-1 leading integer.",
+        "Incorrect line-2 leading integer.",
+        "Invalid TLE classification.",
+        "Incorrect orbital model.",
+        "Incorrect line-1 modulo-10 checksum.",
+        "Incorrect line-2 modulo-10 checksum.",
+        "Line-1 and line-2 object idenfitication number mismatch.",
+        "Incorrect TLE line length.",
+        "Invalid TLE numeric field."
+    };
+    const unsigned int numberOfIntegrityErrorTypes
+            = sizeof( integrityErrorMessages ) / sizeof( integrityErrorMessages[ 0 ] );
+
+    multimap< int, string > corruptedTwoLineElementDataErrors_;
+    unsigned int numberOfValidObjects = 0;
+    for ( unsigned int i = 0; i < numberOfRecords; i++ )
+    {
+        if ( integrityErrors[ i ] == 0 )
+        {
+            if ( numberOfValidObjects != i )
+            {
+                std::swap( twoLineElementData_[ numberOfValidObjects ], twoLineElementData_[ i ] );
+            }
+            numberOfValidObjects++;
+        }
+
+        else
+        {
+            for ( unsigned int j = 0; j < numberOfIntegrityErrorTypes; j++ )
+            {
+                if ( integrityErrors[ i ] & ( 1u << j ) )
+                {
+                    corruptedTwoLineElementDataErrors_.insert(
+                                pair< int, string >( i, integrityErrorMessages[ j ] ) );
+                }
+            }
+        }
+    }
+
+    twoLineElementData_.resize( numberOfValidObjects );
+    numberOfObjects_ = numberOfValidObjects;
+
+    return corruptedTwoLineElementDataErrors_;
+}
+
+//! Set absolute file path.
+void TwoLineElementsTextFileReader::setAbsoluteFilePath( )
+{
+    if ( absoluteDirectoryPath_.compare( "" ) == 0 )
+    {
+        absoluteFilePath_ = getTudatRootPath( ) + relativeDirectoryPath_ + fileName_;
+    }
+
+    else
+    {
+        absoluteFilePath_ = absoluteDirectoryPath_ + fileName_;
+    }
+}
+
+//! Check whether line is a data line.
+bool TwoLineElementsTextFileReader::isDataLine( const FieldRange& line ) const
+{
+    if ( line.empty( ) )
+    {
+        return false;
+    }
+
+    const bool isStartingCharacterAbsent
+            = !startingCharacter_.empty( )
+            && ( line.size( ) < startingCharacter_.size( )
+                 || !std::equal( startingCharacter_.begin( ), startingCharacter_.end( ),
+                                 line.begin( ) ) );
+
+    const bool isSkipKeywordAbsent
+            = !skipKeyword_.empty( )
+            && std::search( line.begin( ), line.end( ), skipKeyword_.begin( ),
+                            skipKeyword_.end( ) ) == line.end( );
+
+    return isStartingCharacterAbsent || isSkipKeywordAbsent
+            || ( startingCharacter_.empty( ) && skipKeyword_.empty( ) );
+}
+
+//! Convert and check range of TLE records.
+void TwoLineElementsTextFileReader::convertTwoLineElementRecords(
+        const vector< FieldRange >& dataLines, const vector< unsigned int >& dataLineNumbers,
+        const unsigned int firstRecord, const unsigned int lastRecord,
+        vector< unsigned int >& integrityErrors )
+{
+    for ( unsigned int i = firstRecord; i < lastRecord; i++ )
+    {
+        const unsigned int firstLine = i * numberOfLinesPerTwoLineElementDatum_;
+        TwoLineElementData& twoLineElementData = twoLineElementData_[ i ];
+
+        twoLineElementData.lineNumbers.assign(
+                    dataLineNumbers.begin( ) + firstLine,
+                    dataLineNumbers.begin( ) + firstLine + numberOfLinesPerTwoLineElementDatum_ );
+
+        // Exceptions cannot be propagated out of the threads, so that fields that cannot be
+        // decoded are reported as integrity error of the object.
+        try
+        {
+            integrityErrors[ i ] = convertTwoLineElementRecord( &dataLines[ firstLine ],
+                                                                twoLineElementData );
+        }
+        catch ( std::runtime_error& )
+        {
+            integrityErrors[ i ] = invalidNumericField;
+        }
+    }
+}
+
+//! Convert and check single TLE record.
+unsigned int TwoLineElementsTextFileReader::convertTwoLineElementRecord(
+        const FieldRange* recordLines, TwoLineElementData& twoLineElementData ) const
+{
+    // Reference: Table 2 in (Vallado, D.A., et al., 2006).
+    const double earthWithWorldGeodeticSystem72GravitationalParameter = 398600.8e9;
+
+    const FieldRange& line1 = recordLines[ numberOfLinesPerTwoLineElementDatum_ - 2 ];
+    const FieldRange& line2 = recordLines[ numberOfLinesPerTwoLineElementDatum_ - 1 ];
+
+    // Store TLE strings, with an empty line-0 string for 2-line data.
+    twoLineElementData.twoLineElementStrings.resize( 3 );
+    twoLineElementData.twoLineElementStrings[ 1 ] = convertFieldToString( line1 );
+    twoLineElementData.twoLineElementStrings[ 2 ] = convertFieldToString( line2 );
+
+    // Line-0 variable storing: split name into words.
+    if ( numberOfLinesPerTwoLineElementDatum_ == 3 )
+    {
+        const FieldRange& line0 = recordLines[ 0 ];
+        twoLineElementData.twoLineElementStrings[ 0 ] = convertFieldToString( line0 );
+        twoLineElementData.objectNameString = twoLineElementData.twoLineElementStrings[ 0 ];
+
+        for ( const char* namePartBegin = line0.begin( ); namePartBegin != line0.end( ); )
+        {
+            if ( isWhitespaceCharacter( *namePartBegin ) )
+            {
+                ++namePartBegin;
+                continue;
+            }
+
+            const char* namePartEnd = namePartBegin;
+            while ( namePartEnd != line0.end( ) && !isWhitespaceCharacter( *namePartEnd ) )
+            {
+                ++namePartEnd;
+            }
+
+            twoLineElementData.objectName.push_back( string( namePartBegin, namePartEnd ) );
+            namePartBegin = namePartEnd;
+        }
+    }
+
+    // The fixed columns of all fields, including the checksums, must be present.
+    if ( line1.size( ) < 69 || line2.size( ) < 69 )
+    {
+        return incorrectLineLength;
+    }
+
+    // Line-1 variable storing, see reference for the columns of each variable.
+    twoLineElementData.lineNumberLine1
+            = convertFieldToInteger( getFieldAtColumns( line1, 0, 1 ) );
+    twoLineElementData.objectIdentificationNumber
+            = convertFieldToInteger( getFieldAtColumns( line1, 2, 5 ) );
+    twoLineElementData.tleClassification = line1[ 7 ];
+    twoLineElementData.launchYear = convertFieldToInteger( getFieldAtColumns( line1, 9, 2 ) );
+    twoLineElementData.fourDigitlaunchYear = twoLineElementData.launchYear
+            + ( twoLineElementData.launchYear > 56 ? 1900 : 2000 );
+    twoLineElementData.launchNumber
+            = convertFieldToInteger( getFieldAtColumns( line1, 11, 3 ) );
+    twoLineElementData.launchPart = convertFieldToString( getFieldAtColumns( line1, 14, 3 ) );
+    twoLineElementData.epochYear = convertFieldToInteger( getFieldAtColumns( line1, 18, 2 ) );
+    twoLineElementData.fourDigitEpochYear = twoLineElementData.epochYear
+            + ( twoLineElementData.epochYear > 56 ? 1900 : 2000 );
+    twoLineElementData.epochDay = convertFieldToDouble( getFieldAtColumns( line1, 20, 12 ) );
+    twoLineElementData.firstDerivativeOfMeanMotionDividedByTwo
+            = convertFieldToDouble( getFieldAtColumns( line1, 33, 10 ) );
+
+    // Apply implied leading decimal points of coefficients of scientific notation.
+    twoLineElementData.coefficientOfSecondDerivativeOfMeanMotionDividedBySix
+            = convertFieldToDouble( getFieldAtColumns( line1, 44, 6 ) ) / 100000.0;
+    twoLineElementData.exponentOfSecondDerivativeOfMeanMotionDividedBySix
+            = convertFieldToInteger( getFieldAtColumns( line1, 50, 2 ) );
+    twoLineElementData.secondDerivativeOfMeanMotionDividedBySix
+            = twoLineElementData.coefficientOfSecondDerivativeOfMeanMotionDividedBySix
+            * pow( 10, twoLineElementData.exponentOfSecondDerivativeOfMeanMotionDividedBySix );
+    twoLineElementData.coefficientOfBStar
+            = convertFieldToDouble( getFieldAtColumns( line1, 53, 6 ) ) / 100000.0;
+    twoLineElementData.exponentOfBStar
+            = convertFieldToInteger( getFieldAtColumns( line1, 59, 2 ) );
+    twoLineElementData.bStar = twoLineElementData.coefficientOfBStar
+            * pow( 10.0, twoLineElementData.exponentOfBStar );
+
+    twoLineElementData.orbitalModel = convertFieldToInteger( getFieldAtColumns( line1, 62, 1 ) );
+    twoLineElementData.tleNumber = convertFieldToInteger( getFieldAtColumns( line1, 64, 4 ) );
+    twoLineElementData.modulo10CheckSumLine1
+            = convertFieldToInteger( getFieldAtColumns( line1, 68, 1 ) );
+
+    // Line-2 variable storing, see reference for the columns of each variable.
+    twoLineElementData.lineNumberLine2
+            = convertFieldToInteger( getFieldAtColumns( line2, 0, 1 ) );
+    twoLineElementData.objectIdentificationNumberLine2
+            = convertFieldToInteger( getFieldAtColumns( line2, 2, 5 ) );
+    twoLineElementData.TLEKeplerianElements( basic_astrodynamics::inclinationIndex )
+            = convertFieldToDouble( getFieldAtColumns( line2, 8, 8 ) );
+    twoLineElementData.TLEKeplerianElements(
+                basic_astrodynamics::longitudeOfAscendingNodeIndex )
+            = convertFieldToDouble( getFieldAtColumns( line2, 17, 8 ) );
+    twoLineElementData.TLEKeplerianElements( basic_astrodynamics::eccentricityIndex )
+            = convertFieldToDouble( getFieldAtColumns( line2, 26, 7 ) ) / 10000000;
+    twoLineElementData.TLEKeplerianElements( basic_astrodynamics::argumentOfPeriapsisIndex )
+            = convertFieldToDouble( getFieldAtColumns( line2, 34, 8 ) );
+    twoLineElementData.meanAnomaly = convertFieldToDouble( getFieldAtColumns( line2, 43, 8 ) );
+    twoLineElementData.meanMotionInRevolutionsPerDay
+            = convertFieldToDouble( getFieldAtColumns( line2, 52, 11 ) );
+    twoLineElementData.revolutionNumber
+            = convertFieldToInteger( getFieldAtColumns( line2, 63, 5 ) );
+    twoLineElementData.modulo10CheckSumLine2
+            = convertFieldToInteger( getFieldAtColumns( line2, 68, 1 ) );
+
+    // Calculate the approximate total number of revolutions, as the counter resets to 0 after
+    // passing by 99999, in the same way as storeTwoLineElementData( ).
+    const int approximateNumberOfRevolutions
+            = twoLineElementData.meanMotionInRevolutionsPerDay
+            * ( currentYear_ - twoLineElementData.fourDigitlaunchYear )
+            * tudat::physical_constants::JULIAN_YEAR_IN_DAYS;
+    const int approximateNumberOfRevolutionsRemainder = approximateNumberOfRevolutions % 100000;
+    const int lostNumberOfRevolutions
+            = approximateNumberOfRevolutions - approximateNumberOfRevolutionsRemainder;
+
+    if ( ( twoLineElementData.revolutionNumber - approximateNumberOfRevolutionsRemainder )
+         <= ( approximateNumberOfRevolutionsRemainder + 100000
+              - twoLineElementData.revolutionNumber ) )
+    {
+        twoLineElementData.totalRevolutionNumber
+                = lostNumberOfRevolutions + twoLineElementData.revolutionNumber;
+    }
+
+    else
+    {
+        twoLineElementData.totalRevolutionNumber
+                = lostNumberOfRevolutions - 100000 + twoLineElementData.revolutionNumber;
+    }
+
+    if ( twoLineElementData.totalRevolutionNumber < 0 )
+    {
+        twoLineElementData.totalRevolutionNumber = twoLineElementData.revolutionNumber;
+    }
+
+    // Calculate semi-major axis, perigee and apogee from the other TLE variables.
+    const double meanMotion = twoLineElementData.meanMotionInRevolutionsPerDay
+            * 2.0 * PI / tudat::physical_constants::JULIAN_DAY;
+    const double semiMajorAxis
+            = orbital_element_conversions::convertEllipticalMeanMotionToSemiMajorAxis(
+                meanMotion, earthWithWorldGeodeticSystem72GravitationalParameter );
+    const double eccentricity = twoLineElementData.TLEKeplerianElements(
+                basic_astrodynamics::eccentricityIndex );
+    twoLineElementData.TLEKeplerianElements( basic_astrodynamics::semiMajorAxisIndex )
+            = semiMajorAxis;
+    twoLineElementData.perigee = semiMajorAxis * ( 1.0 - eccentricity );
+    twoLineElementData.apogee = semiMajorAxis * ( 1.0 + eccentricity );
+
+    // Integrity checks, as performed by checkTwoLineElementsFileIntegrity( ).
+    unsigned int integrityErrors = 0;
+
+    if ( twoLineElementData.lineNumberLine1 != 1 )
+    {
+        integrityErrors |= incorrectLineNumberLine1;
+    }
+
+    if ( twoLineElementData.lineNumberLine2 != 2 )
+    {
+        integrityErrors |= incorrectLineNumberLine2;
+    }
+
+    if ( twoLineElementData.tleClassification != 'U'
+         && twoLineElementData.tleClassification != 'C' )
+    {
+        integrityErrors |= invalidClassification;
+    }
+
+    if ( twoLineElementData.orbitalModel != 0 )
+    {
+        integrityErrors |= incorrectOrbitalModel;
+    }
+
+    // Modulo-10 checksums: add all digits of the first 68 characters, with minus signs counting
+    // as 1; the classification and launch part columns of line 1 are not counted.
+    unsigned int line1Modulo10Sum = 0;
+    unsigned int line2Modulo10Sum = 0;
+    for ( unsigned int j = 0; j < 68; j++ )
+    {
+        if ( line1[ j ] >= '0' && line1[ j ] <= '9' && j != 7 && j != 14 && j != 15 && j != 16 )
+        {
+            line1Modulo10Sum += line1[ j ] - '0';
+        }
+
+        else if ( line1[ j ] == '-' )
+        {
+            line1Modulo10Sum++;
+        }
+
+        if ( line2[ j ] >= '0' && line2[ j ] <= '9' )
+        {
+            line2Modulo10Sum += line2[ j ] - '0';
+        }
+    }
+
+    if ( line1Modulo10Sum % 10 != twoLineElementData.modulo10CheckSumLine1 )
+    {
+        integrityErrors |= incorrectChecksumLine1;
+    }
+
+    if ( line2Modulo10Sum % 10 != twoLineElementData.modulo10CheckSumLine2 )
+    {
+        integrityErrors |= incorrectChecksumLine2;
+    }
+
+    if ( twoLineElementData.objectIdentificationNumber
+         != twoLineElementData.objectIdentificationNumberLine2 )
+    {
+        integrityErrors |= objectIdentificationNumberMismatch;
+    }
+
+    return integrityErrors;
+}
+
 } // namespace input_output
 } // namespace tudat
@@ -34,6 +34,7 @@
  *      111027    K. Kumar          Modified 2-line and 3-line options using enum.
  *      130121    K. Kumar          Added shared-ptr typedef.
  *      131221    K. Kumar          Fixed Doxygen comments.
+ *      261016    agent             Added parallel reading of memory-mapped TLE catalogs.
  *
  *    References
  *      Leloux, J. Filtering Techniques for Orbital Debris Conjunction Analysis
@@ -67,6 +68,7 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include "Tudat/InputOutput/fieldRange.h"
 #include "Tudat/InputOutput/twoLineElementData.h"
 
 namespace tudat
@@ -272,6 +274,30 @@ public:
      */
     std::multimap< int, std::string > checkTwoLineElementsFileIntegrity( );
 
+    //! Read, convert and check TLE data in parallel.
+    /*!
+     * Reads the TLE catalog file in a single pass, replacing the sequence of openFile( ),
+     * readAndStoreData( ), closeFile( ), storeTwoLineElementData( ) and
+     * checkTwoLineElementsFileIntegrity( ) for large catalogs. The file is memory-mapped and
+     * split into its lines, after which the TLE records are converted in parallel in contiguous
+     * chunks, decoding the numeric fields directly from their fixed columns. The integrity checks
+     * of checkTwoLineElementsFileIntegrity( ) are performed during conversion, and the corrupted
+     * objects are removed from the TLE data. Records with lines shorter than 69 characters or
+     * with fields that cannot be decoded are reported as corrupted as well.
+     *
+     * Header lines, empty lines and the line-skipping settings are handled as by
+     * readAndStoreData( ). The map container of data from file is not filled, since the lines
+     * are not copied.
+     * \param numberOfThreads Number of threads used to convert the TLE records; if zero, the
+     *          number of hardware threads is used.
+     * \return Multimap of corrupted TLE errors, with the index of the object in the catalog as
+     *          key.
+     * \throws std::runtime_error If the file does not exist or cannot be mapped, or if the number
+     *          of data lines is not a multiple of the number of lines per TLE datum.
+     */
+    std::multimap< int, std::string > readAndStoreTwoLineElementDataInParallel(
+            unsigned int numberOfThreads = 0 );
+
     //! Set line number type for TLE input data.
     /*!
      * Sets the line number type for TLE input data. This can be either 2-line or 3-line.
@@ -334,6 +360,69 @@ protected:
 
 private:
 
+    //! Flags of integrity errors of TLE data.
+    /*!
+     * Flags of integrity errors of TLE data, combined bitwise per object during conversion by
+     * readAndStoreTwoLineElementDataInParallel( ).
+     */
+    enum TwoLineElementIntegrityErrorFlags
+    {
+        incorrectLineNumberLine1 = 1,
+        incorrectLineNumberLine2 = 2,
+        invalidClassification = 4,
+        incorrectOrbitalModel = 8,
+        incorrectChecksumLine1 = 16,
+        incorrectChecksumLine2 = 32,
+        objectIdentificationNumberMismatch = 64,
+        incorrectLineLength = 128,
+        invalidNumericField = 256
+    };
+
+    //! Set absolute file path.
+    /*!
+     * Sets absolute path to data file from the absolute or relative directory path and the file
+     * name.
+     */
+    void setAbsoluteFilePath( );
+
+    //! Check whether line is a data line.
+    /*!
+     * Checks whether a non-header line is a data line, given the starting character and skip
+     * keyword settings, in the same way as readAndStoreData( ).
+     * \param line Range of characters of line, without end-of-line characters.
+     * \return True if the line is a data line, false if it is skipped.
+     */
+    bool isDataLine( const FieldRange& line ) const;
+
+    //! Convert and check range of TLE records.
+    /*!
+     * Converts and checks a contiguous range of TLE records, storing the TLE data in the
+     * (pre-allocated) vector of TwoLineElementData objects. Executed by each of the threads of
+     * readAndStoreTwoLineElementDataInParallel( ).
+     * \param dataLines Ranges of characters of data lines.
+     * \param dataLineNumbers Line numbers of data lines in file.
+     * \param firstRecord Index of first TLE record to convert.
+     * \param lastRecord Index past last TLE record to convert.
+     * \param integrityErrors Integrity error flags per TLE record (returned by reference).
+     */
+    void convertTwoLineElementRecords( const std::vector< FieldRange >& dataLines,
+                                       const std::vector< unsigned int >& dataLineNumbers,
+                                       const unsigned int firstRecord,
+                                       const unsigned int lastRecord,
+                                       std::vector< unsigned int >& integrityErrors );
+
+    //! Convert and check single TLE record.
+    /*!
+     * Converts the lines of a TLE record to TLE data, decoding the fields at their fixed columns,
+     * and performs the checks of checkTwoLineElementsFileIntegrity( ).
+     * \param recordLines Ranges of characters of lines of TLE record (2 or 3).
+     * \param twoLineElementData TLE data of record (returned by reference).
+     * \return Integrity error flags of TLE record, zero if record is not corrupted.
+     * \throws std::runtime_error If a numeric field cannot be decoded.
+     */
+    unsigned int convertTwoLineElementRecord( const FieldRange* recordLines,
+                                              TwoLineElementData& twoLineElementData ) const;
+
     //! Current year.
     unsigned int currentYear_;
 
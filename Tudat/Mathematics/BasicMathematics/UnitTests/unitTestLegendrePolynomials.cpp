@@ -25,6 +25,8 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      261016    agent             Added tests of geodesy-normalized Legendre table.
+ *      261016    agent             Added tests of thread-local Legendre cache.
  *
  *    References
  *      Mathworks. Legendre - Associated Legendre functions. Help documentation of MATLAB R2012a,
@@ -44,6 +46,8 @@
 
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 #include <Eigen/Core>
 
@@ -278,6 +282,214 @@ BOOST_AUTO_TEST_CASE( test_Legendre_GeodesyLegendrePolynomialDerivative )
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedValues, computedTestValues, 1.0e-14 );
 }
 
+BOOST_AUTO_TEST_CASE( test_GeodesyLegendreTable )
+{
+    // Define degree and order vectors.
+    const Vector10i degree = ( Eigen::VectorXi( 10 ) << 0, 1, 1, 2, 2, 2, 3, 3, 3, 3 ).finished( );
+    const Vector10i order = ( Eigen::VectorXi( 10 ) << 0, 0, 1, 0, 1, 2, 0, 1, 2, 3 ).finished( );
+
+    // Create and update Legendre table.
+    basic_mathematics::GeodesyLegendreTable legendreTable( 3 );
+    legendreTable.update( 0.5 );
+
+    // Get test values of Legendre polynomials and derivatives from table.
+    Vector10d computedPolynomials;
+    Vector10d computedDerivatives;
+    for ( int index = 0; index < degree.size( ); index++ )
+    {
+        computedPolynomials( index )
+                = legendreTable.getLegendrePolynomial( degree( index ), order( index ) );
+        computedDerivatives( index )
+                = legendreTable.getLegendrePolynomialDerivative( degree( index ), order( index ) );
+    }
+
+    // Set expected values, as given in the tests of the geodesy-normalized Legendre polynomials
+    // and derivatives above.
+    const Vector10d expectedPolynomials = ( Eigen::VectorXd( 10 ) <<
+                                            1.0,
+                                            8.660254037844386e-1,
+                                            1.500000000000000,
+                                            -2.795084971874738e-1,
+                                            1.677050983124842,
+                                            1.452368754827781,
+                                            -1.157516198590759,
+                                            3.507803800100574e-1,
+                                            1.921303268617425,
+                                            1.358566569955260
+                                            ).finished( );
+    const Vector10d expectedDerivatives = ( Eigen::VectorXd( 10 ) <<
+                                            0.0,
+                                            1.732050807568877,
+                                            -1.000000000000000,
+                                            3.354101966249685,
+                                            2.236067977499790,
+                                            -1.936491673103709,
+                                            9.921567416492215e-1,
+                                            6.781754013527770,
+                                            1.280868845744950,
+                                            -2.717133139910520
+                                            ).finished( );
+
+    // Check if test values match expected values.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedPolynomials, computedPolynomials, 1.0e-14 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedDerivatives, computedDerivatives, 1.0e-14 );
+}
+
+BOOST_AUTO_TEST_CASE( test_GeodesyLegendreTableHighDegree )
+{
+    // Set maximum degree and polynomial parameter.
+    const int maximumDegree = 70;
+    const double polynomialParameter = -0.3;
+
+    // Create and update Legendre table.
+    basic_mathematics::GeodesyLegendreTable legendreTable( maximumDegree );
+    legendreTable.update( polynomialParameter );
+    BOOST_CHECK_EQUAL( legendreTable.getMaximumDegree( ), maximumDegree );
+
+    // Check that table matches cached recursive computation for all degrees and orders.
+    for ( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            const double expectedPolynomial = basic_mathematics::computeGeodesyLegendrePolynomial(
+                        degree, order, polynomialParameter );
+            const double expectedDerivative
+                    = basic_mathematics::computeGeodesyLegendrePolynomialDerivative(
+                        degree, order, polynomialParameter, expectedPolynomial,
+                        basic_mathematics::computeGeodesyLegendrePolynomial(
+                            degree, order + 1, polynomialParameter ) );
+
+            BOOST_CHECK_SMALL( legendreTable.getLegendrePolynomial( degree, order )
+                               - expectedPolynomial, 1.0e-12 );
+            BOOST_CHECK_SMALL( legendreTable.getLegendrePolynomialDerivative( degree, order )
+                               - expectedDerivative, 1.0e-10 );
+        }
+    }
+
+    // Check that table is recomputed after change of maximum degree.
+    legendreTable.setMaximumDegree( 5 );
+    legendreTable.update( polynomialParameter );
+    BOOST_CHECK_SMALL( legendreTable.getLegendrePolynomial( 5, 3 )
+                       - basic_mathematics::computeGeodesyLegendrePolynomial(
+                           5, 3, polynomialParameter ), 1.0e-14 );
+
+    // Check that negative maximum degree is rejected.
+    BOOST_CHECK_THROW( legendreTable.setMaximumDegree( -1 ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( test_LegendreCache )
+{
+    using basic_mathematics::LegendreCache;
+    using basic_mathematics::computeLegendrePolynomial;
+
+    // Create cache holding all polynomials up to degree 3.
+    LegendreCache legendreCache( 10 );
+    BOOST_CHECK_EQUAL( legendreCache.getMaximumNumberOfEntries( ), 10 );
+
+    // Check that first request is computed, and second request is retrieved from cache.
+    const double expectedPolynomial = computeLegendrePolynomial( 3, 2, 0.3 );
+    BOOST_CHECK_EQUAL( legendreCache.getOrElseUpdate( 3, 2, 0.3, &computeLegendrePolynomial ),
+                       expectedPolynomial );
+    BOOST_CHECK_EQUAL( legendreCache.getOrElseUpdate( 3, 2, 0.3, &computeLegendrePolynomial ),
+                       expectedPolynomial );
+    BOOST_CHECK_EQUAL( legendreCache.getNumberOfMisses( ), 1 );
+    BOOST_CHECK_EQUAL( legendreCache.getNumberOfHits( ), 1 );
+
+    // Check that request for different polynomial parameter evicts cached polynomial.
+    legendreCache.getOrElseUpdate( 3, 2, 0.4, &computeLegendrePolynomial );
+    BOOST_CHECK_EQUAL( legendreCache.getOrElseUpdate( 3, 2, 0.3, &computeLegendrePolynomial ),
+                       expectedPolynomial );
+    BOOST_CHECK_EQUAL( legendreCache.getNumberOfMisses( ), 3 );
+
+    // Check that polynomials that do not fit in the cache, and polynomials with order greater
+    // than degree, are computed but not cached.
+    legendreCache.resetStatistics( );
+    BOOST_CHECK_EQUAL( legendreCache.getOrElseUpdate( 4, 0, 0.3, &computeLegendrePolynomial ),
+                       computeLegendrePolynomial( 4, 0, 0.3 ) );
+    legendreCache.getOrElseUpdate( 4, 0, 0.3, &computeLegendrePolynomial );
+    BOOST_CHECK_EQUAL( legendreCache.getOrElseUpdate( 1, 2, 0.3, &computeLegendrePolynomial ),
+                       0.0 );
+    BOOST_CHECK_EQUAL( legendreCache.getNumberOfMisses( ), 3 );
+    BOOST_CHECK_EQUAL( legendreCache.getNumberOfHits( ), 0 );
+
+    // Check that clearing the cache evicts cached polynomials.
+    legendreCache.resetStatistics( );
+    legendreCache.getOrElseUpdate( 3, 2, 0.3, &computeLegendrePolynomial );
+    legendreCache.clear( );
+    legendreCache.getOrElseUpdate( 3, 2, 0.3, &computeLegendrePolynomial );
+    BOOST_CHECK_EQUAL( legendreCache.getNumberOfHits( ), 1 );
+    BOOST_CHECK_EQUAL( legendreCache.getNumberOfMisses( ), 1 );
+
+    // Check that budget can be changed at runtime.
+    legendreCache.resetStatistics( );
+    legendreCache.setMaximumNumberOfEntries( 15 );
+    legendreCache.getOrElseUpdate( 4, 0, 0.3, &computeLegendrePolynomial );
+    legendreCache.getOrElseUpdate( 4, 0, 0.3, &computeLegendrePolynomial );
+    BOOST_CHECK_EQUAL( legendreCache.getNumberOfHits( ), 1 );
+    BOOST_CHECK_THROW( legendreCache.setMaximumNumberOfEntries( -1 ), std::runtime_error );
+}
+
+//! Compute geodesy-normalized Legendre polynomials up to given degree and order.
+void computeGeodesyLegendrePolynomials( const double polynomialParameter,
+                                        const int maximumDegree,
+                                        Eigen::MatrixXd& legendrePolynomials )
+{
+    legendrePolynomials.setZero( maximumDegree + 1, maximumDegree + 1 );
+    for ( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            legendrePolynomials( degree, order ) = basic_mathematics::
+                    computeGeodesyLegendrePolynomial( degree, order, polynomialParameter );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_LegendreCacheMultipleThreads )
+{
+    using basic_mathematics::getGeodesyLegendreCache;
+
+    // Set polynomial parameters and maximum degree.
+    const int numberOfThreads = 4;
+    const double polynomialParameters[ numberOfThreads ] = { -0.7, -0.1, 0.25, 0.9 };
+    const int maximumDegree = 40;
+
+    // Compute expected Legendre polynomials in main thread, and check that the recursion is
+    // served from the thread-local cache.
+    getGeodesyLegendreCache( ).resetStatistics( );
+    std::vector< Eigen::MatrixXd > expectedPolynomials( numberOfThreads );
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        computeGeodesyLegendrePolynomials( polynomialParameters[ i ], maximumDegree,
+                                           expectedPolynomials[ i ] );
+    }
+    BOOST_CHECK_GT( getGeodesyLegendreCache( ).getNumberOfHits( ), 0 );
+    const unsigned long numberOfHitsInMainThread = getGeodesyLegendreCache( ).getNumberOfHits( );
+
+    // Compute Legendre polynomials concurrently, repeatedly.
+    std::vector< Eigen::MatrixXd > computedPolynomials( numberOfThreads );
+    for ( int repetition = 0; repetition < 10; repetition++ )
+    {
+        boost::thread_group threads;
+        for ( int i = 0; i < numberOfThreads; i++ )
+        {
+            threads.create_thread( boost::bind( &computeGeodesyLegendrePolynomials,
+                                                polynomialParameters[ i ], maximumDegree,
+                                                boost::ref( computedPolynomials[ i ] ) ) );
+        }
+        threads.join_all( );
+
+        // Check that results match results of main thread.
+        for ( int i = 0; i < numberOfThreads; i++ )
+        {
+            BOOST_CHECK( computedPolynomials[ i ] == expectedPolynomials[ i ] );
+        }
+    }
+
+    // Check that the cache of the main thread was not used by the other threads.
+    BOOST_CHECK_EQUAL( getGeodesyLegendreCache( ).getNumberOfHits( ), numberOfHitsInMainThread );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
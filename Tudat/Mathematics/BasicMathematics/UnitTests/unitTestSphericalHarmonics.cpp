@@ -25,6 +25,7 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      261016    agent             Added test of spherical harmonics cache.
  *
  *    References
  *
@@ -34,6 +35,8 @@
 
 #define BOOST_TEST_MAIN
 
+#include <cmath>
+
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -199,6 +202,53 @@ BOOST_AUTO_TEST_CASE( test_SphericalHarmonics_PotentialGradient )
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( testPotentialGradient, expectedValues, 1.0e-15 );
 }
 
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonics_Cache )
+{
+    // Define maximum degree and order, and point at which cache is updated.
+    const int maximumDegree = 50;
+    const int maximumOrder = 40;
+    const double radius = 7.2e6;
+    const double polynomialParameter = 0.4;
+    const double longitude = -2.3;
+    const double referenceRadius = 6378137.0;
+
+    // Create and update spherical harmonics cache.
+    basic_mathematics::SphericalHarmonicsCache sphericalHarmonicsCache(
+                maximumDegree, maximumOrder );
+    sphericalHarmonicsCache.update( radius, polynomialParameter, longitude, referenceRadius );
+
+    BOOST_CHECK_EQUAL( sphericalHarmonicsCache.getMaximumDegree( ), maximumDegree );
+    BOOST_CHECK_EQUAL( sphericalHarmonicsCache.getMaximumOrder( ), maximumOrder );
+
+    // Check radius ratio powers computed through recurrence.
+    for ( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    sphericalHarmonicsCache.getRadiusRatioPowers( )( degree ),
+                    std::pow( referenceRadius / radius, static_cast< double >( degree ) + 1.0 ),
+                    1.0e-13 );
+    }
+
+    // Check sines and cosines of multiples of longitude computed through recurrence.
+    for ( int order = 0; order <= maximumOrder; order++ )
+    {
+        BOOST_CHECK_SMALL( sphericalHarmonicsCache.getCosinesOfMultipleLongitude( )( order )
+                           - std::cos( static_cast< double >( order ) * longitude ), 1.0e-13 );
+        BOOST_CHECK_SMALL( sphericalHarmonicsCache.getSinesOfMultipleLongitude( )( order )
+                           - std::sin( static_cast< double >( order ) * longitude ), 1.0e-13 );
+    }
+
+    // Check Legendre table.
+    BOOST_CHECK_EQUAL( sphericalHarmonicsCache.getLegendreTable( ).getMaximumDegree( ),
+                       maximumDegree );
+    BOOST_CHECK_EQUAL( sphericalHarmonicsCache.getLegendreTable( ).getPolynomialParameter( ),
+                       polynomialParameter );
+
+    // Check that negative maximum degree and order are rejected.
+    BOOST_CHECK_THROW( sphericalHarmonicsCache.setMaximumDegreeAndOrder( -1, 0 ),
+                       std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -27,6 +27,10 @@
  *      120926    E. Dekens         File created.
  *      121218    S. Billemont      Added output fuctions to display Legendre polynomial data,
  *                                  for debugging.
+ *      261016    agent             Added dense, triangular table of geodesy-normalized Legendre
+ *                                  polynomials and derivatives.
+ *      261016    agent             Replaced hashmap-based back-end cache by thread-local,
+ *                                  preallocated cache with runtime budget and hit/miss counters.
  *
  *    References
  *
@@ -34,10 +38,15 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 
 #include <boost/exception/all.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/tss.hpp>
 
 #include "Tudat/Mathematics/BasicMathematics/legendrePolynomials.h"
 
@@ -46,7 +55,7 @@ namespace tudat
 namespace basic_mathematics
 {
 
-// Define maximum size of Legendre polynomials back-end cache.
+// Define default maximum size of Legendre polynomials back-end cache.
 #ifndef MAXIMUM_CACHE_ENTRIES
 #define MAXIMUM_CACHE_ENTRIES 12000
 #endif
@@ -87,11 +96,11 @@ double computeLegendrePolynomial( const int degree,
     else if ( degree == order )
     {
         // Obtain polynomial of degree one and order one.
-        const double degreeOneOrderOnePolynomial = legendreCache.getOrElseUpdate(
+        const double degreeOneOrderOnePolynomial = getLegendreCache( ).getOrElseUpdate(
                     1, 1, polynomialParameter, &computeLegendrePolynomial );
 
         // Obtain prior sectoral polynomial.
-        const double priorSectoralPolynomial = legendreCache.getOrElseUpdate(
+        const double priorSectoralPolynomial = getLegendreCache( ).getOrElseUpdate(
                     degree - 1, order - 1, polynomialParameter, &computeLegendrePolynomial );
 
         // Compute polynomial.
@@ -103,11 +112,11 @@ double computeLegendrePolynomial( const int degree,
     else
     {
         // Obtain prior degree polynomial.
-        const double oneDegreePriorPolynomial = legendreCache.getOrElseUpdate(
+        const double oneDegreePriorPolynomial = getLegendreCache( ).getOrElseUpdate(
                     degree - 1, order, polynomialParameter, &computeLegendrePolynomial );
 
         // Obtain two degrees prior polynomial.
-        const double twoDegreesPriorPolynomial = legendreCache.getOrElseUpdate(
+        const double twoDegreesPriorPolynomial = getLegendreCache( ).getOrElseUpdate(
                     degree - 2, order, polynomialParameter, &computeLegendrePolynomial );
 
         // Compute polynomial.
@@ -155,11 +164,11 @@ double computeGeodesyLegendrePolynomial( const int degree,
     else if ( degree == order )
     {
         // Obtain polynomial of degree one and order one.
-        double degreeOneOrderOnePolynomial = geodesyLegendreCache.getOrElseUpdate(
+        double degreeOneOrderOnePolynomial = getGeodesyLegendreCache( ).getOrElseUpdate(
                     1, 1, polynomialParameter, &computeGeodesyLegendrePolynomial );
 
         // Obtain prior sectoral polynomial.
-        double priorSectoralPolynomial = geodesyLegendreCache.getOrElseUpdate(
+        double priorSectoralPolynomial = getGeodesyLegendreCache( ).getOrElseUpdate(
                     degree - 1, order - 1, polynomialParameter, &computeGeodesyLegendrePolynomial );
 
         // Compute polynomial.
@@ -171,11 +180,11 @@ double computeGeodesyLegendrePolynomial( const int degree,
     else
     {
         // Obtain prior degree polynomial.
-        double oneDegreePriorPolynomial = geodesyLegendreCache.getOrElseUpdate(
+        double oneDegreePriorPolynomial = getGeodesyLegendreCache( ).getOrElseUpdate(
                     degree - 1, order, polynomialParameter, &computeGeodesyLegendrePolynomial );
 
         // Obtain two degrees prior polynomial.
-        double twoDegreesPriorPolynomial = geodesyLegendreCache.getOrElseUpdate(
+        double twoDegreesPriorPolynomial = getGeodesyLegendreCache( ).getOrElseUpdate(
                     degree - 2, order, polynomialParameter, &computeGeodesyLegendrePolynomial );
 
         // Compute polynomial.
@@ -355,6 +364,184 @@ double computeGeodesyLegendrePolynomialVertical( const int degree,
                 * twoDegreesPriorPolynomial );
 }
 
+//! Constructor taking the maximum degree.
+GeodesyLegendreTable::GeodesyLegendreTable( const int aMaximumDegree )
+    : maximumDegree( -1 ),
+      polynomialParameter( 0.0 ),
+      isTableUpdated( false )
+{
+    setMaximumDegree( aMaximumDegree );
+}
+
+//! Set maximum degree.
+void GeodesyLegendreTable::setMaximumDegree( const int aMaximumDegree )
+{
+    // If maximum degree is negative...
+    if ( aMaximumDegree < 0 )
+    {
+        // Set error message.
+        std::stringstream errorMessage;
+        errorMessage << "Error: the maximum degree of a Legendre table (" << aMaximumDegree
+                     << ") cannot be negative." << std::endl;
+
+        // Throw a run-time error.
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+               errorMessage.str( ) ) ) );
+    }
+
+    // Do nothing if maximum degree is unchanged.
+    if ( aMaximumDegree == maximumDegree )
+    {
+        return;
+    }
+
+    maximumDegree = aMaximumDegree;
+    isTableUpdated = false;
+
+    // Allocate triangular tables.
+    const int numberOfEntries = getIndex( maximumDegree, maximumDegree ) + 1;
+    legendrePolynomials.assign( numberOfEntries, 0.0 );
+    legendrePolynomialDerivatives.assign( numberOfEntries, 0.0 );
+    oneDegreePriorCoefficients.assign( numberOfEntries, 0.0 );
+    twoDegreesPriorCoefficients.assign( numberOfEntries, 0.0 );
+    derivativeCoefficients.assign( numberOfEntries, 0.0 );
+    sectoralCoefficients.assign( maximumDegree + 1, 0.0 );
+
+    // Precompute recursion coefficients (see computeGeodesyLegendrePolynomialDiagonal( ),
+    // computeGeodesyLegendrePolynomialVertical( ) and
+    // computeGeodesyLegendrePolynomialDerivative( )).
+    for ( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        const double n = static_cast< double >( degree );
+
+        // Sectoral coefficient, multiplying sqrt( 1 - u^2 ) times the prior sectoral polynomial.
+        if ( degree == 1 )
+        {
+            sectoralCoefficients[ degree ] = std::sqrt( 3.0 );
+        }
+
+        else if ( degree > 1 )
+        {
+            sectoralCoefficients[ degree ] = std::sqrt( ( 2.0 * n + 1.0 ) / ( 2.0 * n ) );
+        }
+
+        for ( int order = 0; order <= degree; order++ )
+        {
+            const double m = static_cast< double >( order );
+            const int index = getIndex( degree, order );
+
+            // Degree recursion coefficients; the two-degrees-prior polynomial is zero for
+            // degree = order + 1.
+            if ( order < degree )
+            {
+                oneDegreePriorCoefficients[ index ]
+                        = std::sqrt( ( 2.0 * n + 1.0 ) * ( 2.0 * n - 1.0 )
+                                     / ( ( n + m ) * ( n - m ) ) );
+            }
+
+            if ( order < degree - 1 )
+            {
+                twoDegreesPriorCoefficients[ index ]
+                        = std::sqrt( ( 2.0 * n + 1.0 ) * ( n + m - 1.0 ) * ( n - m - 1.0 )
+                                     / ( ( n + m ) * ( n - m ) * ( 2.0 * n - 3.0 ) ) );
+            }
+
+            // Derivative coefficient of incremented-order polynomial.
+            derivativeCoefficients[ index ] = std::sqrt( ( n + m + 1.0 ) * ( n - m ) );
+            if ( order == 0 )
+            {
+                derivativeCoefficients[ index ] *= std::sqrt( 0.5 );
+            }
+        }
+    }
+}
+
+//! Update table for polynomial parameter.
+void GeodesyLegendreTable::update( const double aPolynomialParameter )
+{
+    // Do nothing if table is up-to-date.
+    if ( isTableUpdated && aPolynomialParameter == polynomialParameter )
+    {
+        return;
+    }
+
+    polynomialParameter = aPolynomialParameter;
+
+    const double u = polynomialParameter;
+    const double oneMinusUSquared = 1.0 - u * u;
+    const double squareRootOfOneMinusUSquared = std::sqrt( oneMinusUSquared );
+
+    // Compute polynomials, order-by-order. The sectoral polynomial of each order follows from
+    // the sectoral polynomial of the previous order, after which the polynomials of higher degree
+    // follow from the degree recursion, which only accesses the preceding two entries.
+    double* priorSectoralPolynomial = &legendrePolynomials[ 0 ];
+    for ( int order = 0; order <= maximumDegree; order++ )
+    {
+        const int orderIndex = getIndex( order, order );
+        double* polynomials = &legendrePolynomials[ orderIndex ];
+
+        // Sectoral polynomial through sectoral recursion.
+        if ( order == 0 )
+        {
+            polynomials[ 0 ] = 1.0;
+        }
+
+        else
+        {
+            polynomials[ 0 ] = sectoralCoefficients[ order ] * squareRootOfOneMinusUSquared
+                    * *priorSectoralPolynomial;
+        }
+
+        priorSectoralPolynomial = polynomials;
+
+        // Polynomial with degree = order + 1, for which the two-degrees-prior polynomial is zero.
+        if ( order < maximumDegree )
+        {
+            polynomials[ 1 ] = oneDegreePriorCoefficients[ orderIndex + 1 ] * u * polynomials[ 0 ];
+        }
+
+        // Tesseral and zonal polynomials through degree recursion.
+        for ( int i = 2; i <= maximumDegree - order; i++ )
+        {
+            polynomials[ i ]
+                    = oneDegreePriorCoefficients[ orderIndex + i ] * u * polynomials[ i - 1 ]
+                    - twoDegreesPriorCoefficients[ orderIndex + i ] * polynomials[ i - 2 ];
+        }
+    }
+
+    // Compute derivatives, using the polynomial with the order incremented by one (zero for
+    // sectoral polynomials), which is stored in the next order.
+    const double inverseSquareRootOfOneMinusUSquared = 1.0 / squareRootOfOneMinusUSquared;
+    const double orderMultiplier = u / oneMinusUSquared;
+    for ( int order = 0; order <= maximumDegree; order++ )
+    {
+        const int orderIndex = getIndex( order, order );
+        const double* polynomials = &legendrePolynomials[ orderIndex ];
+        double* derivatives = &legendrePolynomialDerivatives[ orderIndex ];
+        const double orderTimesOrderMultiplier = static_cast< double >( order ) * orderMultiplier;
+
+        // Sectoral polynomial derivative.
+        derivatives[ 0 ] = - orderTimesOrderMultiplier * polynomials[ 0 ];
+
+        // Tesseral and zonal polynomial derivatives; the polynomial of degree order + i and
+        // order + 1 is located at index i - 1 of the next order.
+        if ( order < maximumDegree )
+        {
+            const double* incrementedOrderPolynomials
+                    = &legendrePolynomials[ getIndex( order + 1, order + 1 ) ];
+            for ( int i = 1; i <= maximumDegree - order; i++ )
+            {
+                derivatives[ i ] = derivativeCoefficients[ orderIndex + i ]
+                        * incrementedOrderPolynomials[ i - 1 ]
+                        * inverseSquareRootOfOneMinusUSquared
+                        - orderTimesOrderMultiplier * polynomials[ i ];
+            }
+        }
+    }
+
+    isTableUpdated = true;
+}
+
 //! Define overloaded 'equals' operator for use with 'Point' structure.
 bool operator==( const Point& polynomialArguments1, const Point& polynomialArguments2 )
 {
@@ -382,42 +569,126 @@ double LegendreCache::getOrElseUpdate(
         const int degree, const int order, const double polynomialParameter,
         const LegendrePolynomialFunction legendrePolynomialFunction )
 {
-    // Initialize structure with polynomial arguments.
-    Point polynomialArguments( degree, order, polynomialParameter );
+    // If the requested polynomial parameter differs from the cached one, evict all entries by
+    // starting a new generation.
+    if ( polynomialParameter != currentPolynomialParameter )
+    {
+        clear( );
+        currentPolynomialParameter = polynomialParameter;
+    }
 
-    // Initialize cache iterator.
-    CacheTable::iterator cachedEntry = backendCache.find( polynomialArguments );
+    // If the requested polynomial has no entry in the table, compute it without caching.
+    const int index = getIndex( degree, order );
+    if ( degree < 0 || order < 0 || order > degree
+         || index >= static_cast< int >( cachedPolynomials.size( ) ) )
+    {
+        numberOfMisses++;
+        return legendrePolynomialFunction( degree, order, polynomialParameter );
+    }
 
-    // If the requested polynomial was not found in cache, compute polynomial.
-    if ( cachedEntry == backendCache.end( ) )
+    // Else if the requested polynomial was found in cache, return polynomial value from cache.
+    else if ( generationsOfCachedPolynomials[ index ] == currentGeneration )
     {
-        double legendrePolynomial = legendrePolynomialFunction( degree, order,
-                                                                polynomialParameter );
-        // If cache is full, remove the oldest element.
-        if ( history.full( ) )
-        {
-            backendCache.erase( backendCache.find( history[ 0 ] ) );
-            history.pop_front( );
-        }
+        numberOfHits++;
+        return cachedPolynomials[ index ];
+    }
 
-        // Insert computed polynomial into cache.
-        backendCache.insert( std::pair< Point, double >( polynomialArguments,
-                                                         legendrePolynomial ) );
-        history.push_back( polynomialArguments );
+    // Else compute polynomial and insert it into cache.
+    else
+    {
+        numberOfMisses++;
+        const double legendrePolynomial = legendrePolynomialFunction( degree, order,
+                                                                      polynomialParameter );
+        cachedPolynomials[ index ] = legendrePolynomial;
+        generationsOfCachedPolynomials[ index ] = currentGeneration;
 
-        // Return polynomial value from computation.
         return legendrePolynomial;
     }
+}
 
-    // Else the requested polynomial was found in cache; return polynomial value from cache entry.
-    else
+//! Initialize LegendreCache instance, with default maximum number of entries.
+LegendreCache::LegendreCache( )
+    : currentGeneration( 0 ),
+      currentPolynomialParameter( std::numeric_limits< double >::quiet_NaN( ) ),
+      numberOfHits( 0 ),
+      numberOfMisses( 0 )
+{
+    setMaximumNumberOfEntries( MAXIMUM_CACHE_ENTRIES );
+}
+
+//! Initialize LegendreCache instance, with given maximum number of entries.
+LegendreCache::LegendreCache( const int maximumNumberOfEntries )
+    : currentGeneration( 0 ),
+      currentPolynomialParameter( std::numeric_limits< double >::quiet_NaN( ) ),
+      numberOfHits( 0 ),
+      numberOfMisses( 0 )
+{
+    setMaximumNumberOfEntries( maximumNumberOfEntries );
+}
+
+//! Set maximum number of entries.
+void LegendreCache::setMaximumNumberOfEntries( const int maximumNumberOfEntries )
+{
+    // Check if maximum number of entries is valid.
+    if ( maximumNumberOfEntries < 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Maximum number of Legendre cache entries must be non-negative." ) ) );
+    }
+
+    cachedPolynomials.assign( maximumNumberOfEntries, 0.0 );
+    generationsOfCachedPolynomials.assign( maximumNumberOfEntries, 0 );
+    clear( );
+}
+
+//! Clear cache.
+void LegendreCache::clear( )
+{
+    // Start a new generation, and invalidate the cached polynomial parameter.
+    currentPolynomialParameter = std::numeric_limits< double >::quiet_NaN( );
+    currentGeneration++;
+
+    // If the generation counter wrapped around, explicitly invalidate all entries.
+    if ( currentGeneration == 0 )
+    {
+        std::fill( generationsOfCachedPolynomials.begin( ),
+                   generationsOfCachedPolynomials.end( ), 0 );
+        currentGeneration = 1;
+    }
+}
+
+//! Reset number of cache hits and misses.
+void LegendreCache::resetStatistics( )
+{
+    numberOfHits = 0;
+    numberOfMisses = 0;
+}
+
+//! Get back-end cache of unnormalized Legendre polynomials of current thread.
+LegendreCache& getLegendreCache( )
+{
+    static boost::thread_specific_ptr< LegendreCache > legendreCache;
+    if ( legendreCache.get( ) == NULL )
     {
-        return cachedEntry->second;
+        legendreCache.reset( new LegendreCache( ) );
     }
+
+    return *legendreCache;
 }
 
-//! Initialize LegendreCache objects.
-LegendreCache::LegendreCache( ) : history( MAXIMUM_CACHE_ENTRIES ) { }
+//! Get back-end cache of geodesy-normalized Legendre polynomials of current thread.
+LegendreCache& getGeodesyLegendreCache( )
+{
+    static boost::thread_specific_ptr< LegendreCache > geodesyLegendreCache;
+    if ( geodesyLegendreCache.get( ) == NULL )
+    {
+        geodesyLegendreCache.reset( new LegendreCache( ) );
+    }
+
+    return *geodesyLegendreCache;
+}
 
 //! Write contents of Legendre polynomial structure to string.
 std::string writeLegendrePolynomialStructureToString( const Point legendrePolynomialStructure )
@@ -431,32 +702,33 @@ std::string writeLegendrePolynomialStructureToString( const Point legendrePolyno
     return buffer.str( );
 }
 
-//! Dump Legendre polynomial cache data to stream (table and history).
+//! Dump Legendre polynomial cache data to stream (table and statistics).
 void dumpLegendrePolynomialCacheData( std::ostream& outputStream,
-                                      boost::unordered_map< Point, double > cacheTable,
-                                      boost::circular_buffer< Point > cacheHistory )
+                                      const LegendreCache& legendreCache )
 {
     outputStream << "Table:\n";
 
-    for ( boost::unordered_map< Point, double >::iterator iteratorCacheTable = cacheTable.begin( );
-          iteratorCacheTable != cacheTable.end( ); iteratorCacheTable++ )
+    // Loop over all degrees and orders that fit in the table, and write the valid entries.
+    for ( int degree = 0; LegendreCache::getIndex( degree, 0 )
+          < legendreCache.getMaximumNumberOfEntries( ); degree++ )
     {
-        outputStream << "\t" << writeLegendrePolynomialStructureToString(
-                            iteratorCacheTable->first ).c_str( ) << " => "
-                     << iteratorCacheTable->second << std::endl;
-    }
-
-    outputStream << "History:\n";
-
-    for ( boost::circular_buffer< Point >::iterator iteratorCacheHistory = cacheHistory.begin( );
-          iteratorCacheHistory != cacheHistory.end( ); iteratorCacheHistory++ )
-    {
-        outputStream << "\t"
-                     << writeLegendrePolynomialStructureToString( *iteratorCacheHistory ).c_str( )
-                     << ", ";
+        for ( int order = 0; order <= degree && LegendreCache::getIndex( degree, order )
+              < legendreCache.getMaximumNumberOfEntries( ); order++ )
+        {
+            const int index = LegendreCache::getIndex( degree, order );
+            if ( legendreCache.generationsOfCachedPolynomials[ index ]
+                 == legendreCache.currentGeneration )
+            {
+                outputStream << "\t" << writeLegendrePolynomialStructureToString(
+                                    Point( degree, order,
+                                           legendreCache.currentPolynomialParameter ) ).c_str( )
+                             << " => " << legendreCache.cachedPolynomials[ index ] << std::endl;
+            }
+        }
     }
 
-    outputStream << std::endl;
+    outputStream << "Hits: " << legendreCache.numberOfHits << ", misses: "
+                 << legendreCache.numberOfMisses << std::endl;
 }
 
 } // namespace basic_mathematics
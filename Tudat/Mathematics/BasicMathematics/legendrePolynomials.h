@@ -28,6 +28,11 @@
  *      121218    S. Billemont      Added output fuctions to display Legendre polynomial data,
  *                                  for debugging.
  *      130121    K. Kumar          Added shared-ptr typedefs.
+ *      261016    agent             Added dense, triangular table of geodesy-normalized Legendre
+ *                                  polynomials and derivatives.
+ *      261016    agent             Changed Legendre table to order-major storage.
+ *      261016    agent             Replaced hashmap-based back-end cache by thread-local,
+ *                                  preallocated cache with runtime budget and hit/miss counters.
  *
  *    References
  *      Eberly, D. Spherical Harmonics. Help documentation of Geometric Tools, 2008. Available at
@@ -54,11 +59,10 @@
 
 #include <cstddef>
 #include <iostream>
+#include <vector>
 
-#include <boost/circular_buffer.hpp>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
-#include <boost/unordered_map.hpp>
 
 namespace tudat
 {
@@ -320,6 +324,174 @@ double computeGeodesyLegendrePolynomialVertical( const int degree,
                                                  const double oneDegreePriorPolynomial,
                                                  const double twoDegreesPriorPolynomial );
 
+//! Class for dense, triangular table of geodesy-normalized Legendre polynomials.
+/*!
+ * Class that stores all geodesy-normalized associated Legendre polynomials
+ * \f$ \bar{ P }_{ n, m }( u ) \f$ and their derivatives with respect to the polynomial parameter,
+ * up to a given maximum degree, for a single value of the polynomial parameter. The table is
+ * filled in a single pass, using the sectoral and degree recursions given by
+ * Holmes & Featherstone [2002] (see computeGeodesyLegendrePolynomialDiagonal( ) and
+ * computeGeodesyLegendrePolynomialVertical( )), and the derivative as given by
+ * computeGeodesyLegendrePolynomialDerivative( ). The recursion coefficients are precomputed when
+ * the maximum degree is set, such that updating the table for a new polynomial parameter
+ * requires \f$ O( n^2 ) \f$ multiplications and additions, and no square roots, hashing or memory
+ * allocation.
+ *
+ * The polynomials are stored order-by-order in contiguous memory, i.e., all polynomials of order
+ * \f$ m \f$ are stored consecutively, from degree \f$ m \f$ up to the maximum degree. This
+ * matches the degree recursion, which runs over the degree for a fixed order, and the storage
+ * order of (column-major) coefficient matrices, such that sums over the degree can be evaluated
+ * on contiguous memory (see getLegendrePolynomialsOfOrder( )).
+ *
+ * As for computeGeodesyLegendrePolynomialDerivative( ), the derivatives are singular for
+ * \f$ u = \pm 1 \f$.
+ */
+class GeodesyLegendreTable
+{
+public:
+
+    //! Constructor taking the maximum degree.
+    /*!
+     * Constructor taking the maximum degree of the polynomials stored in the table. The table is
+     * not filled until update( ) is called.
+     * \param aMaximumDegree Maximum degree of polynomials stored in the table (default = 0).
+     */
+    explicit GeodesyLegendreTable( const int aMaximumDegree = 0 );
+
+    //! Set maximum degree.
+    /*!
+     * Sets the maximum degree of the polynomials stored in the table, reallocates the table and
+     * precomputes the recursion coefficients. The table must be updated after calling this
+     * function.
+     * \param aMaximumDegree Maximum degree of polynomials stored in the table.
+     */
+    void setMaximumDegree( const int aMaximumDegree );
+
+    //! Update table for polynomial parameter.
+    /*!
+     * Computes all geodesy-normalized Legendre polynomials and their derivatives up to the
+     * maximum degree for the given polynomial parameter. If the table is already up-to-date for
+     * the given polynomial parameter, the table is not recomputed.
+     * \param aPolynomialParameter Free variable of Legendre polynomials, in range [-1, 1].
+     */
+    void update( const double aPolynomialParameter );
+
+    //! Get maximum degree.
+    /*!
+     * Returns the maximum degree of the polynomials stored in the table.
+     * \return Maximum degree of polynomials stored in the table.
+     */
+    int getMaximumDegree( ) const { return maximumDegree; }
+
+    //! Get polynomial parameter.
+    /*!
+     * Returns the polynomial parameter for which the table was last updated.
+     * \return Polynomial parameter of polynomials stored in the table.
+     */
+    double getPolynomialParameter( ) const { return polynomialParameter; }
+
+    //! Get geodesy-normalized Legendre polynomial.
+    /*!
+     * Returns the geodesy-normalized Legendre polynomial of given degree and order, for the
+     * polynomial parameter for which the table was last updated. No bounds checking is performed:
+     * the order may not be larger than the degree, and the degree may not be larger than the
+     * maximum degree.
+     * \param degree Degree of requested Legendre polynomial.
+     * \param order Order of requested Legendre polynomial.
+     * \return Geodesy-normalized Legendre polynomial.
+     */
+    double getLegendrePolynomial( const int degree, const int order ) const
+    {
+        return legendrePolynomials[ getIndex( degree, order ) ];
+    }
+
+    //! Get derivative of geodesy-normalized Legendre polynomial.
+    /*!
+     * Returns the derivative of the geodesy-normalized Legendre polynomial of given degree and
+     * order with respect to the polynomial parameter, for the polynomial parameter for which the
+     * table was last updated. No bounds checking is performed (see getLegendrePolynomial( )).
+     * \param degree Degree of requested Legendre polynomial derivative.
+     * \param order Order of requested Legendre polynomial derivative.
+     * \return Geodesy-normalized Legendre polynomial derivative with respect to the polynomial
+     *          parameter.
+     */
+    double getLegendrePolynomialDerivative( const int degree, const int order ) const
+    {
+        return legendrePolynomialDerivatives[ getIndex( degree, order ) ];
+    }
+
+    //! Get geodesy-normalized Legendre polynomials of given order.
+    /*!
+     * Returns a pointer to the geodesy-normalized Legendre polynomials of given order, which are
+     * stored consecutively from degree equal to the order, up to the maximum degree.
+     * \param order Order of requested Legendre polynomials.
+     * \return Pointer to Legendre polynomial of degree and order equal to given order.
+     */
+    const double* getLegendrePolynomialsOfOrder( const int order ) const
+    {
+        return &legendrePolynomials[ getIndex( order, order ) ];
+    }
+
+    //! Get derivatives of geodesy-normalized Legendre polynomials of given order.
+    /*!
+     * Returns a pointer to the derivatives of the geodesy-normalized Legendre polynomials of given
+     * order, which are stored consecutively from degree equal to the order, up to the maximum
+     * degree.
+     * \param order Order of requested Legendre polynomial derivatives.
+     * \return Pointer to Legendre polynomial derivative of degree and order equal to given order.
+     */
+    const double* getLegendrePolynomialDerivativesOfOrder( const int order ) const
+    {
+        return &legendrePolynomialDerivatives[ getIndex( order, order ) ];
+    }
+
+    //! Get index of polynomial in table.
+    /*!
+     * Returns the index of the polynomial of given degree and order in the triangular table.
+     * \param degree Degree of Legendre polynomial.
+     * \param order Order of Legendre polynomial.
+     * \return Index of Legendre polynomial in table.
+     */
+    int getIndex( const int degree, const int order ) const
+    {
+        return order * ( 2 * maximumDegree + 3 - order ) / 2 + degree - order;
+    }
+
+protected:
+
+private:
+
+    //! Maximum degree of polynomials stored in table.
+    int maximumDegree;
+
+    //! Polynomial parameter for which table was last updated.
+    double polynomialParameter;
+
+    //! Flag indicating whether the table has been updated since the maximum degree was set.
+    bool isTableUpdated;
+
+    //! Geodesy-normalized Legendre polynomials, stored in triangular form.
+    std::vector< double > legendrePolynomials;
+
+    //! Derivatives of geodesy-normalized Legendre polynomials, stored in triangular form.
+    std::vector< double > legendrePolynomialDerivatives;
+
+    //! Coefficients of one-degree-prior polynomials in degree recursion, in triangular form.
+    std::vector< double > oneDegreePriorCoefficients;
+
+    //! Coefficients of two-degrees-prior polynomials in degree recursion, in triangular form.
+    std::vector< double > twoDegreesPriorCoefficients;
+
+    //! Coefficients of incremented-order polynomials in derivative, in triangular form.
+    std::vector< double > derivativeCoefficients;
+
+    //! Coefficients of prior sectoral polynomials in sectoral recursion, per order.
+    std::vector< double > sectoralCoefficients;
+};
+
+//! Typedef for shared-pointer to GeodesyLegendreTable object.
+typedef boost::shared_ptr< GeodesyLegendreTable > GeodesyLegendreTablePointer;
+
 //! Declare structure for arguments of Legendre polynomial (for use in back-end cache).
 struct Point
 {
@@ -356,22 +528,40 @@ bool operator==( const Point& polynomialArguments1, const Point& polynomialArgum
 std::size_t hash_value( Point const& polynomialArguments );
 
 //! Class for creating and accessing a back-end cache of Legendre polynomials.
+/*!
+ * Back-end cache of Legendre polynomials, used by the recursive computation of the Legendre
+ * polynomials. The cached polynomials are stored in a table that is allocated once, in which the
+ * polynomial of degree n and order m is located at index n * ( n + 1 ) / 2 + m. The size of this
+ * table (the budget of the cache) can be set at runtime; polynomials that do not fit in the
+ * table are computed, but not cached.
+ *
+ * The recursive computation of a Legendre polynomial, and the evaluation of a spherical harmonics
+ * expansion, request many degrees and orders for the same polynomial parameter, after which that
+ * polynomial parameter is typically never requested again. The table therefore only holds
+ * polynomials for the most recently requested polynomial parameter; once a different polynomial
+ * parameter is requested, all entries are evicted at once (in constant time).
+ *
+ * Instances of this class are not thread-safe; the caches used by computeLegendrePolynomial( )
+ * and computeGeodesyLegendrePolynomial( ) are therefore thread-local (see getLegendreCache( ) and
+ * getGeodesyLegendreCache( )).
+ */
 class LegendreCache
 {
-private:
+public:
 
     //! Define Legendre polynomial function pointer.
     typedef boost::function< double ( int, int, double ) > LegendrePolynomialFunction;
 
-    //! Define map and buffer variables types.
-    typedef boost::unordered_map< Point, double > CacheTable;
-    typedef boost::circular_buffer< Point > CacheHistory;
-
-public:
-
-    //! Initialize LegendreCache instance.
+    //! Initialize LegendreCache instance, with default maximum number of entries.
     LegendreCache( );
 
+    //! Initialize LegendreCache instance, with given maximum number of entries.
+    /*!
+     * Initializes LegendreCache instance, with given maximum number of entries.
+     * \param maximumNumberOfEntries Maximum number of cached Legendre polynomials.
+     */
+    explicit LegendreCache( const int maximumNumberOfEntries );
+
     //! Get Legendre polynomial value from either cache or from computation.
     /*!
     * \param degree Degree of requested Legendre polynomial.
@@ -385,22 +575,110 @@ public:
     double getOrElseUpdate( const int degree, const int order, const double polynomialParameter,
                             const LegendrePolynomialFunction legendrePolynomialFunction );
 
+    //! Set maximum number of entries.
+    /*!
+     * Sets the maximum number of cached Legendre polynomials, which reallocates the table and
+     * clears the cache. All polynomials up to degree n are cached if the maximum number of entries
+     * is at least ( n + 1 ) * ( n + 2 ) / 2.
+     * \param maximumNumberOfEntries Maximum number of cached Legendre polynomials.
+     */
+    void setMaximumNumberOfEntries( const int maximumNumberOfEntries );
+
+    //! Get maximum number of entries.
+    /*!
+     * Returns the maximum number of cached Legendre polynomials.
+     * \return Maximum number of cached Legendre polynomials.
+     */
+    int getMaximumNumberOfEntries( ) const { return cachedPolynomials.size( ); }
+
+    //! Clear cache.
+    /*!
+     * Evicts all cached Legendre polynomials, without deallocating the table.
+     */
+    void clear( );
+
+    //! Get number of cache hits.
+    /*!
+     * Returns the number of requested Legendre polynomials that were retrieved from the cache,
+     * since construction or the last call to resetStatistics( ).
+     * \return Number of cache hits.
+     */
+    unsigned long getNumberOfHits( ) const { return numberOfHits; }
+
+    //! Get number of cache misses.
+    /*!
+     * Returns the number of requested Legendre polynomials that were computed, since
+     * construction or the last call to resetStatistics( ).
+     * \return Number of cache misses.
+     */
+    unsigned long getNumberOfMisses( ) const { return numberOfMisses; }
+
+    //! Reset number of cache hits and misses.
+    void resetStatistics( );
+
 private:
 
-    // Declare hashmap which links a specific degree, order and polynomial parameter to its
-    // corresponding Legendre polynomial value.
-    CacheTable backendCache;
+    //! Friend function to dump contents of cache.
+    friend void dumpLegendrePolynomialCacheData( std::ostream& outputStream,
+                                                 const LegendreCache& legendreCache );
+
+    //! Get index of Legendre polynomial in table.
+    /*!
+     * Returns the index of the Legendre polynomial of given degree and order in the table of
+     * cached polynomials.
+     * \param degree Degree of Legendre polynomial.
+     * \param order Order of Legendre polynomial.
+     * \return Index of Legendre polynomial in table.
+     */
+    static int getIndex( const int degree, const int order )
+    {
+        return degree * ( degree + 1 ) / 2 + order;
+    }
+
+    //! Table of cached Legendre polynomials.
+    std::vector< double > cachedPolynomials;
+
+    //! Generations in which the entries of the table were cached.
+    /*!
+     * Generations in which the entries of the table were cached. An entry is only valid if it was
+     * cached in the current generation, such that all entries can be evicted by incrementing the
+     * current generation.
+     */
+    std::vector< unsigned int > generationsOfCachedPolynomials;
 
-    // Declare history buffer.
-    CacheHistory history;
+    //! Current generation of the cache.
+    unsigned int currentGeneration;
+
+    //! Polynomial parameter of the Legendre polynomials cached in the current generation.
+    double currentPolynomialParameter;
+
+    //! Number of cache hits.
+    unsigned long numberOfHits;
+
+    //! Number of cache misses.
+    unsigned long numberOfMisses;
 };
 
 //! Typedef shared-pointer to LegendreCache object.
 typedef boost::shared_ptr< LegendreCache > LegendreCachePointer;
 
-// Declare global instances of LegendreCache class.
-static LegendreCache legendreCache;
-static LegendreCache geodesyLegendreCache;
+//! Get back-end cache of unnormalized Legendre polynomials of current thread.
+/*!
+ * Returns the back-end cache used by computeLegendrePolynomial( ). Each thread has its own cache,
+ * which is created on first use, such that Legendre polynomials can safely be computed
+ * concurrently. Settings and statistics of the returned cache only apply to the current thread.
+ * \return Back-end cache of unnormalized Legendre polynomials of current thread.
+ */
+LegendreCache& getLegendreCache( );
+
+//! Get back-end cache of geodesy-normalized Legendre polynomials of current thread.
+/*!
+ * Returns the back-end cache used by computeGeodesyLegendrePolynomial( ). Each thread has its own
+ * cache, which is created on first use, such that Legendre polynomials can safely be computed
+ * concurrently. Settings and statistics of the returned cache only apply to the current thread.
+ * \return Back-end cache of geodesy-normalized Legendre polynomials of current thread.
+ */
+LegendreCache& getGeodesyLegendreCache( );
 
 //! Write contents of Legendre polynomial structure to string.
 /*!
@@ -411,16 +689,15 @@ static LegendreCache geodesyLegendreCache;
  */
 std::string writeLegendrePolynomialStructureToString( const Point legendrePolynomialStructure );
 
-//! Dump Legendre polynomial cache data to stream (table and history).
+//! Dump Legendre polynomial cache data to stream (table and statistics).
 /*!
- * Dumps cached table and history data for Legendre polynomials to given output stream.
+ * Dumps cached Legendre polynomials, and the number of cache hits and misses, to given output
+ * stream.
  * \param outputStream Output stream.
- * \param cacheTable Cache table containing current values of Legendre polynomials.
- * \param cacheHistory Cached history of Legendre polynomials.
+ * \param legendreCache Cache of Legendre polynomials.
  */
 void dumpLegendrePolynomialCacheData( std::ostream& outputStream,
-                                      boost::unordered_map< Point, double > cacheTable,
-                                      boost::circular_buffer< Point > cacheHistory );
+                                      const LegendreCache& legendreCache );
 
 } // namespace basic_mathematics
 } // namespace tudat
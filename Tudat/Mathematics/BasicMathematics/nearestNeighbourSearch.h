@@ -41,6 +41,7 @@
  *      120716    D. Dirkx          Updated with new nearest neighbour search algorithms.
  *      130114    D. Dirkx          Added missing include statements; corrected include guard
  *                                  name.
+ *      261016    agent             Added nearest left neighbour search using forward sweep.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -53,6 +54,7 @@
 #ifndef TUDAT_NEAREST_NEIGHBOR_SEARCH_H
 #define TUDAT_NEAREST_NEIGHBOR_SEARCH_H 
 
+#include <algorithm>
 #include <map>
 #include <stdexcept>
 #include <vector>
@@ -344,6 +346,58 @@ int findNearestLeftNeighbourUsingHuntingAlgorithm(
     return newNearestLowerIndex;
 }
 
+//! Nearest left neighbour search using forward sweep.
+/*!
+ * Nearest left neighbour search starting from the nearest left neighbour of the previous value,
+ * for use when looking up a series of values sorted in ascending order. The interval of the
+ * previous value and the next interval are checked first, after which a binary search is
+ * performed in the remainder of the data, or in all data if the value is smaller than the
+ * previous value. Values outside the range of the data are assigned to the first or last
+ * interval, consistent with the other nearest neighbour searches. As opposed to the hunting
+ * algorithm, no state is kept, so that a series of values can be looked up from a const
+ * function.
+ * \tparam IndependentVariableType Type for entries of vector of in which nearest neighbour is
+ *          sought.
+ * \param independentVariableValue Value of which the nearest left neighbour is to be calculated.
+ * \param previousNearestLowerIndex Nearest left neighbour of previous value (0 for first value).
+ * \param independentValues Vector of independent variables, sorted in ascending order, in which
+ *          the nearest left (lower) neighbour is to be determined.
+ * \return Index of independentValues that is the nearest left neighbour.
+ */
+template< typename IndependentVariableType >
+int findNearestLeftNeighbourUsingForwardSweep(
+        const IndependentVariableType independentVariableValue,
+        const int previousNearestLowerIndex,
+        const std::vector< IndependentVariableType >& independentValues )
+{
+    const int lastLowerIndex = static_cast< int >( independentValues.size( ) ) - 2;
+
+    // Search all data if value is smaller than lower value of previous interval.
+    typename std::vector< IndependentVariableType >::const_iterator searchStart =
+            independentValues.begin( ) + 1;
+    if ( independentVariableValue >= independentValues[ previousNearestLowerIndex ] )
+    {
+        // Check whether value lies in previous or next interval.
+        if ( previousNearestLowerIndex == lastLowerIndex ||
+             independentVariableValue < independentValues[ previousNearestLowerIndex + 1 ] )
+        {
+            return previousNearestLowerIndex;
+        }
+        else if ( previousNearestLowerIndex + 1 == lastLowerIndex ||
+                  independentVariableValue < independentValues[ previousNearestLowerIndex + 2 ] )
+        {
+            return previousNearestLowerIndex + 1;
+        }
+
+        searchStart += previousNearestLowerIndex + 1;
+    }
+
+    // Perform binary search, excluding the final data point.
+    return static_cast< int >( std::upper_bound( searchStart, independentValues.end( ) - 1,
+                                                 independentVariableValue )
+                               - independentValues.begin( ) ) - 1;
+}
+
 } // namespace basic_mathematics
 } // namespace tudat
 
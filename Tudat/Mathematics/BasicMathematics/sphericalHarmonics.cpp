@@ -25,6 +25,7 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      261016    agent             Added spherical harmonics cache.
  *
  *    References
  *
@@ -33,6 +34,10 @@
  */
 
 #include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
 
 #include <Eigen/Core>
 
@@ -92,5 +97,76 @@ Eigen::Vector3d computePotentialGradient(
     return potentialGradient;
 }
 
+//! Constructor taking the maximum degree and order.
+SphericalHarmonicsCache::SphericalHarmonicsCache( const int aMaximumDegree,
+                                                  const int aMaximumOrder )
+    : maximumDegree( -1 ),
+      maximumOrder( -1 )
+{
+    setMaximumDegreeAndOrder( aMaximumDegree, aMaximumOrder );
+}
+
+//! Set maximum degree and order.
+void SphericalHarmonicsCache::setMaximumDegreeAndOrder( const int aMaximumDegree,
+                                                        const int aMaximumOrder )
+{
+    // If maximum degree or order is negative...
+    if ( aMaximumDegree < 0 || aMaximumOrder < 0 )
+    {
+        // Set error message.
+        std::stringstream errorMessage;
+        errorMessage << "Error: the maximum degree (" << aMaximumDegree << ") and order ("
+                     << aMaximumOrder << ") of a spherical harmonics cache cannot be negative."
+                     << std::endl;
+
+        // Throw a run-time error.
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+               errorMessage.str( ) ) ) );
+    }
+
+    // Reallocate cache if maximum degree or order changed.
+    if ( aMaximumDegree != maximumDegree || aMaximumOrder != maximumOrder )
+    {
+        maximumDegree = aMaximumDegree;
+        maximumOrder = aMaximumOrder;
+
+        legendreTable.setMaximumDegree( maximumDegree );
+        radiusRatioPowers.setZero( maximumDegree + 1 );
+        cosinesOfMultipleLongitude.setZero( maximumOrder + 1 );
+        sinesOfMultipleLongitude.setZero( maximumOrder + 1 );
+    }
+}
+
+//! Update cache for given point.
+void SphericalHarmonicsCache::update( const double radius, const double polynomialParameter,
+                                      const double longitude, const double referenceRadius )
+{
+    // Update Legendre polynomials.
+    legendreTable.update( polynomialParameter );
+
+    // Compute radius ratio powers through recurrence.
+    const double radiusRatio = referenceRadius / radius;
+    radiusRatioPowers( 0 ) = radiusRatio;
+    for ( int degree = 1; degree <= maximumDegree; degree++ )
+    {
+        radiusRatioPowers( degree ) = radiusRatioPowers( degree - 1 ) * radiusRatio;
+    }
+
+    // Compute sines and cosines of multiples of longitude through recurrence.
+    const double cosineOfLongitude = std::cos( longitude );
+    const double sineOfLongitude = std::sin( longitude );
+    cosinesOfMultipleLongitude( 0 ) = 1.0;
+    sinesOfMultipleLongitude( 0 ) = 0.0;
+    for ( int order = 1; order <= maximumOrder; order++ )
+    {
+        cosinesOfMultipleLongitude( order )
+                = cosinesOfMultipleLongitude( order - 1 ) * cosineOfLongitude
+                - sinesOfMultipleLongitude( order - 1 ) * sineOfLongitude;
+        sinesOfMultipleLongitude( order )
+                = sinesOfMultipleLongitude( order - 1 ) * cosineOfLongitude
+                + cosinesOfMultipleLongitude( order - 1 ) * sineOfLongitude;
+    }
+}
+
 } // namespace basic_mathematics
 } // namespace tudat
@@ -25,6 +25,8 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      261016    agent             Added spherical harmonics cache with Legendre table, radius
+ *                                  ratio powers and multiple-longitude sines and cosines.
  *
  *    References
  *
@@ -37,6 +39,8 @@
 
 #include <Eigen/Core>
 
+#include "Tudat/Mathematics/BasicMathematics/legendrePolynomials.h"
+
 namespace tudat
 {
 namespace basic_mathematics
@@ -110,6 +114,134 @@ Eigen::Vector3d computePotentialGradient( const Eigen::Vector3d& sphericalPositi
                                           const double legendrePolynomial,
                                           const double legendrePolynomialDerivative );
 
+//! Class for caching the quantities of a spherical harmonics expansion at a single point.
+/*!
+ * Class that stores all quantities that are required to evaluate a spherical harmonics expansion
+ * (or its gradient) at a single point, and that do not depend on the harmonic coefficients: the
+ * geodesy-normalized Legendre polynomials and their derivatives, the powers of the ratio of the
+ * reference radius and the radial coordinate, and the sines and cosines of multiples of the
+ * longitude. These are computed once per point, using recurrence relations, such that the
+ * expansion itself can be evaluated without any calls to std::pow( ), std::sin( ) or
+ * std::cos( ). The storage is allocated when the maximum degree and order are set, such that
+ * updating the cache requires no memory allocation.
+ */
+class SphericalHarmonicsCache
+{
+public:
+
+    //! Constructor taking the maximum degree and order.
+    /*!
+     * Constructor taking the maximum degree and order of the spherical harmonics expansion. The
+     * cache is not filled until update( ) is called.
+     * \param aMaximumDegree Maximum degree of spherical harmonics expansion (default = 0).
+     * \param aMaximumOrder Maximum order of spherical harmonics expansion (default = 0).
+     */
+    explicit SphericalHarmonicsCache( const int aMaximumDegree = 0, const int aMaximumOrder = 0 );
+
+    //! Set maximum degree and order.
+    /*!
+     * Sets the maximum degree and order of the spherical harmonics expansion, and reallocates the
+     * cache if they changed. The cache must be updated after calling this function.
+     * \param aMaximumDegree Maximum degree of spherical harmonics expansion.
+     * \param aMaximumOrder Maximum order of spherical harmonics expansion.
+     */
+    void setMaximumDegreeAndOrder( const int aMaximumDegree, const int aMaximumOrder );
+
+    //! Update cache for given point.
+    /*!
+     * Updates the Legendre polynomials, radius ratio powers and multiple-longitude sines and
+     * cosines for the given point. The powers and the sines and cosines are computed through the
+     * recurrence relations:
+     * \f{eqnarray*}{
+     *     \left( \frac{ R }{ r } \right)^{ n + 2 } = \left( \frac{ R }{ r } \right)^{ n + 1 }
+     *     \frac{ R }{ r } \\
+     *     \cos( ( m + 1 ) \lambda ) = \cos( m \lambda ) \cos \lambda
+     *     - \sin( m \lambda ) \sin \lambda \\
+     *     \sin( ( m + 1 ) \lambda ) = \sin( m \lambda ) \cos \lambda
+     *     + \cos( m \lambda ) \sin \lambda
+     * \f}
+     * \param radius Radial coordinate of point.
+     * \param polynomialParameter Sine of latitude coordinate of point.
+     * \param longitude Longitude coordinate of point.
+     * \param referenceRadius Radius of harmonics reference sphere.
+     */
+    void update( const double radius, const double polynomialParameter,
+                 const double longitude, const double referenceRadius );
+
+    //! Get maximum degree.
+    /*!
+     * Returns the maximum degree of the spherical harmonics expansion.
+     * \return Maximum degree of spherical harmonics expansion.
+     */
+    int getMaximumDegree( ) const { return maximumDegree; }
+
+    //! Get maximum order.
+    /*!
+     * Returns the maximum order of the spherical harmonics expansion.
+     * \return Maximum order of spherical harmonics expansion.
+     */
+    int getMaximumOrder( ) const { return maximumOrder; }
+
+    //! Get Legendre table.
+    /*!
+     * Returns the table of geodesy-normalized Legendre polynomials and derivatives.
+     * \return Table of geodesy-normalized Legendre polynomials.
+     */
+    const GeodesyLegendreTable& getLegendreTable( ) const { return legendreTable; }
+
+    //! Get radius ratio powers.
+    /*!
+     * Returns the powers of the ratio of the reference radius and the radial coordinate, such
+     * that entry \f$ n \f$ is equal to \f$ ( R / r )^{ n + 1 } \f$, up to the maximum degree.
+     * \return Vector of radius ratio powers.
+     */
+    const Eigen::VectorXd& getRadiusRatioPowers( ) const { return radiusRatioPowers; }
+
+    //! Get cosines of multiples of longitude.
+    /*!
+     * Returns the cosines of multiples of the longitude, such that entry \f$ m \f$ is equal to
+     * \f$ \cos( m \lambda ) \f$, up to the maximum order.
+     * \return Vector of cosines of multiples of longitude.
+     */
+    const Eigen::VectorXd& getCosinesOfMultipleLongitude( ) const
+    {
+        return cosinesOfMultipleLongitude;
+    }
+
+    //! Get sines of multiples of longitude.
+    /*!
+     * Returns the sines of multiples of the longitude, such that entry \f$ m \f$ is equal to
+     * \f$ \sin( m \lambda ) \f$, up to the maximum order.
+     * \return Vector of sines of multiples of longitude.
+     */
+    const Eigen::VectorXd& getSinesOfMultipleLongitude( ) const
+    {
+        return sinesOfMultipleLongitude;
+    }
+
+protected:
+
+private:
+
+    //! Maximum degree of spherical harmonics expansion.
+    int maximumDegree;
+
+    //! Maximum order of spherical harmonics expansion.
+    int maximumOrder;
+
+    //! Table of geodesy-normalized Legendre polynomials and derivatives.
+    GeodesyLegendreTable legendreTable;
+
+    //! Powers of ratio of reference radius and radial coordinate.
+    Eigen::VectorXd radiusRatioPowers;
+
+    //! Cosines of multiples of longitude.
+    Eigen::VectorXd cosinesOfMultipleLongitude;
+
+    //! Sines of multiples of longitude.
+    Eigen::VectorXd sinesOfMultipleLongitude;
+};
+
 } // namespace basic_mathematics
 } // namespace tudat
 
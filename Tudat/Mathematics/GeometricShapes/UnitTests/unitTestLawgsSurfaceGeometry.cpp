@@ -31,6 +31,7 @@
  *                                  Moved (con/de)structors and getter/setters to header.
  *      120326    D. Dirkx          Changed raw pointers to shared pointers.
  *      120628    A. Ronse          Boostified unit test.
+ *      261016    agent             Added test of flat panel property arrays.
  *
  *    References
  *      Craidon, C.B. A Desription of the Langley Wireframe Geometry Standard (LaWGS) format, NASA
@@ -42,10 +43,13 @@
 
 #define BOOST_TEST_MAIN
 
+#include <limits>
+
 #include <Eigen/Core>
 
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
@@ -110,6 +114,59 @@ BOOST_AUTO_TEST_CASE( testLawgsSurfaceGeometry )
                        std::numeric_limits< double >::epsilon( ) );
 }
 
+//! Test flat arrays of panel properties of Lawgs surface geometry.
+BOOST_AUTO_TEST_CASE( testLawgsSurfaceGeometryPanelArrays )
+{
+    using namespace tudat;
+    using namespace tudat::geometric_shapes;
+
+    // Create a Lawgs mesh of a sphere, with different numbers of lines and points.
+    boost::shared_ptr< SphereSegment > sphere = boost::make_shared< SphereSegment >( 2.0 );
+    LawgsPartGeometry lawgsSurface;
+    const int numberOfLines = 11;
+    const int numberOfPoints = 7;
+    lawgsSurface.setMesh( sphere, numberOfLines, numberOfPoints );
+
+    // Test if number of panels is correct.
+    BOOST_CHECK_EQUAL( lawgsSurface.getNumberOfPanels( ),
+                       ( numberOfLines - 1 ) * ( numberOfPoints - 1 ) );
+    BOOST_CHECK_EQUAL( lawgsSurface.getPanelAreas( ).rows( ), lawgsSurface.getNumberOfPanels( ) );
+    BOOST_CHECK_EQUAL( lawgsSurface.getPanelCentroids( ).rows( ),
+                       lawgsSurface.getNumberOfPanels( ) );
+    BOOST_CHECK_EQUAL( lawgsSurface.getPanelSurfaceNormals( ).rows( ),
+                       lawgsSurface.getNumberOfPanels( ) );
+
+    // Test if the arrays are consistent with the properties of the individual panels.
+    for ( int i = 0; i < numberOfLines - 1; i++ )
+    {
+        for ( int j = 0; j < numberOfPoints - 1; j++ )
+        {
+            const int panelIndex = lawgsSurface.getPanelIndex( i, j );
+            BOOST_CHECK_EQUAL( panelIndex, i * ( numberOfPoints - 1 ) + j );
+            BOOST_CHECK_EQUAL( lawgsSurface.getPanelAreas( )( panelIndex ),
+                               lawgsSurface.getPanelArea( i, j ) );
+
+            for ( int k = 0; k < 3; k++ )
+            {
+                BOOST_CHECK_EQUAL( lawgsSurface.getPanelCentroids( )( panelIndex, k ),
+                                   lawgsSurface.getPanelCentroid( i, j )( k ) );
+                BOOST_CHECK_EQUAL( lawgsSurface.getPanelSurfaceNormals( )( panelIndex, k ),
+                                   lawgsSurface.getPanelSurfaceNormal( i, j )( k ) );
+            }
+        }
+    }
+
+    // Test if the sum of the panel areas equals the total area.
+    BOOST_CHECK_CLOSE_FRACTION( lawgsSurface.getPanelAreas( ).sum( ),
+                                lawgsSurface.getTotalArea( ),
+                                10.0 * std::numeric_limits< double >::epsilon( ) );
+
+    // Test if the surface normals have unit length.
+    BOOST_CHECK_SMALL( ( lawgsSurface.getPanelSurfaceNormals( ).rowwise( ).norm( ).array( )
+                         - 1.0 ).abs( ).maxCoeff( ),
+                       10.0 * std::numeric_limits< double >::epsilon( ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
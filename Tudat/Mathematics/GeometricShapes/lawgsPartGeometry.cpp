@@ -32,6 +32,8 @@
  *                                  Moved (con/de)structors and getter/setters to header.
  *      120323    D. Dirkx          Removed set functions; moved functionality to constructor,
  *                                  removed raw pointer arrays.
+ *      261016    agent             Adapted to flat storage of panel properties.
+ *
  *    References
  *      Craidon, C.B. A Desription of the Langley Wireframe Geometry Standard (LaWGS) format, NASA
  *          TECHNICAL MEMORANDUM 85767.
@@ -132,7 +134,7 @@ Eigen::VectorXd LawgsPartGeometry::getSurfacePoint( const double independentVari
     lineIndex = static_cast< int > ( floor( independentVariable1 ) );
 
     // Start with panel centroid.
-    point = panelCentroids_[ lineIndex ][ pointIndex ];
+    point = getPanelCentroid( lineIndex, pointIndex );
 
     // Move back to panel corner.
     point -= 0.5 *( meshPoints_[ lineIndex + 1 ][ pointIndex + 1 ] -
@@ -31,6 +31,7 @@
  *                                  Moved (con/de)structors and getter/setters to header.
  *      120323    D. Dirkx          Removed set functions; moved functionality to constructor,
  *                                  removed raw pointer arrays
+ *      261016    agent             Changed panel properties to flat, structure-of-arrays storage.
  *    References
  *      An example of a heritage code which uses such a mesh is found in:
  *          The Mark IV Supersonic-Hypersonic Arbitrary Body Program, Volume
@@ -58,13 +59,15 @@ namespace geometric_shapes
 void QuadrilateralMeshedSurfaceGeometry::performPanelCalculations( )
 {
     // Allocate memory for panel properties.
-    panelCentroids_.resize(boost::extents[ numberOfLines_ - 1 ][ numberOfPoints_ - 1 ]);
-    panelSurfaceNormals_.resize(boost::extents[ numberOfLines_ - 1 ][ numberOfPoints_ - 1 ]);
-    panelAreas_.resize(boost::extents[ numberOfLines_ - 1 ][ numberOfPoints_ - 1 ]);
+    const int numberOfPanels = ( numberOfLines_ - 1 ) * ( numberOfPoints_ - 1 );
+    panelCentroids_.resize( numberOfPanels, 3 );
+    panelSurfaceNormals_.resize( numberOfPanels, 3 );
+    panelAreas_.resize( numberOfPanels );
 
     // Declare local variables for normal and area determination.
     Eigen::Vector3d crossVector1;
     Eigen::Vector3d crossVector2;
+    Eigen::Vector3d panelSurfaceNormal;
 
     // Reset total area.
     totalArea_ = 0.0;
@@ -74,36 +77,39 @@ void QuadrilateralMeshedSurfaceGeometry::performPanelCalculations( )
     {
         for ( int j = 0; j < numberOfPoints_ - 1; j++ )
         {
+            const int panelIndex = getPanelIndex( i, j );
+
             // Set panel centroid.
-            panelCentroids_[ i ][ j ] = ( meshPoints_[ i ][ j ] +
-                                          meshPoints_[ i + 1 ][ j ] +
-                                          meshPoints_[ i ][ j + 1 ] +
-                                          meshPoints_[ i + 1 ][ j + 1 ] ) / 4;
+            panelCentroids_.row( panelIndex ) = ( ( meshPoints_[ i ][ j ] +
+                                                    meshPoints_[ i + 1 ][ j ] +
+                                                    meshPoints_[ i ][ j + 1 ] +
+                                                    meshPoints_[ i + 1 ][ j + 1 ] ) / 4 )
+                    .transpose( );
 
             // Set panel cross vectors.
             crossVector1 = meshPoints_[ i + 1 ][ j + 1 ] - meshPoints_[ i ][ j ];
             crossVector2 = meshPoints_[ i + 1 ][ j ] - meshPoints_[ i ][ j + 1 ];
 
             // Set panel normal (not yet normalized).
-            panelSurfaceNormals_[ i ][ j ] = crossVector1.cross( crossVector2 );
+            panelSurfaceNormal = crossVector1.cross( crossVector2 );
 
             // Set panel area (not yet correct size).
-            panelAreas_[ i ][ j ] = panelSurfaceNormals_[ i ][ j ].norm( );
-            if ( panelAreas_[ i ][ j ] < std::numeric_limits< double >::epsilon( ) )
+            panelAreas_( panelIndex ) = panelSurfaceNormal.norm( );
+            if ( panelAreas_( panelIndex ) < std::numeric_limits< double >::epsilon( ) )
             {
                 std::cerr << "WARNING panel area is zero in part at panel" << i
-                          << ", " << j << std::endl;               
-            }            
+                          << ", " << j << std::endl;
+            }
 
             // Normalize panel normal and, if necessary, invert normal direction.
-            panelSurfaceNormals_[ i ][ j ] *= reversalOperator_;
-            panelSurfaceNormals_[ i ][ j ].normalize( );
+            panelSurfaceNormal *= reversalOperator_;
+            panelSurfaceNormals_.row( panelIndex ) = panelSurfaceNormal.normalized( ).transpose( );
 
             // Set panel area to correct size.
-            panelAreas_[ i ][ j ] *= 0.5;
+            panelAreas_( panelIndex ) *= 0.5;
 
             // Add panel area to total area.
-            totalArea_ += panelAreas_[ i ][ j ];
+            totalArea_ += panelAreas_( panelIndex );
         }
     }
 }
@@ -32,6 +32,7 @@
  *      120323    D. Dirkx          Removed set functions; moved functionality to constructor,
  *                                  removed raw pointer arrays.
  *      130121    K. Kumar          Added shared-ptr typedef.
+ *      261016    agent             Changed panel properties to flat, structure-of-arrays storage.
  *
  *    References
  *      An example of a heritage code which uses such a mesh is found in:
@@ -41,6 +42,9 @@
  *    Notes
  *      The numberOfLines_ and numberOfPoints_ member variables denote the number of mesh points.
  *      The number of panels in the mesh will be numberOfLines_ - 1 by numberOfPoints_ - 1.
+ *      Panel properties are stored contiguously, with the point index running fastest, such
+ *      that panel (i, j) has index i * ( numberOfPoints_ - 1 ) + j. Panel centroids and normals
+ *      are stored as column-major N x 3 matrices, i.e., as separate x-, y- and z-arrays.
  *
  */
 
@@ -104,7 +108,7 @@ public:
      */
     double getPanelArea( const int lineIndex, const int pointIndex )
     {
-        return panelAreas_[ lineIndex ][ pointIndex ];
+        return panelAreas_( getPanelIndex( lineIndex, pointIndex ) );
     }
 
     //! Get panel centroid.
@@ -116,7 +120,7 @@ public:
      */
     Eigen::Vector3d getPanelCentroid( const int lineIndex, const int pointIndex )
     {
-        return panelCentroids_[ lineIndex ][ pointIndex ];
+        return panelCentroids_.row( getPanelIndex( lineIndex, pointIndex ) ).transpose( );
     }
 
     //! Get outward panel surface normal.
@@ -128,7 +132,59 @@ public:
      */
     Eigen::Vector3d getPanelSurfaceNormal( const int lineIndex, const int pointIndex )
     {
-        return panelSurfaceNormals_[ lineIndex ][ pointIndex ];
+        return panelSurfaceNormals_.row( getPanelIndex( lineIndex, pointIndex ) ).transpose( );
+    }
+
+    //! Get number of panels.
+    /*!
+     * Returns number of panels, i.e., ( numberOfLines_ - 1 ) * ( numberOfPoints_ - 1 ).
+     * \return Number of panels on mesh.
+     */
+    int getNumberOfPanels( ) const
+    {
+        return panelAreas_.rows( );
+    }
+
+    //! Get panel index.
+    /*!
+     * Returns index of a panel in the arrays of panel properties.
+     * \param lineIndex Line of panels.
+     * \param pointIndex Point from line.
+     * \return Panel index.
+     */
+    int getPanelIndex( const int lineIndex, const int pointIndex ) const
+    {
+        return lineIndex * ( numberOfPoints_ - 1 ) + pointIndex;
+    }
+
+    //! Get panel areas.
+    /*!
+     * Returns areas of all panels, see getPanelIndex( ) for ordering.
+     * \return Panel areas.
+     */
+    const Eigen::VectorXd& getPanelAreas( ) const
+    {
+        return panelAreas_;
+    }
+
+    //! Get panel centroids.
+    /*!
+     * Returns centroids of all panels as rows, see getPanelIndex( ) for ordering.
+     * \return Panel centroids.
+     */
+    const Eigen::Matrix< double, Eigen::Dynamic, 3 >& getPanelCentroids( ) const
+    {
+        return panelCentroids_;
+    }
+
+    //! Get outward panel surface normals.
+    /*!
+     * Returns outward surface normals of all panels as rows, see getPanelIndex( ) for ordering.
+     * \return Outward panel surface normals.
+     */
+    const Eigen::Matrix< double, Eigen::Dynamic, 3 >& getPanelSurfaceNormals( ) const
+    {
+        return panelSurfaceNormals_;
     }
 
     //! Get number of lines.
@@ -215,21 +271,22 @@ protected:
 
     //! Panel centroids.
     /*!
-     * 2-Dimensional array containing panel centroid locations.
+     * Matrix containing panel centroid locations as rows, see getPanelIndex( ) for ordering.
      */
-    boost::multi_array< Eigen::Vector3d, 2 > panelCentroids_;
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > panelCentroids_;
 
     //! Panel surface normals.
     /*!
-     * 2-Dimensional array containing outward panel surface normal vectors.
+     * Matrix containing outward panel surface normal vectors as rows, see getPanelIndex( ) for
+     * ordering.
      */
-    boost::multi_array< Eigen::Vector3d, 2 > panelSurfaceNormals_;
+    Eigen::Matrix< double, Eigen::Dynamic, 3 > panelSurfaceNormals_;
 
-    //! Panel doubles.
+    //! Panel areas.
     /*!
-     * 2-Dimensional array containing panel areas.
+     * Vector containing panel areas, see getPanelIndex( ) for ordering.
      */
-    boost::multi_array< double, 2 > panelAreas_;
+    Eigen::VectorXd panelAreas_;
 
     //! Total mesh surface area/
     /*!
@@ -32,6 +32,7 @@
  *      120529    E.A.G. Heeren     Boostified unit test.
  *      120615    T. Secretin       Added check for exception handling.
  *      120716    D. Dirkx          Updated with interpolator architecture.
+ *      261016    agent             Added test of interpolation at multiple values.
  *
  *    References
  *
@@ -237,6 +238,81 @@ BOOST_AUTO_TEST_CASE( test_cubicSplineInterpolator_matlab_compare )
                                        outputData, 1.0e-5 );
 }
 
+// Test interpolation at multiple values by comparing to interpolation at single values.
+BOOST_AUTO_TEST_CASE( test_cubicSplineInterpolator_multipleValues )
+{
+    using namespace interpolators;
+
+    // Load input data used for generating matlab interpolation.
+    Eigen::MatrixXd inputData = input_output::readMatrixFromFile(
+                input_output::getTudatRootPath( ) +
+                "Mathematics/Interpolators/UnitTests/interpolator_test_input_data.dat", "," );
+
+    // Put data in STL vectors.
+    std::vector< double > independentVariableValues;
+    std::vector< double > dependentVariableValues;
+    for ( int i = 0; i < inputData.rows( ); i++ )
+    {
+        independentVariableValues.push_back( inputData( i, 0 ) );
+        dependentVariableValues.push_back( inputData( i, 1 ) );
+    }
+
+    // Create cubic spline interpolator.
+    CubicSplineInterpolatorDouble cubicSplineInterpolator(
+                independentVariableValues, dependentVariableValues );
+
+    // Load points at which interpolator is to be evaluated and data generated by Matlab.
+    Eigen::MatrixXd benchmarkData = input_output::readMatrixFromFile(
+                input_output::getTudatRootPath( ) +
+                "Mathematics/Interpolators/UnitTests/"
+                + "cubic_spline_interpolator_test_output_data.dat", "," );
+
+    // Test 1: Interpolate at sorted values in single call and compare to Matlab data.
+    {
+        std::vector< double > targetValues;
+        for ( int i = 0; i < benchmarkData.rows( ); i++ )
+        {
+            targetValues.push_back( benchmarkData( i, 0 ) );
+        }
+
+        const std::vector< double > interpolatedValues =
+                cubicSplineInterpolator.interpolateMultipleValues( targetValues );
+
+        BOOST_CHECK_EQUAL( interpolatedValues.size( ), targetValues.size( ) );
+        for ( unsigned int i = 0; i < targetValues.size( ); i++ )
+        {
+            BOOST_CHECK_CLOSE_FRACTION( interpolatedValues[ i ], benchmarkData( i, 1 ), 1.0e-13 );
+        }
+    }
+
+    // Test 2: Interpolate at unsorted values, including knots and values outside of the table,
+    // and compare to interpolation at single values.
+    {
+        std::vector< double > targetValues;
+        targetValues.push_back( 2.9 );
+        targetValues.push_back( -4.0 );
+        targetValues.push_back( independentVariableValues[ 3 ] );
+        targetValues.push_back( 0.01 );
+        targetValues.push_back( 0.02 );
+        targetValues.push_back( 4.5 );
+        targetValues.push_back( independentVariableValues.back( ) );
+        targetValues.push_back( -2.5 );
+        targetValues.push_back( independentVariableValues.front( ) );
+        targetValues.push_back( 1.7 );
+
+        std::vector< double > interpolatedValues( 3, 0.0 );
+        cubicSplineInterpolator.interpolateMultipleValues( targetValues, interpolatedValues );
+
+        BOOST_CHECK_EQUAL( interpolatedValues.size( ), targetValues.size( ) );
+        for ( unsigned int i = 0; i < targetValues.size( ); i++ )
+        {
+            BOOST_CHECK_SMALL( interpolatedValues[ i ] -
+                               cubicSplineInterpolator.interpolate( targetValues[ i ] ),
+                               1.0e-14 );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
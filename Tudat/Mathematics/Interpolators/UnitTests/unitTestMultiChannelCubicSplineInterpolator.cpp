@@ -0,0 +1,173 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/InputOutput/matrixTextFileReader.h>
+
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/Mathematics/Interpolators/cubicSplineInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/multiChannelCubicSplineInterpolator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_multi_channel_cubic_spline_interpolator )
+
+// Test multi-channel cubic spline interpolator by comparing to single-channel cubic spline
+// interpolators.
+BOOST_AUTO_TEST_CASE( test_multiChannelCubicSplineInterpolator_singleChannelCompare )
+{
+    using namespace interpolators;
+
+    // Load input data, used as first channel.
+    Eigen::MatrixXd inputData = input_output::readMatrixFromFile(
+                input_output::getTudatRootPath( ) +
+                "Mathematics/Interpolators/UnitTests/interpolator_test_input_data.dat", "," );
+
+    // Set independent variable values, and three channels of dependent variable values.
+    const int numberOfDataPoints = inputData.rows( );
+    const int numberOfChannels = 3;
+    std::vector< double > independentVariableValues( numberOfDataPoints );
+    Eigen::MatrixXd dependentVariableValues( numberOfDataPoints, numberOfChannels );
+    for ( int i = 0; i < numberOfDataPoints; i++ )
+    {
+        independentVariableValues[ i ] = inputData( i, 0 );
+        dependentVariableValues( i, 0 ) = inputData( i, 1 );
+        dependentVariableValues( i, 1 ) = 1.0e5 * std::exp( -inputData( i, 0 ) );
+        dependentVariableValues( i, 2 ) = std::pow( inputData( i, 0 ), 3 ) - inputData( i, 0 );
+    }
+
+    // Create multi-channel interpolator, and single-channel interpolator for each channel.
+    MultiChannelCubicSplineInterpolatorDouble multiChannelInterpolator(
+                independentVariableValues, dependentVariableValues );
+    BOOST_CHECK_EQUAL( multiChannelInterpolator.getNumberOfChannels( ),
+                       static_cast< unsigned int >( numberOfChannels ) );
+
+    std::vector< CubicSplineInterpolatorDoublePointer > singleChannelInterpolators;
+    for ( int j = 0; j < numberOfChannels; j++ )
+    {
+        std::vector< double > channelValues( numberOfDataPoints );
+        for ( int i = 0; i < numberOfDataPoints; i++ )
+        {
+            channelValues[ i ] = dependentVariableValues( i, j );
+        }
+
+        singleChannelInterpolators.push_back(
+                    CubicSplineInterpolatorDoublePointer( new CubicSplineInterpolatorDouble(
+                                                              independentVariableValues,
+                                                              channelValues ) ) );
+    }
+
+    // Set target values, including values at and outside the boundaries of the data.
+    std::vector< double > targetValues;
+    for ( int i = 0; i <= 100; i++ )
+    {
+        targetValues.push_back( independentVariableValues.front( ) - 0.5 +
+                                ( independentVariableValues.back( ) -
+                                  independentVariableValues.front( ) + 1.0 ) * i / 100.0 );
+    }
+    targetValues.push_back( independentVariableValues[ 5 ] );
+    targetValues.push_back( independentVariableValues.back( ) );
+
+    // Interpolate at all target values in single call.
+    Eigen::MatrixXd multipleValueResults;
+    multiChannelInterpolator.interpolateMultipleValues( targetValues, multipleValueResults );
+    BOOST_CHECK_EQUAL( multipleValueResults.rows( ), numberOfChannels );
+    BOOST_CHECK_EQUAL( multipleValueResults.cols( ), static_cast< int >( targetValues.size( ) ) );
+
+    // Compare results of all interpolation functions to single-channel interpolators.
+    Eigen::VectorXd bufferResults( numberOfChannels );
+    for ( unsigned int i = 0; i < targetValues.size( ); i++ )
+    {
+        const Eigen::VectorXd vectorResults =
+                multiChannelInterpolator.interpolate( targetValues[ i ] );
+        multiChannelInterpolator.interpolate( targetValues[ i ], bufferResults.data( ) );
+
+        for ( int j = 0; j < numberOfChannels; j++ )
+        {
+            const double expectedValue =
+                    singleChannelInterpolators[ j ]->interpolate( targetValues[ i ] );
+            const double tolerance = 1.0e-14 * std::max( std::fabs( expectedValue ), 1.0 );
+
+            BOOST_CHECK_SMALL( vectorResults( j ) - expectedValue, tolerance );
+            BOOST_CHECK_SMALL( bufferResults( j ) - expectedValue, tolerance );
+            BOOST_CHECK_SMALL( multipleValueResults( j, i ) - expectedValue, tolerance );
+            BOOST_CHECK_SMALL( multiChannelInterpolator.interpolateChannel(
+                                   targetValues[ i ], j ) - expectedValue, tolerance );
+        }
+    }
+}
+
+// Test exception handling of multi-channel cubic spline interpolator.
+BOOST_AUTO_TEST_CASE( test_multiChannelCubicSplineInterpolator_exceptions )
+{
+    using namespace interpolators;
+
+    std::vector< double > independentVariableValues;
+    independentVariableValues.push_back( 0.0 );
+    independentVariableValues.push_back( 1.0 );
+    independentVariableValues.push_back( 2.0 );
+
+    // Test 1: Empty data.
+    BOOST_CHECK_THROW( MultiChannelCubicSplineInterpolatorDouble(
+                           std::vector< double >( ), Eigen::MatrixXd( ) ), std::runtime_error );
+
+    // Test 2: Inconsistent number of data points.
+    BOOST_CHECK_THROW( MultiChannelCubicSplineInterpolatorDouble(
+                           independentVariableValues, Eigen::MatrixXd::Zero( 4, 2 ) ),
+                       std::runtime_error );
+
+    // Test 3: Insufficient number of data points.
+    independentVariableValues.pop_back( );
+    BOOST_CHECK_THROW( MultiChannelCubicSplineInterpolatorDouble(
+                           independentVariableValues, Eigen::MatrixXd::Zero( 2, 2 ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
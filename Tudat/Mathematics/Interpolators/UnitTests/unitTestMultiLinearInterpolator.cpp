@@ -25,6 +25,8 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      122027    A. Ronse          File created.
+ *      261016    agent             Added test of interpolation of vector-valued dependent data
+ *                                  and of interpolation taking fixed-size array.
  *
  *    References
  *
@@ -34,6 +36,7 @@
 
 #define BOOST_TEST_MAIN
 
+#include <boost/array.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/multi_array.hpp>
 
@@ -41,6 +44,8 @@
 #include <vector>
 #include <cmath>
 
+#include <Eigen/Core>
+
 #include <TudatCore/Basics/testMacros.h>
 #include <TudatCore/InputOutput/matrixTextFileReader.h>
 
@@ -172,6 +177,95 @@ BOOST_AUTO_TEST_CASE( test4Dimensions )
                                 std::numeric_limits< double >::epsilon( ) );
 }
 
+// Test 3: 3-dimensional test of vector-valued dependent data, such as aerodynamic coefficients.
+// Comparison to interpolation of each entry separately.
+BOOST_AUTO_TEST_CASE( test3DimensionsVectorValued )
+{
+    typedef Eigen::Matrix< double, 6, 1 > Vector6d;
+
+    // Create independent variable vector, with non-uniform spacing in first dimension.
+    std::vector< std::vector< double > > independentValues;
+    independentValues.resize( 3 );
+    for ( int i = 0; i < 6; i++ )
+    {
+        independentValues[ 0 ].push_back( 3.0 + std::pow( static_cast< double >( i ), 2.0 ) );
+    }
+
+    for ( int i = 0; i < 9; i++ )
+    {
+        independentValues[ 1 ].push_back( -0.5 + static_cast< double >( i ) * 0.125 );
+    }
+
+    independentValues[ 2 ].push_back( 0.0 );
+    independentValues[ 2 ].push_back( 0.02 );
+
+    // Create three-dimensional arrays for vector-valued dependent values and for each entry of
+    // the dependent values separately, based on analytical functions.
+    boost::multi_array< Vector6d, 3 > dependentValues;
+    dependentValues.resize( boost::extents[ 6 ][ 9 ][ 2 ] );
+    std::vector< boost::multi_array< double, 3 > > dependentValueEntries( 6 );
+
+    for ( int l = 0; l < 6; l++ )
+    {
+        dependentValueEntries[ l ].resize( boost::extents[ 6 ][ 9 ][ 2 ] );
+    }
+
+    for ( int i = 0; i < 6; i++ )
+    {
+        for ( int j = 0; j < 9; j++ )
+        {
+            for ( int k = 0; k < 2; k++ )
+            {
+                for ( int l = 0; l < 6; l++ )
+                {
+                    dependentValues[ i ][ j ][ k ]( l ) =
+                            std::sin( static_cast< double >( l + 1 ) * independentValues[ 1 ][ j ]
+                                      + independentValues[ 2 ][ k ] )
+                            / independentValues[ 0 ][ i ];
+                    dependentValueEntries[ l ][ i ][ j ][ k ] = dependentValues[ i ][ j ][ k ]( l );
+                }
+            }
+        }
+    }
+
+    // Initialize interpolators.
+    interpolators::MultiLinearInterpolator< double, Vector6d, 3 > vectorInterpolator(
+            independentValues, dependentValues );
+    std::vector< boost::shared_ptr< interpolators::MultiLinearInterpolator< double, double, 3 > > >
+            entryInterpolators( 6 );
+    for ( int l = 0; l < 6; l++ )
+    {
+        entryInterpolators[ l ] = boost::shared_ptr<
+                interpolators::MultiLinearInterpolator< double, double, 3 > >(
+                    new interpolators::MultiLinearInterpolator< double, double, 3 >(
+                        independentValues, dependentValueEntries[ l ] ) );
+    }
+
+    // Interpolate at a number of target values, passed both as vector and as array, including
+    // values at data points.
+    std::vector< double > targetValue( 3 );
+    boost::array< double, 3 > targetValueArray;
+    for ( int m = 0; m < 25; m++ )
+    {
+        targetValue[ 0 ] = 3.0 + static_cast< double >( m );
+        targetValue[ 1 ] = -0.5 + static_cast< double >( m ) * 0.04;
+        targetValue[ 2 ] = 0.02 * static_cast< double >( m % 5 ) / 4.0;
+        std::copy( targetValue.begin( ), targetValue.end( ), targetValueArray.begin( ) );
+
+        const Vector6d interpolationResult = vectorInterpolator.interpolate( targetValue );
+        const Vector6d arrayInterpolationResult
+                = vectorInterpolator.interpolate( targetValueArray );
+
+        // Check that interpolated vector is equal to separately interpolated entries.
+        for ( int l = 0; l < 6; l++ )
+        {
+            BOOST_CHECK_EQUAL( interpolationResult( l ),
+                               entryInterpolators[ l ]->interpolate( targetValue ) );
+            BOOST_CHECK_EQUAL( arrayInterpolationResult( l ), interpolationResult( l ) );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -31,6 +31,8 @@
  *                                  Moved (con/de)structors and getter/setters to header.
  *      120716    D. Dirkx          Updated with interpolator architecture.
  *      130114    D. Dirkx          Fixed iterator bug.
+ *      261016    agent             Added precomputed polynomial coefficients and evaluation at
+ *                                  multiple values.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -45,6 +47,8 @@
 
 #include <cmath>
 #include <iostream>
+#include <map>
+#include <vector>
 
 #include <Eigen/Core>
 
@@ -184,8 +188,9 @@ public:
                          " not of same size in cubic spline constrcutor" << std::endl;
         }
 
-        // Calculate second derivatives of curve.
+        // Calculate second derivatives of curve and polynomial coefficients of intervals.
         calculateSecondDerivatives( );
+        calculatePolynomialCoefficients( );
     }
 
     //! Cubic spline interpolator constructor.
@@ -226,8 +231,9 @@ public:
         // Create zero value for initializing output.
         zeroValue_ = dependentValues_[ 0 ] - dependentValues_[ 0 ];
 
-        // Calculate second derivatives of curve.
+        // Calculate second derivatives of curve and polynomial coefficients of intervals.
         calculateSecondDerivatives( );
+        calculatePolynomialCoefficients( );
     }
 
     // Statement required to prevent hiding of base class functions.
@@ -244,39 +250,125 @@ public:
     DependentVariableType interpolate(
             const IndependentVariableType targetIndependentVariableValue )
     {
-        using std::pow;
-
         // Determine the lower entry in the table corresponding to the target independent variable
         // value.
         int lowerEntry_ = lookUpScheme_->findNearestLowerNeighbour(
                     targetIndependentVariableValue );
 
-        // Get independent variable values bounding interval in which requested value lies.
-        IndependentVariableType lowerValue, upperValue, squareDifference;
-        lowerValue = independentValues_[ lowerEntry_ ];
-        upperValue = independentValues_[ lowerEntry_ + 1 ];
-
-        // Calculate coefficients A,B,C,D (see Numerical (Press W.H., et al., 2002))
-        squareDifference = ( upperValue - lowerValue ) * ( upperValue - lowerValue );
-        IndependentVariableType coefficientA_ = ( upperValue - targetIndependentVariableValue )
-                / ( upperValue - lowerValue );
-        IndependentVariableType coefficientB_ = 1 - coefficientA_;
-        IndependentVariableType coefficientC_ = ( coefficientA_ * coefficientA_ * coefficientA_ -
-                                                  coefficientA_ ) / 6.0 * squareDifference;
-        IndependentVariableType coefficientD_ = ( coefficientB_ * coefficientB_ * coefficientB_ -
-                                                  coefficientB_ ) / 6.0 * squareDifference;
-
         // The interpolated dependent variable value.
-        return coefficientA_ * dependentValues_[ lowerEntry_ ] +
-                coefficientB_ * dependentValues_[ lowerEntry_ + 1 ] +
-                coefficientC_ * secondDerivativeOfCurve_[ lowerEntry_ ] +
-                coefficientD_ * secondDerivativeOfCurve_[ lowerEntry_ + 1 ];
+        return evaluatePolynomialOfInterval( lowerEntry_, targetIndependentVariableValue );
+    }
+
+    //! Interpolate at multiple values.
+    /*!
+     * Executes interpolation of data at a series of target values of the independent variable.
+     * The intervals in which the target values lie are found in a single forward sweep through
+     * the independent variable values when the target values are sorted in ascending order, which
+     * is the typical case when resampling tabulated data. Unsorted target values are allowed, but
+     * require a binary search whenever a target value is smaller than its predecessor. The
+     * polynomials are subsequently evaluated in a separate loop without branches, which can be
+     * vectorized by the compiler. This function does not use or modify the look-up scheme of the
+     * interpolator, and can therefore be called concurrently from multiple threads.
+     * \param targetIndependentVariableValues Target independent variable values at which the
+     *          interpolation is performed.
+     * \param interpolatedValues Interpolated dependent variable values (returned by reference).
+     *          Resized to the number of target values.
+     */
+    void interpolateMultipleValues(
+            const std::vector< IndependentVariableType >& targetIndependentVariableValues,
+            std::vector< DependentVariableType >& interpolatedValues ) const
+    {
+        const unsigned int numberOfTargetValues = targetIndependentVariableValues.size( );
+        interpolatedValues.resize( numberOfTargetValues, zeroValue_ );
+
+        // Determine the lower entries in the table for all target values.
+        std::vector< int > lowerEntries( numberOfTargetValues );
+        int lowerEntry = 0;
+        for ( unsigned int i = 0; i < numberOfTargetValues; i++ )
+        {
+            lowerEntry = basic_mathematics::findNearestLeftNeighbourUsingForwardSweep(
+                        targetIndependentVariableValues[ i ], lowerEntry, independentValues_ );
+            lowerEntries[ i ] = lowerEntry;
+        }
+
+        // Evaluate polynomials of intervals.
+        for ( unsigned int i = 0; i < numberOfTargetValues; i++ )
+        {
+            interpolatedValues[ i ] = evaluatePolynomialOfInterval(
+                        lowerEntries[ i ], targetIndependentVariableValues[ i ] );
+        }
+    }
+
+    //! Interpolate at multiple values.
+    /*!
+     * Executes interpolation of data at a series of target values of the independent variable,
+     * see the overloaded function for details.
+     * \param targetIndependentVariableValues Target independent variable values at which the
+     *          interpolation is performed.
+     * \return Interpolated dependent variable values.
+     */
+    std::vector< DependentVariableType > interpolateMultipleValues(
+            const std::vector< IndependentVariableType >& targetIndependentVariableValues ) const
+    {
+        std::vector< DependentVariableType > interpolatedValues;
+        interpolateMultipleValues( targetIndependentVariableValues, interpolatedValues );
+        return interpolatedValues;
     }
 
 protected:
 
 private:
 
+    //! Evaluate polynomial of interval.
+    /*!
+     * Evaluates the cubic polynomial of a given interval, using the precomputed coefficients.
+     * \param lowerEntry Lower entry in the table of the interval.
+     * \param targetIndependentVariableValue Target independent variable value.
+     * \return Interpolated dependent variable value.
+     */
+    DependentVariableType evaluatePolynomialOfInterval(
+            const int lowerEntry,
+            const IndependentVariableType targetIndependentVariableValue ) const
+    {
+        const IndependentVariableType offset =
+                targetIndependentVariableValue - independentValues_[ lowerEntry ];
+        const DependentVariableType* coefficients = &polynomialCoefficients_[ 4 * lowerEntry ];
+
+        // Evaluate polynomial using Horner's scheme.
+        return coefficients[ 0 ] + offset * (
+                    coefficients[ 1 ] + offset * (
+                        coefficients[ 2 ] + offset * coefficients[ 3 ] ) );
+    }
+
+    //! Calculates the polynomial coefficients of each interval.
+    /*!
+     * This function calculates the coefficients of the cubic polynomial in each interval, in
+     * terms of the offset from the lower independent variable value of the interval, from the
+     * dependent values and the second derivatives of the curve at the nodes. This avoids
+     * recomputing the interval width and the coefficients (Press W.H., et al., 2002) for each
+     * interpolation. The four coefficients of an interval are stored contiguously.
+     */
+    void calculatePolynomialCoefficients( )
+    {
+        polynomialCoefficients_.resize( 4 * ( numberOfDataPoints_ - 1 ), zeroValue_ );
+
+        for ( unsigned int i = 0; i < numberOfDataPoints_ - 1; i++ )
+        {
+            const IndependentVariableType intervalWidth =
+                    independentValues_[ i + 1 ] - independentValues_[ i ];
+
+            polynomialCoefficients_[ 4 * i ] = dependentValues_[ i ];
+            polynomialCoefficients_[ 4 * i + 1 ] =
+                    ( dependentValues_[ i + 1 ] - dependentValues_[ i ] ) / intervalWidth -
+                    ( 2.0 * secondDerivativeOfCurve_[ i ] + secondDerivativeOfCurve_[ i + 1 ] ) *
+                    ( intervalWidth / 6.0 );
+            polynomialCoefficients_[ 4 * i + 2 ] = secondDerivativeOfCurve_[ i ] / 2.0;
+            polynomialCoefficients_[ 4 * i + 3 ] =
+                    ( secondDerivativeOfCurve_[ i + 1 ] - secondDerivativeOfCurve_[ i ] ) /
+                    ( 6.0 * intervalWidth );
+        }
+    }
+
     //! Calculates the second derivatives of the curve.
     /*!
      * This function calculates the second derivatives of the curve at the nodes, assuming
@@ -360,6 +452,14 @@ private:
      */
     std::vector< DependentVariableType > secondDerivativeOfCurve_;
 
+    //! Polynomial coefficients of each interval.
+    /*!
+     * Coefficients of the cubic polynomial of each interval, in terms of the offset from the lower
+     * independent variable value of the interval, in order of increasing power. The coefficients
+     * of interval i are stored at entries 4i to 4i+3.
+     */
+    std::vector< DependentVariableType > polynomialCoefficients_;
+
     //! The number of datapoints.
     /*!
      * The number of datapoints.
@@ -0,0 +1,394 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *
+ *    References
+ *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *
+ *    Notes
+ *
+ */
+
+#ifndef TUDAT_MULTI_CHANNEL_CUBIC_SPLINE_INTERPOLATOR_H
+#define TUDAT_MULTI_CHANNEL_CUBIC_SPLINE_INTERPOLATOR_H
+
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <boost/exception/all.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Mathematics/BasicMathematics/nearestNeighbourSearch.h"
+#include "Tudat/Mathematics/Interpolators/oneDimensionalInterpolator.h"
+
+namespace tudat
+{
+namespace interpolators
+{
+
+//! Multi-channel cubic spline interpolator, implementation from (Press W.H., et al., 2002).
+/*!
+ * Cubic spline interpolator for a number of dependent variables (channels) that are tabulated at
+ * the same independent variable values, such as the components of a state vector, or the
+ * density, pressure and temperature of an atmosphere table. Each channel is interpolated with
+ * the same natural cubic spline as the CubicSplineInterpolator, but the interval look-up and the
+ * factorisation of the tridiagonal matrix, which depend only on the independent variable values,
+ * are shared by all channels. The polynomial coefficients of the channels are stored interleaved
+ * per interval, so that an interpolation only accesses one contiguous block of memory.
+ * \tparam IndependentVariableType Type of independent variables.
+ */
+template< typename IndependentVariableType >
+class MultiChannelCubicSplineInterpolator :
+        public OneDimensionalInterpolator< IndependentVariableType, Eigen::VectorXd >
+{
+public:
+
+    using OneDimensionalInterpolator< IndependentVariableType, Eigen::VectorXd >::
+    independentValues_;
+    using OneDimensionalInterpolator< IndependentVariableType, Eigen::VectorXd >::
+    lookUpScheme_;
+
+    //! Multi-channel cubic spline interpolator constructor.
+    /*!
+     * Multi-channel cubic spline interpolator constructor, taking a vector of independent
+     * variable values and a matrix of dependent variable values. Note that the dependent variable
+     * values are only stored in the form of polynomial coefficients, so that the
+     * dependentValues_ member of the base class is not set.
+     * \param independentVariables Vector with the independent variable values, sorted in
+     *          ascending order.
+     * \param dependentVariables Matrix with the dependent variable values, with one row per
+     *          independent variable value and one column per channel.
+     * \param selectedLookupScheme Look-up scheme that is to be used when finding interval
+     *          of requested independent variable value.
+     * \throws std::runtime_error If the input is empty, if fewer than three independent variable
+     *          values are provided, or if the number of rows of the dependent variables does not
+     *          match the number of independent variable values.
+     */
+    MultiChannelCubicSplineInterpolator(
+            const std::vector< IndependentVariableType >& independentVariables,
+            const Eigen::MatrixXd& dependentVariables,
+            const AvailableLookupScheme selectedLookupScheme = hunting_algorithm )
+    {
+        // Verify that the initialization variables are not empty, and are of consistent size.
+        if ( independentVariables.size( ) == 0 || dependentVariables.size( ) == 0 )
+        {
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+               "The data used in the multi-channel cubic spline interpolator initialization are "
+               "empty." ) ) );
+        }
+
+        if ( independentVariables.size( ) < 3 )
+        {
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+               "At least three data points are required by the multi-channel cubic spline "
+               "interpolator." ) ) );
+        }
+
+        if ( static_cast< int >( independentVariables.size( ) ) != dependentVariables.rows( ) )
+        {
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+               "The numbers of independent and dependent variable values in the multi-channel "
+               "cubic spline interpolator initialization are not equal." ) ) );
+        }
+
+        // Set independent variable values and sizes.
+        independentValues_ = independentVariables;
+        numberOfDataPoints_ = independentVariables.size( );
+        numberOfChannels_ = dependentVariables.cols( );
+
+        // Create lookup scheme.
+        this->makeLookupScheme( selectedLookupScheme );
+
+        // Calculate polynomial coefficients of all channels.
+        calculatePolynomialCoefficients( dependentVariables );
+    }
+
+    // Statement required to prevent hiding of base class functions.
+    using OneDimensionalInterpolator< IndependentVariableType, Eigen::VectorXd >::interpolate;
+
+    //! Interpolate.
+    /*!
+     * Executes interpolation of all channels at a given target value of the independent
+     * variable.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     *          the interpolation is performed.
+     * \return Interpolated dependent variable values of all channels.
+     */
+    Eigen::VectorXd interpolate( const IndependentVariableType targetIndependentVariableValue )
+    {
+        Eigen::VectorXd interpolatedValues( numberOfChannels_ );
+        interpolate( targetIndependentVariableValue, interpolatedValues.data( ) );
+        return interpolatedValues;
+    }
+
+    //! Interpolate, without allocating memory.
+    /*!
+     * Executes interpolation of all channels at a given target value of the independent
+     * variable, and writes the result to a user-provided buffer.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     *          the interpolation is performed.
+     * \param interpolatedValues Pointer to buffer of at least getNumberOfChannels( ) entries, to
+     *          which the interpolated values of all channels are written.
+     */
+    void interpolate( const IndependentVariableType targetIndependentVariableValue,
+                      double* interpolatedValues )
+    {
+        // Determine the lower entry in the table corresponding to the target independent variable
+        // value.
+        const int lowerEntry = lookUpScheme_->findNearestLowerNeighbour(
+                    targetIndependentVariableValue );
+
+        evaluatePolynomialsOfInterval( lowerEntry, targetIndependentVariableValue,
+                                       interpolatedValues );
+    }
+
+    //! Interpolate single channel.
+    /*!
+     * Executes interpolation of a single channel at a given target value of the independent
+     * variable.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     *          the interpolation is performed.
+     * \param channelIndex Index of channel that is to be interpolated.
+     * \return Interpolated dependent variable value of requested channel.
+     */
+    double interpolateChannel( const IndependentVariableType targetIndependentVariableValue,
+                               const unsigned int channelIndex )
+    {
+        // Determine the lower entry in the table corresponding to the target independent variable
+        // value.
+        const int lowerEntry = lookUpScheme_->findNearestLowerNeighbour(
+                    targetIndependentVariableValue );
+
+        const double offset = targetIndependentVariableValue - independentValues_[ lowerEntry ];
+        const double* coefficients =
+                &polynomialCoefficients_[ 4 * numberOfChannels_ * lowerEntry + channelIndex ];
+
+        // Evaluate polynomial using Horner's scheme.
+        return coefficients[ 0 ] + offset * (
+                    coefficients[ numberOfChannels_ ] + offset * (
+                        coefficients[ 2 * numberOfChannels_ ] +
+                        offset * coefficients[ 3 * numberOfChannels_ ] ) );
+    }
+
+    //! Interpolate at multiple values.
+    /*!
+     * Executes interpolation of all channels at a series of target values of the independent
+     * variable. As for the CubicSplineInterpolator, the intervals are found in a single forward
+     * sweep for target values sorted in ascending order, and the look-up scheme of the
+     * interpolator is not used, so that this function can be called concurrently from multiple
+     * threads.
+     * \param targetIndependentVariableValues Target independent variable values at which the
+     *          interpolation is performed.
+     * \param interpolatedValues Interpolated dependent variable values (returned by reference),
+     *          with one row per channel and one column per target value.
+     */
+    void interpolateMultipleValues(
+            const std::vector< IndependentVariableType >& targetIndependentVariableValues,
+            Eigen::MatrixXd& interpolatedValues ) const
+    {
+        interpolatedValues.resize( numberOfChannels_, targetIndependentVariableValues.size( ) );
+
+        int lowerEntry = 0;
+        for ( unsigned int i = 0; i < targetIndependentVariableValues.size( ); i++ )
+        {
+            lowerEntry = basic_mathematics::findNearestLeftNeighbourUsingForwardSweep(
+                        targetIndependentVariableValues[ i ], lowerEntry, independentValues_ );
+            evaluatePolynomialsOfInterval( lowerEntry, targetIndependentVariableValues[ i ],
+                                           interpolatedValues.col( i ).data( ) );
+        }
+    }
+
+    //! Get number of channels.
+    /*!
+     * Returns the number of channels (dependent variables) of the interpolator.
+     * \return Number of channels.
+     */
+    unsigned int getNumberOfChannels( ) const { return numberOfChannels_; }
+
+protected:
+
+private:
+
+    //! Evaluate polynomials of all channels in interval.
+    /*!
+     * Evaluates the cubic polynomials of all channels in a given interval, using the
+     * precomputed coefficients.
+     * \param lowerEntry Lower entry in the table of the interval.
+     * \param targetIndependentVariableValue Target independent variable value.
+     * \param interpolatedValues Pointer to buffer to which interpolated values are written.
+     */
+    void evaluatePolynomialsOfInterval(
+            const int lowerEntry,
+            const IndependentVariableType targetIndependentVariableValue,
+            double* interpolatedValues ) const
+    {
+        const double offset = targetIndependentVariableValue - independentValues_[ lowerEntry ];
+        const double* constantCoefficients =
+                &polynomialCoefficients_[ 4 * numberOfChannels_ * lowerEntry ];
+        const double* linearCoefficients = constantCoefficients + numberOfChannels_;
+        const double* quadraticCoefficients = linearCoefficients + numberOfChannels_;
+        const double* cubicCoefficients = quadraticCoefficients + numberOfChannels_;
+
+        // Evaluate polynomials using Horner's scheme.
+        for ( unsigned int j = 0; j < numberOfChannels_; j++ )
+        {
+            interpolatedValues[ j ] = constantCoefficients[ j ] + offset * (
+                        linearCoefficients[ j ] + offset * (
+                            quadraticCoefficients[ j ] + offset * cubicCoefficients[ j ] ) );
+        }
+    }
+
+    //! Calculates the polynomial coefficients of all channels.
+    /*!
+     * This function calculates the second derivatives of the curves of all channels at the
+     * nodes, imposing natural spline conditions as in the CubicSplineInterpolator. The
+     * tridiagonal matrix is factorised once, after which the system is solved for all channels
+     * simultaneously, using the algorithm from (Press W.H., et al., 2002). Subsequently, the
+     * coefficients of the cubic polynomials in each interval are calculated, in terms of the
+     * offset from the lower independent variable value of the interval.
+     * \param dependentVariables Matrix with the dependent variable values, with one row per
+     *          independent variable value and one column per channel.
+     */
+    void calculatePolynomialCoefficients( const Eigen::MatrixXd& dependentVariables )
+    {
+        const unsigned int numberOfEquations = numberOfDataPoints_ - 2;
+
+        // Compute interval widths.
+        std::vector< double > intervalWidths( numberOfDataPoints_ - 1 );
+        for ( unsigned int i = 0; i < numberOfDataPoints_ - 1; i++ )
+        {
+            intervalWidths[ i ] = independentValues_[ i + 1 ] - independentValues_[ i ];
+        }
+
+        // Factorise tridiagonal matrix, with diagonal 2 ( h_i + h_i+1 ) and sub- and
+        // super-diagonal h_i+1.
+        std::vector< double > scalingFactors( numberOfEquations );
+        std::vector< double > intermediateVector( numberOfEquations );
+        scalingFactors[ 0 ] = 2.0 * ( intervalWidths[ 1 ] + intervalWidths[ 0 ] );
+        for ( unsigned int i = 1; i < numberOfEquations; i++ )
+        {
+            intermediateVector[ i ] = intervalWidths[ i ] / scalingFactors[ i - 1 ];
+            scalingFactors[ i ] = 2.0 * ( intervalWidths[ i + 1 ] + intervalWidths[ i ] ) -
+                    intervalWidths[ i ] * intermediateVector[ i ];
+        }
+
+        // Solve tridiagonal system for all channels, storing the second derivatives of all
+        // channels at a node contiguously. The second derivatives at the end points are zero
+        // (natural spline condition).
+        std::vector< double > secondDerivatives( numberOfDataPoints_ * numberOfChannels_, 0.0 );
+        for ( unsigned int i = 0; i < numberOfEquations; i++ )
+        {
+            double* currentSecondDerivatives = &secondDerivatives[ ( i + 1 ) * numberOfChannels_ ];
+            const double* previousSecondDerivatives = currentSecondDerivatives - numberOfChannels_;
+            for ( unsigned int j = 0; j < numberOfChannels_; j++ )
+            {
+                const double rightHandSide = 6.0 * (
+                            ( dependentVariables( i + 2, j ) - dependentVariables( i + 1, j ) ) /
+                            intervalWidths[ i + 1 ] -
+                            ( dependentVariables( i + 1, j ) - dependentVariables( i, j ) ) /
+                            intervalWidths[ i ] );
+                currentSecondDerivatives[ j ] = ( i == 0 ) ?
+                            rightHandSide / scalingFactors[ i ] :
+                            ( rightHandSide - intervalWidths[ i ] *
+                              previousSecondDerivatives[ j ] ) / scalingFactors[ i ];
+            }
+        }
+
+        for ( int i = static_cast< int >( numberOfEquations ) - 2; i >= 0; i-- )
+        {
+            double* currentSecondDerivatives = &secondDerivatives[ ( i + 1 ) * numberOfChannels_ ];
+            const double* nextSecondDerivatives = currentSecondDerivatives + numberOfChannels_;
+            for ( unsigned int j = 0; j < numberOfChannels_; j++ )
+            {
+                currentSecondDerivatives[ j ] -=
+                        intermediateVector[ i + 1 ] * nextSecondDerivatives[ j ];
+            }
+        }
+
+        // Calculate polynomial coefficients of each interval, storing the coefficients of all
+        // channels for the same power contiguously.
+        polynomialCoefficients_.resize( 4 * numberOfChannels_ * ( numberOfDataPoints_ - 1 ) );
+        for ( unsigned int i = 0; i < numberOfDataPoints_ - 1; i++ )
+        {
+            const double intervalWidth = intervalWidths[ i ];
+            const double* lowerSecondDerivatives = &secondDerivatives[ i * numberOfChannels_ ];
+            const double* upperSecondDerivatives = lowerSecondDerivatives + numberOfChannels_;
+            double* coefficients = &polynomialCoefficients_[ 4 * numberOfChannels_ * i ];
+
+            for ( unsigned int j = 0; j < numberOfChannels_; j++ )
+            {
+                coefficients[ j ] = dependentVariables( i, j );
+                coefficients[ numberOfChannels_ + j ] =
+                        ( dependentVariables( i + 1, j ) - dependentVariables( i, j ) ) /
+                        intervalWidth -
+                        ( 2.0 * lowerSecondDerivatives[ j ] + upperSecondDerivatives[ j ] ) *
+                        ( intervalWidth / 6.0 );
+                coefficients[ 2 * numberOfChannels_ + j ] = lowerSecondDerivatives[ j ] / 2.0;
+                coefficients[ 3 * numberOfChannels_ + j ] =
+                        ( upperSecondDerivatives[ j ] - lowerSecondDerivatives[ j ] ) /
+                        ( 6.0 * intervalWidth );
+            }
+        }
+    }
+
+    //! The number of datapoints.
+    /*!
+     * The number of datapoints.
+     */
+    unsigned int numberOfDataPoints_;
+
+    //! The number of channels.
+    /*!
+     * The number of channels (dependent variables).
+     */
+    unsigned int numberOfChannels_;
+
+    //! Polynomial coefficients of each interval.
+    /*!
+     * Coefficients of the cubic polynomials of each interval, in terms of the offset from the
+     * lower independent variable value of the interval. The coefficients of interval i are
+     * stored at entries 4 m i to 4 m ( i + 1 ) - 1, with m the number of channels, ordered by
+     * increasing power and then by channel.
+     */
+    std::vector< double > polynomialCoefficients_;
+};
+
+//! Typedef for multi-channel cubic spline interpolator with independent = double.
+typedef MultiChannelCubicSplineInterpolator< double > MultiChannelCubicSplineInterpolatorDouble;
+
+//! Typedef for shared-pointer to multi-channel cubic spline interpolator with independent =
+//! double.
+typedef boost::shared_ptr< MultiChannelCubicSplineInterpolatorDouble >
+MultiChannelCubicSplineInterpolatorDoublePointer;
+
+} // namespace interpolators
+} // namespace tudat
+
+#endif // TUDAT_MULTI_CHANNEL_CUBIC_SPLINE_INTERPOLATOR_H
@@ -27,6 +27,9 @@
  *                D. Dirkx          File created.
  *      121027    A. Ronse          Adapted for addition to Tudat.
  *      131227    K. Kumar          Added note about spurious warning in older GCC versions.
+ *      261016    agent             Replaced recursive interpolation by non-recursive
+ *                                  interpolation without memory allocation, added interpolation
+ *                                  taking fixed-size array of independent variables.
  *
  *    References
  *     Stackoverflow. C++ GCC4.4 warning: array subscript is above array bounds, 2009,
@@ -51,6 +54,7 @@
 #ifndef TUDAT_MULTI_LINEAR_INTERPOLATOR_H
 #define TUDAT_MULTI_LINEAR_INTERPOLATOR_H
 
+#include <cstddef>
 #include <iostream>
 #include <vector>
 
@@ -70,8 +74,9 @@ namespace interpolators
 //! Class for performing multi-linear interpolation for arbitrary number of independent variables.
 /*!
  * Class for performing multi-linear interpolation for arbitrary number of independent variables.
- * Interpolation is calculated recursively over all dimensions of independent variables. Note
- * that the types (i.e. double, float) of all independent variables must be the same.
+ * Interpolation is calculated successively over all dimensions of independent variables, from
+ * the values at the corners of the grid hyper-rectangle in which the independent variables lie.
+ * Note that the types (i.e. double, float) of all independent variables must be the same.
  * \tparam IndependentVariableType Type for independent variables.
  * \tparam DependentVariableType Type for dependent variable.
  * \tparam numberOfDimensions Number of independent variables.
@@ -115,6 +120,7 @@ public:
         }
 
         makeLookupSchemes( selectedLookupScheme );
+        computeCornerOffsets( );
     }
 
     //! Function to perform interpolation.
@@ -127,27 +133,23 @@ public:
     DependentVariableType interpolate(
             const std::vector< IndependentVariableType >& independentValuesToInterpolate )
     {
-        // Determine the nearest lower neighbours.
-        std::vector< int > nearestLowerIndices;
-        nearestLowerIndices.resize( numberOfDimensions );
-        for ( unsigned int i = 0; i < numberOfDimensions; i++ )
-        {
-            nearestLowerIndices[ i ] = lookUpSchemes_[ i ]->findNearestLowerNeighbour(
-                    independentValuesToInterpolate[ i ] );
-        }
-
-        // Initialize function evaluation indices to -1 for debugging purposes.
-        boost::array< int, numberOfDimensions > interpolationIndices;
-        for ( int i = 0; i < numberOfDimensions; i++ )
-        {
-            interpolationIndices[ i ] = -1;
-        }
+        return performInterpolation( &independentValuesToInterpolate[ 0 ] );
+    }
 
-        // Call first step of interpolation, this function calls itself at subsequent independent
-        // variable dimensions to evaluate and properly scale dependent variable table values at
-        // all 2^n grid edges.
-        return performRecursiveInterpolationStep( 0, independentValuesToInterpolate,
-                                                  interpolationIndices, nearestLowerIndices );
+    //! Function to perform interpolation, with independent variables as fixed-size array.
+    /*!
+     *  This function performs the multilinear interpolation, taking the values of the
+     *  independent variables as fixed-size array. Contrary to the version taking a vector, this
+     *  function does not require the caller to allocate memory for the values.
+     *  \param independentVariableValues Array of values of independent variables at which
+     *  the value of the dependent variable is to be determined.
+     *  \return Interpolated value of dependent variable in all dimensions.
+     */
+    DependentVariableType interpolate(
+            const boost::array< IndependentVariableType, numberOfDimensions >&
+            independentValuesToInterpolate )
+    {
+        return performInterpolation( independentValuesToInterpolate.data( ) );
     }
 
 
@@ -198,76 +200,86 @@ private:
         }
     }
 
-    //! Perform the step in a single dimension of the interpolation process.
+    //! Compute offsets of corners of grid hyper-rectangle.
+    /*!
+     * Computes the offsets in the storage of dependentData_ of the 2^{numberOfDimensions}
+     * corners of a hyper-rectangle of the grid, with respect to its lower corner. The bit
+     * ( numberOfDimensions - 1 - i ) of the index of a corner is set if the corner is at the
+     * upper data point in dimension i.
+     */
+    void computeCornerOffsets( )
+    {
+        for ( unsigned int corner = 0; corner < numberOfCorners; corner++ )
+        {
+            cornerOffsets_[ corner ] = 0;
+            for ( int i = 0; i < numberOfDimensions; i++ )
+            {
+                if ( corner & ( 1 << ( numberOfDimensions - 1 - i ) ) )
+                {
+                    cornerOffsets_[ corner ] += dependentData_.strides( )[ i ];
+                }
+            }
+        }
+    }
+
+    //! Perform the interpolation.
     /*!
-     * Function calculates single dimension of the interpolation process. Function calls itself if
-     * final dimension not yet reached. Calling this function with currentVariable = 0 will result
-     * in 2^{numberOfDimensions} number of calls to the function at currentVariable =
-     * numberOfDimensions -1. As such, the complete series of calls, starting at currentVariable =
-     * 0, retrieves the dependent variable values at all edges of the grid hyper-rectangle and
-     * properly scales them.
-     * \param currentVariable Dimension in which this interpolation step is to be performed.
-     * \param independentValuesToInterpolate Vector of values of independent variables at which
-     *          interpolation is to be performed.
-     * \param currentArrayIndices Array of indices modified at index = currentVariable at each
-     *          call of function. Variable is passed to dependentData in highest step to return
-     *          data for interpolation.
-     *  \return Interpolated value in a single dimension
+     * Performs the interpolation, by retrieving the dependent variable values at all
+     * 2^{numberOfDimensions} corners of the grid hyper-rectangle in which the independent
+     * variables lie, and successively interpolating these in the last to the first dimension.
+     * The interpolation is performed without recursion and without allocating memory (for
+     * dependent variable types of fixed size), such that, e.g., all six aerodynamic coefficients
+     * stored as a Vector6d are interpolated in a single pass.
+     * \param independentValuesToInterpolate Pointer to first of numberOfDimensions values of
+     *          independent variables at which interpolation is to be performed.
+     * \return Interpolated value of dependent variable.
      */
-    DependentVariableType performRecursiveInterpolationStep(
-            const unsigned int currentVariable,
-            const std::vector< IndependentVariableType >& independentValuesToInterpolate,
-            boost::array< int, numberOfDimensions > currentArrayIndices,
-            const std::vector< int >& nearestLowerIndices )
+    DependentVariableType performInterpolation(
+            const IndependentVariableType* independentValuesToInterpolate )
     {
-        IndependentVariableType upperFraction, lowerFraction;
-        DependentVariableType upperContribution, lowerContribution;
-
-        // Calculate fractions of data points above and below independent
-        // variable value to be added to interpolated value.
-        upperFraction = ( independentValuesToInterpolate[ currentVariable ] -
-                          independentValues_[ currentVariable ]
-                          [ nearestLowerIndices[ currentVariable ] ] ) /
-                ( independentValues_[ currentVariable ]
-                  [ nearestLowerIndices[ currentVariable ] + 1 ] -
-                  independentValues_[ currentVariable ]
-                  [ nearestLowerIndices[ currentVariable ] ] );
-        lowerFraction = -( independentValuesToInterpolate[ currentVariable ] -
-                           independentValues_[ currentVariable ]
-                           [ nearestLowerIndices[ currentVariable ] + 1 ] ) /
-                ( independentValues_[ currentVariable ]
-                  [ nearestLowerIndices[ currentVariable ] + 1 ] -
-                  independentValues_[ currentVariable ]
-                  [ nearestLowerIndices[ currentVariable ] ] );
-
-        // If at top dimension, call dependent variable data.
-        if ( currentVariable == numberOfDimensions - 1 )
+        // Determine the nearest lower neighbours and the fractions of the data points above and
+        // below the independent variable values.
+        boost::array< IndependentVariableType, numberOfDimensions > upperFractions;
+        boost::array< IndependentVariableType, numberOfDimensions > lowerFractions;
+        const DependentVariableType* lowerCornerData = dependentData_.data( );
+        for ( int i = 0; i < numberOfDimensions; i++ )
+        {
+            const int nearestLowerIndex = lookUpSchemes_[ i ]->findNearestLowerNeighbour(
+                        independentValuesToInterpolate[ i ] );
+            const IndependentVariableType lowerValue
+                    = independentValues_[ i ][ nearestLowerIndex ];
+            const IndependentVariableType upperValue
+                    = independentValues_[ i ][ nearestLowerIndex + 1 ];
+
+            upperFractions[ i ] = ( independentValuesToInterpolate[ i ] - lowerValue )
+                    / ( upperValue - lowerValue );
+            lowerFractions[ i ] = -( independentValuesToInterpolate[ i ] - upperValue )
+                    / ( upperValue - lowerValue );
+
+            lowerCornerData += nearestLowerIndex * dependentData_.strides( )[ i ];
+        }
+
+        // Retrieve dependent variable values at all corners of grid hyper-rectangle.
+        boost::array< DependentVariableType, numberOfCorners > cornerValues;
+        for ( unsigned int corner = 0; corner < numberOfCorners; corner++ )
         {
-            currentArrayIndices[ numberOfDimensions - 1 ] = nearestLowerIndices[ currentVariable ];
-            lowerContribution = dependentData_( currentArrayIndices );
-            currentArrayIndices[ numberOfDimensions - 1 ] = nearestLowerIndices[ currentVariable ]
-                                                            + 1;
-            upperContribution = dependentData_( currentArrayIndices );
+            cornerValues[ corner ] = lowerCornerData[ cornerOffsets_[ corner ] ];
         }
 
-        // If at lower dimension, update currentArrayIndices and call function with
-        // currentVariable++.
-        else
+        // Interpolate in each dimension, starting at the last, by combining the values at the
+        // corners that differ only in the lowest bit of their index.
+        unsigned int numberOfValues = numberOfCorners;
+        for ( int i = numberOfDimensions - 1; i >= 0; i-- )
         {
-            currentArrayIndices[ currentVariable ] = nearestLowerIndices[ currentVariable ];
-            lowerContribution = performRecursiveInterpolationStep(
-                        currentVariable + 1, independentValuesToInterpolate,
-                        currentArrayIndices, nearestLowerIndices );
-            currentArrayIndices[ currentVariable ] = nearestLowerIndices[ currentVariable ] + 1;
-            upperContribution = performRecursiveInterpolationStep(
-                        currentVariable + 1, independentValuesToInterpolate,
-                        currentArrayIndices, nearestLowerIndices );
+            numberOfValues /= 2;
+            for ( unsigned int j = 0; j < numberOfValues; j++ )
+            {
+                cornerValues[ j ] = upperFractions[ i ] * cornerValues[ 2 * j + 1 ]
+                        + lowerFractions[ i ] * cornerValues[ 2 * j ];
+            }
         }
 
-        // Return interpolated value.
-        DependentVariableType returnValue = upperFraction * upperContribution +
-                                            lowerFraction * lowerContribution;
-        return returnValue;
+        return cornerValues[ 0 ];
     }
 
     //! Vector with pointers to look-up scheme.
@@ -290,6 +302,16 @@ private:
      * independent variable points.
      */
     boost::multi_array< DependentVariableType, numberOfDimensions > dependentData_;
+
+    //! Number of corners of grid hyper-rectangle.
+    static const unsigned int numberOfCorners = 1 << numberOfDimensions;
+
+    //! Offsets of corners of grid hyper-rectangle.
+    /*!
+     * Offsets in the storage of dependentData_ of the corners of a grid hyper-rectangle with
+     * respect to its lower corner, see computeCornerOffsets( ).
+     */
+    boost::array< std::ptrdiff_t, numberOfCorners > cornerOffsets_;
 };
 
 } // namespace interpolators
@@ -30,6 +30,7 @@
  *      130204    K. Kumar          Fixed bug in DOPRI8 coefficient set under Windows and added
  *                                  note about problem.
  *      130916    K. Kumar          Removed RKF56 integrator test.
+ *      261016    agent             Restored RKF56 coefficients test.
  *
  *    References
  *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
@@ -101,6 +102,12 @@ BOOST_AUTO_TEST_CASE( testRungeKuttaFehlberg45Coefficients )
     checkValidityOfCoefficientSet( RungeKuttaCoefficients::rungeKuttaFehlberg45, 1.0e-15 );
 }
 
+BOOST_AUTO_TEST_CASE( testRungeKuttaFehlberg56Coefficients )
+{
+    // Check validity of Runge-Kutta-Fehlberg 56 coefficients.
+    checkValidityOfCoefficientSet( RungeKuttaCoefficients::rungeKuttaFehlberg56, 1.0e-15 );
+}
+
 BOOST_AUTO_TEST_CASE( testRungeKuttaFehlberg78Coefficients )
 {
     // Check validity of Runge-Kutta-Fehlberg 78 coefficients.
@@ -0,0 +1,315 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *      261016    agent             Added tests of masked members and of short integration
+ *                                  intervals.
+ *
+ *    References
+ *
+ *    Notes
+ *      The ensemble integrator is tested by comparing each member of an ensemble of Van der Pol
+ *      oscillators to the result of the RungeKuttaVariableStepSizeIntegrator class, which uses the
+ *      same step size control per member.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/testMacros.h>
+#include <TudatCore/Mathematics/NumericalIntegrators/UnitTests/numericalIntegratorTestFunctions.h>
+
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeEnsembleIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using numerical_integrators::RungeKuttaCoefficients;
+using numerical_integrators::RungeKuttaVariableStepSizeEnsembleIntegratorXd;
+using numerical_integrators::RungeKuttaVariableStepSizeIntegratorXd;
+using numerical_integrator_test_functions::computeVanDerPolStateDerivative;
+
+//! Compute the state derivatives of an ensemble of Van der Pol oscillators.
+Eigen::MatrixXd computeVanDerPolEnsembleStateDerivative( const Eigen::VectorXd& times,
+                                                         const Eigen::MatrixXd& states )
+{
+    Eigen::MatrixXd stateDerivatives( states.rows( ), states.cols( ) );
+
+    // Evaluate the state derivatives of all members at once, column by column.
+    stateDerivatives.col( 0 ) = states.col( 1 );
+    stateDerivatives.col( 1 ).array( ) = -states.col( 0 ).array( )
+            + ( 1.0 - states.col( 0 ).array( ).square( ) ) * states.col( 1 ).array( );
+
+    return stateDerivatives;
+}
+
+//! Compute the state derivatives of an ensemble, checking that all states are finite.
+/*!
+ * Computes the state derivatives of an ensemble of Van der Pol oscillators, and throws if any of
+ * the states passed is not finite. Used to check that masked members are not evaluated.
+ */
+Eigen::MatrixXd computeFiniteVanDerPolEnsembleStateDerivative( const Eigen::VectorXd& times,
+                                                               const Eigen::MatrixXd& states )
+{
+    if ( !( states.array( ) == states.array( ) ).all( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "State derivative evaluated for invalid state." ) ) );
+    }
+
+    return computeVanDerPolEnsembleStateDerivative( times, states );
+}
+
+//! Create initial states of a dispersed ensemble of Van der Pol oscillators.
+Eigen::MatrixXd getDispersedInitialStates( const int numberOfMembers )
+{
+    Eigen::MatrixXd initialStates( numberOfMembers, 2 );
+    for ( int member = 0; member < numberOfMembers; member++ )
+    {
+        initialStates( member, 0 ) = 1.0 + 0.05 * member;
+        initialStates( member, 1 ) = 2.0 - 0.03 * member;
+    }
+
+    return initialStates;
+}
+
+BOOST_AUTO_TEST_SUITE( test_runge_kutta_variable_step_size_ensemble_integrator )
+
+//! Test that each ensemble member matches the result of the single-state integrator.
+BOOST_AUTO_TEST_CASE( testEnsembleMembersAgainstSingleStateIntegrator )
+{
+    const int numberOfMembers = 13;
+    const Eigen::MatrixXd initialStates = getDispersedInitialStates( numberOfMembers );
+
+    // Test all predefined coefficient sets.
+    const RungeKuttaCoefficients::CoefficientSets coefficientSets[ ] =
+    {
+        RungeKuttaCoefficients::rungeKuttaFehlberg45,
+        RungeKuttaCoefficients::rungeKuttaFehlberg78,
+        RungeKuttaCoefficients::rungeKutta87DormandPrince
+    };
+
+    for ( unsigned int set = 0; set < 3; set++ )
+    {
+        const RungeKuttaCoefficients& coefficients
+                = RungeKuttaCoefficients::get( coefficientSets[ set ] );
+
+        // Integrate the ensemble.
+        RungeKuttaVariableStepSizeEnsembleIntegratorXd ensembleIntegrator(
+                    coefficients, &computeVanDerPolEnsembleStateDerivative, 0.0, initialStates,
+                    1.0E-12, 10.0, 1.0E-10, 1.0E-10 );
+        const Eigen::MatrixXd finalStates = ensembleIntegrator.integrateTo( 10.0, 0.1 );
+
+        // Check that all members reached the end of the integration interval.
+        const Eigen::VectorXd finalTimes = ensembleIntegrator.getCurrentIndependentVariables( );
+        for ( int member = 0; member < numberOfMembers; member++ )
+        {
+            BOOST_CHECK_CLOSE_FRACTION( finalTimes( member ), 10.0,
+                                        10.0 * std::numeric_limits< double >::epsilon( ) );
+        }
+
+        // Integrate each member separately and compare.
+        for ( int member = 0; member < numberOfMembers; member++ )
+        {
+            RungeKuttaVariableStepSizeIntegratorXd integrator(
+                        coefficients, &computeVanDerPolStateDerivative, 0.0,
+                        initialStates.row( member ).transpose( ), 1.0E-12, 10.0,
+                        1.0E-10, 1.0E-10 );
+            const Eigen::VectorXd finalState = integrator.integrateTo( 10.0, 0.1 );
+
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( finalState,
+                                               finalStates.row( member ).transpose( ), 1.0E-9 );
+        }
+    }
+}
+
+//! Test that a single ensemble step equals an accepted step of the single-state integrator.
+BOOST_AUTO_TEST_CASE( testEnsembleIntegrationStep )
+{
+    const int numberOfMembers = 5;
+    const Eigen::MatrixXd initialStates = getDispersedInitialStates( numberOfMembers );
+    const RungeKuttaCoefficients& coefficients
+            = RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg45 );
+
+    // Use a large step size, such that (some of) the members have to reject their first attempt.
+    RungeKuttaVariableStepSizeEnsembleIntegratorXd ensembleIntegrator(
+                coefficients, &computeVanDerPolEnsembleStateDerivative, 0.0, initialStates,
+                0.0, 10.0, 1.0E-8, 1.0E-8 );
+    const Eigen::MatrixXd states = ensembleIntegrator.performIntegrationStep(
+                Eigen::VectorXd::Constant( numberOfMembers, 1.0 ) );
+
+    for ( int member = 0; member < numberOfMembers; member++ )
+    {
+        RungeKuttaVariableStepSizeIntegratorXd integrator(
+                    coefficients, &computeVanDerPolStateDerivative, 0.0,
+                    initialStates.row( member ).transpose( ), 0.0, 10.0, 1.0E-8, 1.0E-8 );
+        const Eigen::VectorXd state = integrator.performIntegrationStep( 1.0 );
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( state, states.row( member ).transpose( ), 1.0E-14 );
+        BOOST_CHECK_CLOSE_FRACTION( integrator.getCurrentIndependentVariable( ),
+                                    ensembleIntegrator.getCurrentIndependentVariables( )( member ),
+                                    1.0E-14 );
+        BOOST_CHECK_CLOSE_FRACTION( integrator.getNextStepSize( ),
+                                    ensembleIntegrator.getNextStepSizes( )( member ), 1.0E-14 );
+    }
+}
+
+//! Test that masked members are not passed to the state derivative function.
+BOOST_AUTO_TEST_CASE( testEnsembleMaskedMembers )
+{
+    const int numberOfMembers = 3;
+    Eigen::MatrixXd initialStates = getDispersedInitialStates( numberOfMembers );
+    const RungeKuttaCoefficients& coefficients
+            = RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg45 );
+
+    // Set an invalid state for the second member, which is masked out by a zero step size.
+    initialStates.row( 1 ).setConstant( std::numeric_limits< double >::quiet_NaN( ) );
+    const Eigen::VectorXd stepSizes = ( Eigen::VectorXd( 3 ) << 1.0, 0.0, 1.0 ).finished( );
+
+    RungeKuttaVariableStepSizeEnsembleIntegratorXd ensembleIntegrator(
+                coefficients, &computeFiniteVanDerPolEnsembleStateDerivative, 0.0, initialStates,
+                0.0, 10.0, 1.0E-8, 1.0E-8 );
+    const Eigen::MatrixXd states = ensembleIntegrator.performIntegrationStep( stepSizes );
+
+    // Check that the masked member is unchanged, and the other members match the single-state
+    // integrator.
+    BOOST_CHECK_EQUAL( ensembleIntegrator.getCurrentIndependentVariables( )( 1 ), 0.0 );
+    for ( int member = 0; member < numberOfMembers; member += 2 )
+    {
+        RungeKuttaVariableStepSizeIntegratorXd integrator(
+                    coefficients, &computeVanDerPolStateDerivative, 0.0,
+                    initialStates.row( member ).transpose( ), 0.0, 10.0, 1.0E-8, 1.0E-8 );
+        const Eigen::VectorXd state = integrator.performIntegrationStep( 1.0 );
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( state, states.row( member ).transpose( ), 1.0E-14 );
+    }
+}
+
+//! Test that all members reach the end of a very short integration interval.
+BOOST_AUTO_TEST_CASE( testEnsembleShortIntegrationInterval )
+{
+    const int numberOfMembers = 4;
+    const Eigen::MatrixXd initialStates = getDispersedInitialStates( numberOfMembers );
+
+    // Use an interval that is shorter than the machine precision times ten, such that an absolute
+    // tolerance on the end of the interval would mask out all members from the start.
+    const double intervalEnd = 1.0E-15;
+    RungeKuttaVariableStepSizeEnsembleIntegratorXd ensembleIntegrator(
+                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                &computeVanDerPolEnsembleStateDerivative, 0.0, initialStates,
+                0.0, 10.0, 1.0E-10, 1.0E-10 );
+    const Eigen::MatrixXd finalStates = ensembleIntegrator.integrateTo( intervalEnd, 1.0E-16 );
+
+    // Check that all members reached the end of the interval, with a state change that matches
+    // the state derivative at the start of the interval.
+    const Eigen::MatrixXd expectedFinalStates = initialStates + intervalEnd
+            * computeVanDerPolEnsembleStateDerivative(
+                Eigen::VectorXd::Zero( numberOfMembers ), initialStates );
+    for ( int member = 0; member < numberOfMembers; member++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( ensembleIntegrator.getCurrentIndependentVariables( )( member ),
+                                    intervalEnd,
+                                    10.0 * std::numeric_limits< double >::epsilon( ) );
+        BOOST_CHECK_SMALL( ( finalStates.row( member ) - expectedFinalStates.row( member ) )
+                           .norm( ), 1.0E-15 );
+    }
+}
+
+//! Test that multi-threaded integration gives the same result as single-threaded integration.
+BOOST_AUTO_TEST_CASE( testMultiThreadedEnsembleIntegration )
+{
+    const int numberOfMembers = 37;
+    const Eigen::MatrixXd initialStates = getDispersedInitialStates( numberOfMembers );
+    const RungeKuttaCoefficients& coefficients
+            = RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 );
+
+    RungeKuttaVariableStepSizeEnsembleIntegratorXd singleThreadedIntegrator(
+                coefficients, &computeVanDerPolEnsembleStateDerivative, 0.0, initialStates,
+                1.0E-12, 10.0, 1.0E-10, 1.0E-10 );
+    RungeKuttaVariableStepSizeEnsembleIntegratorXd multiThreadedIntegrator(
+                coefficients, &computeVanDerPolEnsembleStateDerivative, 0.0, initialStates,
+                1.0E-12, 10.0, 1.0E-10, 1.0E-10 );
+
+    const Eigen::MatrixXd singleThreadedStates = singleThreadedIntegrator.integrateTo( 5.0, 0.1 );
+    const Eigen::MatrixXd multiThreadedStates = multiThreadedIntegrator.integrateTo( 5.0, 0.1, 4 );
+
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( singleThreadedStates, multiThreadedStates,
+                                       std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test that exceeding minimum step size throws a runtime error, also from a worker thread.
+BOOST_AUTO_TEST_CASE( testEnsembleMinimumStepSizeRuntimeError )
+{
+    const Eigen::MatrixXd initialStates = getDispersedInitialStates( 4 );
+
+    for ( unsigned int numberOfThreads = 1; numberOfThreads <= 2; numberOfThreads++ )
+    {
+        RungeKuttaVariableStepSizeEnsembleIntegratorXd integrator(
+                    RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg45 ),
+                    &computeVanDerPolEnsembleStateDerivative, 0.0, initialStates, 100.0,
+                    std::numeric_limits< double >::infinity( ),
+                    std::numeric_limits< double >::epsilon( ),
+                    std::numeric_limits< double >::epsilon( ) );
+
+        // Declare boolean flag to test if minimum step size is exceeded.
+        bool isMinimumStepSizeExceeded = false;
+
+        // Try integrateTo(), which should result in a runtime error.
+        try
+        {
+            integrator.integrateTo( 10.0, 0.1, numberOfThreads );
+        }
+
+        // Catch the expected runtime error, and set the boolean flag to true.
+        catch ( RungeKuttaVariableStepSizeEnsembleIntegratorXd::MinimumStepSizeExceededError&
+                minimumStepSizeExceededError )
+        {
+            isMinimumStepSizeExceeded = true;
+            BOOST_CHECK_EQUAL( minimumStepSizeExceededError.minimumStepSize, 100.0 );
+        }
+
+        // Check that the minimum step size was indeed exceeded.
+        BOOST_CHECK( isMinimumStepSizeExceeded );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -35,9 +35,16 @@
  *                                  typedef; modified minimum step size exceeded unit tests to use
  *                                  custom exception object.
  *      120321    D.Dirkx           Added unit test for getCurrentStateDerivatives function.
+ *      261016    agent             Added unit test for allocation-free fixed-size integration.
+ *      261016    agent             Added unit test for dense output.
+ *      261016    agent             Extended dense output test to natural step sizes of high-order
+ *                                  coefficient sets.
+ *      261016    agent             Extended dense output test to all coefficient sets.
  *
  *    References
  *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I: Nonstiff
+ *          Problems, 2nd Edition, Springer, 1993.
  *
  *    Notes
  *      This file doesn't test any specific Runge-Kutta-type integrators, but rather some general
@@ -54,16 +61,26 @@
 
 #define BOOST_TEST_MAIN
 
+// Enable run-time checks on memory allocation by Eigen, used to test that integration steps with
+// fixed-size states do not allocate memory.
+#define EIGEN_RUNTIME_NO_MALLOC
+
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <stdexcept>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 #include <boost/exception/all.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <TudatCore/Basics/testMacros.h>
+#include <TudatCore/Basics/utilityMacros.h>
 #include <TudatCore/Mathematics/NumericalIntegrators/UnitTests/numericalIntegratorTestFunctions.h>
 
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
 
@@ -75,8 +92,28 @@ namespace unit_tests
 using tudat::numerical_integrators::RungeKuttaCoefficients;
 using tudat::numerical_integrators::RungeKuttaVariableStepSizeIntegrator;
 using tudat::numerical_integrators::RungeKuttaVariableStepSizeIntegratorXd;
+using tudat::numerical_integrators::RungeKuttaVariableStepSizeIntegrator6d;
 using numerical_integrator_test_functions::computeZeroStateDerivative;
 
+//! Compute state derivative of three uncoupled harmonic oscillators (fixed-size state).
+basic_mathematics::Vector6d computeHarmonicOscillatorsStateDerivative(
+        const double time, const basic_mathematics::Vector6d& state )
+{
+    TUDAT_UNUSED_PARAMETER( time );
+
+    basic_mathematics::Vector6d stateDerivative;
+    stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 ) = -state.segment( 0, 3 );
+    return stateDerivative;
+}
+
+//! Compute state derivative of three uncoupled harmonic oscillators (dynamic-size state).
+Eigen::VectorXd computeHarmonicOscillatorsStateDerivativeXd(
+        const double time, const Eigen::VectorXd& state )
+{
+    return computeHarmonicOscillatorsStateDerivative( time, state );
+}
+
 BOOST_AUTO_TEST_SUITE( test_runge_kutta_variable_step_size_integrator )
 
 //! Test different types of states and state derivatives.
@@ -295,6 +332,184 @@ BOOST_AUTO_TEST_CASE( testStateDerivativeRetrievalFunction )
     }
 }
 
+//! Test that integration steps with fixed-size states do not allocate memory.
+BOOST_AUTO_TEST_CASE( testAllocationFreeFixedSizeIntegrationSteps )
+{
+    const basic_mathematics::Vector6d initialState =
+            ( basic_mathematics::Vector6d( ) << 1.0, 0.0, -0.5, 0.0, 1.0, 0.25 ).finished( );
+
+    // Create fixed-size and dynamic-size integrators.
+    RungeKuttaVariableStepSizeIntegrator6d integrator(
+                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                &computeHarmonicOscillatorsStateDerivative,
+                0.0, initialState, 1.0E-12, 10.0, 1.0E-12, 1.0E-12 );
+    RungeKuttaVariableStepSizeIntegratorXd integratorXd(
+                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                &computeHarmonicOscillatorsStateDerivativeXd,
+                0.0, Eigen::VectorXd( initialState ), 1.0E-12, 10.0, 1.0E-12, 1.0E-12 );
+
+    // Perform integration steps, during which Eigen is not allowed to allocate memory. Large
+    // initial step sizes are used, such that step rejections are also covered.
+    Eigen::internal::set_is_malloc_allowed( false );
+    integrator.performIntegrationStep( 5.0 );
+    for ( unsigned int step = 0; step < 100; step++ )
+    {
+        integrator.performIntegrationStep( integrator.getNextStepSize( ) );
+    }
+    Eigen::internal::set_is_malloc_allowed( true );
+
+    // Check that the result is identical to that obtained using dynamic-size states.
+    integratorXd.performIntegrationStep( 5.0 );
+    for ( unsigned int step = 0; step < 100; step++ )
+    {
+        integratorXd.performIntegrationStep( integratorXd.getNextStepSize( ) );
+    }
+
+    BOOST_CHECK_CLOSE_FRACTION( integrator.getCurrentIndependentVariable( ),
+                                integratorXd.getCurrentIndependentVariable( ),
+                                std::numeric_limits< double >::epsilon( ) );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( integrator.getCurrentState( ),
+                                       integratorXd.getCurrentState( ),
+                                       1.0E-14 );
+}
+
+//! Test dense output inside accepted steps.
+BOOST_AUTO_TEST_CASE( testDenseOutput )
+{
+    const basic_mathematics::Vector6d initialState =
+            ( basic_mathematics::Vector6d( ) << 1.0, 0.0, -0.5, 0.0, 1.0, 0.25 ).finished( );
+
+    // Test dense output for all coefficient sets. The maximum step size does not constrain the
+    // integrator, such that the natural step sizes are taken.
+    std::vector< RungeKuttaCoefficients::CoefficientSets > coefficientSets;
+    coefficientSets.push_back( RungeKuttaCoefficients::rungeKuttaFehlberg45 );
+    coefficientSets.push_back( RungeKuttaCoefficients::rungeKuttaFehlberg56 );
+    coefficientSets.push_back( RungeKuttaCoefficients::rungeKuttaFehlberg78 );
+    coefficientSets.push_back( RungeKuttaCoefficients::rungeKutta87DormandPrince );
+
+    // Set expected dense output orders, equal to the orders of the integrated estimates.
+    std::vector< unsigned int > expectedDenseOutputOrders;
+    expectedDenseOutputOrders.push_back( 4 );
+    expectedDenseOutputOrders.push_back( 5 );
+    expectedDenseOutputOrders.push_back( 7 );
+    expectedDenseOutputOrders.push_back( 8 );
+
+    // Set tolerances of the dense output on the grid, of the order of the integration error
+    // itself (3.6e-10, 1.6e-10, 2.3e-11 and 6.9e-13, respectively). The error of a cubic Hermite
+    // interpolant would be of the order of 1.0e-6 for the step sizes of the high-order sets.
+    std::vector< double > tolerances;
+    tolerances.push_back( 1.0E-9 );
+    tolerances.push_back( 1.0E-9 );
+    tolerances.push_back( 1.0E-10 );
+    tolerances.push_back( 1.0E-10 );
+
+    // Set minimum values of the largest natural step sizes, which increase with the order.
+    const double outputInterval = 0.01;
+    std::vector< double > minimumLargestStepSizes;
+    minimumLargestStepSizes.push_back( outputInterval );
+    minimumLargestStepSizes.push_back( 2.5 * outputInterval );
+    minimumLargestStepSizes.push_back( 10.0 * outputInterval );
+    minimumLargestStepSizes.push_back( 10.0 * outputInterval );
+
+    for ( unsigned int set = 0; set < coefficientSets.size( ); set++ )
+    {
+        // Create two identical integrators; dense output is only requested from the first, to
+        // check that this does not affect the integration itself.
+        RungeKuttaVariableStepSizeIntegrator6d integrator(
+                    RungeKuttaCoefficients::get( coefficientSets.at( set ) ),
+                    &computeHarmonicOscillatorsStateDerivative,
+                    0.0, initialState, 1.0E-12, 100.0, 1.0E-12, 1.0E-12 );
+        RungeKuttaVariableStepSizeIntegrator6d referenceIntegrator(
+                    RungeKuttaCoefficients::get( coefficientSets.at( set ) ),
+                    &computeHarmonicOscillatorsStateDerivative,
+                    0.0, initialState, 1.0E-12, 100.0, 1.0E-12, 1.0E-12 );
+
+        BOOST_CHECK_EQUAL( integrator.getDenseOutputOrder( ),
+                           expectedDenseOutputOrders.at( set ) );
+
+        // Check that dense output is not available before the first step.
+        bool isRuntimeErrorThrown = false;
+        try
+        {
+            integrator.getInterpolatedState( 0.0 );
+        }
+        catch ( std::runtime_error& )
+        {
+            isRuntimeErrorThrown = true;
+        }
+        BOOST_CHECK( isRuntimeErrorThrown );
+
+        // Sample the state on a regular grid, while taking the natural steps of the integrator.
+        double outputTime = outputInterval;
+        double stepSize = 0.01;
+        double largestStepSize = 0.0;
+        while ( integrator.getCurrentIndependentVariable( ) < 10.0 )
+        {
+            const double startOfStep = integrator.getCurrentIndependentVariable( );
+            const basic_mathematics::Vector6d stateAtStartOfStep = integrator.getCurrentState( );
+
+            integrator.performIntegrationStep( stepSize );
+            referenceIntegrator.performIntegrationStep( stepSize );
+            largestStepSize = std::max( largestStepSize,
+                                        integrator.getCurrentIndependentVariable( )
+                                        - startOfStep );
+            stepSize = integrator.getNextStepSize( );
+
+            // Check that the dense output is equal to the states at the start and end of the step.
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( integrator.getInterpolatedState( startOfStep ),
+                                               stateAtStartOfStep,
+                                               std::numeric_limits< double >::epsilon( ) );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        integrator.getInterpolatedState(
+                            integrator.getCurrentIndependentVariable( ) ),
+                        integrator.getCurrentState( ),
+                        std::numeric_limits< double >::epsilon( ) );
+
+            // Compare the dense output on the grid to the analytical solution.
+            while ( outputTime <= integrator.getCurrentIndependentVariable( ) )
+            {
+                const basic_mathematics::Vector6d interpolatedState
+                        = integrator.getInterpolatedState( outputTime );
+                for ( unsigned int i = 0; i < 3; i++ )
+                {
+                    BOOST_CHECK_SMALL( interpolatedState( i )
+                                       - ( initialState( i ) * std::cos( outputTime )
+                                           + initialState( i + 3 ) * std::sin( outputTime ) ),
+                                       tolerances.at( set ) );
+                    BOOST_CHECK_SMALL( interpolatedState( i + 3 )
+                                       - ( -initialState( i ) * std::sin( outputTime )
+                                           + initialState( i + 3 ) * std::cos( outputTime ) ),
+                                       tolerances.at( set ) );
+                }
+
+                outputTime += outputInterval;
+            }
+        }
+
+        // Check that the natural step sizes are larger than the output interval.
+        BOOST_CHECK_GT( largestStepSize, minimumLargestStepSizes.at( set ) );
+
+        // Check that requesting dense output did not affect the integration.
+        BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ),
+                           referenceIntegrator.getCurrentIndependentVariable( ) );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( integrator.getCurrentState( ),
+                                           referenceIntegrator.getCurrentState( ),
+                                           std::numeric_limits< double >::epsilon( ) );
+
+        // Check that dense output outside of the last step is not allowed.
+        isRuntimeErrorThrown = false;
+        try
+        {
+            integrator.getInterpolatedState( integrator.getCurrentIndependentVariable( ) + 0.01 );
+        }
+        catch ( std::runtime_error& )
+        {
+            isRuntimeErrorThrown = true;
+        }
+        BOOST_CHECK( isRuntimeErrorThrown );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -31,6 +31,7 @@
  *                                  such that the correct sets are used for the lower and higher
  *                                  order estimates.
  *      130916    K. Kumar          Removed RKF56.
+ *      261016    agent             Restored RKF56.
  *
  *    References
  *      The Mathworks, Inc. RKF78, Symbolic Math Toolbox, 2012.
@@ -441,6 +442,7 @@ const RungeKuttaCoefficients& RungeKuttaCoefficients::get(
         RungeKuttaCoefficients::CoefficientSets coefficientSet )
 {
     static RungeKuttaCoefficients rungeKuttaFehlberg45Coefficients,
+                                  rungeKuttaFehlberg56Coefficients,
                                   rungeKuttaFehlberg78Coefficients,
                                   rungeKutta87DormandPrinceCoefficients;
 
@@ -453,6 +455,13 @@ const RungeKuttaCoefficients& RungeKuttaCoefficients::get(
         }
         return rungeKuttaFehlberg45Coefficients;
 
+    case rungeKuttaFehlberg56:
+        if ( rungeKuttaFehlberg56Coefficients.higherOrder != 6 )
+        {
+            initializeRungeKuttaFehlberg56Coefficients( rungeKuttaFehlberg56Coefficients );
+        }
+        return rungeKuttaFehlberg56Coefficients;
+
     case rungeKuttaFehlberg78:
         if ( rungeKuttaFehlberg78Coefficients.higherOrder != 8 )
         {
@@ -30,6 +30,7 @@
  *      130118    K. Kumar          Removed unused typedef.
  *      130121    K. Kumar          Added shared-ptr typedef.
  *      130916    K. Kumar          Removed RKF56.
+ *      261016    agent             Restored RKF56 enum option.
  *
  *    References
  *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
@@ -117,6 +118,7 @@ struct RungeKuttaCoefficients
     enum CoefficientSets
     {
         rungeKuttaFehlberg45,
+        rungeKuttaFehlberg56,
         rungeKuttaFehlberg78,
         rungeKutta87DormandPrince
     };
@@ -0,0 +1,757 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261016    agent             File created.
+ *      261016    agent             Excluded masked members from stage evaluations; made end of
+ *                                  integration interval tolerance relative to interval length.
+ *
+ *    References
+ *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
+ *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer, 2005.
+ *
+ *    Notes
+ *      The ensemble states are stored in structure-of-arrays layout: each row of an ensemble
+ *      state matrix holds the state of one member, such that each (column-major) column holds a
+ *      single state element for all members contiguously in memory. All stage operations are
+ *      written as Eigen array expressions over these columns, which allows them to be vectorized
+ *      over the ensemble.
+ *
+ *      The step size control is identical to that of the RungeKuttaVariableStepSizeIntegrator
+ *      class, but is applied to each member individually. All members are advanced in lockstep:
+ *      a member that has rejected its step, or has reached the end of the integration interval,
+ *      is masked out by setting its step size to zero for the current attempt. Masked members are
+ *      removed from the ensemble passed to the state derivative function, such that no state
+ *      derivatives are evaluated for them.
+ *
+ */
+
+#ifndef TUDAT_RUNGE_KUTTA_VARIABLE_STEP_SIZE_ENSEMBLE_INTEGRATOR_H
+#define TUDAT_RUNGE_KUTTA_VARIABLE_STEP_SIZE_ENSEMBLE_INTEGRATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+
+namespace tudat
+{
+namespace numerical_integrators
+{
+
+//! Class that implements a Runge-Kutta variable step size integrator for an ensemble of states.
+/*!
+ * Class that implements a Runge-Kutta variable step size integrator that advances an ensemble of
+ * independent states (e.g., dispersed initial states of a Monte Carlo analysis) in lockstep. The
+ * state derivative function is evaluated once per stage for the complete ensemble, and every
+ * member of the ensemble has its own independent variable and step size control.
+ * \tparam IndependentVariableType The type of the independent variable and of the state elements.
+ *          This type should be either a float or double.
+ * \sa RungeKuttaVariableStepSizeIntegrator.
+ */
+template < typename IndependentVariableType = double >
+class RungeKuttaVariableStepSizeEnsembleIntegrator
+{
+public:
+
+    //! Typedef for the vector of independent variables (one entry per member).
+    typedef Eigen::Matrix< IndependentVariableType, Eigen::Dynamic, 1 > IndependentVariableVector;
+
+    //! Typedef for the ensemble state (one row per member, one column per state element).
+    typedef Eigen::Matrix< IndependentVariableType, Eigen::Dynamic, Eigen::Dynamic >
+    EnsembleStateType;
+
+    //! Typedef for the error tolerances (one entry per state element).
+    typedef Eigen::Matrix< IndependentVariableType, 1, Eigen::Dynamic > ErrorToleranceType;
+
+    //! Typedef to the ensemble state derivative function.
+    /*!
+     * Typedef to the ensemble state derivative function. The function takes the independent
+     * variables of all members and the ensemble state (one row per member) as input, and should
+     * return the state derivatives in the same layout. When the ensemble is integrated using
+     * multiple threads, this function is called concurrently for disjoint blocks of members and
+     * must therefore be thread-safe.
+     */
+    typedef boost::function< EnsembleStateType(
+            const IndependentVariableVector&, const EnsembleStateType& ) >
+    EnsembleStateDerivativeFunction;
+
+    //! Exception that is thrown if the minimum step size is exceeded.
+    /*!
+     * Exception thrown by RungeKuttaVariableStepSizeEnsembleIntegrator<>::performIntegrationStep()
+     * and RungeKuttaVariableStepSizeEnsembleIntegrator<>::integrateTo() if the minimum step size
+     * is exceeded by any member of the ensemble.
+     */
+    class MinimumStepSizeExceededError;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking coefficients, an ensemble state derivative function, initial
+     * conditions, minimum & maximum step size and relative & absolute error tolerance per item in
+     * the state vector as argument.
+     * \param coefficients Coefficients to use with this integrator.
+     * \param ensembleStateDerivativeFunction Ensemble state derivative function.
+     * \param intervalStart The start of the integration interval, equal for all members.
+     * \param initialStates The initial states, one row per member.
+     * \param minimumStepSize The minimum step size to take. If this constraint is violated by any
+     *          member, an exception will be thrown.
+     * \param maximumStepSize The maximum step size to take.
+     * \param relativeErrorTolerance The relative error tolerance, for each individual state
+     *          vector element.
+     * \param absoluteErrorTolerance The absolute error tolerance, for each individual state
+     *          vector element.
+     * \param safetyFactorForNextStepSize Safety factor used to scale prediction of next step size.
+     * \param maximumFactorIncreaseForNextStepSize Maximum factor increase for next step size.
+     * \param minimumFactorDecreaseForNextStepSize Minimum factor decrease for next step size.
+     */
+    RungeKuttaVariableStepSizeEnsembleIntegrator(
+            const RungeKuttaCoefficients& coefficients,
+            const EnsembleStateDerivativeFunction& ensembleStateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const EnsembleStateType& initialStates,
+            const IndependentVariableType minimumStepSize,
+            const IndependentVariableType maximumStepSize,
+            const ErrorToleranceType& relativeErrorTolerance,
+            const ErrorToleranceType& absoluteErrorTolerance,
+            const IndependentVariableType safetyFactorForNextStepSize = 0.8,
+            const IndependentVariableType maximumFactorIncreaseForNextStepSize = 4.0,
+            const IndependentVariableType minimumFactorDecreaseForNextStepSize = 0.1 ) :
+        ensembleStateDerivativeFunction_( ensembleStateDerivativeFunction ),
+        currentIndependentVariables_(
+            IndependentVariableVector::Constant( initialStates.rows( ), intervalStart ) ),
+        currentStates_( initialStates ),
+        nextStepSizes_( IndependentVariableVector::Zero( initialStates.rows( ) ) ),
+        coefficients_( coefficients ),
+        minimumStepSize_( std::fabs( minimumStepSize ) ),
+        maximumStepSize_( std::fabs( maximumStepSize ) ),
+        relativeErrorTolerance_( relativeErrorTolerance.array( ).abs( ) ),
+        absoluteErrorTolerance_( absoluteErrorTolerance.array( ).abs( ) ),
+        safetyFactorForNextStepSize_( std::fabs( safetyFactorForNextStepSize ) ),
+        maximumFactorIncreaseForNextStepSize_( std::fabs( maximumFactorIncreaseForNextStepSize ) ),
+        minimumFactorDecreaseForNextStepSize_( std::fabs( minimumFactorDecreaseForNextStepSize ) )
+    { }
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking coefficients, an ensemble state derivative function, initial
+     * conditions, minimum & maximum step size and relative & absolute error tolerance for all
+     * items in the state vector as argument.
+     * \param coefficients Coefficients to use with this integrator.
+     * \param ensembleStateDerivativeFunction Ensemble state derivative function.
+     * \param intervalStart The start of the integration interval, equal for all members.
+     * \param initialStates The initial states, one row per member.
+     * \param minimumStepSize The minimum step size to take. If this constraint is violated by any
+     *          member, an exception will be thrown.
+     * \param maximumStepSize The maximum step size to take.
+     * \param relativeErrorTolerance The relative error tolerance, equal for all individual state
+     *          vector elements.
+     * \param absoluteErrorTolerance The absolute error tolerance, equal for all individual state
+     *          vector elements.
+     * \param safetyFactorForNextStepSize Safety factor used to scale prediction of next step size.
+     * \param maximumFactorIncreaseForNextStepSize Maximum factor increase for next step size.
+     * \param minimumFactorDecreaseForNextStepSize Minimum factor decrease for next step size.
+     */
+    RungeKuttaVariableStepSizeEnsembleIntegrator(
+            const RungeKuttaCoefficients& coefficients,
+            const EnsembleStateDerivativeFunction& ensembleStateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const EnsembleStateType& initialStates,
+            const IndependentVariableType minimumStepSize,
+            const IndependentVariableType maximumStepSize,
+            const IndependentVariableType relativeErrorTolerance,
+            const IndependentVariableType absoluteErrorTolerance,
+            const IndependentVariableType safetyFactorForNextStepSize = 0.8,
+            const IndependentVariableType maximumFactorIncreaseForNextStepSize = 4.0,
+            const IndependentVariableType minimumFactorDecreaseForNextStepSize = 0.1 ) :
+        ensembleStateDerivativeFunction_( ensembleStateDerivativeFunction ),
+        currentIndependentVariables_(
+            IndependentVariableVector::Constant( initialStates.rows( ), intervalStart ) ),
+        currentStates_( initialStates ),
+        nextStepSizes_( IndependentVariableVector::Zero( initialStates.rows( ) ) ),
+        coefficients_( coefficients ),
+        minimumStepSize_( std::fabs( minimumStepSize ) ),
+        maximumStepSize_( std::fabs( maximumStepSize ) ),
+        relativeErrorTolerance_( ErrorToleranceType::Constant(
+                                     initialStates.cols( ), std::fabs( relativeErrorTolerance ) ) ),
+        absoluteErrorTolerance_( ErrorToleranceType::Constant(
+                                     initialStates.cols( ), std::fabs( absoluteErrorTolerance ) ) ),
+        safetyFactorForNextStepSize_( std::fabs( safetyFactorForNextStepSize ) ),
+        maximumFactorIncreaseForNextStepSize_( std::fabs( maximumFactorIncreaseForNextStepSize ) ),
+        minimumFactorDecreaseForNextStepSize_( std::fabs( minimumFactorDecreaseForNextStepSize ) )
+    { }
+
+    //! Get number of members in the ensemble.
+    /*!
+     * Returns the number of members (independent states) in the ensemble.
+     * \return Number of members in the ensemble.
+     */
+    int getNumberOfMembers( ) const { return static_cast< int >( currentStates_.rows( ) ); }
+
+    //! Get step sizes of the next step.
+    /*!
+     * Returns the step size of the next step, for each member of the ensemble.
+     * \return Step sizes to be used for the next step.
+     */
+    IndependentVariableVector getNextStepSizes( ) const { return nextStepSizes_; }
+
+    //! Get current states.
+    /*!
+     * Returns the current states of the ensemble, one row per member.
+     * \return Current integrated states.
+     */
+    EnsembleStateType getCurrentStates( ) const { return currentStates_; }
+
+    //! Get current independent variables.
+    /*!
+     * Returns the current value of the independent variable of each member of the ensemble.
+     * \return Current independent variables.
+     */
+    IndependentVariableVector getCurrentIndependentVariables( ) const
+    {
+        return currentIndependentVariables_;
+    }
+
+    //! Perform a single integration step for all members.
+    /*!
+     * Performs a single accepted integration step for each member of the ensemble, and computes
+     * the new step size per member. If the step size of a member is too large to satisfy the
+     * error constraints, the step for that member is redone (with the other members masked out)
+     * until the error constraints are satisfied.
+     * \param stepSizes The step size to take, for each member of the ensemble.
+     * \return The states at the end of the step.
+     */
+    EnsembleStateType performIntegrationStep( const IndependentVariableVector& stepSizes );
+
+    //! Integrate all members to the given end of the integration interval.
+    /*!
+     * Integrates all members of the ensemble to the given end of the integration interval, using
+     * the step size control per member. The ensemble can be split in contiguous blocks of members
+     * that are integrated concurrently, each by a separate thread.
+     * \param intervalEnd The end of the integration interval, equal for all members.
+     * \param initialStepSize The initial step size, equal for all members.
+     * \param numberOfThreads The number of threads over which the ensemble is distributed
+     *          (default 1). The ensemble state derivative function must be thread-safe if more
+     *          than one thread is used.
+     * \return The states at the end of the integration interval.
+     */
+    EnsembleStateType integrateTo( const IndependentVariableType intervalEnd,
+                                   const IndependentVariableType initialStepSize,
+                                   const unsigned int numberOfThreads = 1 );
+
+protected:
+
+    //! Perform a single lockstep step attempt for a block of members.
+    /*!
+     * Performs a single step attempt for a block of members. Members with a step size equal to
+     * zero are masked out and left unchanged; they are not passed to the state derivative
+     * function. For all other members, the new step size is computed, and the state and
+     * independent variable are updated if the step is accepted.
+     * \param stepSizes Step sizes to use for this attempt, zero for masked members.
+     * \param independentVariables Independent variables of the block (updated if accepted).
+     * \param states States of the block (updated if accepted).
+     * \param nextStepSizes Next step sizes of the block (updated for unmasked members).
+     * \param isStepAccepted Flags indicating whether the step of each member was accepted.
+     * \param stageStateDerivatives Workspace for the stage evaluations, reused between attempts.
+     */
+    void performStepAttempt( const IndependentVariableVector& stepSizes,
+                             IndependentVariableVector& independentVariables,
+                             EnsembleStateType& states,
+                             IndependentVariableVector& nextStepSizes,
+                             std::vector< bool >& isStepAccepted,
+                             std::vector< EnsembleStateType >& stageStateDerivatives );
+
+    //! Integrate a contiguous block of members to the end of the integration interval.
+    /*!
+     * Integrates a contiguous block of members to the end of the integration interval. This
+     * function operates on local copies of the block data, and is run by each of the threads
+     * started by integrateTo( ).
+     * \param firstMember Index of the first member in the block.
+     * \param numberOfMembersInBlock Number of members in the block.
+     * \param intervalEnd The end of the integration interval.
+     * \param exceptionPointer Pointer to store any exception thrown in the block.
+     */
+    void integrateBlockTo( const int firstMember, const int numberOfMembersInBlock,
+                           const IndependentVariableType intervalEnd,
+                           boost::exception_ptr& exceptionPointer );
+
+    //! Ensemble state derivative function.
+    /*!
+     * Ensemble state derivative function, as passed to the constructor.
+     */
+    EnsembleStateDerivativeFunction ensembleStateDerivativeFunction_;
+
+    //! Current independent variables.
+    /*!
+     * Current independent variable of each member of the ensemble.
+     */
+    IndependentVariableVector currentIndependentVariables_;
+
+    //! Current states.
+    /*!
+     * Current state of each member of the ensemble, one row per member.
+     */
+    EnsembleStateType currentStates_;
+
+    //! Next step sizes.
+    /*!
+     * Step size to be used for the next step of each member of the ensemble.
+     */
+    IndependentVariableVector nextStepSizes_;
+
+    //! Coefficients for the integrator.
+    /*!
+     * Coefficients for the integrator, as defined by the Butcher tableau.
+     */
+    RungeKuttaCoefficients coefficients_;
+
+    //! Minimum step size.
+    /*!
+     * Minimum step size.
+     */
+    IndependentVariableType minimumStepSize_;
+
+    //! Maximum step size.
+    /*!
+     * Maximum step size.
+     */
+    IndependentVariableType maximumStepSize_;
+
+    //! Relative error tolerance.
+    /*!
+     * Relative error tolerance per element in the state.
+     */
+    ErrorToleranceType relativeErrorTolerance_;
+
+    //! Absolute error tolerance.
+    /*!
+     * Absolute error tolerance per element in the state.
+     */
+    ErrorToleranceType absoluteErrorTolerance_;
+
+    //! Safety factor for next step size.
+    /*!
+     * Safety factor used to scale prediction of next step size. This is usually picked between
+     * 0.8 and 0.9 (Burden and Faires, 2001).
+     */
+    IndependentVariableType safetyFactorForNextStepSize_;
+
+    //! Maximum factor increase for next step size.
+    /*!
+     * The maximum factor by which the next step size can increase compared to the current value
+     * (Burden and Faires, 2001).
+     */
+    IndependentVariableType maximumFactorIncreaseForNextStepSize_;
+
+    //! Minimum factor decrease for next step size.
+    /*!
+     * The minimum factor by which the next step size can decrease compared to the current value
+     * (Burden and Faires, 2001).
+     */
+    IndependentVariableType minimumFactorDecreaseForNextStepSize_;
+};
+
+//! Perform a single integration step for all members.
+template < typename IndependentVariableType >
+typename RungeKuttaVariableStepSizeEnsembleIntegrator< IndependentVariableType >::EnsembleStateType
+RungeKuttaVariableStepSizeEnsembleIntegrator< IndependentVariableType >::performIntegrationStep(
+        const IndependentVariableVector& stepSizes )
+{
+    std::vector< EnsembleStateType > stageStateDerivatives;
+    std::vector< bool > isStepAccepted( currentStates_.rows( ) );
+
+    // Step sizes of the current attempt; members that have accepted their step are masked out.
+    IndependentVariableVector attemptStepSizes = stepSizes;
+
+    bool areAllStepsAccepted = false;
+    while ( !areAllStepsAccepted )
+    {
+        performStepAttempt( attemptStepSizes, currentIndependentVariables_, currentStates_,
+                            nextStepSizes_, isStepAccepted, stageStateDerivatives );
+
+        // Retry rejected members with their reduced step size.
+        areAllStepsAccepted = true;
+        for ( int member = 0; member < attemptStepSizes.rows( ); member++ )
+        {
+            if ( isStepAccepted[ member ] )
+            {
+                attemptStepSizes( member ) = 0.0;
+            }
+
+            else
+            {
+                attemptStepSizes( member ) = nextStepSizes_( member );
+                areAllStepsAccepted = false;
+            }
+        }
+    }
+
+    return currentStates_;
+}
+
+//! Integrate all members to the given end of the integration interval.
+template < typename IndependentVariableType >
+typename RungeKuttaVariableStepSizeEnsembleIntegrator< IndependentVariableType >::EnsembleStateType
+RungeKuttaVariableStepSizeEnsembleIntegrator< IndependentVariableType >::integrateTo(
+        const IndependentVariableType intervalEnd,
+        const IndependentVariableType initialStepSize,
+        const unsigned int numberOfThreads )
+{
+    const int numberOfMembers = getNumberOfMembers( );
+
+    // Set the initial step size for all members.
+    nextStepSizes_.setConstant( initialStepSize );
+
+    // Determine the number of blocks, such that each thread handles at least one member.
+    const int numberOfBlocks = std::max(
+                1, std::min( numberOfMembers, static_cast< int >( numberOfThreads ) ) );
+
+    std::vector< boost::exception_ptr > exceptionPointers( numberOfBlocks );
+
+    if ( numberOfBlocks == 1 )
+    {
+        integrateBlockTo( 0, numberOfMembers, intervalEnd, exceptionPointers[ 0 ] );
+    }
+
+    else
+    {
+        // Distribute the members over the blocks as evenly as possible.
+        boost::thread_group threads;
+        int firstMember = 0;
+        for ( int block = 0; block < numberOfBlocks; block++ )
+        {
+            const int numberOfMembersInBlock = numberOfMembers / numberOfBlocks
+                    + ( block < numberOfMembers % numberOfBlocks ? 1 : 0 );
+
+            threads.create_thread(
+                        boost::bind( &RungeKuttaVariableStepSizeEnsembleIntegrator::
+                                     integrateBlockTo, this, firstMember, numberOfMembersInBlock,
+                                     intervalEnd, boost::ref( exceptionPointers[ block ] ) ) );
+
+            firstMember += numberOfMembersInBlock;
+        }
+
+        threads.join_all( );
+    }
+
+    // Rethrow the first exception encountered by any of the blocks.
+    for ( int block = 0; block < numberOfBlocks; block++ )
+    {
+        if ( exceptionPointers[ block ] )
+        {
+            boost::rethrow_exception( exceptionPointers[ block ] );
+        }
+    }
+
+    return currentStates_;
+}
+
+//! Perform a single lockstep step attempt for a block of members.
+template < typename IndependentVariableType >
+void RungeKuttaVariableStepSizeEnsembleIntegrator< IndependentVariableType >::performStepAttempt(
+        const IndependentVariableVector& stepSizes,
+        IndependentVariableVector& independentVariables,
+        EnsembleStateType& states,
+        IndependentVariableVector& nextStepSizes,
+        std::vector< bool >& isStepAccepted,
+        std::vector< EnsembleStateType >& stageStateDerivatives )
+{
+    const int numberOfStages = static_cast< int >( coefficients_.cCoefficients.rows( ) );
+    stageStateDerivatives.resize( numberOfStages );
+
+    // Collect the members that take a step in this attempt. Masked members are accepted as is.
+    isStepAccepted.assign( states.rows( ), true );
+    std::vector< int > activeMembers;
+    activeMembers.reserve( states.rows( ) );
+    for ( int member = 0; member < states.rows( ); member++ )
+    {
+        if ( stepSizes( member ) != 0.0 )
+        {
+            activeMembers.push_back( member );
+        }
+    }
+
+    const int numberOfActiveMembers = static_cast< int >( activeMembers.size( ) );
+    if ( numberOfActiveMembers == 0 )
+    {
+        return;
+    }
+
+    // Gather the active members into a compact ensemble, such that the state derivative function
+    // is only evaluated for these members.
+    IndependentVariableVector activeStepSizes( numberOfActiveMembers );
+    IndependentVariableVector activeIndependentVariables( numberOfActiveMembers );
+    EnsembleStateType activeStates( numberOfActiveMembers, states.cols( ) );
+    for ( int activeMember = 0; activeMember < numberOfActiveMembers; activeMember++ )
+    {
+        const int member = activeMembers[ activeMember ];
+        activeStepSizes( activeMember ) = stepSizes( member );
+        activeIndependentVariables( activeMember ) = independentVariables( member );
+        activeStates.row( activeMember ) = states.row( member );
+    }
+
+    // Define lower and higher order estimates.
+    EnsembleStateType lowerOrderEstimate( activeStates ), higherOrderEstimate( activeStates );
+    EnsembleStateType intermediateStates;
+
+    // Compute the k_i state derivatives per stage, for all active members at once.
+    for ( int stage = 0; stage < numberOfStages; stage++ )
+    {
+        // Compute the intermediate states to pass to the state derivative for this stage.
+        intermediateStates = activeStates;
+        for ( int column = 0; column < stage; column++ )
+        {
+            if ( coefficients_.aCoefficients( stage, column ) != 0.0 )
+            {
+                intermediateStates.array( ) +=
+                        stageStateDerivatives[ column ].array( ).colwise( )
+                        * ( coefficients_.aCoefficients( stage, column )
+                            * activeStepSizes.array( ) );
+            }
+        }
+
+        // Compute the state derivatives of all active members.
+        stageStateDerivatives[ stage ] = ensembleStateDerivativeFunction_(
+                    activeIndependentVariables
+                    + coefficients_.cCoefficients( stage ) * activeStepSizes,
+                    intermediateStates );
+
+        // Update the estimates.
+        lowerOrderEstimate.array( ) += stageStateDerivatives[ stage ].array( ).colwise( )
+                * ( coefficients_.bCoefficients( 0, stage ) * activeStepSizes.array( ) );
+        higherOrderEstimate.array( ) += stageStateDerivatives[ stage ].array( ).colwise( )
+                * ( coefficients_.bCoefficients( 1, stage ) * activeStepSizes.array( ) );
+    }
+
+    // Compute the relative truncation error per member, based on the higher and lower order
+    // estimates and the relative and absolute error tolerances (Montenbruck and Gill, 2005).
+    const IndependentVariableVector maximumErrorInStates =
+            ( ( higherOrderEstimate - lowerOrderEstimate ).array( ).abs( )
+              / ( ( higherOrderEstimate.array( ).abs( ).rowwise( )
+                    * relativeErrorTolerance_.array( ) ).rowwise( )
+                  + absoluteErrorTolerance_.array( ) ) ).rowwise( ).maxCoeff( );
+
+    for ( int activeMember = 0; activeMember < numberOfActiveMembers; activeMember++ )
+    {
+        const int member = activeMembers[ activeMember ];
+        const IndependentVariableType stepSize = activeStepSizes( activeMember );
+
+        // Compute the new step size, and limit the change in step size to prevent aliasing with
+        // the dynamics of the system (Burden and Faires, 2001).
+        const IndependentVariableType newStepSize = safetyFactorForNextStepSize_ * stepSize
+                * std::pow( 1.0 / maximumErrorInStates( activeMember ),
+                            1.0 / coefficients_.higherOrder );
+
+        if ( newStepSize / stepSize <= minimumFactorDecreaseForNextStepSize_ )
+        {
+            nextStepSizes( member ) = stepSize * minimumFactorDecreaseForNextStepSize_;
+        }
+
+        else if ( newStepSize / stepSize >= maximumFactorIncreaseForNextStepSize_ )
+        {
+            nextStepSizes( member ) = stepSize * maximumFactorIncreaseForNextStepSize_;
+        }
+
+        else
+        {
+            nextStepSizes( member ) = newStepSize;
+        }
+
+        // Check if minimum step size is violated and throw exception if necessary.
+        if ( std::fabs( nextStepSizes( member ) ) < minimumStepSize_ )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            MinimumStepSizeExceededError(
+                                minimumStepSize_, std::fabs( nextStepSizes( member ) ) ) ) );
+        }
+
+        else if ( std::fabs( nextStepSizes( member ) ) > maximumStepSize_ )
+        {
+            nextStepSizes( member ) = maximumStepSize_;
+        }
+
+        // Accept the step if the error is within bounds.
+        isStepAccepted[ member ] = maximumErrorInStates( activeMember ) <= 1.0;
+        if ( isStepAccepted[ member ] )
+        {
+            independentVariables( member ) += stepSize;
+
+            switch ( coefficients_.orderEstimateToIntegrate )
+            {
+            case RungeKuttaCoefficients::lower:
+                states.row( member ) = lowerOrderEstimate.row( activeMember );
+                break;
+
+            case RungeKuttaCoefficients::higher:
+                states.row( member ) = higherOrderEstimate.row( activeMember );
+                break;
+
+            default: // The default case will never occur because OrderEstimateToIntegrate is an
+                     // enum.
+                boost::throw_exception(
+                            boost::enable_error_info(
+                                std::runtime_error( "Order estimate to integrate is invalid." ) ) );
+            }
+        }
+    }
+}
+
+//! Integrate a contiguous block of members to the end of the integration interval.
+template < typename IndependentVariableType >
+void RungeKuttaVariableStepSizeEnsembleIntegrator< IndependentVariableType >::integrateBlockTo(
+        const int firstMember, const int numberOfMembersInBlock,
+        const IndependentVariableType intervalEnd,
+        boost::exception_ptr& exceptionPointer )
+{
+    // Copy the block data, such that the threads do not share any intermediate data.
+    IndependentVariableVector independentVariables =
+            currentIndependentVariables_.segment( firstMember, numberOfMembersInBlock );
+    EnsembleStateType states = currentStates_.middleRows( firstMember, numberOfMembersInBlock );
+    IndependentVariableVector nextStepSizes =
+            nextStepSizes_.segment( firstMember, numberOfMembersInBlock );
+
+    std::vector< EnsembleStateType > stageStateDerivatives;
+    std::vector< bool > isStepAccepted( numberOfMembersInBlock );
+    IndependentVariableVector stepSizes( numberOfMembersInBlock );
+
+    // Set the tolerance with which the end of the integration interval is considered reached,
+    // relative to the length of the integration interval of each member, such that it is
+    // independent of the scale of the independent variable.
+    const IndependentVariableVector tolerances
+            = ( intervalEnd - independentVariables.array( ) ).abs( )
+            * ( std::numeric_limits< IndependentVariableType >::epsilon( ) * 10.0 );
+
+    try
+    {
+        bool isIntervalEndReachedForAllMembers = false;
+        while ( !isIntervalEndReachedForAllMembers )
+        {
+            // Determine the step size of each member, and mask out the members that have reached
+            // the end of the integration interval.
+            isIntervalEndReachedForAllMembers = true;
+            for ( int member = 0; member < numberOfMembersInBlock; member++ )
+            {
+                const IndependentVariableType remainingInterval
+                        = intervalEnd - independentVariables( member );
+                const IndependentVariableType stepSizeSign
+                        = nextStepSizes( member ) < 0.0 ? -1.0 : 1.0;
+
+                if ( remainingInterval * stepSizeSign <= tolerances( member ) )
+                {
+                    stepSizes( member ) = 0.0;
+                }
+
+                else
+                {
+                    stepSizes( member ) = ( std::fabs( nextStepSizes( member ) )
+                                            >= std::fabs( remainingInterval ) )
+                            ? remainingInterval : nextStepSizes( member );
+                    isIntervalEndReachedForAllMembers = false;
+                }
+            }
+
+            if ( !isIntervalEndReachedForAllMembers )
+            {
+                performStepAttempt( stepSizes, independentVariables, states, nextStepSizes,
+                                    isStepAccepted, stageStateDerivatives );
+            }
+        }
+    }
+
+    catch ( ... )
+    {
+        exceptionPointer = boost::current_exception( );
+    }
+
+    // Store the block data; the blocks are disjoint, so no locking is required.
+    currentIndependentVariables_.segment( firstMember, numberOfMembersInBlock )
+            = independentVariables;
+    currentStates_.middleRows( firstMember, numberOfMembersInBlock ) = states;
+    nextStepSizes_.segment( firstMember, numberOfMembersInBlock ) = nextStepSizes;
+}
+
+//! Exception that is thrown if the minimum step size is exceeded.
+/*!
+ * Exception thrown by RungeKuttaVariableStepSizeEnsembleIntegrator<> if the minimum step size is
+ * exceeded by any member of the ensemble.
+ */
+template < typename IndependentVariableType >
+class RungeKuttaVariableStepSizeEnsembleIntegrator< IndependentVariableType >
+        ::MinimumStepSizeExceededError : public std::runtime_error
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, initializes the parent runtime_error.
+     * \param minimumStepSize_ The minimum step size allowed by the integrator.
+     * \param requestedStepSize_ The new calculated step size.
+     */
+    MinimumStepSizeExceededError( IndependentVariableType minimumStepSize_,
+                                  IndependentVariableType requestedStepSize_ ) :
+        std::runtime_error( "Minimum step size exceeded." ),
+        minimumStepSize( minimumStepSize_ ), requestedStepSize( requestedStepSize_ )
+    { }
+
+    //! The minimum step size allowed by the integrator.
+    /*!
+     * The minimum step size allowed by the integrator.
+     */
+    IndependentVariableType minimumStepSize;
+
+    //! The new calculated step size.
+    /*!
+     * The new calculated step size.
+     */
+    IndependentVariableType requestedStepSize;
+
+protected:
+private:
+};
+
+//! Typedef of variable-step size Runge-Kutta ensemble integrator (double precision).
+typedef RungeKuttaVariableStepSizeEnsembleIntegrator< >
+RungeKuttaVariableStepSizeEnsembleIntegratorXd;
+
+//! Typedef for shared-pointer to RungeKuttaVariableStepSizeEnsembleIntegratorXd object.
+typedef boost::shared_ptr< RungeKuttaVariableStepSizeEnsembleIntegratorXd >
+RungeKuttaVariableStepSizeEnsembleIntegratorXdPointer;
+
+} // namespace numerical_integrators
+} // namespace tudat
+
+#endif // TUDAT_RUNGE_KUTTA_VARIABLE_STEP_SIZE_ENSEMBLE_INTEGRATOR_H
@@ -44,18 +44,43 @@
  *      120614    A. Ronse          Fixed bug in constructor.
  *      130121    K. Kumar          Added shared-ptr typedef.
  *      130307    D. Dirkx          Added function to retrieve integration stage evaluations.
+ *      261016    agent             Added preallocated stage workspace, reused across steps;
+ *                                  replaced recursion on rejected steps by loop; added Vector6d
+ *                                  typedef.
+ *      261016    agent             Added dense output (cubic Hermite continuous extension) and
+ *                                  reuse of the state derivative at the start of the step.
+ *      261016    agent             Replaced cubic Hermite dense output by order-matched
+ *                                  Hermite-Birkhoff continuous extension; first stage is
+ *                                  recomputed at the start of each step.
  *
  *    References
  *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
  *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer, 2005.
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I: Nonstiff
+ *          Problems, 2nd Edition, Springer, 1993.
+ *      Enright, W.H., Jackson, K.R., Norsett, S.P., Thomsen, P.G. Interpolants for Runge-Kutta
+ *          formulas, ACM Transactions on Mathematical Software, 12(3), 193-218, 1986.
  *
  *    Notes
+ *      Dedicated continuous extensions exist for several embedded Runge-Kutta methods, e.g., the
+ *      seventh-order interpolant of DOP853, which requires three additional stages (Hairer et al.,
+ *      1993). Such extensions are tied to a specific Butcher tableau, and are not available for
+ *      the coefficient sets in RungeKuttaCoefficients. Instead, the dense output uses a generic
+ *      Hermite-Birkhoff continuous extension of order p, with p the order of the integrated
+ *      estimate (at least 3). The interpolating polynomial matches the states at the start and
+ *      end of the step, and the state derivatives at the start and end of the step and at p - 3
+ *      interior nodes. The state derivatives at the interior nodes are bootstrapped: they are
+ *      first evaluated on the cubic Hermite interpolant, after which each of p - 4 sweeps
+ *      re-evaluates them on the current interpolant, gaining one order per sweep (Enright et al.,
+ *      1986). This requires (p - 3)^2 + 1 additional state derivative evaluations per step in
+ *      which dense output is requested, and none for steps in which it is not.
  *
  */
 
 #ifndef TUDAT_RUNGE_KUTTA_VARIABLE_STEP_SIZE_INTEGRATOR_H
 #define TUDAT_RUNGE_KUTTA_VARIABLE_STEP_SIZE_INTEGRATOR_H
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 #include <utility>
@@ -67,10 +92,13 @@
 #include <boost/shared_ptr.hpp>
 
 #include <Eigen/Core>
+#include <Eigen/LU>
+#include <Eigen/StdVector>
 
 #include <TudatCore/Basics/utilityMacros.h>
 #include <TudatCore/Mathematics/NumericalIntegrators/reinitializableNumericalIntegrator.h>
 
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
 
 namespace tudat
@@ -123,6 +151,14 @@ public:
     typedef typename ReinitializableNumericalIntegratorBase::NumericalIntegratorBase::
     StateDerivativeFunction StateDerivativeFunction;
 
+    //! Typedef for the workspace of stage evaluations.
+    /*!
+     * Typedef for the workspace of stage evaluations. An aligned allocator is used, such that
+     * fixed-size vectorizable state derivative types (e.g., Vector6d) can be stored safely.
+     */
+    typedef std::vector< StateDerivativeType, Eigen::aligned_allocator< StateDerivativeType > >
+    StateDerivativeWorkspace;
+
     //! Exception that is thrown if the minimum step size is exceeded.
     /*!
      * Exception thrown by RungeKuttaVariableStepSizeIntegrator<>::
@@ -166,6 +202,7 @@ public:
         currentIndependentVariable_( intervalStart ),
         currentState_( initialState ),
         lastIndependentVariable_( intervalStart ),
+        lastState_( initialState ),
         coefficients_( coefficients ),
         minimumStepSize_( std::fabs( minimumStepSize ) ),
         maximumStepSize_( std::fabs( maximumStepSize ) ),
@@ -174,7 +211,20 @@ public:
         safetyFactorForNextStepSize_( std::fabs( safetyFactorForNextStepSize ) ),
         maximumFactorIncreaseForNextStepSize_( std::fabs( maximumFactorIncreaseForNextStepSize ) ),
         minimumFactorDecreaseForNextStepSize_( std::fabs( minimumFactorDecreaseForNextStepSize ) ),
-        newStepSizeFunction_( newStepSizeFunction )
+        newStepSizeFunction_( newStepSizeFunction ),
+        currentStateDerivatives_( coefficients.cCoefficients.rows( ),
+                                  StateDerivativeType::Zero( initialState.rows( ),
+                                                             initialState.cols( ) ) ),
+        intermediateState_( initialState ),
+        lowerOrderEstimate_( initialState ),
+        higherOrderEstimate_( initialState ),
+        currentStateDerivative_( StateDerivativeType::Zero( initialState.rows( ),
+                                                            initialState.cols( ) ) ),
+        lastStateDerivative_( currentStateDerivative_ ),
+        isLastStateDerivativeComputed_( false ),
+        denseOutputOrder_( 0 ),
+        denseOutputBasisOrder_( 0 ),
+        isDenseOutputComputed_( false )
     {
         // Set default newStepSizeFunction_ to the class method.
         if ( this->newStepSizeFunction_ == 0 )
@@ -221,6 +271,7 @@ public:
         currentIndependentVariable_( intervalStart ),
         currentState_( initialState ),
         lastIndependentVariable_( intervalStart ),
+        lastState_( initialState ),
         coefficients_( coefficients ),
         minimumStepSize_( std::fabs( minimumStepSize ) ),
         maximumStepSize_( std::fabs( maximumStepSize ) ),
@@ -231,7 +282,20 @@ public:
         safetyFactorForNextStepSize_( std::fabs( safetyFactorForNextStepSize ) ),
         maximumFactorIncreaseForNextStepSize_( std::fabs( maximumFactorIncreaseForNextStepSize ) ),
         minimumFactorDecreaseForNextStepSize_( std::fabs( minimumFactorDecreaseForNextStepSize ) ),
-        newStepSizeFunction_( newStepSizeFunction )
+        newStepSizeFunction_( newStepSizeFunction ),
+        currentStateDerivatives_( coefficients.cCoefficients.rows( ),
+                                  StateDerivativeType::Zero( initialState.rows( ),
+                                                             initialState.cols( ) ) ),
+        intermediateState_( initialState ),
+        lowerOrderEstimate_( initialState ),
+        higherOrderEstimate_( initialState ),
+        currentStateDerivative_( StateDerivativeType::Zero( initialState.rows( ),
+                                                            initialState.cols( ) ) ),
+        lastStateDerivative_( currentStateDerivative_ ),
+        isLastStateDerivativeComputed_( false ),
+        denseOutputOrder_( 0 ),
+        denseOutputBasisOrder_( 0 ),
+        isDenseOutputComputed_( false )
     {
         // Set default newStepSizeFunction_ to the class method.
         if ( newStepSizeFunction_ == 0 )
@@ -274,7 +338,8 @@ public:
      */
     std::vector< StateDerivativeType > getCurrentStateDerivatives( ) 
     { 
-        return currentStateDerivatives_;
+        return std::vector< StateDerivativeType >( currentStateDerivatives_.begin( ),
+                                                   currentStateDerivatives_.end( ) );
     }
 
     //! Perform a single integration step.
@@ -286,6 +351,63 @@ public:
      */
     virtual StateType performIntegrationStep( const IndependentVariableType stepSize );
 
+    //! Get interpolated state inside the last accepted step (dense output).
+    /*!
+     * Returns the state at the given value of the independent variable, which should lie inside
+     * the last accepted step, using a Hermite-Birkhoff continuous extension of the order returned
+     * by getDenseOutputOrder( ). The state derivatives required by the continuous extension are
+     * computed on the first call after each step, and reused for all subsequent calls inside the
+     * same step. The first stage of the step is reused as the state derivative at the start of
+     * the step for coefficient sets of which the first stage is evaluated at the start of the
+     * step (i.e., c_{1} = 0, which is the case for all predefined sets).
+     * \param independentVariable Value of the independent variable at which the state is to be
+     *          computed. This value should lie between the values of the independent variable at
+     *          the start and end of the last accepted step.
+     * \return Interpolated state at the given value of the independent variable.
+     * \throws std::runtime_error If no accepted step is available, or if the independent variable
+     *          lies outside of the last accepted step.
+     */
+    StateType getInterpolatedState( const IndependentVariableType independentVariable );
+
+    //! Set order of the dense output.
+    /*!
+     * Sets the order of the continuous extension used by getInterpolatedState( ). By default, the
+     * order of the integrated estimate is used (with a minimum of 3).
+     * \param denseOutputOrder Order of the continuous extension, between 3 and 10.
+     * \throws std::runtime_error If the order lies outside of the supported range.
+     */
+    void setDenseOutputOrder( const unsigned int denseOutputOrder )
+    {
+        if ( denseOutputOrder < 3 || denseOutputOrder > 10 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Dense output order should lie between 3 and "
+                                                "10." ) ) );
+        }
+
+        this->denseOutputOrder_ = denseOutputOrder;
+        this->isDenseOutputComputed_ = false;
+    }
+
+    //! Get order of the dense output.
+    /*!
+     * Returns the order of the continuous extension used by getInterpolatedState( ).
+     * \return Order of the continuous extension.
+     */
+    unsigned int getDenseOutputOrder( ) const
+    {
+        if ( this->denseOutputOrder_ != 0 )
+        {
+            return this->denseOutputOrder_;
+        }
+
+        const unsigned int integratedOrder
+                = ( this->coefficients_.orderEstimateToIntegrate == RungeKuttaCoefficients::lower )
+                ? this->coefficients_.lowerOrder : this->coefficients_.higherOrder;
+        return std::min( std::max( integratedOrder, 3u ), 10u );
+    }
+
     //! Rollback internal state to the last state.
     /*!
      * Performs rollback of the internal state to the last state. This function can only be called
@@ -303,6 +425,7 @@ public:
 
         this->currentIndependentVariable_ = this->lastIndependentVariable_;
         this->currentState_ = this->lastState_;
+        this->isDenseOutputComputed_ = false;
         return true;
     }
 
@@ -320,6 +443,7 @@ public:
     {
         this->currentState_ = newState;
         this->lastIndependentVariable_ = currentIndependentVariable_;
+        this->isDenseOutputComputed_ = false;
     }
 
 protected:
@@ -348,6 +472,31 @@ protected:
             const StateType& relativeErrorTolerance, const StateType& absoluteErrorTolerance,
             const StateType& lowerOrderEstimate, const StateType& higherOrderEstimate );
 
+    //! Compute the basis of the dense output.
+    /*!
+     * Computes the interior nodes of the continuous extension of the given order, and the inverse
+     * of the matrix that maps the interpolation conditions to the polynomial coefficients. The
+     * polynomial is expressed in s = 2 theta - 1, with theta the normalized position inside the
+     * step, and the interior nodes are equally spaced at j / ( p - 1 ), j = 1, ..., p - 3, which
+     * keeps the system well-conditioned for all supported orders.
+     * \param denseOutputOrder Order of the continuous extension.
+     */
+    void computeDenseOutputBasis( const unsigned int denseOutputOrder );
+
+    //! Compute the state derivatives used by the dense output for the last accepted step.
+    void computeDenseOutput( );
+
+    //! Evaluate the dense output polynomial.
+    /*!
+     * Evaluates the continuous extension at the given normalized position inside the last
+     * accepted step, using the state derivatives currently stored in the dense output workspace.
+     * \param theta Normalized position inside the step, between 0 and 1.
+     * \param stepSize Size of the last accepted step.
+     * \return Interpolated state.
+     */
+    StateType evaluateDenseOutput( const IndependentVariableType theta,
+                                   const IndependentVariableType stepSize );
+
     //! Last used step size.
     /*!
      * Last used step size, passed to either integrateTo( ) or performIntegrationStep( ).
@@ -441,9 +590,76 @@ protected:
 
     //! Vector of state derivatives.
     /*!
-     * Vector of state derivatives, i.e. values of k_{i} in Runge-Kutta scheme.
+     * Vector of state derivatives, i.e. values of k_{i} in Runge-Kutta scheme. The vector is
+     * allocated once, in the constructor, and reused for every step.
+     */
+    StateDerivativeWorkspace currentStateDerivatives_;
+
+    //! Intermediate state.
+    /*!
+     * Intermediate state passed to the state derivative function for each stage, reused for every
+     * step.
+     */
+    StateType intermediateState_;
+
+    //! Lower order estimate.
+    /*!
+     * Lower order estimate of the state at the end of the step, reused for every step.
+     */
+    StateType lowerOrderEstimate_;
+
+    //! Higher order estimate.
+    /*!
+     * Higher order estimate of the state at the end of the step, reused for every step.
+     */
+    StateType higherOrderEstimate_;
+
+    //! State derivative at the current state.
+    /*!
+     * State derivative at the current state and independent variable, computed at the start of
+     * each step and reused as the first stage of all attempts of that step.
+     */
+    StateDerivativeType currentStateDerivative_;
+
+    //! State derivative at the last state.
+    /*!
+     * State derivative at the last state and independent variable, used for dense output.
      */
-    std::vector< StateDerivativeType > currentStateDerivatives_;
+    StateDerivativeType lastStateDerivative_;
+
+    //! Flag indicating whether the state derivative at the last state has been computed.
+    bool isLastStateDerivativeComputed_;
+
+    //! Order of the dense output set by the user (0 if the default order is used).
+    unsigned int denseOutputOrder_;
+
+    //! Order for which the dense output basis has been computed (0 if not computed).
+    unsigned int denseOutputBasisOrder_;
+
+    //! Interior nodes of the dense output, as normalized positions inside the step.
+    Eigen::VectorXd denseOutputNodes_;
+
+    //! Inverse of the dense output interpolation matrix.
+    /*!
+     * Inverse of the matrix that maps the interpolation conditions (states at the start and end
+     * of the step, followed by the scaled state derivatives at the start of the step, the interior
+     * nodes and the end of the step) to the coefficients of the polynomial in s = 2 theta - 1.
+     */
+    Eigen::MatrixXd denseOutputBasisInverse_;
+
+    //! Weights of the interpolation conditions, reused for each evaluation of the dense output.
+    Eigen::VectorXd denseOutputWeights_;
+
+    //! State derivatives at the start of the step, the interior nodes and the end of the step.
+    StateDerivativeWorkspace denseOutputStateDerivatives_;
+
+    //! Flag indicating whether the dense output has been computed for the last accepted step.
+    bool isDenseOutputComputed_;
+
+public:
+
+    // Ensure that fixed-size vectorizable members (e.g., Vector6d states) are properly aligned.
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
 //! Perform a single integration step.
@@ -452,71 +668,317 @@ StateType
 RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType >
 ::performIntegrationStep( const IndependentVariableType stepSize )
 {
-    // Define and allocated vector for the number of stages.
-    currentStateDerivatives_.clear( );
-    currentStateDerivatives_.reserve( this->coefficients_.cCoefficients.rows( ) );
+    const int numberOfStages = this->coefficients_.cCoefficients.rows( );
 
-    // Define lower and higher order estimates.
-    StateType lowerOrderEstimate( this->currentState_ ),
-              higherOrderEstimate( this->currentState_ );
+    // Ensure that the workspace holds an entry per stage; this only allocates memory if the
+    // coefficients do not match those passed to the constructor.
+    if ( static_cast< int >( currentStateDerivatives_.size( ) ) != numberOfStages )
+    {
+        currentStateDerivatives_.resize(
+                    numberOfStages, StateDerivativeType::Zero( this->currentState_.rows( ),
+                                                               this->currentState_.cols( ) ) );
+    }
 
-    // Compute the k_i state derivatives per stage.
-    for ( int stage = 0; stage < this->coefficients_.cCoefficients.rows( ); stage++ )
+    // Check if the first stage is evaluated at the start of the step. If so, the state derivative
+    // at the current state is computed once per step, and reused for all attempts of this step
+    // (and as the state derivative at the start of the step for dense output). It is not carried
+    // over from a previous step, since the state derivative function may depend on data that is
+    // updated between steps.
+    const bool isFirstStageAtStartOfStep = numberOfStages > 0
+            && this->coefficients_.cCoefficients( 0 ) == 0.0;
+    if ( isFirstStageAtStartOfStep )
     {
-        // Compute the intermediate state to pass to the state derivative for this stage.
-        StateType intermediateState( this->currentState_ );
+        this->currentStateDerivative_ = this->stateDerivativeFunction_(
+                    this->currentIndependentVariable_, this->currentState_ );
+    }
 
-        // Compute the intermediate state.
-        for ( int column = 0; column < stage; column++ )
+    // Perform step attempts until the error is within bounds. All intermediate results are
+    // stored in the workspace members, such that no memory is allocated for fixed-size states.
+    IndependentVariableType attemptedStepSize = stepSize;
+    while ( true )
+    {
+        // Initialize lower and higher order estimates.
+        lowerOrderEstimate_ = this->currentState_;
+        higherOrderEstimate_ = this->currentState_;
+
+        // Compute the k_i state derivatives per stage.
+        for ( int stage = 0; stage < numberOfStages; stage++ )
+        {
+            // Compute the intermediate state to pass to the state derivative for this stage.
+            intermediateState_ = this->currentState_;
+            for ( int column = 0; column < stage; column++ )
+            {
+                intermediateState_ += attemptedStepSize
+                        * this->coefficients_.aCoefficients( stage, column )
+                        * currentStateDerivatives_[ column ];
+            }
+
+            // Compute the state derivative, or reuse the state derivative at the current state.
+            if ( stage == 0 && isFirstStageAtStartOfStep )
+            {
+                currentStateDerivatives_[ stage ] = this->currentStateDerivative_;
+            }
+
+            else
+            {
+                currentStateDerivatives_[ stage ] = this->stateDerivativeFunction_(
+                            this->currentIndependentVariable_ +
+                            this->coefficients_.cCoefficients( stage ) * attemptedStepSize,
+                            intermediateState_ );
+            }
+
+            // Update the estimate.
+            lowerOrderEstimate_ += this->coefficients_.bCoefficients( 0, stage )
+                    * attemptedStepSize * currentStateDerivatives_[ stage ];
+            higherOrderEstimate_ += this->coefficients_.bCoefficients( 1, stage )
+                    * attemptedStepSize * currentStateDerivatives_[ stage ];
+        }
+
+        // Determine if the error was within bounds and compute a new step size.
+        if ( computeNextStepSizeAndValidateResult( lowerOrderEstimate_, higherOrderEstimate_,
+                                                   attemptedStepSize ) )
         {
-            intermediateState += stepSize * this->coefficients_.aCoefficients( stage, column )
-                    * currentStateDerivatives_[ column ];
+            break;
         }
 
-        // Compute the state derivative.
-        currentStateDerivatives_.push_back(
-                    this->stateDerivativeFunction_(
-                        this->currentIndependentVariable_ +
-                        this->coefficients_.cCoefficients( stage ) * stepSize,
-                        intermediateState ) );
-
-        // Update the estimate.
-        lowerOrderEstimate += this->coefficients_.bCoefficients( 0, stage ) * stepSize *
-                currentStateDerivatives_[ stage ];
-        higherOrderEstimate += this->coefficients_.bCoefficients( 1, stage ) * stepSize *
-                currentStateDerivatives_[ stage ];
+        // Reject current step, and retry with the new step size.
+        attemptedStepSize = this->stepSize_;
     }
 
-    // Determine if the error was within bounds and compute a new step size.
-    if ( computeNextStepSizeAndValidateResult( lowerOrderEstimate,
-                                               higherOrderEstimate, stepSize ) )
+    // Accept the current step.
+    this->lastIndependentVariable_ = this->currentIndependentVariable_;
+    this->lastState_ = this->currentState_;
+    this->currentIndependentVariable_ += attemptedStepSize;
+
+    // The state derivative at the start of the step is retained for dense output; all other
+    // state derivatives required for dense output are only computed when requested.
+    this->lastStateDerivative_.swap( this->currentStateDerivative_ );
+    this->isLastStateDerivativeComputed_ = isFirstStageAtStartOfStep;
+    this->isDenseOutputComputed_ = false;
+
+    switch ( this->coefficients_.orderEstimateToIntegrate )
     {
-        // Accept the current step.
-        this->lastIndependentVariable_ = this->currentIndependentVariable_;
-        this->lastState_ = this->currentState_;
-        this->currentIndependentVariable_ += stepSize;
+    case RungeKuttaCoefficients::lower:
+        this->currentState_ = lowerOrderEstimate_;
+        break;
+
+    case RungeKuttaCoefficients::higher:
+        this->currentState_ = higherOrderEstimate_;
+        break;
+
+    default: // The default case will never occur because OrderEstimateToIntegrate is an enum.
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Order estimate to integrate is invalid." ) ) );
+    }
+
+    return this->currentState_;
+}
+
+//! Get interpolated state inside the last accepted step (dense output).
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+StateType
+RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType >
+::getInterpolatedState( const IndependentVariableType independentVariable )
+{
+    const IndependentVariableType stepSize
+            = this->currentIndependentVariable_ - this->lastIndependentVariable_;
 
-        switch ( this->coefficients_.orderEstimateToIntegrate )
+    // Check that an accepted step is available.
+    if ( stepSize == 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "No accepted step available for dense output." ) ) );
+    }
+
+    // Compute the normalized position inside the last step, and check that it lies inside the
+    // step (allowing for round-off errors).
+    const IndependentVariableType theta
+            = ( independentVariable - this->lastIndependentVariable_ ) / stepSize;
+    const IndependentVariableType tolerance
+            = std::numeric_limits< IndependentVariableType >::epsilon( ) * 10.0;
+
+    if ( theta < -tolerance || theta > 1.0 + tolerance )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Requested dense output is outside of the last accepted step." ) ) );
+    }
+
+    // Return the states at the start and end of the step exactly.
+    if ( theta <= 0.0 )
+    {
+        return this->lastState_;
+    }
+
+    if ( theta >= 1.0 )
+    {
+        return this->currentState_;
+    }
+
+    // Compute the state derivatives required by the continuous extension, if not yet available.
+    if ( !this->isDenseOutputComputed_ )
+    {
+        computeDenseOutput( );
+    }
+
+    return evaluateDenseOutput( theta, stepSize );
+}
+
+//! Compute the basis of the dense output.
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+void
+RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType >
+::computeDenseOutputBasis( const unsigned int denseOutputOrder )
+{
+    const int numberOfCoefficients = denseOutputOrder + 1;
+    const int numberOfInteriorNodes = denseOutputOrder - 3;
+
+    // Set equally spaced interior nodes.
+    denseOutputNodes_.resize( numberOfInteriorNodes );
+    for ( int node = 0; node < numberOfInteriorNodes; node++ )
+    {
+        denseOutputNodes_( node ) = static_cast< double >( node + 1 )
+                / static_cast< double >( numberOfInteriorNodes + 2 );
+    }
+
+    // Set up the interpolation matrix for the polynomial sum_k a_k s^k, with s = 2 theta - 1.
+    // The first two rows impose the states at theta = 0 and theta = 1; the remaining rows impose
+    // the derivatives with respect to theta (i.e., the state derivative times the step size) at
+    // theta = 0, the interior nodes and theta = 1.
+    Eigen::MatrixXd interpolationMatrix
+            = Eigen::MatrixXd::Zero( numberOfCoefficients, numberOfCoefficients );
+    for ( int power = 0; power < numberOfCoefficients; power++ )
+    {
+        interpolationMatrix( 0, power ) = ( power % 2 == 0 ) ? 1.0 : -1.0;
+        interpolationMatrix( 1, power ) = 1.0;
+    }
+
+    for ( int derivativeNode = 0; derivativeNode < numberOfInteriorNodes + 2; derivativeNode++ )
+    {
+        double theta = 0.0;
+        if ( derivativeNode == numberOfInteriorNodes + 1 )
         {
-        case RungeKuttaCoefficients::lower:
-            this->currentState_ = lowerOrderEstimate;
-            return this->currentState_;
+            theta = 1.0;
+        }
 
-        case RungeKuttaCoefficients::higher:
-            this->currentState_ = higherOrderEstimate;
-            return currentState_;
+        else if ( derivativeNode > 0 )
+        {
+            theta = denseOutputNodes_( derivativeNode - 1 );
+        }
 
-        default: // The default case will never occur because OrderEstimateToIntegrate is an enum.
-            boost::throw_exception(
-                        boost::enable_error_info(
-                            std::runtime_error( "Order estimate to integrate is invalid." ) ) );
+        const double s = 2.0 * theta - 1.0;
+        double sPower = 1.0;
+        for ( int power = 1; power < numberOfCoefficients; power++ )
+        {
+            interpolationMatrix( derivativeNode + 2, power ) = 2.0 * power * sPower;
+            sPower *= s;
         }
     }
-    else
+
+    denseOutputBasisInverse_ = interpolationMatrix.inverse( );
+    denseOutputWeights_.resize( numberOfCoefficients );
+
+    denseOutputStateDerivatives_.resize(
+                numberOfInteriorNodes + 2, StateDerivativeType::Zero(
+                    this->currentState_.rows( ), this->currentState_.cols( ) ) );
+
+    denseOutputBasisOrder_ = denseOutputOrder;
+}
+
+//! Compute the state derivatives used by the dense output for the last accepted step.
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+void
+RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType >
+::computeDenseOutput( )
+{
+    const unsigned int denseOutputOrder = getDenseOutputOrder( );
+    if ( denseOutputOrder != denseOutputBasisOrder_ )
+    {
+        computeDenseOutputBasis( denseOutputOrder );
+    }
+
+    const int numberOfInteriorNodes = denseOutputOrder - 3;
+    const IndependentVariableType stepSize
+            = this->currentIndependentVariable_ - this->lastIndependentVariable_;
+
+    // Compute the state derivatives at the start and end of the step.
+    if ( !this->isLastStateDerivativeComputed_ )
+    {
+        this->lastStateDerivative_ = this->stateDerivativeFunction_(
+                    this->lastIndependentVariable_, this->lastState_ );
+        this->isLastStateDerivativeComputed_ = true;
+    }
+
+    denseOutputStateDerivatives_[ 0 ] = this->lastStateDerivative_;
+    denseOutputStateDerivatives_[ numberOfInteriorNodes + 1 ] = this->stateDerivativeFunction_(
+                this->currentIndependentVariable_, this->currentState_ );
+
+    // Compute the first estimate of the state derivatives at the interior nodes from the cubic
+    // Hermite interpolant, which is third order accurate (Hairer et al., 1993).
+    for ( int node = 0; node < numberOfInteriorNodes; node++ )
+    {
+        const IndependentVariableType theta = denseOutputNodes_( node );
+        const IndependentVariableType thetaSquared = theta * theta;
+        const IndependentVariableType thetaCubed = thetaSquared * theta;
+
+        intermediateState_ = ( 2.0 * thetaCubed - 3.0 * thetaSquared + 1.0 ) * this->lastState_
+                + ( -2.0 * thetaCubed + 3.0 * thetaSquared ) * this->currentState_
+                + ( ( thetaCubed - 2.0 * thetaSquared + theta ) * stepSize )
+                * denseOutputStateDerivatives_[ 0 ]
+                + ( ( thetaCubed - thetaSquared ) * stepSize )
+                * denseOutputStateDerivatives_[ numberOfInteriorNodes + 1 ];
+
+        denseOutputStateDerivatives_[ node + 1 ] = this->stateDerivativeFunction_(
+                    this->lastIndependentVariable_ + theta * stepSize, intermediateState_ );
+    }
+
+    // Re-evaluate the state derivatives at the interior nodes on the current interpolant. Each
+    // sweep raises the order of the interpolant by one, until the order of the continuous
+    // extension is reached (Enright et al., 1986).
+    for ( int sweep = 1; sweep < numberOfInteriorNodes; sweep++ )
+    {
+        for ( int node = 0; node < numberOfInteriorNodes; node++ )
+        {
+            const IndependentVariableType theta = denseOutputNodes_( node );
+            intermediateState_ = evaluateDenseOutput( theta, stepSize );
+            denseOutputStateDerivatives_[ node + 1 ] = this->stateDerivativeFunction_(
+                        this->lastIndependentVariable_ + theta * stepSize, intermediateState_ );
+        }
+    }
+
+    this->isDenseOutputComputed_ = true;
+}
+
+//! Evaluate the dense output polynomial.
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+StateType
+RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType >
+::evaluateDenseOutput( const IndependentVariableType theta,
+                       const IndependentVariableType stepSize )
+{
+    // Compute the weights of the interpolation conditions.
+    const double s = 2.0 * theta - 1.0;
+    double sPower = 1.0;
+    denseOutputWeights_.setZero( );
+    for ( int power = 0; power < denseOutputBasisInverse_.rows( ); power++ )
+    {
+        denseOutputWeights_ += sPower * denseOutputBasisInverse_.row( power ).transpose( );
+        sPower *= s;
+    }
+
+    // Combine the states and state derivatives.
+    StateType interpolatedState = denseOutputWeights_( 0 ) * this->lastState_
+            + denseOutputWeights_( 1 ) * this->currentState_;
+    for ( unsigned int node = 0; node < denseOutputStateDerivatives_.size( ); node++ )
     {
-        // Reject current step.
-        return performIntegrationStep( this->stepSize_ );
+        interpolatedState += ( denseOutputWeights_( node + 2 ) * stepSize )
+                * denseOutputStateDerivatives_[ node ];
     }
+
+    return interpolatedState;
 }
 
 //! Compute the next step size and validate the result.
@@ -594,25 +1056,15 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
 {
     TUDAT_UNUSED_PARAMETER( lowerOrder);
 
-    // Compute the truncation error based on the higher and lower order estimates.
-    const StateType truncationError_ =
-            ( higherOrderEstimate - lowerOrderEstimate ).array( ).abs( );
-
-    // Compute error tolerance based on relative and absolute error tolerances.
-    const StateType errorTolerance_ =
-            ( higherOrderEstimate.array( ).abs( ) *
-              relativeErrorTolerance.array( ) ).matrix( )
-            + absoluteErrorTolerance;
-
-    // Compute relative truncation error. This will indicate if the current step satisfies the
-    // required tolerances.
-    const StateType relativeTruncationError_ = truncationError_.array( ) /
-            errorTolerance_.array( );
-
-    // Compute the maximum error based on the largest coefficient in the relative truncation error
-    // matrix.
+    // Compute the maximum relative truncation error, i.e., the truncation error based on the
+    // higher and lower order estimates, divided by the error tolerance based on relative and
+    // absolute error tolerances. This will indicate if the current step satisfies the required
+    // tolerances. The computation is done as a single expression, such that no temporary states
+    // are created.
     const typename StateType::Scalar maximumErrorInState_
-            = relativeTruncationError_.array( ).abs( ).maxCoeff( );
+            = ( ( higherOrderEstimate - lowerOrderEstimate ).array( ).abs( )
+                / ( higherOrderEstimate.array( ).abs( ) * relativeErrorTolerance.array( )
+                    + absoluteErrorTolerance.array( ) ) ).maxCoeff( );
 
     // Compute the new step size. This is based off of the equation given in
     // (Montenbruck and Gill, 2005).
@@ -679,6 +1131,20 @@ typedef RungeKuttaVariableStepSizeIntegrator< > RungeKuttaVariableStepSizeIntegr
 typedef boost::shared_ptr< RungeKuttaVariableStepSizeIntegratorXd >
 RungeKuttaVariableStepSizeIntegratorXdPointer;
 
+//! Typedef of variable-step size Runge-Kutta integrator (state/state derivative = Vector6d,
+//! independent variable = double).
+/*!
+ * Typedef of a variable-step size Runge-Kutta integrator with Vector6ds as state and state
+ * derivative and double as independent variable. Steps taken with this integrator do not
+ * allocate any memory.
+ */
+typedef RungeKuttaVariableStepSizeIntegrator< double, basic_mathematics::Vector6d >
+RungeKuttaVariableStepSizeIntegrator6d;
+
+//! Typedef for shared-pointer to RungeKuttaVariableStepSizeIntegrator6d object.
+typedef boost::shared_ptr< RungeKuttaVariableStepSizeIntegrator6d >
+RungeKuttaVariableStepSizeIntegrator6dPointer;
+
 } // namespace numerical_integrators
 } // namespace tudat
 